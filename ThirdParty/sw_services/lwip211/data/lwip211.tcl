@@ -637,6 +637,10 @@ proc generate_lwip_opts {libhandle} {
 	puts $lwipopts_fd "\#define PBUF_POOL_SIZE $pbuf_pool_size"
 	puts $lwipopts_fd "\#define PBUF_POOL_BUFSIZE $pbuf_pool_bufsize"
 	puts $lwipopts_fd "\#define PBUF_LINK_HLEN $pbuf_link_hlen"
+	set rx_zero_copy	[common::get_property CONFIG.gem_rx_zero_copy $libhandle]
+	if {$rx_zero_copy == true} {
+		puts $lwipopts_fd "\#define LWIP_SUPPORT_CUSTOM_PBUF 1"
+	}
 	puts $lwipopts_fd ""
 
 	# ARP options
@@ -802,6 +806,8 @@ proc generate_lwip_opts {libhandle} {
 			puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP  1"
 			puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP  1"
 			puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP 	1"
+			# GEM interfaces still offload their checksums
+			puts $lwipopts_fd "\#define LWIP_CHECKSUM_CTRL_PER_NETIF 1"
 		} else {
 			puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP 	0"
 			puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP 	0"
@@ -1516,6 +1522,26 @@ proc generate_adapterconfig_include {libhandle} {
 		set ndesc [common::get_property CONFIG.n_rx_descriptors $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_DESC $ndesc"
 		puts $fd ""
+		set rx_zero_copy [common::get_property CONFIG.gem_rx_zero_copy $libhandle]
+		if {$rx_zero_copy == true} {
+			puts $fd "\#define XLWIP_CONFIG_GEM_RX_ZERO_COPY 1"
+			puts $fd ""
+		}
+		set prio_queue [common::get_property CONFIG.gem_priority_queue $libhandle]
+		if {$prio_queue == true} {
+			puts $fd "\#define XLWIP_CONFIG_GEM_PRIO_QUEUE 1"
+			puts $fd ""
+		}
+		set rx_poll [common::get_property CONFIG.gem_rx_poll $libhandle]
+		if {$rx_poll == true} {
+			puts $fd "\#define XLWIP_CONFIG_GEM_RX_POLL 1"
+			set budget [common::get_property CONFIG.gem_rx_poll_budget $libhandle]
+			puts $fd "\#define XLWIP_CONFIG_GEM_RX_POLL_BUDGET $budget"
+			puts $fd ""
+		}
+		set coalesce_usecs [common::get_property CONFIG.gem_rx_coalesce_usecs $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_GEM_RX_COALESCE_USECS $coalesce_usecs"
+		puts $fd ""
 	}
 
 	puts $fd "\#endif"
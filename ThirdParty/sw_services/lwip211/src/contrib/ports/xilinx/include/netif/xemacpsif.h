@@ -100,10 +100,30 @@ extern "C" {
 
 #define MAX_FRAME_SIZE_JUMBO (XEMACPS_MTU_JUMBO + XEMACPS_HDR_SIZE + XEMACPS_TRL_SIZE)
 
+#ifndef XLWIP_CONFIG_GEM_RX_POLL_BUDGET
+#define XLWIP_CONFIG_GEM_RX_POLL_BUDGET 32
+#endif
+#ifndef XLWIP_CONFIG_GEM_RX_COALESCE_USECS
+#define XLWIP_CONFIG_GEM_RX_COALESCE_USECS 0
+#endif
+
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+#ifndef XLWIP_CONFIG_N_RX_PRIO_DESC
+#define XLWIP_CONFIG_N_RX_PRIO_DESC 32
+#endif
+#ifndef XLWIP_CONFIG_N_TX_PRIO_DESC
+#define XLWIP_CONFIG_N_TX_PRIO_DESC 32
+#endif
+#endif
+
 void 	xemacpsif_setmac(u32_t index, u8_t *addr);
 u8_t*	xemacpsif_getmac(u32_t index);
 err_t 	xemacpsif_init(struct netif *netif);
 s32_t 	xemacpsif_input(struct netif *netif);
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+err_t	xemacpsif_add_prio_ethertype(struct netif *netif, u16_t ethtype);
+err_t	xemacpsif_add_prio_udp_port(struct netif *netif, u16_t udp_port);
+#endif
 
 /* xaxiemacif_hw.c */
 void 	xemacps_error_handler(XEmacPs * Temac);
@@ -124,6 +144,20 @@ typedef struct {
 
 	unsigned int last_rx_frms_cntr;
 
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	/* queue 1 rings, used for priority traffic when the GEM has them */
+	XEmacPs_BdRing rx_prio_ring;
+	XEmacPs_BdRing tx_prio_ring;
+	pq_queue_t *recv_prio_q;
+	void *rx_prio_bdspace;
+	void *tx_prio_bdspace;
+	u32_t has_prio_queue;
+#endif
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+	/* RX interrupts are masked and the rings are left to emacps_rx_poll() */
+	volatile u32_t rx_poll_active;
+#endif
+
 } xemacpsif_s;
 
 extern xemacpsif_s xemacpsif;
@@ -153,6 +187,13 @@ void init_emacps_on_error (xemacpsif_s *xemacps, struct netif *netif);
 void clean_dma_txdescs(struct xemac_s *xemac);
 void resetrx_on_no_rxdata(xemacpsif_s *xemacpsif);
 void reset_dma(struct xemac_s *xemac);
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+s32_t emacps_rx_poll(struct xemac_s *xemac, u32_t budget);
+#endif
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+s32_t add_prio_class(u16_t ethtype, u16_t udp_port);
+void setup_prio_classes(xemacpsif_s *xemacpsif);
+#endif
 
 #ifdef __cplusplus
 }
@@ -35,17 +35,45 @@
 extern "C" {
 #endif
 
+/*
+ * Single-producer/single-consumer ring. One context (typically the EMAC
+ * interrupt handler) enqueues and one context (the lwIP input thread or
+ * main loop) dequeues; the head and tail indices are published with
+ * release stores and read with acquire loads, so neither side needs
+ * interrupts masked. Contexts that share a side must still serialize
+ * among themselves.
+ *
+ * A queue with more than one producer or consumer context is created with
+ * pq_create_locked_queue(); its operations run under SYS_ARCH_PROTECT.
+ *
+ * PQ_QUEUE_SIZE must be a power of two.
+ */
+#ifndef PQ_QUEUE_SIZE
 #define PQ_QUEUE_SIZE 4096
+#endif
+
+#if ((PQ_QUEUE_SIZE & (PQ_QUEUE_SIZE - 1)) != 0)
+#error "PQ_QUEUE_SIZE must be a power of two"
+#endif
 
 typedef struct {
 	void *data[PQ_QUEUE_SIZE];
-	int head, tail, len;
+	unsigned int head;		/* written by the producer only */
+	unsigned int tail;		/* written by the consumer only */
+	unsigned int high_water;	/* largest length seen by the producer */
+	unsigned int drops;		/* enqueues refused because the ring was full */
+	unsigned int locked;		/* operations run under SYS_ARCH_PROTECT */
 } pq_queue_t;
 
 pq_queue_t*	pq_create_queue();
+pq_queue_t*	pq_create_locked_queue();
 int 		pq_enqueue(pq_queue_t *q, void *p);
 void*		pq_dequeue(pq_queue_t *q);
 int		pq_qlength(pq_queue_t *q);
+int		pq_enqueue_bulk(pq_queue_t *q, void **p, int n);
+int		pq_dequeue_bulk(pq_queue_t *q, void **p, int n);
+unsigned int	pq_high_water(pq_queue_t *q);
+unsigned int	pq_drops(pq_queue_t *q);
 
 #ifdef __cplusplus
 }
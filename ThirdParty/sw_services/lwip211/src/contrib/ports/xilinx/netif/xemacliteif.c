@@ -359,8 +359,10 @@ xemacif_send_handler(void *arg) {
 
 	if (pq_qlength(xemacliteif->send_q) && (XEmacLite_TxBufferAvailable(instance) == TRUE)) {
 		struct pbuf *p = pq_dequeue(xemacliteif->send_q);
-		_unbuffered_low_level_output(instance, p);
-		pbuf_free(p);
+		if (p) {
+			_unbuffered_low_level_output(instance, p);
+			pbuf_free(p);
+		}
 	}
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
@@ -626,7 +628,8 @@ static err_t low_level_init(struct netif *netif)
 	if (!xemacliteif->recv_q)
 		return ERR_MEM;
 
-	xemacliteif->send_q = pq_create_queue();
+	/* Dequeued both by low_level_output() and by the send handler */
+	xemacliteif->send_q = pq_create_locked_queue();
 	if (!xemacliteif->send_q)
 		return ERR_MEM;
 
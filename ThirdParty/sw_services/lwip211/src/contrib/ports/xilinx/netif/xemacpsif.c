@@ -138,6 +138,11 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
     if (freecnt <= 5) {
 	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
 		process_sent_bds(xemacpsif, txring);
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+		if (xemacpsif->has_prio_queue != 0) {
+			process_sent_bds(xemacpsif, &xemacpsif->tx_prio_ring);
+		}
+#endif
 	}
 
     if (is_tx_space_available(xemacpsif)) {
@@ -167,6 +172,26 @@ static struct pbuf * low_level_input(struct netif *netif)
 	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 	struct pbuf *p;
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	/* refill the receive queues from the BD rings */
+	if (pq_qlength(xemacpsif->recv_q) == 0
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+			&& pq_qlength(xemacpsif->recv_prio_q) == 0
+#endif
+			) {
+		SYS_ARCH_PROTECT(lev);
+		emacps_rx_poll(xemac, XLWIP_CONFIG_GEM_RX_POLL_BUDGET);
+		SYS_ARCH_UNPROTECT(lev);
+	}
+#endif
+
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	/* priority frames are handed to the stack first */
+	if (pq_qlength(xemacpsif->recv_prio_q) != 0)
+		return (struct pbuf *)pq_dequeue(xemacpsif->recv_prio_q);
+#endif
 
 	/* see if there is data to process */
 	if (pq_qlength(xemacpsif->recv_q) == 0)
@@ -202,7 +227,8 @@ static err_t xemacpsif_output(struct netif *netif, struct pbuf *p,
  * interface.
  *
  * Returns the number of packets read (max 1 packet on success,
- * 0 if there are no packets)
+ * 0 if there are no packets). In RX polling mode up to
+ * XLWIP_CONFIG_GEM_RX_POLL_BUDGET packets are read per call.
  *
  */
 
@@ -210,21 +236,29 @@ s32_t xemacpsif_input(struct netif *netif)
 {
 	struct eth_hdr *ethhdr;
 	struct pbuf *p;
-	SYS_ARCH_DECL_PROTECT(lev);
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+	s32_t n_packets = 0;
 
-#ifdef OS_IS_FREERTOS
+	while (n_packets < XLWIP_CONFIG_GEM_RX_POLL_BUDGET)
+#elif defined(OS_IS_FREERTOS)
 	while (1)
 #endif
 	{
-		/* move received packet into a new pbuf */
-		SYS_ARCH_PROTECT(lev);
+		/* move received packet into a new pbuf; the receive queues are
+		 * lock-free, so the interrupt need not be masked here */
 		p = low_level_input(netif);
-		SYS_ARCH_UNPROTECT(lev);
 
 		/* no packet could be read, silently ignore this */
 		if (p == NULL) {
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+			return n_packets;
+#else
 			return 0;
+#endif
 		}
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+		n_packets++;
+#endif
 
 		/* points to packet payload, which starts with an Ethernet header */
 		ethhdr = p->payload;
@@ -261,7 +295,15 @@ s32_t xemacpsif_input(struct netif *netif)
 		}
 	}
 
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+#if !NO_SYS
+	/* budget used up, come back for the rest */
+	sys_sem_signal(&((struct xemac_s *)(netif->state))->sem_rx_data_available);
+#endif
+	return n_packets;
+#else
 	return 1;
+#endif
 }
 
 
@@ -311,6 +353,11 @@ static err_t low_level_init(struct netif *netif)
 	xemacpsif->recv_q = pq_create_queue();
 	if (!xemacpsif->recv_q)
 		return ERR_MEM;
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	xemacpsif->recv_prio_q = pq_create_queue();
+	if (!xemacpsif->recv_prio_q)
+		return ERR_MEM;
+#endif
 
 	/* maximum transfer unit */
 #ifdef ZYNQMP_USE_JUMBO
@@ -338,6 +385,14 @@ static err_t low_level_init(struct netif *netif)
 	netif->flags |= NETIF_FLAG_IGMP;
 #endif
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+	/* The GEM inserts and verifies IP, TCP and UDP checksums (the driver
+	 * enables checksum offload by default); only ICMP is left to lwIP */
+	NETIF_SET_CHECKSUM_CTRL(netif, NETIF_CHECKSUM_GEN_ICMP |
+			NETIF_CHECKSUM_GEN_ICMP6 | NETIF_CHECKSUM_CHECK_ICMP |
+			NETIF_CHECKSUM_CHECK_ICMP6);
+#endif
+
 #if !NO_SYS
 	sys_sem_new(&xemac->sem_rx_data_available, 0);
 #endif
@@ -501,7 +556,7 @@ static void xemacpsif_mld6_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 	reset_dma(xemac);
 
 	/* Start Ethernet */
-	XEmacPs_Start(&xemacpsif->emacps);
+	start_emacps(xemacpsif);
 
 	SYS_ARCH_UNPROTECT(lev);
 }
@@ -568,6 +623,72 @@ static err_t xemacpsif_mld6_mac_filter_update (struct netif *netif, ip_addr_t *g
 }
 #endif
 
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+static err_t xemacpsif_add_prio_class(struct netif *netif, u16_t ethtype,
+		u16_t udp_port)
+{
+	struct xemac_s *xemac = (struct xemac_s *) (netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *) (xemac->state);
+	XEmacPs_BdRing *txring;
+	s32_t status;
+	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+
+	/* Wait till all sent packets are acknowledged from HW */
+	while(txring->HwCnt);
+	if (xemacpsif->has_prio_queue != 0) {
+		while(xemacpsif->tx_prio_ring.HwCnt);
+	}
+
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+
+	/* Screeners can only be changed while the controller is stopped */
+	XEmacPs_Stop(&xemacpsif->emacps);
+
+	status = add_prio_class(ethtype, udp_port);
+	if (status == 0) {
+		setup_prio_classes(xemacpsif);
+	}
+
+	/* Reset DMA */
+	reset_dma(xemac);
+
+	/* Start Ethernet */
+	start_emacps(xemacpsif);
+
+	SYS_ARCH_UNPROTECT(lev);
+
+	return (status == 0) ? ERR_OK : ERR_MEM;
+}
+
+/*
+ * xemacpsif_add_prio_ethertype():
+ *
+ * Steer frames of the given ethertype to the priority queue on both
+ * transmit and receive. The class table is shared by all interfaces.
+ */
+err_t xemacpsif_add_prio_ethertype(struct netif *netif, u16_t ethtype)
+{
+	if (ethtype == 0)
+		return ERR_ARG;
+	return xemacpsif_add_prio_class(netif, ethtype, 0);
+}
+
+/*
+ * xemacpsif_add_prio_udp_port():
+ *
+ * Steer IPv4 UDP datagrams with the given destination port to the
+ * priority queue on both transmit and receive.
+ */
+err_t xemacpsif_add_prio_udp_port(struct netif *netif, u16_t udp_port)
+{
+	if (udp_port == 0)
+		return ERR_ARG;
+	return xemacpsif_add_prio_class(netif, 0, udp_port);
+}
+#endif
+
 #if LWIP_IGMP
 static void xemacpsif_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 		u8_t action)
@@ -608,7 +729,7 @@ static void xemacpsif_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 	reset_dma(xemac);
 
 	/* Start Ethernet */
-	XEmacPs_Start(&xemacpsif->emacps);
+	start_emacps(xemacpsif);
 
 	SYS_ARCH_UNPROTECT(lev);
 }
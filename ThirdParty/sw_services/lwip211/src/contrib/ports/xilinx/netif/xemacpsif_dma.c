@@ -32,6 +32,9 @@
 #include "lwip/stats.h"
 #include "lwip/sys.h"
 #include "lwip/inet_chksum.h"
+#include "lwip/prot/ethernet.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/udp.h"
 
 #include "netif/xadapter.h"
 #include "netif/xemacpsif.h"
@@ -64,6 +67,10 @@
 /* A max of 4 different ethernet interfaces are supported */
 static UINTPTR tx_pbufs_storage[4*XLWIP_CONFIG_N_TX_DESC];
 static UINTPTR rx_pbufs_storage[4*XLWIP_CONFIG_N_RX_DESC];
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+static UINTPTR tx_prio_pbufs_storage[4*XLWIP_CONFIG_N_TX_PRIO_DESC];
+static UINTPTR rx_prio_pbufs_storage[4*XLWIP_CONFIG_N_RX_PRIO_DESC];
+#endif
 
 static s32_t emac_intr_num;
 
@@ -123,6 +130,92 @@ long xInsideISR = 0;
 #define XEMACPS_BD_TO_INDEX(ringptr, bdptr)				\
 	(((UINTPTR)bdptr - (UINTPTR)(ringptr)->BaseBdAddr) / (ringptr)->Separation)
 
+/* process_rx_bds() budget for draining a ring completely */
+#define XEMACPS_RX_BUDGET_ALL	0xFFFFFFFFU
+
+/* The GEM interrupt moderation timer counts in 800 ns units at 1 Gbps */
+#define XEMACPS_RX_COALESCE_DELAY	\
+	LWIP_MIN(255U, ((XLWIP_CONFIG_GEM_RX_COALESCE_USECS * 5U) + 3U) / 4U)
+
+#ifdef XLWIP_CONFIG_GEM_RX_ZERO_COPY
+/******************************************************************************
+ * Zero-copy RX.
+ *
+ * Instead of handing PBUF_POOL pbufs to the GEM, every interface owns a pool
+ * of cache-line aligned RX buffers. A received frame is passed to lwIP as a
+ * PBUF_REF custom pbuf that points straight at the DMA buffer and is sized
+ * to the received length, so no pbuf_alloc/pbuf_realloc happens per frame.
+ * When lwIP frees the pbuf, the buffer goes back to the interface pool and
+ * is re-armed on the next refill.
+ *
+ * Cache maintenance is limited to the bytes actually touched: a frame is
+ * invalidated over rx_bytes only, and a buffer coming back from the stack is
+ * invalidated over the length it was handed up with before it is given back
+ * to the hardware (the stack may have dirtied those lines, nothing beyond).
+ * A frame is only handed up once a replacement buffer has been taken from
+ * the pool, so the rings stay fully armed however many frames an interrupt
+ * covers. Frames that are dropped because the pool is empty never leave the
+ * driver; their buffer is recycled on the same BD without any realloc.
+ *********************************************************************************/
+#ifdef ZYNQMP_USE_JUMBO
+#define XEMACPS_ZC_RX_BUF_SIZE		XEMACPS_RX_BUF_SIZE_JUMBO
+#else
+#define XEMACPS_ZC_RX_BUF_SIZE		XEMACPS_RX_BUF_SIZE
+#endif
+#define XEMACPS_ZC_RX_BUF_ALIGNMENT	64U
+#define XEMACPS_ZC_RX_BUF_ALIGNED_SIZE	\
+	((XEMACPS_ZC_RX_BUF_SIZE + XEMACPS_ZC_RX_BUF_ALIGNMENT - 1U) & \
+			~(XEMACPS_ZC_RX_BUF_ALIGNMENT - 1U))
+
+/* Buffers per interface: one per RX BD plus as many again in flight in lwIP */
+#ifndef XLWIP_CONFIG_N_RX_ZC_BUFS
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+#define XLWIP_CONFIG_N_RX_ZC_BUFS	(2 * (XLWIP_CONFIG_N_RX_DESC + XLWIP_CONFIG_N_RX_PRIO_DESC))
+#else
+#define XLWIP_CONFIG_N_RX_ZC_BUFS	(2 * XLWIP_CONFIG_N_RX_DESC)
+#endif
+#endif
+
+/* One pool per GEM instance, indexed like rx_pbufs_storage */
+#define XEMACPS_ZC_RX_NUM_POOLS		XPAR_XEMACPS_NUM_INSTANCES
+
+struct xemacps_zc_rx_buf {
+	struct pbuf_custom pc;		/* must be first */
+	struct xemacps_zc_rx_buf *next;
+	u8_t *data;
+	u32_t inval_len;		/* bytes to invalidate before re-arming */
+	u8_t pool_index;
+};
+
+static u8_t zc_rx_buf_space[XEMACPS_ZC_RX_NUM_POOLS * XLWIP_CONFIG_N_RX_ZC_BUFS]
+			[XEMACPS_ZC_RX_BUF_ALIGNED_SIZE]
+			__attribute__ ((aligned (XEMACPS_ZC_RX_BUF_ALIGNMENT)));
+static struct xemacps_zc_rx_buf zc_rx_bufs[XEMACPS_ZC_RX_NUM_POOLS * XLWIP_CONFIG_N_RX_ZC_BUFS];
+static struct xemacps_zc_rx_buf *zc_rx_free_list[XEMACPS_ZC_RX_NUM_POOLS];
+static u8_t zc_rx_pool_initialized[XEMACPS_ZC_RX_NUM_POOLS];
+#endif
+
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+/******************************************************************************
+ * Priority queue.
+ *
+ * On GEM versions with priority queues (ZynqMP, Versal) every interface
+ * drives a second RX and TX BD ring on queue 1. The RX screeners steer the
+ * classes below to RX queue 1, so those frames have their own BDs and are
+ * handed to lwIP ahead of anything waiting in the bulk receive queue. On
+ * transmit, frames of the same classes go out on TX queue 1, which the GEM
+ * services before queue 0, while bulk traffic uses queue 0.
+ *
+ * By default IEEE 1588 (ethertype 0x88F7 and UDP ports 319/320) is treated
+ * as priority traffic; xemacpsif_add_prio_ethertype() and
+ * xemacpsif_add_prio_udp_port() add further classes.
+ *********************************************************************************/
+#define XEMACPS_PRIO_QUEUE	1U
+
+static u16_t prio_ethtypes[XEMACPS_MAX_SCREENER_TYPE2] = { 0x88F7U };
+static u16_t prio_udp_ports[XEMACPS_MAX_SCREENER_TYPE1] = { 319U, 320U };
+#endif
+
 
 s32_t is_tx_space_available(xemacpsif_s *emac)
 {
@@ -191,6 +284,219 @@ u32_t get_base_index_rxpbufsstorage (xemacpsif_s *xemacpsif)
 	return index;
 }
 
+static inline
+UINTPTR *get_tx_pbufs_storage (xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
+{
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	if (txring == &xemacpsif->tx_prio_ring) {
+		return &tx_prio_pbufs_storage[(get_base_index_txpbufsstorage(xemacpsif) /
+				XLWIP_CONFIG_N_TX_DESC) * XLWIP_CONFIG_N_TX_PRIO_DESC];
+	}
+#endif
+	return &tx_pbufs_storage[get_base_index_txpbufsstorage(xemacpsif)];
+}
+
+static inline
+UINTPTR *get_rx_pbufs_storage (xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
+{
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	if (rxring == &xemacpsif->rx_prio_ring) {
+		return &rx_prio_pbufs_storage[(get_base_index_rxpbufsstorage(xemacpsif) /
+				XLWIP_CONFIG_N_RX_DESC) * XLWIP_CONFIG_N_RX_PRIO_DESC];
+	}
+#endif
+	return &rx_pbufs_storage[get_base_index_rxpbufsstorage(xemacpsif)];
+}
+
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+/*
+ * Software mirror of the RX screeners, used to pick the TX queue. Only the
+ * first pbuf is looked at; lwIP always places the headers there.
+ */
+static u32_t is_prio_frame(struct pbuf *p)
+{
+	struct eth_hdr *ethhdr;
+	struct ip_hdr *iphdr;
+	struct udp_hdr *udphdr;
+	u16_t type;
+	u16_t iphdr_len;
+	u16_t port;
+	u32_t i;
+
+	if (p->len < SIZEOF_ETH_HDR) {
+		return 0;
+	}
+	ethhdr = (struct eth_hdr *)p->payload;
+	type = lwip_htons(ethhdr->type);
+	for (i = 0; i < XEMACPS_MAX_SCREENER_TYPE2; i++) {
+		if ((prio_ethtypes[i] != 0) && (prio_ethtypes[i] == type)) {
+			return 1;
+		}
+	}
+
+	if ((type != ETHTYPE_IP) || (p->len < (SIZEOF_ETH_HDR + IP_HLEN))) {
+		return 0;
+	}
+	iphdr = (struct ip_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR);
+	if ((IPH_PROTO(iphdr) != IP_PROTO_UDP) ||
+			((IPH_OFFSET(iphdr) & PP_HTONS(IP_OFFMASK)) != 0)) {
+		return 0;
+	}
+	iphdr_len = IPH_HL_BYTES(iphdr);
+	if (p->len < (SIZEOF_ETH_HDR + iphdr_len + UDP_HLEN)) {
+		return 0;
+	}
+	udphdr = (struct udp_hdr *)((u8_t *)iphdr + iphdr_len);
+	port = lwip_ntohs(udphdr->dest);
+	for (i = 0; i < XEMACPS_MAX_SCREENER_TYPE1; i++) {
+		if ((prio_udp_ports[i] != 0) && (prio_udp_ports[i] == port)) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* Program the RX screeners from the priority class tables */
+static void setup_prio_screeners(xemacpsif_s *xemacpsif)
+{
+	u8_t i;
+
+	XEmacPs_ClearScreeners(&xemacpsif->emacps);
+	for (i = 0; i < XEMACPS_MAX_SCREENER_TYPE1; i++) {
+		if (prio_udp_ports[i] != 0) {
+			XEmacPs_SetScreenerType1(&xemacpsif->emacps, i, XEMACPS_PRIO_QUEUE,
+					XEMACPS_SCREENER_MATCH_UDPPORT, 0, prio_udp_ports[i]);
+		}
+	}
+	for (i = 0; i < XEMACPS_MAX_SCREENER_TYPE2; i++) {
+		if (prio_ethtypes[i] != 0) {
+			XEmacPs_SetScreenerType2(&xemacpsif->emacps, i, XEMACPS_PRIO_QUEUE,
+					XEMACPS_SCREENER_MATCH_ETHTYPE, 0, prio_ethtypes[i]);
+		}
+	}
+}
+
+/*
+ * Add a priority class. Either ethtype or udp_port is non-zero. The caller
+ * reprograms the screeners with the EMAC stopped.
+ */
+s32_t add_prio_class(u16_t ethtype, u16_t udp_port)
+{
+	u32_t i;
+	u16_t *table;
+	u32_t size;
+	u16_t value;
+
+	if (ethtype != 0) {
+		table = prio_ethtypes;
+		size = XEMACPS_MAX_SCREENER_TYPE2;
+		value = ethtype;
+	} else {
+		table = prio_udp_ports;
+		size = XEMACPS_MAX_SCREENER_TYPE1;
+		value = udp_port;
+	}
+	for (i = 0; i < size; i++) {
+		if (table[i] == value) {
+			return 0;
+		}
+	}
+	for (i = 0; i < size; i++) {
+		if (table[i] == 0) {
+			table[i] = value;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+void setup_prio_classes(xemacpsif_s *xemacpsif)
+{
+	if (xemacpsif->has_prio_queue != 0) {
+		setup_prio_screeners(xemacpsif);
+	}
+}
+#endif
+
+#ifdef XLWIP_CONFIG_GEM_RX_ZERO_COPY
+/*
+ * lwIP gave up its last reference to a zero-copy RX pbuf. This may run in
+ * thread context, so the free list is updated with interrupts masked.
+ */
+static void zc_rx_pbuf_free(struct pbuf *p)
+{
+	struct xemacps_zc_rx_buf *buf = (struct xemacps_zc_rx_buf *)p;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	buf->next = zc_rx_free_list[buf->pool_index];
+	zc_rx_free_list[buf->pool_index] = buf;
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+static void zc_rx_pool_init(xemacpsif_s *xemacpsif)
+{
+	u32_t pool_index;
+	u32_t i;
+	struct xemacps_zc_rx_buf *buf;
+
+	pool_index = get_base_index_rxpbufsstorage(xemacpsif) / XLWIP_CONFIG_N_RX_DESC;
+	if (zc_rx_pool_initialized[pool_index] != 0) {
+		return;
+	}
+
+	zc_rx_free_list[pool_index] = NULL;
+	for (i = 0; i < XLWIP_CONFIG_N_RX_ZC_BUFS; i++) {
+		buf = &zc_rx_bufs[(pool_index * XLWIP_CONFIG_N_RX_ZC_BUFS) + i];
+		buf->pc.custom_free_function = zc_rx_pbuf_free;
+		buf->data = zc_rx_buf_space[(pool_index * XLWIP_CONFIG_N_RX_ZC_BUFS) + i];
+		buf->inval_len = XEMACPS_ZC_RX_BUF_ALIGNED_SIZE;
+		buf->pool_index = (u8_t)pool_index;
+		buf->next = zc_rx_free_list[pool_index];
+		zc_rx_free_list[pool_index] = buf;
+	}
+	zc_rx_pool_initialized[pool_index] = 1;
+}
+
+/*
+ * Called from the RX handler or during DMA (re)initialisation, i.e. with the
+ * EMAC interrupt masked, so the pool needs no further protection here.
+ */
+static inline struct xemacps_zc_rx_buf *zc_rx_buf_get(xemacpsif_s *xemacpsif)
+{
+	u32_t pool_index;
+	struct xemacps_zc_rx_buf *buf;
+
+	pool_index = get_base_index_rxpbufsstorage(xemacpsif) / XLWIP_CONFIG_N_RX_DESC;
+	buf = zc_rx_free_list[pool_index];
+	if (buf != NULL) {
+		zc_rx_free_list[pool_index] = buf->next;
+		buf->next = NULL;
+	}
+	return buf;
+}
+
+static inline void zc_rx_buf_put(struct xemacps_zc_rx_buf *buf)
+{
+	buf->next = zc_rx_free_list[buf->pool_index];
+	zc_rx_free_list[buf->pool_index] = buf;
+}
+
+/*
+ * Discard any lines the stack may have dirtied while it owned the buffer so
+ * that a later eviction cannot overwrite data written by the GEM.
+ */
+static inline void zc_rx_buf_prepare(xemacpsif_s *xemacpsif,
+					struct xemacps_zc_rx_buf *buf)
+{
+	if ((xemacpsif->emacps.Config.IsCacheCoherent == 0) &&
+					(buf->inval_len != 0)) {
+		Xil_DCacheInvalidateRange((UINTPTR)buf->data, (UINTPTR)buf->inval_len);
+	}
+	buf->inval_len = 0;
+}
+#endif
+
 void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 {
 	XEmacPs_Bd *txbdset;
@@ -201,14 +507,14 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 	u32_t bdindex;
 	struct pbuf *p;
 	u32 *temp;
-	u32_t index;
+	UINTPTR *storage;
 
-	index = get_base_index_txpbufsstorage (xemacpsif);
+	storage = get_tx_pbufs_storage (xemacpsif, txring);
 
 	while (1) {
 		/* obtain processed BD's */
 		n_bds = XEmacPs_BdRingFromHwTx(txring,
-								XLWIP_CONFIG_N_TX_DESC, &txbdset);
+								txring->AllCnt, &txbdset);
 		if (n_bds == 0)  {
 			return;
 		}
@@ -220,17 +526,17 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 			temp = (u32 *)curbdpntr;
 			*temp = 0;
 			temp++;
-			if (bdindex == (XLWIP_CONFIG_N_TX_DESC - 1)) {
+			if (bdindex == (txring->AllCnt - 1)) {
 				*temp = 0xC0000000;
 			} else {
 				*temp = 0x80000000;
 			}
 			dsb();
-			p = (struct pbuf *)tx_pbufs_storage[index + bdindex];
+			p = (struct pbuf *)storage[bdindex];
 			if (p != NULL) {
 				pbuf_free(p);
 			}
-			tx_pbufs_storage[index + bdindex] = 0;
+			storage[bdindex] = 0;
 			curbdpntr = XEmacPs_BdRingNext(txring, curbdpntr);
 			n_pbufs_freed--;
 			dsb();
@@ -260,6 +566,11 @@ void emacps_send_handler(void *arg)
 	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress,XEMACPS_TXSR_OFFSET, regval);
 
 	/* If Transmit done interrupt is asserted, process completed BD's */
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	if (xemacpsif->has_prio_queue != 0) {
+		process_sent_bds(xemacpsif, &xemacpsif->tx_prio_ring);
+	}
+#endif
 	process_sent_bds(xemacpsif, txringptr);
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
@@ -276,15 +587,22 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 	XEmacPs_BdRing *txring;
 	u32_t bdindex;
 	u32_t lev;
-	u32_t index;
+	UINTPTR *storage;
 	u32_t max_fr_size;
+	UINTPTR flush_start = 0;
+	UINTPTR flush_end = 0;
 
 	lev = mfcpsr();
 	mtcpsr(lev | 0x000000C0);
 
 	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	if ((xemacpsif->has_prio_queue != 0) && (is_prio_frame(p) != 0)) {
+		txring = &xemacpsif->tx_prio_ring;
+	}
+#endif
 
-	index = get_base_index_txpbufsstorage (xemacpsif);
+	storage = get_tx_pbufs_storage (xemacpsif, txring);
 
 	/* first count the number of pbufs */
 	for (q = p, n_pbufs = 0; q != NULL; q = q->next)
@@ -300,7 +618,7 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 
 	for(q = p, txbd = txbdset; q != NULL; q = q->next) {
 		bdindex = XEMACPS_BD_TO_INDEX(txring, txbd);
-		if (tx_pbufs_storage[index + bdindex] != 0) {
+		if (storage[bdindex] != 0) {
 			mtcpsr(lev);
 			LWIP_DEBUGF(NETIF_DEBUG, ("PBUFS not available\r\n"));
 			return XST_FAILURE;
@@ -308,9 +626,16 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 
 		/* Send the data from the pbuf to the interface, one pbuf at a
 		   time. The size of the data in each pbuf is kept in the ->len
-		   variable. */
+		   variable. Pbufs that continue the previous one in memory
+		   are flushed together with it. */
 		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheFlushRange((UINTPTR)q->payload, (UINTPTR)q->len);
+			if ((UINTPTR)q->payload != flush_end) {
+				if (flush_end != flush_start) {
+					Xil_DCacheFlushRange(flush_start, flush_end - flush_start);
+				}
+				flush_start = (UINTPTR)q->payload;
+			}
+			flush_end = (UINTPTR)q->payload + q->len;
 		}
 
 		XEmacPs_BdSetAddressTx(txbd, (UINTPTR)q->payload);
@@ -325,13 +650,16 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 		else
 			XEmacPs_BdSetLength(txbd, q->len & 0x3FFF);
 
-		tx_pbufs_storage[index + bdindex] = (UINTPTR)q;
+		storage[bdindex] = (UINTPTR)q;
 
 		pbuf_ref(q);
 		last_txbd = txbd;
 		XEmacPs_BdClearLast(txbd);
 		txbd = XEmacPs_BdRingNext(txring, txbd);
 	}
+	if (flush_end != flush_start) {
+		Xil_DCacheFlushRange(flush_start, flush_end - flush_start);
+	}
 	XEmacPs_BdSetLast(last_txbd);
 	/* For fragmented packets, remember the 1st BD allocated for the 1st
 	   packet fragment. The used bit for this BD should be cleared at the end
@@ -365,6 +693,78 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 	return status;
 }
 
+#ifdef XLWIP_CONFIG_GEM_RX_ZERO_COPY
+void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
+{
+	XEmacPs_Bd *rxbd;
+	XStatus status;
+	struct xemacps_zc_rx_buf *buf;
+	u32_t freebds;
+	u32_t bdindex;
+	u32 *temp;
+	UINTPTR *storage;
+
+	storage = get_rx_pbufs_storage (xemacpsif, rxring);
+
+	freebds = XEmacPs_BdRingGetFreeCnt (rxring);
+	while (freebds > 0) {
+		freebds--;
+		status = XEmacPs_BdRingAlloc(rxring, 1, &rxbd);
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("setup_rx_bds: Error allocating RxBD\r\n"));
+			return;
+		}
+		bdindex = XEMACPS_BD_TO_INDEX(rxring, rxbd);
+
+		/*
+		 * A buffer still attached to this BD is either the one of a
+		 * dropped frame or the replacement reserved when the frame was
+		 * handed up, and is armed as is; otherwise take one from the pool.
+		 */
+		buf = (struct xemacps_zc_rx_buf *)storage[bdindex];
+		if (buf == NULL) {
+			buf = zc_rx_buf_get(xemacpsif);
+			if (buf == NULL) {
+#if LINK_STATS
+				lwip_stats.link.memerr++;
+#endif
+				XEmacPs_BdRingUnAlloc(rxring, 1, rxbd);
+				return;
+			}
+		}
+
+		status = XEmacPs_BdRingToHw(rxring, 1, rxbd);
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("Error committing RxBD to hardware\r\n"));
+			zc_rx_buf_put(buf);
+			storage[bdindex] = 0;
+			XEmacPs_BdRingUnAlloc(rxring, 1, rxbd);
+			return;
+		}
+		zc_rx_buf_prepare(xemacpsif, buf);
+
+		temp = (u32 *)rxbd;
+		temp++;
+		/* Status field should be cleared first to avoid drops */
+		*temp = 0;
+		dsb();
+
+		/* Set high address when required */
+#ifdef __aarch64__
+		XEmacPs_BdWrite(rxbd, XEMACPS_BD_ADDR_HI_OFFSET,
+			(((UINTPTR)buf->data) & ULONG64_HI_MASK) >> 32U);
+#endif
+		/* Set address field; add WRAP bit on last descriptor  */
+		if (bdindex == (rxring->AllCnt - 1)) {
+			XEmacPs_BdWrite(rxbd, XEMACPS_BD_ADDR_OFFSET, ((UINTPTR)buf->data | XEMACPS_RXBUF_WRAP_MASK));
+		} else {
+			XEmacPs_BdWrite(rxbd, XEMACPS_BD_ADDR_OFFSET, (UINTPTR)buf->data);
+		}
+
+		storage[bdindex] = (UINTPTR)buf;
+	}
+}
+#else
 void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 {
 	XEmacPs_Bd *rxbd;
@@ -373,9 +773,9 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 	u32_t freebds;
 	u32_t bdindex;
 	u32 *temp;
-	u32_t index;
+	UINTPTR *storage;
 
-	index = get_base_index_rxpbufsstorage (xemacpsif);
+	storage = get_rx_pbufs_storage (xemacpsif, rxring);
 
 	freebds = XEmacPs_BdRingGetFreeCnt (rxring);
 	while (freebds > 0) {
@@ -435,71 +835,91 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 			(((UINTPTR)p->payload) & ULONG64_HI_MASK) >> 32U);
 #endif
 		/* Set address field; add WRAP bit on last descriptor  */
-		if (bdindex == (XLWIP_CONFIG_N_RX_DESC - 1)) {
+		if (bdindex == (rxring->AllCnt - 1)) {
 			XEmacPs_BdWrite(rxbd, XEMACPS_BD_ADDR_OFFSET, ((UINTPTR)p->payload | XEMACPS_RXBUF_WRAP_MASK));
 		} else {
 			XEmacPs_BdWrite(rxbd, XEMACPS_BD_ADDR_OFFSET, (UINTPTR)p->payload);
 		}
 
-		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
+		storage[bdindex] = (UINTPTR)p;
 	}
 }
+#endif
 
-void emacps_recv_handler(void *arg)
+/*
+ * Drain at most budget BDs of one RX BD ring into the given receive queue
+ * and re-arm them. Returns the number of BDs processed.
+ */
+static u32_t process_rx_bds(struct xemac_s *xemac, XEmacPs_BdRing *rxring,
+						pq_queue_t *recv_q, u32_t budget)
 {
 	struct pbuf *p;
+#ifdef XLWIP_CONFIG_GEM_RX_ZERO_COPY
+	struct xemacps_zc_rx_buf *buf;
+	struct xemacps_zc_rx_buf *newbuf;
+#endif
 	XEmacPs_Bd *rxbdset, *curbdptr;
-	struct xemac_s *xemac;
 	xemacpsif_s *xemacpsif;
-	XEmacPs_BdRing *rxring;
 	volatile s32_t bd_processed;
 	s32_t rx_bytes, k;
 	u32_t bdindex;
-	u32_t regval;
-	u32_t index;
-	u32_t gigeversion;
+	u32_t done = 0;
+	UINTPTR *storage;
 
-	xemac = (struct xemac_s *)(arg);
 	xemacpsif = (xemacpsif_s *)(xemac->state);
-	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
-
-#ifdef OS_IS_FREERTOS
-	xInsideISR++;
-#endif
-
-	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
-	index = get_base_index_rxpbufsstorage (xemacpsif);
-	/*
-	 * If Reception done interrupt is asserted, call RX call back function
-	 * to handle the processed BDs and then raise the according flag.
-	 */
-	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET);
-	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET, regval);
-	if (gigeversion <= 2) {
-			resetrx_on_no_rxdata(xemacpsif);
-	}
+	storage = get_rx_pbufs_storage (xemacpsif, rxring);
 
-	while(1) {
+	while(done < budget) {
 
-		bd_processed = XEmacPs_BdRingFromHwRx(rxring, XLWIP_CONFIG_N_RX_DESC, &rxbdset);
+		/*
+		 * Look no further than the BDs given to the hardware: one left
+		 * unarmed for want of a buffer still has its used bit set.
+		 */
+		bd_processed = XEmacPs_BdRingFromHwRx(rxring,
+				LWIP_MIN(rxring->HwCnt, budget - done), &rxbdset);
 		if (bd_processed <= 0) {
 			break;
 		}
+		done += bd_processed;
 
 		for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
 
 			bdindex = XEMACPS_BD_TO_INDEX(rxring, curbdptr);
-			p = (struct pbuf *)rx_pbufs_storage[index + bdindex];
-
-			/*
-			 * Adjust the buffer size to the actual number of bytes received.
-			 */
 #ifdef ZYNQMP_USE_JUMBO
 			rx_bytes = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, curbdptr);
 #else
 			rx_bytes = XEmacPs_BdGetLength(curbdptr);
 #endif
+#ifdef XLWIP_CONFIG_GEM_RX_ZERO_COPY
+			buf = (struct xemacps_zc_rx_buf *)storage[bdindex];
+
+			/*
+			 * Only hand the buffer up if a replacement can be taken from
+			 * the pool right away, so that every BD of the burst is armed
+			 * again on refill; otherwise drop the frame and keep the
+			 * buffer on this BD.
+			 */
+			newbuf = zc_rx_buf_get(xemacpsif);
+			if (newbuf == NULL) {
+#if LINK_STATS
+				lwip_stats.link.memerr++;
+				lwip_stats.link.drop++;
+#endif
+				curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
+				continue;
+			}
+			storage[bdindex] = (UINTPTR)newbuf;
+			buf->inval_len = rx_bytes;
+			p = pbuf_alloced_custom(PBUF_RAW, rx_bytes, PBUF_REF, &buf->pc,
+					buf->data, XEMACPS_ZC_RX_BUF_SIZE);
+#else
+			p = (struct pbuf *)storage[bdindex];
+
+			/*
+			 * Adjust the buffer size to the actual number of bytes received.
+			 */
 			pbuf_realloc(p, rx_bytes);
+#endif
 
 			/* Invalidate RX frame before queuing to handle
 			 * L1 cache prefetch conditions on any architecture.
@@ -509,7 +929,7 @@ void emacps_recv_handler(void *arg)
 			/* store it in the receive queue,
 			 * where it'll be processed by a different handler
 			 */
-			if (pq_enqueue(xemacpsif->recv_q, (void*)p) < 0) {
+			if (pq_enqueue(recv_q, (void*)p) < 0) {
 #if LINK_STATS
 				lwip_stats.link.memerr++;
 				lwip_stats.link.drop++;
@@ -521,10 +941,119 @@ void emacps_recv_handler(void *arg)
 		/* free up the BD's */
 		XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
 		setup_rx_bds(xemacpsif, rxring);
-#if !NO_SYS
+#if !NO_SYS && !defined(XLWIP_CONFIG_GEM_RX_POLL)
 		sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
 	}
+	return done;
+}
+
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+/*
+ * RX polling mode. The first RX interrupt masks further RX interrupts and
+ * leaves the BDs to emacps_rx_poll(), which xemacpsif_input() calls from
+ * thread (or main loop) context with a bounded budget. RX interrupts are
+ * unmasked once a poll finds the rings empty; a frame that arrived in
+ * between is still latched in the ISR and raises the interrupt right away.
+ */
+static void rx_poll_intr_disable(xemacpsif_s *xemacpsif)
+{
+	XEmacPs_IntDisable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	if (xemacpsif->has_prio_queue != 0) {
+		XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress,
+				XEMACPS_INTQ1_IDR_OFFSET, XEMACPS_INTQ1_IXR_RX_MASK);
+	}
+#endif
+}
+
+static void rx_poll_intr_enable(xemacpsif_s *xemacpsif)
+{
+	XEmacPs_IntEnable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	if (xemacpsif->has_prio_queue != 0) {
+		XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress,
+				XEMACPS_INTQ1_IER_OFFSET, XEMACPS_INTQ1_IXR_RX_MASK);
+	}
+#endif
+}
+
+/*
+ * Process at most budget received frames. Must be called with
+ * SYS_ARCH_PROTECT held. Returns the number of frames queued.
+ */
+s32_t emacps_rx_poll(struct xemac_s *xemac, u32_t budget)
+{
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	u32_t done = 0;
+
+	if (xemacpsif->rx_poll_active == 0) {
+		return 0;
+	}
+
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	if (xemacpsif->has_prio_queue != 0) {
+		done = process_rx_bds(xemac, &xemacpsif->rx_prio_ring,
+					xemacpsif->recv_prio_q, budget);
+	}
+#endif
+	if (done < budget) {
+		done += process_rx_bds(xemac, &XEmacPs_GetRxRing(&xemacpsif->emacps),
+					xemacpsif->recv_q, budget - done);
+	}
+
+	/* Rings are empty, go back to interrupt mode */
+	if (done < budget) {
+		xemacpsif->rx_poll_active = 0;
+		rx_poll_intr_enable(xemacpsif);
+	}
+	return (s32_t)done;
+}
+#endif
+
+void emacps_recv_handler(void *arg)
+{
+	struct xemac_s *xemac;
+	xemacpsif_s *xemacpsif;
+	u32_t regval;
+	u32_t gigeversion;
+
+	xemac = (struct xemac_s *)(arg);
+	xemacpsif = (xemacpsif_s *)(xemac->state);
+
+#ifdef OS_IS_FREERTOS
+	xInsideISR++;
+#endif
+
+	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
+	/*
+	 * If Reception done interrupt is asserted, call RX call back function
+	 * to handle the processed BDs and then raise the according flag.
+	 */
+	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET);
+	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET, regval);
+	if (gigeversion <= 2) {
+			resetrx_on_no_rxdata(xemacpsif);
+	}
+
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+	/* Leave the BDs to emacps_rx_poll() */
+	rx_poll_intr_disable(xemacpsif);
+	xemacpsif->rx_poll_active = 1;
+#if !NO_SYS
+	sys_sem_signal(&xemac->sem_rx_data_available);
+#endif
+#else
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	/* Priority frames first, they never wait behind the bulk ring */
+	if (xemacpsif->has_prio_queue != 0) {
+		process_rx_bds(xemac, &xemacpsif->rx_prio_ring, xemacpsif->recv_prio_q,
+						XEMACPS_RX_BUDGET_ALL);
+	}
+#endif
+	process_rx_bds(xemac, &XEmacPs_GetRxRing(&xemacpsif->emacps), xemacpsif->recv_q,
+					XEMACPS_RX_BUDGET_ALL);
+#endif
 
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
@@ -550,23 +1079,107 @@ void clean_dma_txdescs(struct xemac_s *xemac)
 			(UINTPTR) xemacpsif->tx_bdspace, BD_ALIGNMENT,
 				 XLWIP_CONFIG_N_TX_DESC);
 	XEmacPs_BdRingClone(txringptr, &bdtemplate, XEMACPS_SEND);
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	if (xemacpsif->has_prio_queue != 0) {
+		XEmacPs_BdRingCreate(&xemacpsif->tx_prio_ring,
+				(UINTPTR) xemacpsif->tx_prio_bdspace,
+				(UINTPTR) xemacpsif->tx_prio_bdspace, BD_ALIGNMENT,
+					 XLWIP_CONFIG_N_TX_PRIO_DESC);
+		XEmacPs_BdRingClone(&xemacpsif->tx_prio_ring, &bdtemplate, XEMACPS_SEND);
+	}
+#endif
+}
+
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+/*
+ * Create the queue 1 BD rings and arm the RX one. The BD space is the one
+ * otherwise used to park the unused queues.
+ */
+static XStatus init_prio_dma(xemacpsif_s *xemacpsif)
+{
+	XEmacPs_Bd bdtemplate;
+	UINTPTR *storage;
+	XStatus status;
+	u32_t i;
+
+	XEmacPs_BdClear(&bdtemplate);
+	status = XEmacPs_BdRingCreate(&xemacpsif->rx_prio_ring,
+				(UINTPTR) xemacpsif->rx_prio_bdspace,
+				(UINTPTR) xemacpsif->rx_prio_bdspace, BD_ALIGNMENT,
+				     XLWIP_CONFIG_N_RX_PRIO_DESC);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting up priority RxBD space\r\n"));
+		return XST_FAILURE;
+	}
+	status = XEmacPs_BdRingClone(&xemacpsif->rx_prio_ring, &bdtemplate, XEMACPS_RECV);
+	if (status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XEmacPs_BdSetStatus(&bdtemplate, XEMACPS_TXBUF_USED_MASK);
+	status = XEmacPs_BdRingCreate(&xemacpsif->tx_prio_ring,
+				(UINTPTR) xemacpsif->tx_prio_bdspace,
+				(UINTPTR) xemacpsif->tx_prio_bdspace, BD_ALIGNMENT,
+				     XLWIP_CONFIG_N_TX_PRIO_DESC);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting up priority TxBD space\r\n"));
+		return XST_FAILURE;
+	}
+	status = XEmacPs_BdRingClone(&xemacpsif->tx_prio_ring, &bdtemplate, XEMACPS_SEND);
+	if (status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	storage = get_rx_pbufs_storage(xemacpsif, &xemacpsif->rx_prio_ring);
+	for (i = 0; i < XLWIP_CONFIG_N_RX_PRIO_DESC; i++) {
+		storage[i] = 0;
+	}
+	setup_rx_bds(xemacpsif, &xemacpsif->rx_prio_ring);
+	if (XEmacPs_BdRingGetFreeCnt(&xemacpsif->rx_prio_ring) != 0) {
+		printf("unable to arm all priority RxBDs in init_dma\r\n");
+		return XST_FAILURE;
+	}
+	return XST_SUCCESS;
 }
 
+/*
+ * Bulk traffic on TX queue 0, priority traffic on TX/RX queue 1. RX queue 1
+ * uses the same buffer size as queue 0.
+ */
+static void set_prio_queue_ptrs(xemacpsif_s *xemacpsif)
+{
+	u32_t rxbufsize;
+
+	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, 0, XEMACPS_SEND);
+	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->tx_prio_ring.BaseBdAddr,
+						XEMACPS_PRIO_QUEUE, XEMACPS_SEND);
+	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->rx_prio_ring.BaseBdAddr,
+						XEMACPS_PRIO_QUEUE, XEMACPS_RECV);
+
+	rxbufsize = (XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress,
+			XEMACPS_DMACR_OFFSET) & XEMACPS_DMACR_RXBUF_MASK) >> XEMACPS_DMACR_RXBUF_SHIFT;
+	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress,
+			XEMACPS_DMA_RXQ1_BUFSIZE_OFFSET, rxbufsize);
+}
+#endif
+
 XStatus init_dma(struct xemac_s *xemac)
 {
 	XEmacPs_Bd bdtemplate;
 	XEmacPs_BdRing *rxringptr, *txringptr;
+#ifndef XLWIP_CONFIG_GEM_RX_ZERO_COPY
 	XEmacPs_Bd *rxbd;
 	struct pbuf *p;
+	u32_t bdindex;
+	u32 *temp;
+#endif
 	XStatus status;
 	s32_t i;
-	u32_t bdindex;
 	volatile UINTPTR tempaddress;
 	u32_t index;
 	u32_t gigeversion;
 	XEmacPs_Bd *bdtxterminate;
 	XEmacPs_Bd *bdrxterminate;
-	u32 *temp;
 
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 	struct xtopology_t *xtopologyp = &xtopology[xemac->topology_index];
@@ -669,6 +1282,30 @@ XStatus init_dma(struct xemac_s *xemac)
 		return ERR_IF;
 	}
 
+#ifdef XLWIP_CONFIG_GEM_RX_ZERO_COPY
+	zc_rx_pool_init(xemacpsif);
+#endif
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	xemacpsif->has_prio_queue = (gigeversion > 2) ? 1 : 0;
+	if (xemacpsif->has_prio_queue != 0) {
+		xemacpsif->rx_prio_bdspace = (void *)bdrxterminate;
+		xemacpsif->tx_prio_bdspace = (void *)bdtxterminate;
+		if (init_prio_dma(xemacpsif) != XST_SUCCESS) {
+			return ERR_IF;
+		}
+	}
+#endif
+
+#ifdef XLWIP_CONFIG_GEM_RX_ZERO_COPY
+	for (i = 0; i < XLWIP_CONFIG_N_RX_DESC; i++) {
+		rx_pbufs_storage[index + i] = 0;
+	}
+	setup_rx_bds(xemacpsif, rxringptr);
+	if (XEmacPs_BdRingGetFreeCnt(rxringptr) != 0) {
+		printf("unable to arm all RxBDs in init_dma\r\n");
+		return ERR_IF;
+	}
+#else
 	/*
 	 * Allocate RX descriptors, 1 RxBD at a time.
 	 */
@@ -723,6 +1360,7 @@ XStatus init_dma(struct xemac_s *xemac)
 
 		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
 	}
+#endif
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
 	if (gigeversion > 2) {
 		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, 1, XEMACPS_SEND);
@@ -731,6 +1369,14 @@ XStatus init_dma(struct xemac_s *xemac)
 	}
 	if (gigeversion > 2)
 	{
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+		if (xemacpsif->has_prio_queue != 0) {
+			/* Both queues are in use, there is nothing to park */
+			set_prio_queue_ptrs(xemacpsif);
+			setup_prio_classes(xemacpsif);
+		} else
+#endif
+		{
 		/*
 		 * This version of GEM supports priority queuing and the current
 		 * driver is using tx priority queue 1 and normal rx queue for
@@ -749,8 +1395,16 @@ XStatus init_dma(struct xemac_s *xemac)
 						XEMACPS_TXBUF_WRAP_MASK));
 		XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_TXQBASE_OFFSET),
 				   (UINTPTR)bdtxterminate);
+		}
 	}
 
+#if XLWIP_CONFIG_GEM_RX_COALESCE_USECS > 0
+	/* Hold back RX interrupts so that one covers several frames */
+	XEmacPs_SetIntrModeration(&xemacpsif->emacps, XEMACPS_RX_COALESCE_DELAY, 0);
+#endif
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+	xemacpsif->rx_poll_active = 0;
+#endif
 
 	/*
 	 * Connect the device driver handler that will be called when an
@@ -805,44 +1459,65 @@ void resetrx_on_no_rxdata(xemacpsif_s *xemacpsif)
 	}
 }
 
-void free_txrx_pbufs(xemacpsif_s *xemacpsif)
+static void free_ring_tx_pbufs(UINTPTR *storage, u32_t count)
 {
-	s32_t index;
-	s32_t index1;
+	u32_t index;
 	struct pbuf *p;
 
-	index1 = get_base_index_txpbufsstorage (xemacpsif);
-
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
-		if (tx_pbufs_storage[index] != 0) {
-			p = (struct pbuf *)tx_pbufs_storage[index];
+	for (index = 0; index < count; index++) {
+		if (storage[index] != 0) {
+			p = (struct pbuf *)storage[index];
 			pbuf_free(p);
-			tx_pbufs_storage[index] = 0;
+			storage[index] = 0;
 		}
 	}
+}
 
-	index1 = get_base_index_rxpbufsstorage(xemacpsif);
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_RX_DESC); index++) {
-		p = (struct pbuf *)rx_pbufs_storage[index];
+static void free_ring_rx_pbufs(UINTPTR *storage, u32_t count)
+{
+	u32_t index;
+#ifndef XLWIP_CONFIG_GEM_RX_ZERO_COPY
+	struct pbuf *p;
+#endif
+
+	for (index = 0; index < count; index++) {
+#ifdef XLWIP_CONFIG_GEM_RX_ZERO_COPY
+		/* Armed buffers go back to the pool; the ones lwIP holds return on pbuf_free */
+		if (storage[index] != 0) {
+			zc_rx_buf_put((struct xemacps_zc_rx_buf *)storage[index]);
+			storage[index] = 0;
+		}
+#else
+		p = (struct pbuf *)storage[index];
 		pbuf_free(p);
+#endif
+	}
+}
 
+void free_txrx_pbufs(xemacpsif_s *xemacpsif)
+{
+	free_onlytx_pbufs(xemacpsif);
+
+	free_ring_rx_pbufs(get_rx_pbufs_storage(xemacpsif,
+			&XEmacPs_GetRxRing(&xemacpsif->emacps)), XLWIP_CONFIG_N_RX_DESC);
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	if (xemacpsif->has_prio_queue != 0) {
+		free_ring_rx_pbufs(get_rx_pbufs_storage(xemacpsif,
+				&xemacpsif->rx_prio_ring), XLWIP_CONFIG_N_RX_PRIO_DESC);
 	}
+#endif
 }
 
 void free_onlytx_pbufs(xemacpsif_s *xemacpsif)
 {
-	s32_t index;
-	s32_t index1;
-	struct pbuf *p;
-
-	index1 = get_base_index_txpbufsstorage (xemacpsif);
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
-		if (tx_pbufs_storage[index] != 0) {
-			p = (struct pbuf *)tx_pbufs_storage[index];
-			pbuf_free(p);
-			tx_pbufs_storage[index] = 0;
-		}
+	free_ring_tx_pbufs(get_tx_pbufs_storage(xemacpsif,
+			&XEmacPs_GetTxRing(&xemacpsif->emacps)), XLWIP_CONFIG_N_TX_DESC);
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	if (xemacpsif->has_prio_queue != 0) {
+		free_ring_tx_pbufs(get_tx_pbufs_storage(xemacpsif,
+				&xemacpsif->tx_prio_ring), XLWIP_CONFIG_N_TX_PRIO_DESC);
 	}
+#endif
 }
 
 /* reset Tx and Rx DMA pointers after XEmacPs_Stop */
@@ -866,6 +1541,13 @@ void reset_dma(struct xemac_s *xemac)
 
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, txqueuenum, XEMACPS_SEND);
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	if (xemacpsif->has_prio_queue != 0) {
+		XEmacPs_BdRingPtrReset(&xemacpsif->tx_prio_ring, xemacpsif->tx_prio_bdspace);
+		XEmacPs_BdRingPtrReset(&xemacpsif->rx_prio_ring, xemacpsif->rx_prio_bdspace);
+		set_prio_queue_ptrs(xemacpsif);
+	}
+#endif
 }
 
 void emac_disable_intr(void)
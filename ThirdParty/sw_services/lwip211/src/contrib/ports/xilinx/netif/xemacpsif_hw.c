@@ -196,6 +196,13 @@ void start_emacps (xemacpsif_s *xemacps)
 {
 	/* start the temac */
 	XEmacPs_Start(&xemacps->emacps);
+#ifdef XLWIP_CONFIG_GEM_PRIO_QUEUE
+	/* XEmacPs_Start() only enables the queue 1 transmit interrupts */
+	if (xemacps->has_prio_queue != 0) {
+		XEmacPs_WriteReg(xemacps->emacps.Config.BaseAddress,
+				XEMACPS_INTQ1_IER_OFFSET, XEMACPS_INTQ1_IXR_RX_MASK);
+	}
+#endif
 }
 
 void restart_emacps_transmitter (xemacpsif_s *xemacps) {
@@ -30,12 +30,30 @@
 
 #include <stdlib.h>
 
+#include "lwip/sys.h"
 #include "netif/xpqueue.h"
+#include "xlwipconfig.h"
+#include "xparameters.h"
 #include "xil_printf.h"
 
-#define NUM_QUEUES	2
+/*
+ * With the priority queue option, the GEM adapter uses a second receive
+ * queue per interface for priority traffic.
+ */
+#ifndef PQ_NUM_QUEUES
+#if defined(XLWIP_CONFIG_GEM_PRIO_QUEUE) && defined(XPAR_XEMACPS_NUM_INSTANCES)
+#define PQ_NUM_QUEUES	(2 + XPAR_XEMACPS_NUM_INSTANCES)
+#else
+#define PQ_NUM_QUEUES	2
+#endif
+#endif
+
+#define PQ_MASK		(PQ_QUEUE_SIZE - 1U)
+
+#define pq_load_acquire(x)	__atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define pq_store_release(x, v)	__atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
 
-pq_queue_t pq_queue[NUM_QUEUES];
+pq_queue_t pq_queue[PQ_NUM_QUEUES];
 
 pq_queue_t *
 pq_create_queue()
@@ -43,7 +61,7 @@ pq_create_queue()
 	static int i;
 	pq_queue_t *q = NULL;
 
-	if (i >= NUM_QUEUES) {
+	if (i >= PQ_NUM_QUEUES) {
 		xil_printf("ERR: Max Queues allocated\n\r");
 		return q;
 	}
@@ -53,41 +71,141 @@ pq_create_queue()
 	if (!q)
 		return q;
 
-	q->head = q->tail = q->len = 0;
+	q->head = q->tail = 0;
+	q->high_water = q->drops = 0;
+	q->locked = 0;
 
 	return q;
 }
 
+pq_queue_t *
+pq_create_locked_queue()
+{
+	pq_queue_t *q = pq_create_queue();
+
+	if (q)
+		q->locked = 1;
+
+	return q;
+}
+
+/*
+ * Producer side. The entries are written before the new head is published,
+ * so the consumer never sees a slot that is not filled in yet.
+ */
+static int
+pq_enqueue_ring(pq_queue_t *q, void **p, int n)
+{
+	unsigned int head = q->head;
+	unsigned int tail = pq_load_acquire(q->tail);
+	unsigned int space = PQ_QUEUE_SIZE - (head - tail);
+	unsigned int len;
+	int i;
+
+	if ((unsigned int)n > space) {
+		q->drops += (unsigned int)n - space;
+		n = (int)space;
+	}
+
+	for (i = 0; i < n; i++)
+		q->data[(head + (unsigned int)i) & PQ_MASK] = p[i];
+
+	pq_store_release(q->head, head + (unsigned int)n);
+
+	len = (head - tail) + (unsigned int)n;
+	if (len > q->high_water)
+		q->high_water = len;
+
+	return n;
+}
+
+int
+pq_enqueue_bulk(pq_queue_t *q, void **p, int n)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (!q->locked)
+		return pq_enqueue_ring(q, p, n);
+
+	SYS_ARCH_PROTECT(lev);
+	n = pq_enqueue_ring(q, p, n);
+	SYS_ARCH_UNPROTECT(lev);
+
+	return n;
+}
+
 int
 pq_enqueue(pq_queue_t *q, void *p)
 {
-	if (q->len == PQ_QUEUE_SIZE)
+	if (pq_enqueue_bulk(q, &p, 1) != 1)
 		return -1;
 
-	q->data[q->head] = p;
-	q->head = (q->head + 1)%PQ_QUEUE_SIZE;
-	q->len++;
-
 	return 0;
 }
 
+/*
+ * Consumer side. The entries are read before the new tail is published,
+ * so the producer never overwrites a slot that is still being read.
+ */
+static int
+pq_dequeue_ring(pq_queue_t *q, void **p, int n)
+{
+	unsigned int tail = q->tail;
+	unsigned int head = pq_load_acquire(q->head);
+	unsigned int avail = head - tail;
+	int i;
+
+	if ((unsigned int)n > avail)
+		n = (int)avail;
+
+	for (i = 0; i < n; i++)
+		p[i] = q->data[(tail + (unsigned int)i) & PQ_MASK];
+
+	pq_store_release(q->tail, tail + (unsigned int)n);
+
+	return n;
+}
+
+int
+pq_dequeue_bulk(pq_queue_t *q, void **p, int n)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (!q->locked)
+		return pq_dequeue_ring(q, p, n);
+
+	SYS_ARCH_PROTECT(lev);
+	n = pq_dequeue_ring(q, p, n);
+	SYS_ARCH_UNPROTECT(lev);
+
+	return n;
+}
+
 void*
 pq_dequeue(pq_queue_t *q)
 {
-	int ptail;
+	void *p;
 
-	if (q->len == 0)
+	if (pq_dequeue_bulk(q, &p, 1) != 1)
 		return NULL;
 
-	ptail = q->tail;
-	q->tail = (q->tail + 1)%PQ_QUEUE_SIZE;
-	q->len--;
-
-	return q->data[ptail];
+	return p;
 }
 
 int
 pq_qlength(pq_queue_t *q)
 {
-	return q->len;
+	return (int)(pq_load_acquire(q->head) - pq_load_acquire(q->tail));
+}
+
+unsigned int
+pq_high_water(pq_queue_t *q)
+{
+	return q->high_water;
+}
+
+unsigned int
+pq_drops(pq_queue_t *q)
+{
+	return q->drops;
 }
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2020 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+/*
+ * Host test of the pbuf queue (xpqueue.c). It checks the ring bookkeeping
+ * from a single thread, the ordering of a single-producer/single-consumer
+ * queue with the producer and the consumer on two threads, and that a
+ * locked queue with two consumer threads hands out every entry once.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lwip/sys.h"
+#include "netif/xpqueue.h"
+
+#define NUM_ITEMS	1000000U
+#define MAX_BULK	16
+
+pthread_mutex_t sys_arch_lock;
+
+static int failures;
+
+#define CHECK(cond) do { \
+	if (!(cond)) { \
+		printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+		failures++; \
+	} \
+} while (0)
+
+static void *to_ptr(unsigned int v)
+{
+	return (void *)(uintptr_t)v;
+}
+
+static unsigned int to_val(void *p)
+{
+	return (unsigned int)(uintptr_t)p;
+}
+
+static void test_fill(pq_queue_t *q)
+{
+	unsigned int i;
+
+	CHECK(pq_dequeue(q) == NULL);
+
+	for (i = 1; i <= PQ_QUEUE_SIZE; i++)
+		CHECK(pq_enqueue(q, to_ptr(i)) == 0);
+
+	CHECK(pq_qlength(q) == PQ_QUEUE_SIZE);
+	CHECK(pq_enqueue(q, to_ptr(0)) == -1);
+	CHECK(pq_drops(q) == 1);
+	CHECK(pq_high_water(q) == PQ_QUEUE_SIZE);
+
+	for (i = 1; i <= PQ_QUEUE_SIZE; i++)
+		CHECK(to_val(pq_dequeue(q)) == i);
+
+	CHECK(pq_qlength(q) == 0);
+	CHECK(pq_dequeue(q) == NULL);
+}
+
+struct producer_arg {
+	pq_queue_t *q;
+	unsigned int seed;
+};
+
+/* Enqueues 1 to NUM_ITEMS in order, in single and bulk enqueues */
+static void *producer(void *arg)
+{
+	struct producer_arg *a = arg;
+	void *batch[MAX_BULK];
+	unsigned int next = 1;
+
+	while (next <= NUM_ITEMS) {
+		int n = (int)(rand_r(&a->seed) % MAX_BULK) + 1;
+		int i, done;
+
+		if (next + (unsigned int)n - 1 > NUM_ITEMS)
+			n = (int)(NUM_ITEMS - next + 1);
+
+		if (n == 1) {
+			if (pq_enqueue(a->q, to_ptr(next)) == 0)
+				next++;
+			else
+				sched_yield();
+			continue;
+		}
+
+		for (i = 0; i < n; i++)
+			batch[i] = to_ptr(next + (unsigned int)i);
+		done = pq_enqueue_bulk(a->q, batch, n);
+		next += (unsigned int)done;
+		if (done < n)
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+static void test_spsc(pq_queue_t *q)
+{
+	struct producer_arg a = { q, 1 };
+	void *batch[MAX_BULK];
+	unsigned int expected = 1;
+	unsigned int seed = 2;
+	pthread_t thread;
+
+	pthread_create(&thread, NULL, producer, &a);
+
+	while (expected <= NUM_ITEMS) {
+		int n = (int)(rand_r(&seed) % MAX_BULK) + 1;
+		int i;
+
+		n = pq_dequeue_bulk(q, batch, n);
+		if (n == 0)
+			sched_yield();
+		for (i = 0; i < n; i++) {
+			if (to_val(batch[i]) != expected) {
+				printf("FAIL: got %u, expected %u\n",
+						to_val(batch[i]), expected);
+				failures++;
+				expected = to_val(batch[i]);
+			}
+			expected++;
+		}
+	}
+
+	pthread_join(thread, NULL);
+	CHECK(pq_qlength(q) == 0);
+	printf("spsc: %u entries, high water %u, refused %u\n", NUM_ITEMS,
+			pq_high_water(q), pq_drops(q));
+}
+
+struct consumer_arg {
+	pq_queue_t *q;
+	unsigned char *seen;
+	unsigned int count;
+};
+
+static unsigned int consumed;
+
+/* Dequeues until all entries are consumed by either consumer */
+static void *consumer(void *arg)
+{
+	struct consumer_arg *a = arg;
+	void *p;
+
+	while (__atomic_load_n(&consumed, __ATOMIC_RELAXED) < NUM_ITEMS) {
+		p = pq_dequeue(a->q);
+		if (p == NULL) {
+			sched_yield();
+			continue;
+		}
+		a->seen[to_val(p)]++;
+		a->count++;
+		__atomic_add_fetch(&consumed, 1, __ATOMIC_RELAXED);
+		/* Let the other consumer in, also on a single CPU */
+		if ((a->count % 32) == 0)
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+static void test_locked(pq_queue_t *q)
+{
+	struct producer_arg a = { q, 3 };
+	struct consumer_arg c[2];
+	unsigned char *seen[2];
+	pthread_t threads[3];
+	unsigned int i;
+	int t;
+
+	for (t = 0; t < 2; t++) {
+		seen[t] = calloc(NUM_ITEMS + 1, 1);
+		c[t].q = q;
+		c[t].seen = seen[t];
+		c[t].count = 0;
+		pthread_create(&threads[t], NULL, consumer, &c[t]);
+	}
+	pthread_create(&threads[2], NULL, producer, &a);
+
+	for (t = 0; t < 3; t++)
+		pthread_join(threads[t], NULL);
+
+	for (i = 1; i <= NUM_ITEMS; i++) {
+		if (seen[0][i] + seen[1][i] != 1) {
+			printf("FAIL: entry %u dequeued %d times\n", i,
+					seen[0][i] + seen[1][i]);
+			failures++;
+			break;
+		}
+	}
+	CHECK(pq_qlength(q) == 0);
+	printf("locked: %u entries, consumers %u/%u\n", NUM_ITEMS,
+			c[0].count, c[1].count);
+
+	free(seen[0]);
+	free(seen[1]);
+}
+
+int main(void)
+{
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&sys_arch_lock, &attr);
+
+	test_fill(pq_create_queue());
+	test_spsc(pq_create_queue());
+	test_locked(pq_create_locked_queue());
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2020 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+/*
+ * Host lwIP options for the zero-copy RX test: a NO_SYS build with
+ * SYS_ARCH_PROTECT and link statistics, and no protocols beyond what
+ * the GEM adapter needs to compile.
+ */
+#ifndef __LWIPOPTS_H__
+#define __LWIPOPTS_H__
+
+#define NO_SYS			1
+#define SYS_LIGHTWEIGHT_PROT	1
+#define PROCESSOR_LITTLE_ENDIAN
+
+/* lwip/sys.h only maps these for ARM and MicroBlaze */
+unsigned int sys_arch_protect(void);
+void sys_arch_unprotect(unsigned int lev);
+#define SYS_ARCH_DECL_PROTECT(lev)	unsigned int lev
+#define SYS_ARCH_PROTECT(lev)		lev = sys_arch_protect()
+#define SYS_ARCH_UNPROTECT(lev)		sys_arch_unprotect(lev)
+
+#define MEM_ALIGNMENT		64
+#define MEM_SIZE		(64 * 1024)
+#define MEMP_NUM_PBUF		16
+#define PBUF_POOL_SIZE		16
+#define PBUF_POOL_BUFSIZE	1700
+
+#define LWIP_RAW		0
+#define LWIP_UDP		0
+#define LWIP_TCP		0
+#define LWIP_ARP		1
+#define LWIP_ICMP		0
+#define LWIP_IGMP		0
+#define LWIP_DHCP		0
+#define LWIP_NETCONN		0
+#define LWIP_SOCKET		0
+
+#define LWIP_STATS		1
+#define LWIP_STATS_LARGE	1
+#define LINK_STATS		1
+#define LWIP_STATS_DISPLAY	0
+
+#endif
@@ -0,0 +1,635 @@
+/*
+ * Copyright (C) 2020 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+/*
+ * Host test of the GEM zero-copy RX path (xemacpsif_dma.c) with the
+ * priority queue and RX interrupt moderation. A simulated GEM fills the
+ * queue 0 and queue 1 BD rings in bursts, as moderated interrupts deliver
+ * them, and the RX handler runs after each burst. A "stack" thread takes
+ * the frames off the receive queues like xemacpsif_input() and holds,
+ * frees or hands them to an "application" thread that frees them later,
+ * so buffers come back to the pool from two threads while the handler
+ * re-arms the rings. Twice during the run the DMA is torn down and set up
+ * again as HandleEmacPsError() does, with buffers still held by lwIP.
+ *
+ * Checked are that every frame reaches lwIP intact and in order per queue
+ * or is counted as dropped, that a buffer lwIP holds is never armed again
+ * (the simulated GEM would overwrite it), that no buffer is on the free list
+ * and a BD at once, that the rings stay fully armed when the pool runs dry,
+ * that cache invalidation stays within a buffer but covers what lwIP may
+ * have dirtied before the GEM writes the buffer again, and that all buffers
+ * are back once lwIP has freed everything. The poll build (ZC_TEST_RX_POLL)
+ * runs the same load with the rings drained by emacps_rx_poll() from the
+ * stack thread.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Included so that the test can look at the buffer pool and BD storage */
+#include "xemacpsif_dma.c"
+
+#define NUM_FRAMES	500000U
+#define NUM_RESETS	2U		/* each takes another 256 KB of bd_space */
+#define MAX_BURST	40U		/* more than both rings hold */
+#define STACK_BACKLOG	12U		/* frames the stack thread sits on */
+#define APP_BACKLOG	6U		/* frames the application sits on */
+#define GEM_PACE_QUEUED	8		/* frames queued before the GEM waits */
+#define GEM_PACE_SPINS	1000U
+
+#define FRAME_MIN	60U
+#define FRAME_MAX	1514U
+#define FRAME_HDR	20U		/* ethernet header, sequence, length */
+
+#define ETHTYPE_BULK	0x0800U
+#define ETHTYPE_PRIO	0x88F7U
+
+#define NUM_ZC_BUFS	XLWIP_CONFIG_N_RX_ZC_BUFS
+
+unsigned long zc_test_gem_base;
+struct xtopology_t xtopology[1];
+
+static u32 gem_regs[0x2000 / 4];
+static xemacpsif_s emacps_if;
+static struct xemac_s xemac;
+
+static pthread_mutex_t sys_arch_lock;
+
+static int failures;
+
+#define CHECK(cond) do { \
+	if (!(cond)) { \
+		printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+		failures++; \
+	} \
+} while (0)
+
+/* Simulated GEM: the next BD it writes on each queue */
+struct gem_queue {
+	XEmacPs_BdRing *ring;
+	u32 next;
+};
+
+static struct gem_queue gem_q[2];
+
+/* Buffers currently owned by lwIP, set on dequeue and cleared before free */
+static u8 held[NUM_ZC_BUFS];
+
+/*
+ * Bytes of each buffer that lwIP may have left dirty in the cache. They
+ * must be invalidated before the GEM writes the buffer again, or a later
+ * eviction would overwrite the frame.
+ */
+static u32 dirty[NUM_ZC_BUFS];
+
+static u32 frames_sent;
+static u32 frames_overrun;
+static u32 frames_delivered;
+static u32 frames_prio;
+static u32 invalidates;
+static u32 resets;
+static volatile int gem_done;
+static volatile int stack_done;
+static pq_queue_t *app_q;
+
+/* SYS_ARCH_PROTECT masks interrupts on target; here it takes one lock */
+sys_prot_t sys_arch_protect(void)
+{
+	pthread_mutex_lock(&sys_arch_lock);
+	return 0;
+}
+
+void sys_arch_unprotect(sys_prot_t lev)
+{
+	(void)lev;
+	pthread_mutex_unlock(&sys_arch_lock);
+}
+
+void Xil_DCacheInvalidateRange(INTPTR adr, INTPTR len)
+{
+	UINTPTR base = (UINTPTR)zc_rx_buf_space;
+	UINTPTR first;
+	UINTPTR last;
+
+	/* Only ever the bytes of a single RX buffer */
+	CHECK(len > 0);
+	CHECK((UINTPTR)adr >= base);
+	CHECK((UINTPTR)(adr + len) <= base + sizeof(zc_rx_buf_space));
+	first = ((UINTPTR)adr - base) / XEMACPS_ZC_RX_BUF_ALIGNED_SIZE;
+	last = ((UINTPTR)(adr + len - 1) - base) / XEMACPS_ZC_RX_BUF_ALIGNED_SIZE;
+	CHECK(first == last);
+	if ((first == last) && ((UINTPTR)adr == (UINTPTR)zc_rx_buf_space[first]) &&
+			((u32)len >= __atomic_load_n(&dirty[first], __ATOMIC_ACQUIRE))) {
+		__atomic_store_n(&dirty[first], 0, __ATOMIC_RELEASE);
+	}
+	invalidates++;
+}
+
+void Xil_DCacheFlushRange(INTPTR adr, INTPTR len)
+{
+	(void)adr;
+	(void)len;
+}
+
+static u32 buf_index(struct pbuf *p)
+{
+	return (u32)((struct xemacps_zc_rx_buf *)p - zc_rx_bufs);
+}
+
+static void set_held(struct pbuf *p, u8 v)
+{
+	__atomic_store_n(&held[buf_index(p)], v, __ATOMIC_RELEASE);
+}
+
+static u8 frame_byte(u32 seq, u32 i)
+{
+	return (u8)((seq * 7U) + i);
+}
+
+/*
+ * Frame the GEM writes for sequence number seq: an ethernet header with the
+ * queue's ethertype, the sequence number and length, then a pattern.
+ */
+static void gem_write_frame(u8 *data, u32 seq, u32 len, u32 prio)
+{
+	u16 type = prio ? ETHTYPE_PRIO : ETHTYPE_BULK;
+	u16 len16 = (u16)len;
+	u32 i;
+
+	memset(data, 0xFF, 12);
+	data[12] = (u8)(type >> 8);
+	data[13] = (u8)type;
+	memcpy(&data[14], &seq, sizeof(seq));
+	memcpy(&data[18], &len16, sizeof(len16));
+	for (i = FRAME_HDR; i < len; i++) {
+		data[i] = frame_byte(seq, i);
+	}
+}
+
+/* Queue the frame was sent on, from its ethertype */
+static u32 frame_prio(struct pbuf *p)
+{
+	return (((u8 *)p->payload)[12] == (u8)(ETHTYPE_PRIO >> 8)) ? 1U : 0U;
+}
+
+/* Returns the sequence number of an intact frame, or 0 */
+static u32 frame_check(struct pbuf *p, u32 prio)
+{
+	u8 *data = (u8 *)p->payload;
+	u16 type = prio ? ETHTYPE_PRIO : ETHTYPE_BULK;
+	u16 len16;
+	u32 seq;
+	u32 i;
+
+	if ((p->next != NULL) || (p->len != p->tot_len) || (p->len < FRAME_HDR)) {
+		return 0;
+	}
+	if ((data[12] != (u8)(type >> 8)) || (data[13] != (u8)type)) {
+		return 0;
+	}
+	memcpy(&seq, &data[14], sizeof(seq));
+	memcpy(&len16, &data[18], sizeof(len16));
+	if (len16 != p->len) {
+		return 0;
+	}
+	for (i = FRAME_HDR; i < p->len; i++) {
+		if (data[i] != frame_byte(seq, i)) {
+			return 0;
+		}
+	}
+	return seq;
+}
+
+static XEmacPs_Bd *gem_bd(struct gem_queue *q)
+{
+	return (XEmacPs_Bd *)(q->ring->BaseBdAddr + (q->next * q->ring->Separation));
+}
+
+/*
+ * Receive one frame on a queue. The GEM stops at a BD it does not own, as
+ * on the hardware the frame is then lost for lack of a buffer.
+ */
+static int gem_receive(struct gem_queue *q, u32 seq, u32 len, u32 prio)
+{
+	XEmacPs_Bd *bd = gem_bd(q);
+	u32 addr = XEmacPs_BdRead(bd, XEMACPS_BD_ADDR_OFFSET);
+	u32 idx;
+
+	if ((addr & XEMACPS_RXBUF_NEW_MASK) != 0) {
+		return -1;
+	}
+	idx = (u32)(((addr & XEMACPS_RXBUF_ADD_MASK) - (UINTPTR)zc_rx_buf_space) /
+			XEMACPS_ZC_RX_BUF_ALIGNED_SIZE);
+	CHECK(idx < NUM_ZC_BUFS);
+	if (idx >= NUM_ZC_BUFS) {
+		return -1;
+	}
+	CHECK(__atomic_load_n(&dirty[idx], __ATOMIC_ACQUIRE) == 0);
+
+	gem_write_frame((u8 *)(UINTPTR)(addr & XEMACPS_RXBUF_ADD_MASK), seq, len, prio);
+	XEmacPs_BdWrite(bd, XEMACPS_BD_STAT_OFFSET,
+			len | XEMACPS_RXBUF_SOF_MASK | XEMACPS_RXBUF_EOF_MASK);
+	dsb();
+	XEmacPs_BdWrite(bd, XEMACPS_BD_ADDR_OFFSET, addr | XEMACPS_RXBUF_NEW_MASK);
+
+	if ((addr & XEMACPS_RXBUF_WRAP_MASK) != 0) {
+		q->next = 0;
+	} else {
+		q->next++;
+	}
+	return 0;
+}
+
+static void gem_reset(void)
+{
+	gem_q[0].ring = &XEmacPs_GetRxRing(&emacps_if.emacps);
+	gem_q[0].next = 0;
+	gem_q[1].ring = &emacps_if.rx_prio_ring;
+	gem_q[1].next = 0;
+}
+
+/* Interrupt: the handler runs unless RX interrupts are masked for polling */
+static void gem_interrupt(void)
+{
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+	if (emacps_if.rx_poll_active != 0) {
+		return;
+	}
+#endif
+	emacps_recv_handler(&xemac);
+}
+
+/*
+ * Must be called under SYS_ARCH_PROTECT. Every buffer is on the free list,
+ * armed on a BD or owned by lwIP, never two of these, and every BD is armed.
+ * Returns the number of buffers not owned by lwIP.
+ */
+static u32 check_pool(void)
+{
+	static u8 seen[NUM_ZC_BUFS];
+	struct xemacps_zc_rx_buf *buf;
+	XEmacPs_BdRing *rings[2];
+	UINTPTR *storage;
+	u32 count = 0;
+	u32 idx;
+	u32 r;
+	u32 i;
+
+	memset(seen, 0, sizeof(seen));
+	for (buf = zc_rx_free_list[0]; buf != NULL; buf = buf->next) {
+		idx = (u32)(buf - zc_rx_bufs);
+		CHECK(idx < NUM_ZC_BUFS);
+		if (idx >= NUM_ZC_BUFS) {
+			return count;
+		}
+		/* Seen twice is also a loop in the list */
+		CHECK(seen[idx] == 0);
+		if (seen[idx] != 0) {
+			return count;
+		}
+		CHECK(__atomic_load_n(&held[idx], __ATOMIC_ACQUIRE) == 0);
+		seen[idx] = 1;
+		count++;
+	}
+
+	rings[0] = &XEmacPs_GetRxRing(&emacps_if.emacps);
+	rings[1] = &emacps_if.rx_prio_ring;
+	for (r = 0; r < 2; r++) {
+		CHECK(XEmacPs_BdRingGetFreeCnt(rings[r]) == 0);
+		storage = get_rx_pbufs_storage(&emacps_if, rings[r]);
+		for (i = 0; i < rings[r]->AllCnt; i++) {
+			CHECK(storage[i] != 0);
+			if (storage[i] == 0) {
+				continue;
+			}
+			idx = (u32)((struct xemacps_zc_rx_buf *)storage[i] - zc_rx_bufs);
+			CHECK(idx < NUM_ZC_BUFS);
+			if (idx >= NUM_ZC_BUFS) {
+				continue;
+			}
+			CHECK(seen[idx] == 0);
+			CHECK(__atomic_load_n(&held[idx], __ATOMIC_ACQUIRE) == 0);
+			seen[idx] = 1;
+			count++;
+		}
+	}
+	return count;
+}
+
+/* What HandleEmacPsError() does to the rings, with lwIP holding buffers */
+static void dma_reset(void)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	/* Hand up what is complete so that the frame accounting holds */
+	emacps_recv_handler(&xemac);
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+	emacps_rx_poll(&xemac, XEMACPS_RX_BUDGET_ALL);
+#endif
+	free_txrx_pbufs(&emacps_if);
+	if (init_dma(&xemac) != 0) {
+		/* The rings are not armed, the GEM cannot go on */
+		printf("FAIL %s:%d: init_dma() after reset\n", __FILE__, __LINE__);
+		printf("FAILED\n");
+		exit(1);
+	}
+	gem_reset();
+	check_pool();
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+/*
+ * Give the stack a chance to keep up, so that most frames get through and
+ * the pool only runs dry when lwIP sits on many buffers.
+ */
+static void gem_pace(void)
+{
+	u32 spins;
+
+	for (spins = 0; spins < GEM_PACE_SPINS; spins++) {
+		if (((pq_qlength(emacps_if.recv_q) + pq_qlength(emacps_if.recv_prio_q)) <
+				GEM_PACE_QUEUED)
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+				&& (emacps_if.rx_poll_active == 0)
+#endif
+				) {
+			break;
+		}
+		sched_yield();
+	}
+}
+
+static void gem_run(void)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+	unsigned int seed = 1;
+	u32 next_reset = NUM_FRAMES / (NUM_RESETS + 1U);
+	u32 seq = 1;
+	u32 burst;
+	u32 prio;
+	u32 len;
+
+	while (seq <= NUM_FRAMES) {
+		burst = (rand_r(&seed) % MAX_BURST) + 1U;
+
+		SYS_ARCH_PROTECT(lev);
+		while ((burst-- > 0) && (seq <= NUM_FRAMES)) {
+			prio = ((rand_r(&seed) % 4U) == 0) ? 1U : 0U;
+			len = FRAME_MIN + (rand_r(&seed) % (FRAME_MAX - FRAME_MIN + 1U));
+			if (gem_receive(&gem_q[prio], seq, len, prio) == 0) {
+				frames_sent++;
+			} else {
+				frames_overrun++;
+			}
+			seq++;
+		}
+		gem_interrupt();
+		check_pool();
+		SYS_ARCH_UNPROTECT(lev);
+
+		if ((seq >= next_reset) && (resets < NUM_RESETS)) {
+			dma_reset();
+			resets++;
+			next_reset += NUM_FRAMES / (NUM_RESETS + 1U);
+		}
+		gem_pace();
+	}
+
+	SYS_ARCH_PROTECT(lev);
+	gem_done = 1;
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+static void release(struct pbuf *p)
+{
+	CHECK(frame_check(p, frame_prio(p)) != 0);
+	/* The stack wrote to the frame, think of a checksum or a header rewrite */
+	__atomic_store_n(&dirty[buf_index(p)], p->len, __ATOMIC_RELEASE);
+	set_held(p, 0);
+	pbuf_free(p);
+}
+
+/* Application thread: frees what the stack handed over, a little later */
+static void *app_thread(void *arg)
+{
+	struct pbuf *backlog[APP_BACKLOG];
+	u32 count = 0;
+	unsigned int seed = 3;
+	struct pbuf *p;
+	u32 i;
+
+	(void)arg;
+	while (1) {
+		p = (struct pbuf *)pq_dequeue(app_q);
+		if (p == NULL) {
+			if (__atomic_load_n(&stack_done, __ATOMIC_ACQUIRE) != 0) {
+				break;
+			}
+			/* Idle, finish with one of the frames */
+			if (count > 0) {
+				i = rand_r(&seed) % count;
+				release(backlog[i]);
+				backlog[i] = backlog[--count];
+			}
+			sched_yield();
+			continue;
+		}
+		if (count == APP_BACKLOG) {
+			i = rand_r(&seed) % APP_BACKLOG;
+			release(backlog[i]);
+			backlog[i] = backlog[--count];
+		}
+		backlog[count++] = p;
+	}
+	while (count > 0) {
+		release(backlog[--count]);
+	}
+	return NULL;
+}
+
+/* Stack thread: takes frames like xemacpsif_input() and keeps some of them */
+static void *stack_thread(void *arg)
+{
+	struct pbuf *backlog[STACK_BACKLOG];
+	u32 last_seq[2] = { 0, 0 };
+	u32 count = 0;
+	unsigned int seed = 2;
+	SYS_ARCH_DECL_PROTECT(lev);
+	struct pbuf *p;
+	u32 prio;
+	u32 seq;
+	u32 action;
+	u32 i;
+
+	(void)arg;
+	while (1) {
+		SYS_ARCH_PROTECT(lev);
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+		if ((pq_qlength(emacps_if.recv_q) == 0) &&
+				(pq_qlength(emacps_if.recv_prio_q) == 0)) {
+			emacps_rx_poll(&xemac, XLWIP_CONFIG_GEM_RX_POLL_BUDGET);
+			check_pool();
+		}
+#endif
+		prio = 1;
+		p = (struct pbuf *)pq_dequeue(emacps_if.recv_prio_q);
+		if (p == NULL) {
+			prio = 0;
+			p = (struct pbuf *)pq_dequeue(emacps_if.recv_q);
+		}
+		if (p == NULL) {
+			if ((gem_done != 0)
+#ifdef XLWIP_CONFIG_GEM_RX_POLL
+					&& (emacps_if.rx_poll_active == 0)
+#endif
+					) {
+				SYS_ARCH_UNPROTECT(lev);
+				break;
+			}
+			SYS_ARCH_UNPROTECT(lev);
+			/* Idle, finish with one of the frames */
+			if (count > 0) {
+				i = rand_r(&seed) % count;
+				release(backlog[i]);
+				backlog[i] = backlog[--count];
+			}
+			sched_yield();
+			continue;
+		}
+		set_held(p, 1);
+		SYS_ARCH_UNPROTECT(lev);
+
+		seq = frame_check(p, prio);
+		CHECK(seq != 0);
+		CHECK(seq > last_seq[prio]);
+		last_seq[prio] = seq;
+		frames_delivered++;
+		frames_prio += prio;
+
+		action = rand_r(&seed) % 8U;
+		if (action < 3U) {
+			release(p);
+		} else if (action < 5U) {
+			/* The application gets it */
+			while (pq_enqueue(app_q, p) < 0) {
+				sched_yield();
+			}
+		} else if (action == 5U) {
+			/* A second reference, as a queued retransmission would hold */
+			pbuf_ref(p);
+			pbuf_free(p);
+			release(p);
+		} else {
+			if (count == STACK_BACKLOG) {
+				i = rand_r(&seed) % STACK_BACKLOG;
+				release(backlog[i]);
+				backlog[i] = backlog[--count];
+			}
+			backlog[count++] = p;
+		}
+	}
+
+	while (count > 0) {
+		release(backlog[--count]);
+	}
+	__atomic_store_n(&stack_done, 1, __ATOMIC_RELEASE);
+	return NULL;
+}
+
+static void setup(void)
+{
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&sys_arch_lock, &attr);
+
+	mem_init();
+	memp_init();
+
+	zc_test_gem_base = (unsigned long)gem_regs;
+	gem_regs[0xFC / 4] = GEM_VERSION_ZYNQMP << 16;
+	emacps_if.emacps.Config.BaseAddress = (UINTPTR)gem_regs;
+	emacps_if.emacps.Config.IsCacheCoherent = 0;
+	emacps_if.emacps.IsReady = XIL_COMPONENT_IS_READY;
+	emacps_if.emacps.Version = GEM_VERSION_ZYNQMP;
+	emacps_if.recv_q = pq_create_queue();
+	emacps_if.recv_prio_q = pq_create_queue();
+	app_q = pq_create_locked_queue();
+
+	xemac.type = xemac_type_emacps;
+	xemac.topology_index = 0;
+	xemac.state = &emacps_if;
+
+	CHECK(init_dma(&xemac) == 0);
+	CHECK(emacps_if.has_prio_queue != 0);
+	gem_reset();
+}
+
+int main(void)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+	pthread_t threads[2];
+	u32 unowned;
+
+	setup();
+
+	pthread_create(&threads[0], NULL, stack_thread, NULL);
+	pthread_create(&threads[1], NULL, app_thread, NULL);
+	gem_run();
+	pthread_join(threads[0], NULL);
+	pthread_join(threads[1], NULL);
+
+	SYS_ARCH_PROTECT(lev);
+	unowned = check_pool();
+	SYS_ARCH_UNPROTECT(lev);
+
+	/* Every buffer came back and every frame is accounted for */
+	CHECK(unowned == NUM_ZC_BUFS);
+	CHECK(frames_sent == frames_delivered + lwip_stats.link.drop);
+	/* The load ran the pool dry and used both queues */
+	CHECK(lwip_stats.link.drop > 0);
+	CHECK(frames_prio > 0);
+	CHECK(frames_delivered > frames_prio);
+	CHECK(invalidates > 0);
+	CHECK(resets == NUM_RESETS);
+
+	printf("zero-copy rx: %u frames, %u delivered (%u priority), "
+			"%u dropped, %u overruns\n", frames_sent, frames_delivered,
+			frames_prio, (u32)lwip_stats.link.drop, frames_overrun);
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,957 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_collect.c
+* @{
+*
+* This file contains the routines for the trace and performance counter
+* collection service. The service configures a set of performance counters
+* and trace units of the partition, samples the counters and drains the trace
+* packets routed to a shim DMA into host memory.
+*
+* The counters are configured in a single transaction and their register
+* addresses are computed once. A snapshot reads all the counters in one pass
+* through the backend, bypassing the transaction and the shadow register
+* cache. On Linux, a sampler thread takes snapshots at a fixed period and
+* stores them in a ring of samples which the application reads with
+* XAie_CollectGetSamples(). When the ring is full, new samples are dropped and
+* counted.
+*
+* The trace buffer is split in chunks, each written by one BD of the S2MM
+* channel of the shim DMA. The BDs are chained into a ring and use the lock
+* of the same ID as the BD: the DMA acquires it with value 0 and releases it
+* with value 1 once the chunk is full, XAie_CollectTraceDrain() copies the
+* full chunks in order and releases their lock with value 0.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   agent   10/17/2026  Initial creation
+* </pre>
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __AIEBAREMETAL__
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#include "xaie_collect.h"
+#include "xaie_dma.h"
+#include "xaie_helper.h"
+#include "xaie_io.h"
+#include "xaie_locks.h"
+#include "xaie_perfcnt.h"
+#include "xaie_txn.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_COLLECT_MAX_TRACE_SLOTS	8U
+
+/**************************** Type Definitions *******************************/
+/*
+ * Typedef for a collection instance. Sample i of the ring has its timestamp
+ * in SampleTime[i] and its counter values in
+ * SampleBuf[i * NumCounters, (i + 1) * NumCounters).
+ */
+struct XAie_CollectInst {
+	XAie_DevInst *DevInst;	/* Device instance */
+	u64 *CounterAddr;	/* Register address of each counter */
+	u32 NumCounters;	/* Number of counters */
+	u64 *SampleTime;	/* Timestamps of the samples in us */
+	u32 *SampleBuf;		/* Counter values of the samples */
+	u32 MaxSamples;		/* Number of samples of the ring */
+	u32 SampleHead;		/* Index of the oldest sample */
+	u32 NumSamples;		/* Number of samples in the ring */
+	u32 NumDropped;		/* Samples dropped since the last read */
+	XAie_MemInst *TraceMem;	/* Trace buffer, NULL if not setup */
+	XAie_LocType TraceLoc;	/* Location of the shim DMA */
+	u32 TraceBufSize;	/* Size of a trace chunk in bytes */
+	u8 TraceChNum;		/* S2MM channel of the shim DMA */
+	u8 TraceStartBd;	/* BD of the first trace chunk */
+	u8 TraceNumBufs;	/* Number of trace chunks */
+	u8 TraceNextBuf;	/* Next trace chunk to drain */
+#ifndef __AIEBAREMETAL__
+	pthread_mutex_t Lock;	/* Protects the ring, IsRunning, HasThread */
+	pthread_cond_t Cond;	/* Signals the sampler thread to stop */
+	pthread_t Thread;	/* Sampler thread */
+	u32 *ThreadValues;	/* Snapshot buffer of the sampler thread */
+	u32 PeriodUs;		/* Sampling period in us */
+	u8 IsRunning;		/* Sampler thread is running */
+	u8 HasThread;		/* Sampler thread is created, not joined */
+#endif
+};
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This function reads all the counters of a collection instance through the
+* backend.
+*
+* @param	Collect: Collection instance pointer.
+* @param	Values: Buffer to store the counter values.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_CollectRead(XAie_CollectInst *Collect, u32 *Values)
+{
+	XAie_DevInst *DevInst = Collect->DevInst;
+	const XAie_Backend *Backend = DevInst->Backend;
+
+	for(u32 i = 0U; i < Collect->NumCounters; i++) {
+		Values[i] = Backend->Ops.Read32(DevInst->IOInst,
+				Collect->CounterAddr[i]);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function frees a collection instance.
+*
+* @param	Collect: Collection instance pointer.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_CollectFree(XAie_CollectInst *Collect)
+{
+	free(Collect->CounterAddr);
+	free(Collect->SampleTime);
+	free(Collect->SampleBuf);
+#ifndef __AIEBAREMETAL__
+	free(Collect->ThreadValues);
+#endif
+	free(Collect);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function invalidates the BDs of a trace buffer ring, so that the shim
+* DMA doesn't write to the buffer once it is freed.
+*
+* @param	DevInst: Device Instance.
+* @param	MemInst: Trace buffer.
+* @param	ShimLoc: Location of the shim NOC tile.
+* @param	StartBd: First BD of the ring.
+* @param	NumBds: Number of BDs to invalidate.
+* @param	BufSize: Size of a chunk in bytes.
+*
+* @return	None.
+*
+* @note		Internal only. The BDs are written with the address of their
+*		chunk, as the backend may require the buffer of a shim DMA BD.
+*
+******************************************************************************/
+static void _XAie_CollectDisableTraceBds(XAie_DevInst *DevInst,
+		XAie_MemInst *MemInst, XAie_LocType ShimLoc, u8 StartBd,
+		u8 NumBds, u32 BufSize)
+{
+	XAie_DmaDesc DmaDesc;
+
+	for(u8 i = 0U; i < NumBds; i++) {
+		if((XAie_DmaDescInit(DevInst, &DmaDesc, ShimLoc) != XAIE_OK) ||
+				(XAie_DmaSetAddrOffsetLen(&DmaDesc, MemInst,
+					(u64)BufSize * i, BufSize) != XAIE_OK) ||
+				(XAie_DmaDisableBd(&DmaDesc) != XAIE_OK) ||
+				(XAie_DmaWriteBd(DevInst, &DmaDesc, ShimLoc,
+					StartBd + i) != XAIE_OK)) {
+			XAIE_ERROR("Failed to disable trace BD %u\n",
+					StartBd + i);
+		}
+	}
+}
+
+#ifndef __AIEBAREMETAL__
+/*****************************************************************************/
+/**
+*
+* This function adds a sample to the ring of a collection instance. The
+* sample is dropped if the ring is full.
+*
+* @param	Collect: Collection instance pointer.
+* @param	TimeStamp: Timestamp of the sample in us.
+* @param	Values: Counter values of the sample.
+*
+* @return	None.
+*
+* @note		Internal only. Must be called with the lock held.
+*
+******************************************************************************/
+static void _XAie_CollectPushSample(XAie_CollectInst *Collect, u64 TimeStamp,
+		const u32 *Values)
+{
+	u32 Index;
+
+	if(Collect->NumSamples == Collect->MaxSamples) {
+		Collect->NumDropped++;
+		return;
+	}
+
+	Index = (Collect->SampleHead + Collect->NumSamples) %
+		Collect->MaxSamples;
+	Collect->SampleTime[Index] = TimeStamp;
+	memcpy(&Collect->SampleBuf[(u64)Index * Collect->NumCounters], Values,
+			Collect->NumCounters * sizeof(*Values));
+	Collect->NumSamples++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the sampler thread. It takes a snapshot of the counters every
+* period until XAie_CollectStop() is called. A sample which is late by more
+* than one period moves the next deadline instead of being taken twice.
+*
+* @param	Arg: Collection instance pointer.
+*
+* @return	NULL.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void *_XAie_CollectThread(void *Arg)
+{
+	XAie_CollectInst *Collect = (XAie_CollectInst *)Arg;
+	struct timespec Next, Now;
+	u64 PeriodNs = (u64)Collect->PeriodUs * 1000U;
+
+	clock_gettime(CLOCK_MONOTONIC, &Next);
+	pthread_mutex_lock(&Collect->Lock);
+	while(Collect->IsRunning != 0U) {
+		pthread_mutex_unlock(&Collect->Lock);
+
+		clock_gettime(CLOCK_MONOTONIC, &Now);
+		_XAie_CollectRead(Collect, Collect->ThreadValues);
+
+		pthread_mutex_lock(&Collect->Lock);
+		_XAie_CollectPushSample(Collect, (u64)Now.tv_sec * 1000000U +
+				(u64)Now.tv_nsec / 1000U,
+				Collect->ThreadValues);
+
+		Next.tv_sec += (time_t)(PeriodNs / 1000000000U);
+		Next.tv_nsec += (long)(PeriodNs % 1000000000U);
+		if(Next.tv_nsec >= 1000000000L) {
+			Next.tv_sec++;
+			Next.tv_nsec -= 1000000000L;
+		}
+		if((Now.tv_sec > Next.tv_sec) || ((Now.tv_sec == Next.tv_sec) &&
+				(Now.tv_nsec > Next.tv_nsec))) {
+			Next = Now;
+		}
+
+		while(Collect->IsRunning != 0U) {
+			if(pthread_cond_timedwait(&Collect->Cond,
+					&Collect->Lock, &Next) != 0) {
+				break;
+			}
+		}
+	}
+	pthread_mutex_unlock(&Collect->Lock);
+
+	return NULL;
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* This API creates a collection instance for a set of performance counters.
+* The control registers of the counters are configured in one transaction,
+* unless a transaction is already in progress in which case they are
+* recorded in it.
+*
+* @param	DevInst: Device Instance
+* @param	Counters: Array of counters to collect.
+* @param	NumCounters: Number of counters. Can be 0 to only collect trace.
+* @param	MaxSamples: Number of samples kept for the sampler thread.
+*
+* @return	Pointer to the collection instance on success, NULL on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+XAie_CollectInst* XAie_CollectCreate(XAie_DevInst *DevInst,
+		const XAie_CollectCounter *Counters, u32 NumCounters,
+		u32 MaxSamples)
+{
+	XAie_CollectInst *Collect;
+	AieRC RC = XAIE_OK;
+	u8 OwnTxn = 0U;
+
+	if((DevInst == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return NULL;
+	}
+
+	if((NumCounters != 0U) && (Counters == NULL)) {
+		XAIE_ERROR("Invalid counters\n");
+		return NULL;
+	}
+
+	Collect = (XAie_CollectInst *)calloc(1U, sizeof(*Collect));
+	if(Collect == NULL) {
+		XAIE_ERROR("Memory allocation failed\n");
+		return NULL;
+	}
+
+	Collect->DevInst = DevInst;
+	Collect->NumCounters = NumCounters;
+	Collect->MaxSamples = MaxSamples;
+	if(NumCounters != 0U) {
+		Collect->CounterAddr = (u64 *)calloc(NumCounters,
+				sizeof(*Collect->CounterAddr));
+		if(Collect->CounterAddr == NULL) {
+			XAIE_ERROR("Memory allocation failed\n");
+			_XAie_CollectFree(Collect);
+			return NULL;
+		}
+	}
+
+	if((NumCounters != 0U) && (MaxSamples != 0U)) {
+		Collect->SampleTime = (u64 *)calloc(MaxSamples,
+				sizeof(*Collect->SampleTime));
+		Collect->SampleBuf = (u32 *)calloc((u64)MaxSamples *
+				NumCounters, sizeof(*Collect->SampleBuf));
+		if((Collect->SampleTime == NULL) ||
+				(Collect->SampleBuf == NULL)) {
+			XAIE_ERROR("Memory allocation failed\n");
+			_XAie_CollectFree(Collect);
+			return NULL;
+		}
+	}
+
+	for(u32 i = 0U; i < NumCounters; i++) {
+		RC = _XAie_PerfCounterGetRegAddr(DevInst, Counters[i].Loc,
+				Counters[i].Module, Counters[i].Counter,
+				&Collect->CounterAddr[i]);
+		if(RC != XAIE_OK) {
+			XAIE_ERROR("Invalid counter %d\n", i);
+			_XAie_CollectFree(Collect);
+			return NULL;
+		}
+	}
+
+	if((NumCounters != 0U) && (DevInst->TxnInst == NULL)) {
+		if(XAie_StartTransaction(DevInst, 0U) == XAIE_OK) {
+			OwnTxn = 1U;
+		}
+	}
+
+	for(u32 i = 0U; i < NumCounters; i++) {
+		RC = XAie_PerfCounterControlSet(DevInst, Counters[i].Loc,
+				Counters[i].Module, Counters[i].Counter,
+				Counters[i].StartEvent, Counters[i].StopEvent);
+		if(RC != XAIE_OK) {
+			XAIE_ERROR("Failed to configure counter %d\n", i);
+			break;
+		}
+	}
+
+	if(OwnTxn != 0U) {
+		if(RC != XAIE_OK) {
+			XAie_CancelTransaction(DevInst);
+		} else {
+			RC = XAie_SubmitTransaction(DevInst);
+		}
+	}
+
+	if(RC != XAIE_OK) {
+		_XAie_CollectFree(Collect);
+		return NULL;
+	}
+
+#ifndef __AIEBAREMETAL__
+	if(NumCounters != 0U) {
+		Collect->ThreadValues = (u32 *)calloc(NumCounters,
+				sizeof(*Collect->ThreadValues));
+		if(Collect->ThreadValues == NULL) {
+			XAIE_ERROR("Memory allocation failed\n");
+			_XAie_CollectFree(Collect);
+			return NULL;
+		}
+	}
+
+	pthread_mutex_init(&Collect->Lock, NULL);
+	{
+		pthread_condattr_t Attr;
+
+		pthread_condattr_init(&Attr);
+		pthread_condattr_setclock(&Attr, CLOCK_MONOTONIC);
+		pthread_cond_init(&Collect->Cond, &Attr);
+		pthread_condattr_destroy(&Attr);
+	}
+#endif
+
+	return Collect;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API destroys a collection instance. The sampler thread is stopped,
+* the S2MM channel and the BDs of the trace buffer are disabled and the trace
+* buffer is freed. The counters and trace units are left configured.
+*
+* @param	Collect: Collection instance pointer.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_CollectDestroy(XAie_CollectInst *Collect)
+{
+	if(Collect == NULL) {
+		XAIE_ERROR("Invalid collection instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+#ifndef __AIEBAREMETAL__
+	XAie_CollectStop(Collect);
+	pthread_cond_destroy(&Collect->Cond);
+	pthread_mutex_destroy(&Collect->Lock);
+#endif
+
+	if(Collect->TraceMem != NULL) {
+		XAie_DmaChannelDisable(Collect->DevInst, Collect->TraceLoc,
+				Collect->TraceChNum, DMA_S2MM);
+		_XAie_CollectDisableTraceBds(Collect->DevInst,
+				Collect->TraceMem, Collect->TraceLoc,
+				Collect->TraceStartBd, Collect->TraceNumBufs,
+				Collect->TraceBufSize);
+		XAie_MemFree(Collect->TraceMem);
+	}
+
+	_XAie_CollectFree(Collect);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API configures trace units of the partition. All the trace units are
+* configured in one transaction, unless a transaction is already in progress
+* in which case they are recorded in it.
+*
+* @param	Collect: Collection instance pointer.
+* @param	Traces: Array of trace units to configure.
+* @param	NumTraces: Number of trace units.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_CollectTraceConfig(XAie_CollectInst *Collect,
+		const XAie_CollectTrace *Traces, u32 NumTraces)
+{
+	XAie_DevInst *DevInst;
+	u8 SlotId[XAIE_COLLECT_MAX_TRACE_SLOTS];
+	AieRC RC = XAIE_OK;
+	u8 OwnTxn = 0U;
+
+	if((Collect == NULL) || (Traces == NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	for(u32 i = 0U; i < NumTraces; i++) {
+		if((Traces[i].NumEvents > XAIE_COLLECT_MAX_TRACE_SLOTS) ||
+				((Traces[i].NumEvents != 0U) &&
+				 (Traces[i].Events == NULL))) {
+			XAIE_ERROR("Invalid events of trace %d\n", i);
+			return XAIE_INVALID_ARGS;
+		}
+	}
+
+	for(u8 i = 0U; i < XAIE_COLLECT_MAX_TRACE_SLOTS; i++) {
+		SlotId[i] = i;
+	}
+
+	DevInst = Collect->DevInst;
+	if(DevInst->TxnInst == NULL) {
+		RC = XAie_StartTransaction(DevInst, 0U);
+		if(RC != XAIE_OK) {
+			return RC;
+		}
+		OwnTxn = 1U;
+	}
+
+	for(u32 i = 0U; i < NumTraces; i++) {
+		RC = XAie_TraceControlConfig(DevInst, Traces[i].Loc,
+				Traces[i].Module, Traces[i].StartEvent,
+				Traces[i].StopEvent, Traces[i].Mode);
+		if(RC != XAIE_OK) {
+			break;
+		}
+
+		RC = XAie_TracePktConfig(DevInst, Traces[i].Loc,
+				Traces[i].Module, Traces[i].Pkt);
+		if(RC != XAIE_OK) {
+			break;
+		}
+
+		if(Traces[i].NumEvents != 0U) {
+			RC = XAie_TraceEventList(DevInst, Traces[i].Loc,
+					Traces[i].Module, Traces[i].Events,
+					SlotId, Traces[i].NumEvents);
+			if(RC != XAIE_OK) {
+				break;
+			}
+		}
+	}
+
+	if(RC != XAIE_OK) {
+		XAIE_ERROR("Failed to configure trace\n");
+		if(OwnTxn != 0U) {
+			XAie_CancelTransaction(DevInst);
+		}
+		return RC;
+	}
+
+	if(OwnTxn != 0U) {
+		RC = XAie_SubmitTransaction(DevInst);
+	}
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API sets up the trace buffer in host memory and the S2MM channel of
+* a shim DMA which writes the trace packets routed to it into the buffer. The
+* buffer is split in NumBufs chunks of BufSize bytes, written in a ring by
+* the BDs StartBd to StartBd + NumBufs - 1 which use the locks of the same
+* IDs. The stream switch route to the channel is not configured by this API.
+*
+* @param	Collect: Collection instance pointer.
+* @param	ShimLoc: Location of the shim NOC tile.
+* @param	ChNum: S2MM channel of the shim DMA.
+* @param	StartBd: First BD of the ring.
+* @param	NumBufs: Number of chunks of the ring.
+* @param	BufSize: Size of a chunk in bytes.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_CollectTraceBufferSetup(XAie_CollectInst *Collect,
+		XAie_LocType ShimLoc, u8 ChNum, u8 StartBd, u8 NumBufs,
+		u32 BufSize)
+{
+	XAie_DevInst *DevInst;
+	const XAie_DmaMod *DmaMod;
+	XAie_MemInst *MemInst;
+	XAie_DmaDesc DmaDesc;
+	AieRC RC;
+	u8 TileType;
+	u8 NumBds = 0U;
+
+	if(Collect == NULL) {
+		XAIE_ERROR("Invalid collection instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(Collect->TraceMem != NULL) {
+		XAIE_ERROR("Trace buffer already setup\n");
+		return XAIE_ERR;
+	}
+
+	DevInst = Collect->DevInst;
+	TileType = _XAie_GetTileTypefromLoc(DevInst, ShimLoc);
+	if(TileType != XAIEGBL_TILE_TYPE_SHIMNOC) {
+		XAIE_ERROR("Invalid Tile Type\n");
+		return XAIE_INVALID_TILE;
+	}
+
+	DmaMod = DevInst->DevProp.DevMod[TileType].DmaMod;
+	if((NumBufs == 0U) || (BufSize == 0U) ||
+			((u32)StartBd + NumBufs > DmaMod->NumBds) ||
+			((u32)StartBd + NumBufs > DmaMod->NumLocks)) {
+		XAIE_ERROR("Invalid trace buffer ring\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	MemInst = XAie_MemAllocate(DevInst, (u64)BufSize * NumBufs,
+			XAIE_MEM_NONCACHEABLE);
+	if(MemInst == NULL) {
+		XAIE_ERROR("Failed to allocate trace buffer\n");
+		return XAIE_ERR;
+	}
+
+	for(u8 i = 0U; i < NumBufs; i++) {
+		u8 Bd = StartBd + i;
+
+		RC = XAie_DmaDescInit(DevInst, &DmaDesc, ShimLoc);
+		if(RC != XAIE_OK) {
+			goto free_mem;
+		}
+
+		RC = XAie_DmaSetAddrOffsetLen(&DmaDesc, MemInst,
+				(u64)BufSize * i, BufSize);
+		if(RC != XAIE_OK) {
+			goto free_mem;
+		}
+
+		RC = XAie_DmaSetLock(&DmaDesc, XAie_LockInit(Bd, 0),
+				XAie_LockInit(Bd, 1));
+		if(RC != XAIE_OK) {
+			goto free_mem;
+		}
+
+		RC = XAie_DmaSetNextBd(&DmaDesc, StartBd + (i + 1U) % NumBufs,
+				XAIE_ENABLE);
+		if(RC != XAIE_OK) {
+			goto free_mem;
+		}
+
+		RC = XAie_DmaEnableBd(&DmaDesc);
+		if(RC != XAIE_OK) {
+			goto free_mem;
+		}
+
+		RC = XAie_DmaWriteBd(DevInst, &DmaDesc, ShimLoc, Bd);
+		if(RC != XAIE_OK) {
+			goto free_mem;
+		}
+		NumBds++;
+	}
+
+	RC = XAie_DmaChannelPushBdToQueue(DevInst, ShimLoc, ChNum, DMA_S2MM,
+			StartBd);
+	if(RC != XAIE_OK) {
+		goto free_mem;
+	}
+
+	RC = XAie_DmaChannelEnable(DevInst, ShimLoc, ChNum, DMA_S2MM);
+	if(RC != XAIE_OK) {
+		goto free_mem;
+	}
+
+	Collect->TraceMem = MemInst;
+	Collect->TraceLoc = ShimLoc;
+	Collect->TraceBufSize = BufSize;
+	Collect->TraceChNum = ChNum;
+	Collect->TraceStartBd = StartBd;
+	Collect->TraceNumBufs = NumBufs;
+	Collect->TraceNextBuf = 0U;
+
+	return XAIE_OK;
+
+free_mem:
+	XAIE_ERROR("Failed to setup trace buffer\n");
+	_XAie_CollectDisableTraceBds(DevInst, MemInst, ShimLoc, StartBd, NumBds,
+			BufSize);
+	XAie_MemFree(MemInst);
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API copies the full chunks of the trace buffer, in the order they
+* were written, and gives them back to the shim DMA. It doesn't wait for
+* chunks to be filled and only copies whole chunks.
+*
+* @param	Collect: Collection instance pointer.
+* @param	Buf: Buffer to copy the trace to.
+* @param	Size: Size of Buf in bytes.
+* @param	DrainedSize: Pointer to store the number of bytes copied.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Not supported while a transaction is in progress.
+*
+******************************************************************************/
+AieRC XAie_CollectTraceDrain(XAie_CollectInst *Collect, void *Buf, u64 Size,
+		u64 *DrainedSize)
+{
+	XAie_DevInst *DevInst;
+	AieRC RC;
+	u8 *VAddr;
+
+	if((Collect == NULL) || (Buf == NULL) || (DrainedSize == NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(Collect->TraceMem == NULL) {
+		XAIE_ERROR("Trace buffer not setup\n");
+		return XAIE_ERR;
+	}
+
+	/*
+	 * The lock acquires would only be recorded by the transaction, the
+	 * chunks can't be known to be full.
+	 */
+	DevInst = Collect->DevInst;
+	if(DevInst->TxnInst != NULL) {
+		XAIE_ERROR("Trace drain not supported in a transaction\n");
+		return XAIE_ERR;
+	}
+
+	VAddr = (u8 *)XAie_MemGetVAddr(Collect->TraceMem);
+	*DrainedSize = 0U;
+	while(Size - *DrainedSize >= Collect->TraceBufSize) {
+		u8 Bd = Collect->TraceStartBd + Collect->TraceNextBuf;
+
+		if(XAie_LockAcquire(DevInst, Collect->TraceLoc,
+				XAie_LockInit(Bd, 1), 0U) != XAIE_OK) {
+			break;
+		}
+
+		XAie_MemSyncForCPU(Collect->TraceMem);
+		memcpy((u8 *)Buf + *DrainedSize, VAddr +
+				(u64)Collect->TraceBufSize *
+				Collect->TraceNextBuf, Collect->TraceBufSize);
+
+		RC = XAie_LockRelease(DevInst, Collect->TraceLoc,
+				XAie_LockInit(Bd, 0), 0U);
+		if(RC != XAIE_OK) {
+			XAIE_ERROR("Failed to release trace chunk\n");
+			return RC;
+		}
+
+		*DrainedSize += Collect->TraceBufSize;
+		Collect->TraceNextBuf = (Collect->TraceNextBuf + 1U) %
+			Collect->TraceNumBufs;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API reads all the counters of a collection instance. The commands
+* recorded by a transaction in progress are executed first.
+*
+* @param	Collect: Collection instance pointer.
+* @param	Values: Buffer to store the value of each counter.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_CollectSnapshot(XAie_CollectInst *Collect, u32 *Values)
+{
+	if((Collect == NULL) || (Values == NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(Collect->DevInst->TxnInst != NULL) {
+		_XAie_TxnFlush(Collect->DevInst);
+	}
+
+	_XAie_CollectRead(Collect, Values);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API starts the sampler thread, which takes a snapshot of the counters
+* every PeriodUs microseconds. The backend must support reads from the
+* sampler thread concurrently with the application.
+*
+* @param	Collect: Collection instance pointer.
+* @param	PeriodUs: Sampling period in microseconds.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Not supported on baremetal, nor with the SIM, CDO, DEBUG and
+*		SNAPSHOT backends, which don't support such reads.
+*
+******************************************************************************/
+AieRC XAie_CollectStart(XAie_CollectInst *Collect, u32 PeriodUs)
+{
+#ifndef __AIEBAREMETAL__
+	if((Collect == NULL) || (PeriodUs == 0U)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if((Collect->NumCounters == 0U) || (Collect->MaxSamples == 0U)) {
+		XAIE_ERROR("No counters to sample\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if((Collect->DevInst->Backend->Type == XAIE_IO_BACKEND_SIM) ||
+			(Collect->DevInst->Backend->Type == XAIE_IO_BACKEND_CDO) ||
+			(Collect->DevInst->Backend->Type == XAIE_IO_BACKEND_DEBUG) ||
+			(Collect->DevInst->Backend->Type ==
+			 XAIE_IO_BACKEND_SNAPSHOT)) {
+		XAIE_ERROR("Sampler thread not supported by the backend\n");
+		return XAIE_INVALID_BACKEND;
+	}
+
+	/* A thread being stopped must be joined before starting a new one */
+	pthread_mutex_lock(&Collect->Lock);
+	if(Collect->HasThread != 0U) {
+		pthread_mutex_unlock(&Collect->Lock);
+		XAIE_ERROR("Sampling already in progress\n");
+		return XAIE_ERR;
+	}
+	Collect->PeriodUs = PeriodUs;
+	Collect->IsRunning = 1U;
+	Collect->HasThread = 1U;
+	pthread_mutex_unlock(&Collect->Lock);
+
+	if(pthread_create(&Collect->Thread, NULL, _XAie_CollectThread,
+				Collect) != 0) {
+		XAIE_ERROR("Failed to create sampler thread\n");
+		pthread_mutex_lock(&Collect->Lock);
+		Collect->IsRunning = 0U;
+		Collect->HasThread = 0U;
+		pthread_mutex_unlock(&Collect->Lock);
+		return XAIE_ERR;
+	}
+
+	return XAIE_OK;
+#else
+	(void)Collect;
+	(void)PeriodUs;
+	XAIE_ERROR("Sampler thread not supported\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* This API stops the sampler thread. The samples taken so far are kept.
+*
+* @param	Collect: Collection instance pointer.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_CollectStop(XAie_CollectInst *Collect)
+{
+	if(Collect == NULL) {
+		XAIE_ERROR("Invalid collection instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+#ifndef __AIEBAREMETAL__
+	pthread_mutex_lock(&Collect->Lock);
+	if(Collect->IsRunning == 0U) {
+		pthread_mutex_unlock(&Collect->Lock);
+		return XAIE_OK;
+	}
+	Collect->IsRunning = 0U;
+	pthread_cond_signal(&Collect->Cond);
+	pthread_mutex_unlock(&Collect->Lock);
+
+	pthread_join(Collect->Thread, NULL);
+
+	pthread_mutex_lock(&Collect->Lock);
+	Collect->HasThread = 0U;
+	pthread_mutex_unlock(&Collect->Lock);
+#endif
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API reads and removes the oldest samples taken by the sampler thread.
+* The counter values of sample i are stored at
+* Values[i * NumCounters, (i + 1) * NumCounters).
+*
+* @param	Collect: Collection instance pointer.
+* @param	TimeStamps: Buffer to store the timestamps of the samples in us,
+*		from CLOCK_MONOTONIC. Can be NULL.
+* @param	Values: Buffer to store the counter values of the samples.
+* @param	MaxSamples: Maximum number of samples to read.
+* @param	NumSamples: Pointer to store the number of samples read.
+* @param	NumDropped: Pointer to store the number of samples dropped
+*		because the ring was full since the last call. Can be NULL.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_CollectGetSamples(XAie_CollectInst *Collect, u64 *TimeStamps,
+		u32 *Values, u32 MaxSamples, u32 *NumSamples, u32 *NumDropped)
+{
+#ifndef __AIEBAREMETAL__
+	u32 Count;
+#endif
+
+	if((Collect == NULL) || (Values == NULL) || (NumSamples == NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+#ifndef __AIEBAREMETAL__
+	pthread_mutex_lock(&Collect->Lock);
+	Count = Collect->NumSamples;
+	if(Count > MaxSamples) {
+		Count = MaxSamples;
+	}
+
+	for(u32 i = 0U; i < Count; i++) {
+		u32 Index = (Collect->SampleHead + i) % Collect->MaxSamples;
+
+		if(TimeStamps != NULL) {
+			TimeStamps[i] = Collect->SampleTime[Index];
+		}
+		memcpy(&Values[(u64)i * Collect->NumCounters],
+				&Collect->SampleBuf[(u64)Index *
+				Collect->NumCounters],
+				Collect->NumCounters * sizeof(*Values));
+	}
+
+	if(Count != 0U) {
+		Collect->SampleHead = (Collect->SampleHead + Count) %
+			Collect->MaxSamples;
+		Collect->NumSamples -= Count;
+	}
+	*NumSamples = Count;
+	if(NumDropped != NULL) {
+		*NumDropped = Collect->NumDropped;
+	}
+	Collect->NumDropped = 0U;
+	pthread_mutex_unlock(&Collect->Lock);
+#else
+	(void)TimeStamps;
+	(void)MaxSamples;
+	*NumSamples = 0U;
+	if(NumDropped != NULL) {
+		*NumDropped = 0U;
+	}
+#endif
+
+	return XAIE_OK;
+}
+
+/** @} */
@@ -0,0 +1,79 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_collect.h
+* @{
+*
+* Header file for the trace and performance counter collection service.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   agent   10/17/2026  Initial creation
+* </pre>
+*
+******************************************************************************/
+#ifndef XAIECOLLECT_H
+#define XAIECOLLECT_H
+
+/***************************** Include Files *********************************/
+#include "xaie_events.h"
+#include "xaie_trace.h"
+#include "xaiegbl.h"
+
+/**************************** Type Definitions *******************************/
+/*
+ * Typedef for a performance counter sampled by the collection service.
+ */
+typedef struct {
+	XAie_LocType Loc;	/* Location of the tile */
+	XAie_ModuleType Module;	/* Module of the counter */
+	u8 Counter;		/* Performance counter of the module */
+	XAie_Events StartEvent;	/* Event starting the counter */
+	XAie_Events StopEvent;	/* Event stopping the counter */
+} XAie_CollectCounter;
+
+/*
+ * Typedef for a trace unit configured by the collection service. Events[i]
+ * is traced in slot i of the trace unit.
+ */
+typedef struct {
+	XAie_LocType Loc;	/* Location of the tile */
+	XAie_ModuleType Module;	/* Module of the trace unit */
+	XAie_Packet Pkt;	/* Packet the trace is sent with */
+	XAie_TraceMode Mode;	/* Trace mode */
+	XAie_Events StartEvent;	/* Event starting the trace */
+	XAie_Events StopEvent;	/* Event stopping the trace */
+	XAie_Events *Events;	/* Traced events */
+	u8 NumEvents;		/* Number of traced events */
+} XAie_CollectTrace;
+
+typedef struct XAie_CollectInst XAie_CollectInst;
+
+/************************** Function Prototypes  *****************************/
+XAie_CollectInst* XAie_CollectCreate(XAie_DevInst *DevInst,
+		const XAie_CollectCounter *Counters, u32 NumCounters,
+		u32 MaxSamples);
+AieRC XAie_CollectDestroy(XAie_CollectInst *Collect);
+AieRC XAie_CollectTraceConfig(XAie_CollectInst *Collect,
+		const XAie_CollectTrace *Traces, u32 NumTraces);
+AieRC XAie_CollectTraceBufferSetup(XAie_CollectInst *Collect,
+		XAie_LocType ShimLoc, u8 ChNum, u8 StartBd, u8 NumBufs,
+		u32 BufSize);
+AieRC XAie_CollectTraceDrain(XAie_CollectInst *Collect, void *Buf, u64 Size,
+		u64 *DrainedSize);
+AieRC XAie_CollectSnapshot(XAie_CollectInst *Collect, u32 *Values);
+AieRC XAie_CollectStart(XAie_CollectInst *Collect, u32 PeriodUs);
+AieRC XAie_CollectStop(XAie_CollectInst *Collect);
+AieRC XAie_CollectGetSamples(XAie_CollectInst *Collect, u64 *TimeStamps,
+		u32 *Values, u32 MaxSamples, u32 *NumSamples, u32 *NumDropped);
+
+#endif		/* end of protection macro */
+/** @} */
@@ -26,6 +26,8 @@
 * 1.5   Tejus   06/10/2020  Add helper functions for IO backend.
 * 1.6   Nishad  07/06/2020  Add helper functions for stream switch module.
 * 1.7   Nishad  07/24/2020  Add _XAie_GetFatalGroupErrors() helper function.
+* 1.8   agent   10/17/2026  Record IO in transactions.
+* 1.9   agent   10/17/2026  Go through the shadow register cache.
 * </pre>
 *
 ******************************************************************************/
@@ -34,6 +36,8 @@
 
 /***************************** Include Files *********************************/
 #include "xaie_io.h"
+#include "xaie_shadow.h"
+#include "xaie_txn.h"
 #include "xaiegbl_regdef.h"
 
 /***************************** Macro Definitions *****************************/
@@ -76,20 +80,58 @@ static inline void XAie_Write32(XAie_DevInst *DevInst, u64 RegOff, u32 Value)
 {
 	const XAie_Backend *Backend = DevInst->Backend;
 
+	if((DevInst->ShadowInst != NULL) &&
+			(_XAie_ShadowWrite32(DevInst, RegOff, Value) != 0U)) {
+		return;
+	}
+
+	if(DevInst->TxnInst != NULL) {
+		_XAie_TxnWrite32(DevInst, RegOff, Value);
+		return;
+	}
+
 	Backend->Ops.Write32((void*)(DevInst->IOInst), RegOff, Value);
 }
 
 static inline u32 XAie_Read32(XAie_DevInst *DevInst, u64 RegOff)
 {
 	const XAie_Backend *Backend = DevInst->Backend;
+	u32 Value;
+
+	if((DevInst->ShadowInst != NULL) &&
+			(_XAie_ShadowRead32(DevInst, RegOff, &Value) != 0U)) {
+		return Value;
+	}
+
+	if(DevInst->TxnInst != NULL) {
+		_XAie_TxnFlush(DevInst);
+	}
 
-	return Backend->Ops.Read32((void*)(DevInst->IOInst), RegOff);
+	Value = Backend->Ops.Read32((void*)(DevInst->IOInst), RegOff);
+	if(DevInst->ShadowInst != NULL) {
+		_XAie_ShadowFill(DevInst, RegOff, Value);
+	}
+
+	return Value;
 }
 
 static inline void XAie_MaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
 		u32 Value)
 {
 	const XAie_Backend *Backend = DevInst->Backend;
+	u32 RegVal;
+
+	if((DevInst->ShadowInst != NULL) &&
+			(_XAie_ShadowMaskWrite32(DevInst, RegOff, Mask, Value,
+				&RegVal) != 0U)) {
+		XAie_Write32(DevInst, RegOff, RegVal);
+		return;
+	}
+
+	if(DevInst->TxnInst != NULL) {
+		_XAie_TxnMaskWrite32(DevInst, RegOff, Mask, Value);
+		return;
+	}
 
 	Backend->Ops.MaskWrite32((void *)(DevInst->IOInst), RegOff, Mask,
 			Value);
@@ -100,6 +142,11 @@ static inline u32 XAie_MaskPoll(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
 {
 	const XAie_Backend *Backend = DevInst->Backend;
 
+	if(DevInst->TxnInst != NULL) {
+		return _XAie_TxnMaskPoll(DevInst, RegOff, Mask, Value,
+				TimeOutUs);
+	}
+
 	return Backend->Ops.MaskPoll((void*)(DevInst->IOInst), RegOff, Mask,
 			Value, TimeOutUs);
 }
@@ -109,6 +156,17 @@ static inline void XAie_BlockWrite32(XAie_DevInst *DevInst, u64 RegOff,
 {
 	const XAie_Backend *Backend = DevInst->Backend;
 
+	if((DevInst->ShadowInst != NULL) &&
+			(_XAie_ShadowBlockWrite32(DevInst, RegOff, Data, Size) !=
+			 0U)) {
+		return;
+	}
+
+	if(DevInst->TxnInst != NULL) {
+		_XAie_TxnBlockWrite32(DevInst, RegOff, Data, Size);
+		return;
+	}
+
 	Backend->Ops.BlockWrite32((void *)(DevInst->IOInst), RegOff, Data,
 			Size);
 }
@@ -118,6 +176,17 @@ static inline void XAie_BlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
 {
 	const XAie_Backend *Backend = DevInst->Backend;
 
+	if((DevInst->ShadowInst != NULL) &&
+			(_XAie_ShadowBlockSet32(DevInst, RegOff, Data, Size) !=
+			 0U)) {
+		return;
+	}
+
+	if(DevInst->TxnInst != NULL) {
+		_XAie_TxnBlockSet32(DevInst, RegOff, Data, Size);
+		return;
+	}
+
 	Backend->Ops.BlockSet32((void *)(DevInst->IOInst), RegOff, Data, Size);
 }
 
@@ -126,6 +195,10 @@ static inline void XAie_CmdWrite(XAie_DevInst *DevInst, u8 Col, u8 Row,
 {
 	const XAie_Backend *Backend = DevInst->Backend;
 
+	if(DevInst->TxnInst != NULL) {
+		_XAie_TxnFlush(DevInst);
+	}
+
 	Backend->Ops.CmdWrite((void *)(DevInst->IOInst), Col, Row, Command,
 			CmdWd0, CmdWd1, CmdStr);
 }
@@ -135,6 +208,14 @@ static inline AieRC XAie_RunOp(XAie_DevInst *DevInst, XAie_BackendOpCode Op,
 {
 	const XAie_Backend *Backend = DevInst->Backend;
 
+	if(DevInst->TxnInst != NULL) {
+		_XAie_TxnFlush(DevInst);
+	}
+
+	if(DevInst->ShadowInst != NULL) {
+		_XAie_ShadowRunOp(DevInst, Op);
+	}
+
 	return Backend->Ops.RunOp(DevInst->IOInst, DevInst, Op, Arg);
 }
 
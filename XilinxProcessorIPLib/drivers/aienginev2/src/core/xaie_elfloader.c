@@ -25,16 +25,53 @@
 * 1.6   Tejus   06/03/2020  Fix compilation error for simulation.
 * 1.7   Tejus   06/10/2020  Switch to new io backend.
 * 1.8   Dishita 08/10/2020  Add calls to turn ECC on and off for PM and DM.
+* 1.9   agent   10/17/2026  Add multi tile elf loader with column workers.
+* 2.0   agent   10/17/2026  Bound the program headers and sections by the
+*                           elf size.
 * </pre>
 *
 ******************************************************************************/
 /***************************** Include Files *********************************/
 #include "xaie_elfloader.h"
 #include "xaie_ecc.h"
+
+#ifndef __AIEBAREMETAL__
+#include <pthread.h>
+#include <unistd.h>
+#endif
 /************************** Constant Definitions *****************************/
 #define XAIESIM_CMDIO_CMD_SETSTACK       0U
 #define XAIESIM_CMDIO_CMD_LOADSYM        1U
 
+/* Steps of _XAie_WriteProgramSection() */
+#define XAIE_ELF_SECT_ECC		(1U << 0)
+#define XAIE_ELF_SECT_WRITE		(1U << 1)
+#define XAIE_ELF_SECT_ALL		(XAIE_ELF_SECT_ECC | XAIE_ELF_SECT_WRITE)
+
+#define XAIE_ELF_HASH_OFFSET		0x811C9DC5U
+#define XAIE_ELF_HASH_PRIME		0x01000193U
+
+/**************************** Type Definitions *******************************/
+/* Elf image shared by the tiles of XAie_LoadElfTiles() */
+typedef struct {
+	const unsigned char *ElfMem;	/* Elf contents */
+	u64 ElfSz;			/* Size of headers and loadable sections */
+	u32 Hash;			/* Hash of the first ElfSz bytes */
+	u8 IsAllocated;			/* ElfMem is read from a file */
+} XAie_ElfImage;
+
+/* Column range written by one worker of XAie_LoadElfTiles() */
+typedef struct {
+	XAie_DevInst *DevInst;
+	const XAie_ElfTile *Tiles;
+	const XAie_ElfImage *Images;
+	const u32 *TileImage;		/* Index of the image of each tile */
+	u32 NumTiles;
+	u32 StartCol;			/* First column of the worker */
+	u32 EndCol;			/* Column after the last one */
+	AieRC RC;
+} XAie_ElfWorker;
+
 /************************** Function Definitions *****************************/
 /*****************************************************************************/
 /**
@@ -201,14 +238,18 @@ static AieRC _XAie_GetTargetTileLoc(XAie_DevInst *DevInst, XAie_LocType Loc,
 * @param	Loc: Starting location of the section.
 * @param	ProgSec: Poiner to the program section entry in the ELF buffer.
 * @param	ElfPtr: Pointer to the program header.
+* @param	Steps: XAIE_ELF_SECT_ECC to turn ECC on for the data memories
+*		of the section, XAIE_ELF_SECT_WRITE to write the section. The
+*		section is validated in both the steps.
 *
 * @return	XAIE_OK on success and error code for failure.
 *
-* @note		Internal API only.
+* @note		Internal API only. The write step only accesses the memories of
+*		the tiles, it doesn't update the device instance.
 *
 *******************************************************************************/
 static AieRC _XAie_WriteProgramSection(XAie_DevInst *DevInst, XAie_LocType Loc,
-		const unsigned char *ProgSec, const Elf32_Phdr *Phdr)
+		const unsigned char *ProgSec, const Elf32_Phdr *Phdr, u8 Steps)
 {
 	AieRC RC;
 	u32 OverFlowBytes;
@@ -240,8 +281,10 @@ static AieRC _XAie_WriteProgramSection(XAie_DevInst *DevInst, XAie_LocType Loc,
 		 * memory out of Progsec will not result in a segmentation
 		 * fault.
 		 */
-		XAie_BlockWrite32(DevInst, Addr, (u32 *)ProgSec,
-				(Phdr->p_memsz + 4U - 1U) / 4U);
+		if(Steps & XAIE_ELF_SECT_WRITE) {
+			XAie_BlockWrite32(DevInst, Addr, (u32 *)ProgSec,
+					(Phdr->p_memsz + 4U - 1U) / 4U);
+		}
 
 		return XAIE_OK;
 	}
@@ -282,7 +325,7 @@ static AieRC _XAie_WriteProgramSection(XAie_DevInst *DevInst, XAie_LocType Loc,
 			_XAie_GetTileAddr(DevInst, TgtLoc.Row, TgtLoc.Col);
 
 		/* Turn ECC On if EccStatus flag is set. */
-		if(DevInst->EccStatus) {
+		if((Steps & XAIE_ELF_SECT_ECC) && DevInst->EccStatus) {
 			RC = _XAie_EccOnDM(DevInst, TgtLoc);
 			if(RC != XAIE_OK) {
 				XAIE_ERROR("Unable to turn ECC On for Data Memory\n");
@@ -291,8 +334,10 @@ static AieRC _XAie_WriteProgramSection(XAie_DevInst *DevInst, XAie_LocType Loc,
 		}
 
 		/* ceil(number of 32bit words to write)*/
-		XAie_BlockWrite32(DevInst, Addr, (u32 *)ProgSec,
-				(BytesToWrite + 4U - 1U) / 4U);
+		if(Steps & XAIE_ELF_SECT_WRITE) {
+			XAie_BlockWrite32(DevInst, Addr, (u32 *)ProgSec,
+					(BytesToWrite + 4U - 1U) / 4U);
+		}
 
 		SectionSize -= BytesToWrite;
 		SectionAddr += BytesToWrite;
@@ -325,7 +370,7 @@ static AieRC _XAie_WriteProgramSection(XAie_DevInst *DevInst, XAie_LocType Loc,
 			_XAie_GetTileAddr(DevInst, TgtLoc.Row, TgtLoc.Col);
 
 		/* Turn ECC On if the EccStatus flag is set */
-		if(DevInst->EccStatus) {
+		if((Steps & XAIE_ELF_SECT_ECC) && DevInst->EccStatus) {
 			RC = _XAie_EccOnDM(DevInst, TgtLoc);
 			if(RC != XAIE_OK) {
 				XAIE_ERROR("Unable to turn ECC On for Data Memory\n");
@@ -334,8 +379,10 @@ static AieRC _XAie_WriteProgramSection(XAie_DevInst *DevInst, XAie_LocType Loc,
 		}
 
 		/* ceil(number of 32bit words to write)*/
-		XAie_BlockSet32(DevInst, Addr, 0U,
-				(BytesToWrite + 4U - 1U) / 4U);
+		if(Steps & XAIE_ELF_SECT_WRITE) {
+			XAie_BlockSet32(DevInst, Addr, 0U,
+					(BytesToWrite + 4U - 1U) / 4U);
+		}
 
 		SectionSize -= BytesToWrite;
 		SectionAddr += BytesToWrite;
@@ -344,6 +391,48 @@ static AieRC _XAie_WriteProgramSection(XAie_DevInst *DevInst, XAie_LocType Loc,
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This routine goes through the loadable program sections of the elf and runs
+* the given steps of _XAie_WriteProgramSection() for each of them.
+*
+* @param	DevInst: Device Instance.
+* @param	Loc: Location of AIE Tile.
+* @param	ElfMem: Pointer to the Elf contents in memory.
+* @param	Steps: Steps of _XAie_WriteProgramSection() to run.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		Internal API only.
+*
+*******************************************************************************/
+static AieRC _XAie_LoadProgramSections(XAie_DevInst *DevInst, XAie_LocType Loc,
+		const unsigned char *ElfMem, u8 Steps)
+{
+	AieRC RC;
+	const Elf32_Ehdr *Ehdr;
+	const Elf32_Phdr *Phdr;
+	const unsigned char *SectionPtr;
+
+	Ehdr = (const Elf32_Ehdr *) ElfMem;
+	for(u16 phnum = 0U; phnum < Ehdr->e_phnum; phnum++) {
+		Phdr = (const Elf32_Phdr*) (ElfMem + Ehdr->e_phoff +
+			phnum * Ehdr->e_phentsize);
+		_XAie_PrintProgSectHdr(Phdr);
+		if(Phdr->p_type == PT_LOAD) {
+			SectionPtr = ElfMem + Phdr->p_offset;
+			RC = _XAie_WriteProgramSection(DevInst, Loc,
+					SectionPtr, Phdr, Steps);
+			if(RC != XAIE_OK) {
+				return RC;
+			}
+		}
+	}
+
+	return XAIE_OK;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -365,8 +454,6 @@ AieRC XAie_LoadElfMem(XAie_DevInst *DevInst, XAie_LocType Loc,
 {
 	AieRC RC;
 	Elf32_Ehdr *Ehdr;
-	Elf32_Phdr *Phdr;
-	const unsigned char *SectionPtr;
 	u8 TileType;
 
 	if((DevInst == XAIE_NULL) || (ElfMem == XAIE_NULL) ||
@@ -390,18 +477,10 @@ AieRC XAie_LoadElfMem(XAie_DevInst *DevInst, XAie_LocType Loc,
 		_XAie_EccEvntResetPM(DevInst, Loc);
 	}
 
-	for(u8 phnum = 0U; phnum < Ehdr->e_phnum; phnum++) {
-		Phdr = (Elf32_Phdr*) (ElfMem + sizeof(*Ehdr) +
-			phnum * sizeof(*Phdr));
-		_XAie_PrintProgSectHdr(Phdr);
-		if(Phdr->p_type == PT_LOAD) {
-			SectionPtr = ElfMem + Phdr->p_offset;
-			RC = _XAie_WriteProgramSection(DevInst, Loc,
-					SectionPtr, Phdr);
-			if(RC != XAIE_OK) {
-				return RC;
-			}
-		}
+	RC = _XAie_LoadProgramSections(DevInst, Loc, ElfMem,
+			XAIE_ELF_SECT_ALL);
+	if(RC != XAIE_OK) {
+		return RC;
 	}
 
 	/* Turn ECC On after program memory load */
@@ -470,6 +549,145 @@ static u32 XAieSim_GetStackRange(const char *MapPtr,
 }
 #endif
 
+/*****************************************************************************/
+/**
+*
+* This routine reads the entire elf file into memory.
+*
+* @param	ElfPtr: Path to the elf file.
+* @param	ElfMem: Pointer to return the elf contents. The buffer is
+*		allocated by this routine and has to be freed by the caller.
+* @param	ElfSz: Pointer to return the size of the elf.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		Internal API only.
+*
+*******************************************************************************/
+static AieRC _XAie_ReadElfFile(const char *ElfPtr, unsigned char **ElfMem,
+		u64 *ElfSz)
+{
+	FILE *Fd;
+	int Ret;
+	long Size;
+	unsigned char *Mem;
+
+	Fd = fopen(ElfPtr, "r");
+	if(Fd == XAIE_NULL) {
+		XAIE_ERROR("Unable to open elf file\n");
+		return XAIE_INVALID_ELF;
+	}
+
+	/* Get the file size of the elf */
+	Ret = fseek(Fd, 0L, SEEK_END);
+	Size = ftell(Fd);
+	if((Ret != 0) || (Size <= 0L)) {
+		XAIE_ERROR("Failed to get end of file\n");
+		fclose(Fd);
+		return XAIE_INVALID_ELF;
+	}
+
+	rewind(Fd);
+	XAIE_DBG("Elf size is %ld bytes\n", Size);
+
+	/* Read entire elf file into memory */
+	Mem = (unsigned char*) malloc((size_t)Size);
+	if(Mem == NULL) {
+		XAIE_ERROR("Memory allocation failed\n");
+		fclose(Fd);
+		return XAIE_ERR;
+	}
+
+	Ret = fread((void*)Mem, (size_t)Size, 1U, Fd);
+	fclose(Fd);
+	if(Ret == 0) {
+		XAIE_ERROR("Failed to read Elf into memory\n");
+		free(Mem);
+		return XAIE_ERR;
+	}
+
+	*ElfMem = Mem;
+	*ElfSz = (u64)Size;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine checks that the headers and the loadable sections of the elf are
+* within the elf and returns the size of the part used by the loader.
+*
+* @param	DevInst: Device Instance.
+* @param	ElfMem: Pointer to the Elf contents in memory.
+* @param	FileSz: Size of the elf in bytes.
+* @param	ElfSz: Pointer to return the size used by the loader.
+*
+* @return	XAIE_OK on success and XAIE_INVALID_ELF for failure.
+*
+* @note		The sections are written in 32bit words, program memory
+*		sections up to their memory size. Internal API only.
+*
+*******************************************************************************/
+static AieRC _XAie_GetElfImageSize(XAie_DevInst *DevInst,
+		const unsigned char *ElfMem, u64 FileSz, u64 *ElfSz)
+{
+	const XAie_CoreMod *CoreMod;
+	const Elf32_Ehdr *Ehdr;
+	const Elf32_Phdr *Phdr;
+	u64 SectEnd;
+	u64 Size;
+
+	CoreMod = DevInst->DevProp.DevMod[XAIEGBL_TILE_TYPE_AIETILE].CoreMod;
+
+	Ehdr = (const Elf32_Ehdr *) ElfMem;
+	if((FileSz < sizeof(*Ehdr)) ||
+			(memcmp(Ehdr->e_ident, ELFMAG, SELFMAG) != 0) ||
+			(Ehdr->e_ident[EI_CLASS] != ELFCLASS32)) {
+		XAIE_ERROR("Invalid elf header\n");
+		return XAIE_INVALID_ELF;
+	}
+
+	Size = (u64)Ehdr->e_phoff + (u64)Ehdr->e_phnum * Ehdr->e_phentsize;
+	if(((Ehdr->e_phnum != 0U) &&
+			(Ehdr->e_phentsize != sizeof(*Phdr))) ||
+			(Size > FileSz)) {
+		XAIE_ERROR("Invalid elf program headers\n");
+		return XAIE_INVALID_ELF;
+	}
+	if(Size < sizeof(*Ehdr)) {
+		Size = sizeof(*Ehdr);
+	}
+
+	for(u16 phnum = 0U; phnum < Ehdr->e_phnum; phnum++) {
+		Phdr = (const Elf32_Phdr*) (ElfMem + Ehdr->e_phoff +
+			phnum * Ehdr->e_phentsize);
+		if(Phdr->p_type != PT_LOAD) {
+			continue;
+		}
+
+		if(Phdr->p_paddr < CoreMod->ProgMemSize) {
+			SectEnd = (u64)Phdr->p_offset +
+				(((u64)Phdr->p_memsz + 3U) & ~(u64)3U);
+		} else {
+			SectEnd = (u64)Phdr->p_offset +
+				(((u64)Phdr->p_filesz + 3U) & ~(u64)3U);
+		}
+		if((Phdr->p_filesz > Phdr->p_memsz) || (SectEnd > FileSz)) {
+			XAIE_ERROR("Invalid section at offset 0x%x\n",
+					Phdr->p_offset);
+			return XAIE_INVALID_ELF;
+		}
+		if(SectEnd > Size) {
+			Size = SectEnd;
+		}
+	}
+
+	*ElfSz = Size;
+
+	return XAIE_OK;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -490,8 +708,6 @@ static u32 XAieSim_GetStackRange(const char *MapPtr,
 AieRC XAie_LoadElf(XAie_DevInst *DevInst, XAie_LocType Loc, const char *ElfPtr,
 		u8 LoadSym)
 {
-	FILE *Fd;
-	int Ret;
 	unsigned char *ElfMem;
 	u8 TileType;
 	u64 ElfSz;
@@ -554,46 +770,445 @@ AieRC XAie_LoadElf(XAie_DevInst *DevInst, XAie_LocType Loc, const char *ElfPtr,
 	}
 #endif
 	(void)LoadSym;
-	Fd = fopen(ElfPtr, "r");
-	if(Fd == XAIE_NULL) {
-		XAIE_ERROR("Unable to open elf file\n");
-		return XAIE_INVALID_ELF;
+	RC = _XAie_ReadElfFile(ElfPtr, &ElfMem, &ElfSz);
+	if(RC != XAIE_OK) {
+		return RC;
 	}
 
-	/* Get the file size of the elf */
-	Ret = fseek(Fd, 0L, SEEK_END);
-	if(Ret != 0U) {
-		XAIE_ERROR("Failed to get end of file\n");
-		return XAIE_INVALID_ELF;
+	RC = _XAie_GetElfImageSize(DevInst, ElfMem, ElfSz, &ElfSz);
+	if(RC != XAIE_OK) {
+		free(ElfMem);
+		return RC;
 	}
 
-	ElfSz = ftell(Fd);
-	rewind(Fd);
-	XAIE_DBG("Elf size is %ld bytes\n", ElfSz);
+	RC = XAie_LoadElfMem(DevInst, Loc, ElfMem);
+	if(RC != XAIE_OK) {
+		free(ElfMem);
+		return RC;
+	}
 
-	/* Read entire elf file into memory */
-	ElfMem = (unsigned char*) malloc(ElfSz);
-	if(ElfMem == NULL) {
-		XAIE_ERROR("Memory allocation failed\n");
-		return XAIE_ERR;
+	free(ElfMem);
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine computes the FNV-1a hash of a buffer.
+*
+* @param	Data: Pointer to the buffer.
+* @param	Size: Size of the buffer in bytes.
+*
+* @return	Hash of the buffer.
+*
+* @note		Internal API only.
+*
+*******************************************************************************/
+static u32 _XAie_ElfHash(const unsigned char *Data, u64 Size)
+{
+	u32 Hash = XAIE_ELF_HASH_OFFSET;
+
+	for(u64 i = 0U; i < Size; i++) {
+		Hash = (Hash ^ Data[i]) * XAIE_ELF_HASH_PRIME;
 	}
 
-	Ret = fread((void*)ElfMem, ElfSz, 1U, Fd);
-	if(Ret == 0U) {
-		XAIE_ERROR("Failed to read Elf into memory\n");
-		return XAIE_ERR;
+	return Hash;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine finds the elf image of a tile. Tiles with the same elf path or
+* the same elf buffer share the image without reading it again, and elfs with
+* identical contents are kept only once.
+*
+* @param	DevInst: Device Instance.
+* @param	Tiles: Array of the tiles to load.
+* @param	TileId: Index of the tile in Tiles.
+* @param	Images: Array of the images found so far.
+* @param	TileImage: Index of the image of the previous tiles.
+* @param	NumImages: Pointer to the number of images, updated when a new
+*		image is added.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		Internal API only.
+*
+*******************************************************************************/
+static AieRC _XAie_GetElfImage(XAie_DevInst *DevInst,
+		const XAie_ElfTile *Tiles, u32 TileId, XAie_ElfImage *Images,
+		u32 *TileImage, u32 *NumImages)
+{
+	AieRC RC;
+	const XAie_ElfTile *Tile = &Tiles[TileId];
+	unsigned char *FileMem = XAIE_NULL;
+	const unsigned char *ElfMem;
+	u64 FileSz = 0U;
+	u64 ElfSz;
+	u32 Hash;
+
+	for(u32 i = 0U; i < TileId; i++) {
+		if(((Tile->ElfPath != XAIE_NULL) &&
+				(Tiles[i].ElfPath != XAIE_NULL) &&
+				(strcmp(Tile->ElfPath, Tiles[i].ElfPath) == 0)) ||
+			((Tile->ElfPath == XAIE_NULL) &&
+				(Tiles[i].ElfPath == XAIE_NULL) &&
+				(Tile->ElfMem == Tiles[i].ElfMem))) {
+			TileImage[TileId] = TileImage[i];
+			return XAIE_OK;
+		}
 	}
 
-	fclose(Fd);
+	if(Tile->ElfPath != XAIE_NULL) {
+		RC = _XAie_ReadElfFile(Tile->ElfPath, &FileMem, &FileSz);
+		if(RC != XAIE_OK) {
+			return RC;
+		}
+		ElfMem = FileMem;
+	} else {
+		ElfMem = Tile->ElfMem;
+		FileSz = Tile->ElfMemSz;
+	}
 
-	RC = XAie_LoadElfMem(DevInst, Loc, ElfMem);
+	RC = _XAie_GetElfImageSize(DevInst, ElfMem, FileSz, &ElfSz);
 	if(RC != XAIE_OK) {
-		free(ElfMem);
+		XAIE_ERROR("Invalid elf for tile (%d, %d)\n", Tile->Loc.Col,
+				Tile->Loc.Row);
+		free(FileMem);
 		return RC;
 	}
 
-	free(ElfMem);
+	Hash = _XAie_ElfHash(ElfMem, ElfSz);
+	for(u32 i = 0U; i < *NumImages; i++) {
+		if((Images[i].Hash == Hash) && (Images[i].ElfSz == ElfSz) &&
+				(memcmp(Images[i].ElfMem, ElfMem, ElfSz) == 0)) {
+			free(FileMem);
+			TileImage[TileId] = i;
+			return XAIE_OK;
+		}
+	}
+
+	Images[*NumImages].ElfMem = ElfMem;
+	Images[*NumImages].ElfSz = ElfSz;
+	Images[*NumImages].Hash = Hash;
+	Images[*NumImages].IsAllocated = (FileMem != XAIE_NULL) ? 1U : 0U;
+	TileImage[TileId] = *NumImages;
+	(*NumImages)++;
+
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This routine writes the program sections of the tiles in the column range of
+* a worker. It can run in parallel with the other workers as the section
+* writes only access the tile memories.
+*
+* @param	Arg: Pointer to the XAie_ElfWorker of the worker.
+*
+* @return	NULL. The status is returned in the worker.
+*
+* @note		Internal API only.
+*
+*******************************************************************************/
+static void *_XAie_ElfWorkerRun(void *Arg)
+{
+	XAie_ElfWorker *Worker = (XAie_ElfWorker *)Arg;
+	const XAie_ElfImage *Image;
+	XAie_LocType Loc;
+
+	Worker->RC = XAIE_OK;
+	for(u32 i = 0U; i < Worker->NumTiles; i++) {
+		Loc = Worker->Tiles[i].Loc;
+		if((Loc.Col < Worker->StartCol) || (Loc.Col >= Worker->EndCol)) {
+			continue;
+		}
+
+		Image = &Worker->Images[Worker->TileImage[i]];
+		Worker->RC = _XAie_LoadProgramSections(Worker->DevInst, Loc,
+				Image->ElfMem, XAIE_ELF_SECT_WRITE);
+		if(Worker->RC != XAIE_OK) {
+			break;
+		}
+	}
+
+	return XAIE_NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine runs the workers writing the tiles. The columns of the tiles are
+* split in contiguous ranges, one per worker. The workers run in parallel if the
+* backend supports accesses from multiple threads, in the calling thread
+* otherwise.
+*
+* @param	DevInst: Device Instance.
+* @param	Tiles: Array of the tiles to load.
+* @param	NumTiles: Number of tiles.
+* @param	Images: Array of the elf images.
+* @param	TileImage: Index of the image of each tile.
+* @param	NumWorkers: Number of workers requested, 0 for one worker per
+*		online cpu.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		Internal API only.
+*
+*******************************************************************************/
+static AieRC _XAie_RunElfWorkers(XAie_DevInst *DevInst,
+		const XAie_ElfTile *Tiles, u32 NumTiles,
+		const XAie_ElfImage *Images, const u32 *TileImage,
+		u32 NumWorkers)
+{
+	XAie_ElfWorker Serial;
+	u32 StartCol = DevInst->NumCols;
+	u32 EndCol = 0U;
+
+	for(u32 i = 0U; i < NumTiles; i++) {
+		if(Tiles[i].Loc.Col < StartCol) {
+			StartCol = Tiles[i].Loc.Col;
+		}
+		if(Tiles[i].Loc.Col >= EndCol) {
+			EndCol = Tiles[i].Loc.Col + 1U;
+		}
+	}
+
+	Serial.DevInst = DevInst;
+	Serial.Tiles = Tiles;
+	Serial.Images = Images;
+	Serial.TileImage = TileImage;
+	Serial.NumTiles = NumTiles;
+	Serial.StartCol = StartCol;
+	Serial.EndCol = EndCol;
+
+#ifndef __AIEBAREMETAL__
+	XAie_ElfWorker *Workers;
+	pthread_t *Threads;
+	u8 *IsRunning;
+	AieRC RC = XAIE_OK;
+
+	/*
+	 * The simulation and cdo backends are sequential, the snapshot
+	 * backend records into a single buffer, and the transactions and the
+	 * shadow register cache are kept in the device instance without a
+	 * lock, so these are written from the calling thread.
+	 */
+	if((DevInst->Backend->Type == XAIE_IO_BACKEND_SIM) ||
+			(DevInst->Backend->Type == XAIE_IO_BACKEND_CDO) ||
+			(DevInst->Backend->Type == XAIE_IO_BACKEND_BAREMETAL) ||
+			(DevInst->Backend->Type == XAIE_IO_BACKEND_SNAPSHOT) ||
+			(DevInst->TxnInst != XAIE_NULL) ||
+			(DevInst->ShadowInst != XAIE_NULL)) {
+		NumWorkers = 1U;
+	} else if(NumWorkers == 0U) {
+		long NumCpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+		NumWorkers = (NumCpus > 0L) ? (u32)NumCpus : 1U;
+	}
+
+	if(NumWorkers > EndCol - StartCol) {
+		NumWorkers = EndCol - StartCol;
+	}
+
+	if(NumWorkers > 1U) {
+		Workers = (XAie_ElfWorker *)malloc(NumWorkers *
+				sizeof(*Workers));
+		Threads = (pthread_t *)malloc(NumWorkers * sizeof(*Threads));
+		IsRunning = (u8 *)calloc(NumWorkers, sizeof(*IsRunning));
+		if((Workers == XAIE_NULL) || (Threads == XAIE_NULL) ||
+				(IsRunning == XAIE_NULL)) {
+			XAIE_DBG("No memory for workers, loading serially\n");
+			free(Workers);
+			free(Threads);
+			free(IsRunning);
+			NumWorkers = 1U;
+		}
+	}
+
+	if(NumWorkers > 1U) {
+		for(u32 w = 0U; w < NumWorkers; w++) {
+			Workers[w] = Serial;
+			Workers[w].StartCol = StartCol +
+				w * (EndCol - StartCol) / NumWorkers;
+			Workers[w].EndCol = StartCol +
+				(w + 1U) * (EndCol - StartCol) / NumWorkers;
+			if(pthread_create(&Threads[w], NULL, _XAie_ElfWorkerRun,
+						&Workers[w]) == 0) {
+				IsRunning[w] = 1U;
+			}
+		}
+
+		for(u32 w = 0U; w < NumWorkers; w++) {
+			if(IsRunning[w] == 1U) {
+				pthread_join(Threads[w], NULL);
+			} else {
+				/* Thread could not be created, write here */
+				_XAie_ElfWorkerRun(&Workers[w]);
+			}
+			if((RC == XAIE_OK) && (Workers[w].RC != XAIE_OK)) {
+				RC = Workers[w].RC;
+			}
+		}
+
+		free(Workers);
+		free(Threads);
+		free(IsRunning);
+
+		return RC;
+	}
+#else
+	(void)NumWorkers;
+#endif
+
+	_XAie_ElfWorkerRun(&Serial);
+
+	return Serial.RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function loads the elfs of multiple AIE tiles. Each elf is read and
+* parsed once, even if it is used by multiple tiles or given for multiple tiles
+* with different paths or buffers with identical contents. The tile memories
+* are then written in parallel by the workers, each of them owning a contiguous
+* range of columns.
+*
+* All the tiles and elfs are validated before any tile memory is written. The
+* ECC state of the device instance is updated from the calling thread, before
+* and after the parallel writes, in the order of the tiles.
+*
+* @param	DevInst: Device Instance.
+* @param	Tiles: Array of the tiles to load with their elf.
+* @param	NumTiles: Number of tiles in the array.
+* @param	NumWorkers: Maximum number of workers writing the tiles, 0 for
+*		one worker per online cpu.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		The tiles are written from the calling thread with the
+*		simulation, cdo, baremetal and snapshot backends, when a
+*		transaction is open and when the shadow register cache is
+*		enabled. The data memory sections of a tile can be in the
+*		memory of its neighbour tiles, including the neighbour columns.
+*		The elfs of the tiles are expected not to overlap there, as the
+*		order of the writes to a memory shared by two workers is not
+*		defined. In simulation, XAie_LoadElf() is to be used to set
+*		the stack range and load the symbols of the elf.
+*
+*******************************************************************************/
+AieRC XAie_LoadElfTiles(XAie_DevInst *DevInst, const XAie_ElfTile *Tiles,
+		u32 NumTiles, u32 NumWorkers)
+{
+	AieRC RC = XAIE_OK;
+	XAie_ElfImage *Images;
+	u32 *TileImage;
+	u32 NumImages = 0U;
+	u8 TileType;
+
+	if((DevInst == XAIE_NULL) || (Tiles == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	for(u32 i = 0U; i < NumTiles; i++) {
+		if((Tiles[i].ElfPath == XAIE_NULL) &&
+				((Tiles[i].ElfMem == XAIE_NULL) ||
+				 (Tiles[i].ElfMemSz == 0U))) {
+			XAIE_ERROR("Invalid elf for tile %d\n", i);
+			return XAIE_INVALID_ARGS;
+		}
+
+		TileType = _XAie_GetTileTypefromLoc(DevInst, Tiles[i].Loc);
+		if(TileType != XAIEGBL_TILE_TYPE_AIETILE) {
+			XAIE_ERROR("Invalid tile type\n");
+			return XAIE_INVALID_TILE;
+		}
+	}
+
+	if(NumTiles == 0U) {
+		return XAIE_OK;
+	}
+
+	Images = (XAie_ElfImage *)calloc(NumTiles, sizeof(*Images));
+	TileImage = (u32 *)malloc(NumTiles * sizeof(*TileImage));
+	if((Images == XAIE_NULL) || (TileImage == XAIE_NULL)) {
+		XAIE_ERROR("Memory allocation failed\n");
+		RC = XAIE_ERR;
+		goto free_images;
+	}
+
+	/* Read and parse each elf once */
+	for(u32 i = 0U; i < NumTiles; i++) {
+		RC = _XAie_GetElfImage(DevInst, Tiles, i, Images, TileImage,
+				&NumImages);
+		if(RC != XAIE_OK) {
+			goto free_images;
+		}
+	}
+	XAIE_DBG("Loading %d tiles with %d elf images\n", NumTiles,
+			NumImages);
+
+	/* Validate the sections of every tile before writing any of them */
+	for(u32 i = 0U; i < NumTiles; i++) {
+		RC = _XAie_LoadProgramSections(DevInst, Tiles[i].Loc,
+				Images[TileImage[i]].ElfMem, 0U);
+		if(RC != XAIE_OK) {
+			goto free_images;
+		}
+	}
+
+	/*
+	 * The ECC state of the device instance is shared by all the tiles, so
+	 * it is only updated from here. For AIE, turn ECC Off before program
+	 * memory load.
+	 */
+	for(u32 i = 0U; i < NumTiles; i++) {
+		if((DevInst->DevProp.DevGen == XAIE_DEV_GEN_AIE) &&
+				(DevInst->EccStatus == XAIE_ENABLE)) {
+			_XAie_EccEvntResetPM(DevInst, Tiles[i].Loc);
+		}
+
+		RC = _XAie_LoadProgramSections(DevInst, Tiles[i].Loc,
+				Images[TileImage[i]].ElfMem, XAIE_ELF_SECT_ECC);
+		if(RC != XAIE_OK) {
+			goto free_images;
+		}
+	}
+
+	RC = _XAie_RunElfWorkers(DevInst, Tiles, NumTiles, Images, TileImage,
+			NumWorkers);
+	if(RC != XAIE_OK) {
+		goto free_images;
+	}
+
+	/* Turn ECC On after program memory load */
+	if(DevInst->EccStatus) {
+		for(u32 i = 0U; i < NumTiles; i++) {
+			RC = _XAie_EccOnPM(DevInst, Tiles[i].Loc);
+			if(RC != XAIE_OK) {
+				XAIE_ERROR("Unable to turn ECC On for Program "
+						"Memory\n");
+				goto free_images;
+			}
+		}
+	}
+
+free_images:
+	if(Images != XAIE_NULL) {
+		for(u32 i = 0U; i < NumImages; i++) {
+			if(Images[i].IsAllocated == 1U) {
+				free((void *)Images[i].ElfMem);
+			}
+		}
+	}
+	free(Images);
+	free(TileImage);
+
+	return RC;
+}
+
 /** @} */
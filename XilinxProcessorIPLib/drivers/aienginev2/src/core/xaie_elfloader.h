@@ -19,6 +19,7 @@
 * 1.0   Tejus   09/24/2019  Initial creation
 * 1.1   Tejus   03/20/2020  Remove range apis
 * 1.2   Tejus   05/26/2020  Add API to load elf from memory.
+* 1.3   agent   10/17/2026  Add API to load the elfs of multiple tiles.
 * </pre>
 *
 ******************************************************************************/
@@ -41,11 +42,25 @@ typedef struct {
 	u32 start;	/**< Stack start address */
 	u32 end;	/**< Stack end address */
 } XAieSim_StackSz;
+
+/*
+ * Tile to load with XAie_LoadElfTiles(). The elf is read from ElfPath, or
+ * from the ElfMemSz bytes at ElfMem if ElfPath is NULL.
+ */
+typedef struct {
+	XAie_LocType Loc;		/**< Location of AIE Tile */
+	const char *ElfPath;		/**< Path to the elf file */
+	const unsigned char *ElfMem;	/**< Elf contents in memory */
+	u64 ElfMemSz;			/**< Size of ElfMem in bytes */
+} XAie_ElfTile;
+
 /************************** Function Prototypes  *****************************/
 
 AieRC XAie_LoadElf(XAie_DevInst *DevInst, XAie_LocType Loc, const char *ElfPtr,
 		u8 LoadSym);
 AieRC XAie_LoadElfMem(XAie_DevInst *DevInst, XAie_LocType Loc,
 		const unsigned char* ElfMem);
+AieRC XAie_LoadElfTiles(XAie_DevInst *DevInst, const XAie_ElfTile *Tiles,
+		u32 NumTiles, u32 NumWorkers);
 #endif		/* end of protection macro */
 /** @} */
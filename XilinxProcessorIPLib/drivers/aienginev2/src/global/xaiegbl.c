@@ -24,6 +24,10 @@
 * 1.4   Dishita 07/28/2020  Add api to turn ECC On and Off.
 * 1.5   Nishad  09/15/2020  Add check to validate XAie_MemCacheProp value in
 *			    XAie_MemAllocate().
+* 1.6   agent   10/17/2026  Drop unsubmitted transaction in XAie_Finish and
+*			    don't switch backend within a transaction.
+* 1.7   agent   10/17/2026  Free the shadow register cache in XAie_Finish and
+*			    invalidate it when switching backend.
 * </pre>
 *
 ******************************************************************************/
@@ -137,6 +141,13 @@ AieRC XAie_Finish(XAie_DevInst *DevInst)
 		return XAIE_INVALID_ARGS;
 	}
 
+	if(DevInst->TxnInst != NULL) {
+		XAIE_ERROR("Dropping transaction which is not submitted\n");
+		XAie_CancelTransaction(DevInst);
+	}
+
+	XAie_ShadowCacheDisable(DevInst);
+
 	CurrBackend = DevInst->Backend;
 	RC = CurrBackend->Ops.Finish(DevInst->IOInst);
 	if (RC != XAIE_OK) {
@@ -178,6 +189,11 @@ AieRC XAie_SetIOBackend(XAie_DevInst *DevInst, XAie_BackendType Backend)
 		return XAIE_INVALID_ARGS;
 	}
 
+	if(DevInst->TxnInst != NULL) {
+		XAIE_ERROR("Can't switch backend within a transaction\n");
+		return XAIE_ERR;
+	}
+
 	/* Release resources for current backend */
 	CurrBackend = DevInst->Backend;
 	RC = CurrBackend->Ops.Finish((void *)(DevInst->IOInst));
@@ -199,6 +215,7 @@ AieRC XAie_SetIOBackend(XAie_DevInst *DevInst, XAie_BackendType Backend)
 
 	XAIE_DBG("Switching backend to %d\n", Backend);
 	DevInst->Backend = NewBackend;
+	_XAie_ShadowInvalidate(DevInst);
 
 	return XAIE_OK;
 }
@@ -33,6 +33,9 @@
 * 2.1   Tejus   06/10/2020  Add IO backend data structures.
 * 2.2   Tejus   06/10/2020  Add ess simulation backend.
 * 2.3   Tejus   06/10/2020  Add api to change backend at runtime.
+* 2.4   agent   10/17/2026  Add transaction instance to device instance.
+* 2.5   agent   10/17/2026  Add snapshot backend.
+* 2.6   agent   10/17/2026  Add shadow register cache to device instance.
 * </pre>
 *
 ******************************************************************************/
@@ -54,6 +57,8 @@ typedef struct XAie_TileMod XAie_TileMod;
 typedef struct XAie_DmaMod XAie_DmaMod;
 typedef struct XAie_LockMod XAie_LockMod;
 typedef struct XAie_Backend XAie_Backend;
+typedef struct XAie_TxnInst XAie_TxnInst;
+typedef struct XAie_ShadowInst XAie_ShadowInst;
 
 /*
  * This typedef captures all the properties of a AIE Device
@@ -75,6 +80,7 @@ typedef enum {
 	XAIE_IO_BACKEND_BAREMETAL, /* Baremetal backend */
 	XAIE_IO_BACKEND_DEBUG, /* IO debug backend */
 	XAIE_IO_BACKEND_LINUX, /* Linux kernel backend */
+	XAIE_IO_BACKEND_SNAPSHOT, /* Snapshot recording backend */
 	XAIE_IO_BACKEND_MAX
 } XAie_BackendType;
 
@@ -114,6 +120,9 @@ typedef struct {
 	u32 CoreInUse[XAIE_TILES_BITMAP_SIZE];/* Bitmap for ECC status of PM */
 	const XAie_Backend *Backend; /* Backend IO properties */
 	void *IOInst;	       /* IO Instance for the backend */
+	XAie_TxnInst *TxnInst; /* Transaction in progress, NULL if none */
+	XAie_ShadowInst *ShadowInst; /* Shadow register cache, NULL if
+					disabled */
 	XAie_DevProp DevProp; /* Pointer to the device property. To be
 				     setup to AIE prop during intialization*/
 	XAie_PartitionProp PartProp; /* Partition property */
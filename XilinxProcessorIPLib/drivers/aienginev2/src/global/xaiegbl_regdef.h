@@ -41,6 +41,7 @@
 * 2.8   Nishad 07/21/2020  Add data structure for interrupt controller.
 * 2.9   Nishad 07/24/2020  Add event property to capture default group error
 *			   mask.
+* 3.0   agent  10/17/2026  Add data structures for shadow register cache.
 * </pre>
 *
 ******************************************************************************/
@@ -599,6 +600,30 @@ typedef struct XAie_L2IntrMod {
 	u8 NumNoCIntr;
 } XAie_L2IntrMod;
 
+/*
+ * This structure captures a set of configuration registers which can be kept
+ * in the shadow register cache. The set is NumRepeats blocks of NumRegs
+ * contiguous registers, the first one at RegOff and the blocks Stride bytes
+ * apart.
+ */
+typedef struct XAie_RegRange {
+	u32 RegOff;
+	u32 Stride;
+	u16 NumRegs;
+	u16 NumRepeats;
+} XAie_RegRange;
+
+/*
+ * This structure captures the registers of a tile type which hold
+ * configuration only, so that the last value written to them is the value in
+ * hardware. Status, counter and action registers are not part of it. The
+ * ranges are sorted by offset.
+ */
+typedef struct XAie_ShadowMod {
+	const XAie_RegRange *Ranges;
+	u8 NumRanges;
+} XAie_ShadowMod;
+
 /*
  * This typedef contains all the modules for a Tile type
  */
@@ -616,6 +641,7 @@ typedef struct XAie_TileMod {
 	const XAie_ClockMod *ClockMod;
 	const XAie_L1IntrMod *L1IntrMod;
 	const XAie_L2IntrMod *L2IntrMod;
+	const XAie_ShadowMod *ShadowMod;
 } XAie_TileMod;
 
 #endif
@@ -49,6 +49,8 @@
 *			    register properties
 * 3.3   Nishad  07/21/2020  Populate interrupt controller data structure.
 * 3.4   Nishad  07/24/2020  Populate value of default group error mask.
+* 3.5   agent   10/17/2026  Populate configuration registers for shadow
+*			    register cache.
 * </pre>
 *
 ******************************************************************************/
@@ -67,6 +69,16 @@
 /**************************** Type Definitions *******************************/
 
 /**************************** Macro Definitions ******************************/
+/* Range of contiguous registers from Start to End, both included */
+#define XAIE_REG_RANGE(Start, End) \
+	{ .RegOff = (Start), .Stride = 0U, \
+	  .NumRegs = (u16)((((End) - (Start)) / 4U) + 1U), .NumRepeats = 1U }
+
+/* Rep blocks of Num registers from Start, Off bytes apart */
+#define XAIE_REG_RANGE_REP(Start, Num, Off, Rep) \
+	{ .RegOff = (Start), .Stride = (Off), .NumRegs = (Num), \
+	  .NumRepeats = (Rep) }
+
 
 /************************** Variable Definitions *****************************/
 /*
@@ -2836,6 +2848,127 @@ static const XAie_L2IntrMod AieNoCL2IntrMod =
 	.NumNoCIntr = 4U,
 };
 
+/*
+ * Configuration registers of XAIEGBL_TILE_TYPE_AIETILE tiles for the shadow
+ * register cache. The timer and dma channel control registers are left out
+ * as they have self clearing reset bits, and so are all the status, counter,
+ * event generate and broadcast block registers.
+ */
+static const XAie_RegRange AieTileShadowRanges[] =
+{
+	XAIE_REG_RANGE(XAIEGBL_MEM_PERCTRL0, XAIEGBL_MEM_PERCTRL1),
+	XAIE_REG_RANGE(XAIEGBL_MEM_PERCOU0EVTVAL, XAIEGBL_MEM_PERCOU1EVTVAL),
+	XAIE_REG_RANGE(XAIEGBL_MEM_EVTBRDCAST0, XAIEGBL_MEM_EVTBRDCAST15),
+	XAIE_REG_RANGE(XAIEGBL_MEM_TRACTRL0, XAIEGBL_MEM_TRACTRL1),
+	XAIE_REG_RANGE(XAIEGBL_MEM_TRAEVT0, XAIEGBL_MEM_TRAEVT1),
+	XAIE_REG_RANGE(XAIEGBL_MEM_TIMTRIEVTLOWVAL, XAIEGBL_MEM_TIMTRIEVTHIGVAL),
+	XAIE_REG_RANGE(XAIEGBL_MEM_WTCHPT0, XAIEGBL_MEM_WTCHPT1),
+	XAIE_REG_RANGE(XAIEGBL_MEM_COMEVTINP, XAIEGBL_MEM_COMEVTCTRL),
+	XAIE_REG_RANGE(XAIEGBL_MEM_EVTGRP0ENA, XAIEGBL_MEM_EVTGRPUSREVTENA),
+	/* Buffer descriptors without the interleaved state word */
+	XAIE_REG_RANGE_REP(XAIEGBL_MEM_DMABD0ADDA, 5U,
+			XAIEGBL_MEM_DMABD1ADDA - XAIEGBL_MEM_DMABD0ADDA, 16U),
+	XAIE_REG_RANGE_REP(XAIEGBL_MEM_DMABD0CTRL, 1U,
+			XAIEGBL_MEM_DMABD1CTRL - XAIEGBL_MEM_DMABD0CTRL, 16U),
+	XAIE_REG_RANGE(XAIEGBL_MEM_LOCKEVTVALCTRL0, XAIEGBL_MEM_LOCKEVTVALCTRL1),
+	XAIE_REG_RANGE(XAIEGBL_CORE_PERCTR0, XAIEGBL_CORE_PERCTR2),
+	XAIE_REG_RANGE(XAIEGBL_CORE_PERCOU0EVTVAL, XAIEGBL_CORE_PERCOU3EVTVAL),
+	XAIE_REG_RANGE(XAIEGBL_CORE_ENAEVE, XAIEGBL_CORE_RSTEVT),
+	XAIE_REG_RANGE(XAIEGBL_CORE_PCEVT0, XAIEGBL_CORE_PCEVT3),
+	XAIE_REG_RANGE(XAIEGBL_CORE_EVTBRDCAST0, XAIEGBL_CORE_EVTBRDCAST15),
+	XAIE_REG_RANGE(XAIEGBL_CORE_TRACTRL0, XAIEGBL_CORE_TRACTRL1),
+	XAIE_REG_RANGE(XAIEGBL_CORE_TRAEVT0, XAIEGBL_CORE_TRAEVT1),
+	XAIE_REG_RANGE(XAIEGBL_CORE_TIMTRIEVTLOWVAL,
+			XAIEGBL_CORE_TIMTRIEVTHIGVAL),
+	XAIE_REG_RANGE(XAIEGBL_CORE_COMEVTINP, XAIEGBL_CORE_COMEVTCTRL),
+	XAIE_REG_RANGE(XAIEGBL_CORE_EVTGRP0ENA, XAIEGBL_CORE_EVTGRPUSREVTENA),
+	XAIE_REG_RANGE(XAIEGBL_CORE_TILCTRL, XAIEGBL_CORE_TILCTRL),
+	XAIE_REG_RANGE(XAIEGBL_CORE_TILCLOCTRL, XAIEGBL_CORE_TILCLOCTRL),
+	XAIE_REG_RANGE(XAIEGBL_CORE_STRSWIMSTRCFGMECORE0,
+			XAIEGBL_CORE_STRSWIMSTRCFGEAS3),
+	XAIE_REG_RANGE(XAIEGBL_CORE_STRSWISLVMECORE0CFG,
+			XAIEGBL_CORE_STRSWISLVMEMTRACFG),
+	XAIE_REG_RANGE(XAIEGBL_CORE_STRSWISLVMECORE0SLO0,
+			XAIEGBL_CORE_STRSWISLVMEMTRASLO3),
+	XAIE_REG_RANGE(XAIEGBL_CORE_STRSWIEVTPORTSEL0,
+			XAIEGBL_CORE_STRSWIEVTPORTSEL1),
+};
+
+/*
+ * Configuration registers of the PL module of XAIEGBL_TILE_TYPE_SHIMNOC and
+ * XAIEGBL_TILE_TYPE_SHIMPL tiles. The first level interrupt controller enable
+ * and disable registers are left out as they are write to set and clear.
+ */
+#define XAIE_PL_SHADOW_RANGES \
+	XAIE_REG_RANGE(XAIEGBL_PL_PERCTR0, XAIEGBL_PL_PERCTR1), \
+	XAIE_REG_RANGE(XAIEGBL_PL_PERCOU0EVTVAL, XAIEGBL_PL_PERCOU1EVTVAL), \
+	XAIE_REG_RANGE(XAIEGBL_PL_PLINTUPSCFG, XAIEGBL_PL_PLINTDOWBYPASS), \
+	XAIE_REG_RANGE(XAIEGBL_PL_EVTBRDCAST0A, XAIEGBL_PL_EVTBRDCAST15A), \
+	XAIE_REG_RANGE(XAIEGBL_PL_TRACTRL0, XAIEGBL_PL_TRACTRL1), \
+	XAIE_REG_RANGE(XAIEGBL_PL_TRAEVT0, XAIEGBL_PL_TRAEVT1), \
+	XAIE_REG_RANGE(XAIEGBL_PL_TIMTRIEVTLOWVAL, XAIEGBL_PL_TIMTRIEVTHIGVAL), \
+	XAIE_REG_RANGE(XAIEGBL_PL_COMEVTINP, XAIEGBL_PL_COMEVTCTRL), \
+	XAIE_REG_RANGE(XAIEGBL_PL_EVTGRP0ENA, XAIEGBL_PL_EVTGRPUSRENA), \
+	XAIE_REG_RANGE(XAIEGBL_PL_INTCON1STLEVIRQNOA, \
+			XAIEGBL_PL_INTCON1STLEVIRQEVTA), \
+	XAIE_REG_RANGE(XAIEGBL_PL_INTCON1STLEVIRQNOB, \
+			XAIEGBL_PL_INTCON1STLEVIRQEVTB), \
+	XAIE_REG_RANGE(XAIEGBL_PL_TILCLOCTRL, XAIEGBL_PL_TILCLOCTRL), \
+	XAIE_REG_RANGE(XAIEGBL_PL_STRSWIMSTRCFGTILCTR, \
+			XAIEGBL_PL_STRSWIMSTRCFGEAS3), \
+	XAIE_REG_RANGE(XAIEGBL_PL_STRSWISLVTILCTRCFG, \
+			XAIEGBL_PL_STRSWISLVTRACFG), \
+	XAIE_REG_RANGE(XAIEGBL_PL_STRSWISLVTILCTRSLO0, \
+			XAIEGBL_PL_STRSWISLVTRASLO3), \
+	XAIE_REG_RANGE(XAIEGBL_PL_STRSWIEVTPORTSEL0, \
+			XAIEGBL_PL_STRSWIEVTPORTSEL1)
+
+/*
+ * Configuration registers of XAIEGBL_TILE_TYPE_SHIMNOC tiles for the shadow
+ * register cache.
+ */
+static const XAie_RegRange AieShimNocShadowRanges[] =
+{
+	XAIE_REG_RANGE(XAIEGBL_NOC_LOCKEVTVALCTRL0, XAIEGBL_NOC_LOCKEVTVALCTRL1),
+	XAIE_REG_RANGE(XAIEGBL_NOC_INTCON2NDLEVINT, XAIEGBL_NOC_INTCON2NDLEVINT),
+	XAIE_REG_RANGE(XAIEGBL_NOC_DMABD0ADDLOW, XAIEGBL_NOC_DMABD15PKT),
+	XAIE_REG_RANGE(XAIEGBL_NOC_NOCINTMETONOCSOU2,
+			XAIEGBL_NOC_NOCINTMETONOCSOU5),
+	XAIE_REG_RANGE(XAIEGBL_NOC_MEAXICFG, XAIEGBL_NOC_MEAXICFG),
+	XAIE_REG_RANGE(XAIEGBL_NOC_MUXCFG, XAIEGBL_NOC_DEMCFG),
+	XAIE_PL_SHADOW_RANGES,
+};
+
+/*
+ * Configuration registers of XAIEGBL_TILE_TYPE_SHIMPL tiles for the shadow
+ * register cache.
+ */
+static const XAie_RegRange AieShimPlShadowRanges[] =
+{
+	XAIE_PL_SHADOW_RANGES,
+};
+
+static const XAie_ShadowMod AieTileShadowMod =
+{
+	.Ranges = AieTileShadowRanges,
+	.NumRanges = sizeof(AieTileShadowRanges) /
+		sizeof(AieTileShadowRanges[0]),
+};
+
+static const XAie_ShadowMod AieShimNocShadowMod =
+{
+	.Ranges = AieShimNocShadowRanges,
+	.NumRanges = sizeof(AieShimNocShadowRanges) /
+		sizeof(AieShimNocShadowRanges[0]),
+};
+
+static const XAie_ShadowMod AieShimPlShadowMod =
+{
+	.Ranges = AieShimPlShadowRanges,
+	.NumRanges = sizeof(AieShimPlShadowRanges) /
+		sizeof(AieShimPlShadowRanges[0]),
+};
+
 /*
  * AIE Module
  * This data structure captures all the modules for each tile type.
@@ -2861,6 +2994,7 @@ XAie_TileMod AieMod[] =
 		.ClockMod = &AieTileClockMod,
 		.L1IntrMod = NULL,
 		.L2IntrMod = NULL,
+		.ShadowMod = &AieTileShadowMod,
 	},
 	{
 		/*
@@ -2879,6 +3013,7 @@ XAie_TileMod AieMod[] =
 		.ClockMod = &AiePlClockMod,
 		.L1IntrMod = &AiePlL1IntrMod,
 		.L2IntrMod = &AieNoCL2IntrMod,
+		.ShadowMod = &AieShimNocShadowMod,
 	},
 	{
 		/*
@@ -2897,6 +3032,7 @@ XAie_TileMod AieMod[] =
 		.ClockMod = &AiePlClockMod,
 		.L1IntrMod = &AiePlL1IntrMod,
 		.L2IntrMod = NULL,
+		.ShadowMod = &AieShimPlShadowMod,
 	},
 	{
 		/*
@@ -2915,6 +3051,7 @@ XAie_TileMod AieMod[] =
 		.ClockMod = NULL,
 		.L1IntrMod = NULL,
 		.L2IntrMod = NULL,
+		.ShadowMod = NULL,
 	}
 };
 
@@ -0,0 +1,1006 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_snapshot.c
+* @{
+*
+* This file contains the data structures and routines for low level IO
+* operations for the snapshot backend. The backend doesn't access the device,
+* it records the register operations of the driver into a snapshot, which can
+* be exported with XAie_SnapshotExport() and replayed to a partition with
+* XAie_SnapshotReplay() from any backend.
+*
+* Contiguous writes are recorded as block writes, and consecutive operations
+* of the same kind are recorded as one command. Register reads and shim DMA
+* buffer descriptors can't be recorded, a snapshot with any of them can't be
+* exported.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   agent   10/17/2026  Initial creation.
+* </pre>
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "xaie_debug.h"
+#include "xaie_helper.h"
+#include "xaie_io.h"
+#include "xaie_npi.h"
+#include "xaie_snapshot.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_SNAPSHOT_HDR_WORDS		(sizeof(XAie_SnapshotHdr) / 4U)
+#define XAIE_SNAPSHOT_INIT_WORDS	1024U
+#define XAIE_SNAPSHOT_NO_CMD		0xFFFFFFFFU
+
+/****************************** Type Definitions *****************************/
+typedef struct {
+	u32 *Buf;		/* Header and commands */
+	u32 NumWords;		/* Number of words used in Buf */
+	u32 MaxWords;		/* Number of words allocated for Buf */
+	u32 LastCmd;		/* Index of the last command word */
+	u32 NumCmds;
+	u32 NumErrors;		/* Commands which could not be recorded */
+	u8 DevGen;
+	u8 NumRows;
+	u8 NumCols;
+} XAie_SnapshotIO;
+
+/************************** Variable Definitions *****************************/
+const XAie_Backend SnapshotBackend =
+{
+	.Type = XAIE_IO_BACKEND_SNAPSHOT,
+	.Ops.Init = XAie_SnapshotIO_Init,
+	.Ops.Finish = XAie_SnapshotIO_Finish,
+	.Ops.Write32 = XAie_SnapshotIO_Write32,
+	.Ops.Read32 = XAie_SnapshotIO_Read32,
+	.Ops.MaskWrite32 = XAie_SnapshotIO_MaskWrite32,
+	.Ops.MaskPoll = XAie_SnapshotIO_MaskPoll,
+	.Ops.BlockWrite32 = XAie_SnapshotIO_BlockWrite32,
+	.Ops.BlockSet32 = XAie_SnapshotIO_BlockSet32,
+	.Ops.CmdWrite = XAie_SnapshotIO_CmdWrite,
+	.Ops.RunOp = XAie_SnapshotIO_RunOp,
+	.Ops.MemAllocate = XAie_DebugMemAllocate,
+	.Ops.MemFree = XAie_DebugMemFree,
+	.Ops.MemSyncForCPU = XAie_DebugMemSyncForCPU,
+	.Ops.MemSyncForDev = XAie_DebugMemSyncForDev,
+	.Ops.MemAttach = XAie_DebugMemAttach,
+	.Ops.MemDetach = XAie_DebugMemDetach,
+};
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to free the global IO instance
+*
+* @param	IOInst: IO Instance pointer.
+*
+* @return	XAIE_OK.
+*
+* @note		The recorded snapshot is freed with the IO instance.
+*
+*******************************************************************************/
+AieRC XAie_SnapshotIO_Finish(void *IOInst)
+{
+	XAie_SnapshotIO *SnapshotIOInst = (XAie_SnapshotIO *)IOInst;
+
+	free(SnapshotIOInst->Buf);
+	free(SnapshotIOInst);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to initialize the global IO instance
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success. Error code on failure.
+*
+* @note		None.
+*
+*******************************************************************************/
+AieRC XAie_SnapshotIO_Init(XAie_DevInst *DevInst)
+{
+	XAie_SnapshotIO *IOInst;
+
+	IOInst = (XAie_SnapshotIO *)calloc(1U, sizeof(*IOInst));
+	if(IOInst == NULL) {
+		XAIE_ERROR("Memory allocation failed\n");
+		return XAIE_ERR;
+	}
+
+	IOInst->Buf = (u32 *)malloc(XAIE_SNAPSHOT_INIT_WORDS * sizeof(u32));
+	if(IOInst->Buf == NULL) {
+		XAIE_ERROR("Memory allocation failed\n");
+		free(IOInst);
+		return XAIE_ERR;
+	}
+
+	/* The header is filled when the snapshot is exported */
+	IOInst->NumWords = XAIE_SNAPSHOT_HDR_WORDS;
+	IOInst->MaxWords = XAIE_SNAPSHOT_INIT_WORDS;
+	IOInst->LastCmd = XAIE_SNAPSHOT_NO_CMD;
+	IOInst->DevGen = DevInst->DevProp.DevGen;
+	IOInst->NumRows = DevInst->NumRows;
+	IOInst->NumCols = DevInst->NumCols;
+	DevInst->IOInst = IOInst;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine makes room for words at the end of the snapshot.
+*
+* @param	IOInst: Snapshot IO instance pointer.
+* @param	NumWords: Number of words to add.
+*
+* @return	XAIE_OK on success, XAIE_ERR if the snapshot can't grow.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_SnapshotReserve(XAie_SnapshotIO *IOInst, u32 NumWords)
+{
+	u32 *Buf;
+	u64 MaxWords = IOInst->MaxWords;
+
+	if((u64)IOInst->NumWords + NumWords <= MaxWords) {
+		return XAIE_OK;
+	}
+
+	while((u64)IOInst->NumWords + NumWords > MaxWords) {
+		MaxWords *= 2U;
+	}
+
+	/* The size of the snapshot in bytes is recorded on 32 bits */
+	if(MaxWords > (0xFFFFFFFFU / 4U)) {
+		MaxWords = 0xFFFFFFFFU / 4U;
+		if((u64)IOInst->NumWords + NumWords > MaxWords) {
+			XAIE_ERROR("Snapshot is too large\n");
+			IOInst->NumErrors++;
+			return XAIE_ERR;
+		}
+	}
+
+	Buf = (u32 *)realloc(IOInst->Buf, MaxWords * sizeof(u32));
+	if(Buf == NULL) {
+		XAIE_ERROR("Memory allocation failed\n");
+		IOInst->NumErrors++;
+		return XAIE_ERR;
+	}
+
+	IOInst->Buf = Buf;
+	IOInst->MaxWords = (u32)MaxWords;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine checks the register offset of a command fits the snapshot
+* format.
+*
+* @param	IOInst: Snapshot IO instance pointer.
+* @param	RegOff: Register offset.
+*
+* @return	XAIE_OK on success, XAIE_ERR for failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_SnapshotCheckOff(XAie_SnapshotIO *IOInst, u64 RegOff)
+{
+	if(RegOff > 0xFFFFFFFFU) {
+		XAIE_ERROR("Register offset 0x%lx can't be recorded\n", RegOff);
+		IOInst->NumErrors++;
+		return XAIE_ERR;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine checks if the last command of the snapshot is a command of the
+* given opcode which can be extended by one more element.
+*
+* @param	IOInst: Snapshot IO instance pointer.
+* @param	Op: Opcode of the command.
+*
+* @return	1 if the last command can be extended, 0 otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static u8 _XAie_SnapshotCanAppend(XAie_SnapshotIO *IOInst, u32 Op)
+{
+	u32 Cmd;
+
+	if(IOInst->LastCmd == XAIE_SNAPSHOT_NO_CMD) {
+		return 0U;
+	}
+
+	Cmd = IOInst->Buf[IOInst->LastCmd];
+	if(((Cmd >> XAIE_SNAPSHOT_OP_SHIFT) != Op) ||
+			((Cmd & XAIE_SNAPSHOT_COUNT_MASK) ==
+			 XAIE_SNAPSHOT_COUNT_MASK)) {
+		return 0U;
+	}
+
+	return 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine adds the elements of a command to the snapshot. The elements
+* are appended to the last command if it has the same opcode, otherwise a new
+* command is started.
+*
+* @param	IOInst: Snapshot IO instance pointer.
+* @param	Op: Opcode of the command.
+* @param	Words: Words of the elements.
+* @param	NumWords: Number of words of the elements.
+*
+* @return	None.
+*
+* @note		Internal only. Only for the commands made of a list of
+*		elements of the same size.
+*
+*******************************************************************************/
+static void _XAie_SnapshotAddElem(XAie_SnapshotIO *IOInst, u32 Op,
+		const u32 *Words, u32 NumWords)
+{
+	if(_XAie_SnapshotCanAppend(IOInst, Op) == 0U) {
+		if(_XAie_SnapshotReserve(IOInst, NumWords + 1U) != XAIE_OK) {
+			return;
+		}
+		IOInst->LastCmd = IOInst->NumWords;
+		IOInst->Buf[IOInst->NumWords++] = Op << XAIE_SNAPSHOT_OP_SHIFT;
+		IOInst->NumCmds++;
+	} else if(_XAie_SnapshotReserve(IOInst, NumWords) != XAIE_OK) {
+		return;
+	}
+
+	memcpy(&IOInst->Buf[IOInst->NumWords], Words, NumWords * sizeof(u32));
+	IOInst->NumWords += NumWords;
+	IOInst->Buf[IOInst->LastCmd]++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine adds a block write to the snapshot. It is merged to the last
+* command if that one is a block write ending at RegOff.
+*
+* @param	IOInst: Snapshot IO instance pointer.
+* @param	RegOff: Register offset of the block.
+* @param	Data: Pointer to the data of the block.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_SnapshotAddBlock(XAie_SnapshotIO *IOInst, u64 RegOff,
+		const u32 *Data, u32 Size)
+{
+	u32 Cmd;
+	u32 Count;
+
+	while(Size > 0U) {
+		Count = 0U;
+		if(_XAie_SnapshotCanAppend(IOInst,
+					XAIE_SNAPSHOT_OP_BLOCKWRITE) == 1U) {
+			Cmd = IOInst->Buf[IOInst->LastCmd];
+			Count = Cmd & XAIE_SNAPSHOT_COUNT_MASK;
+			if(IOInst->Buf[IOInst->LastCmd + 1U] + 4U * (u64)Count !=
+					RegOff) {
+				Count = 0U;
+			}
+		}
+
+		if(Count == 0U) {
+			if(_XAie_SnapshotReserve(IOInst, 2U) != XAIE_OK) {
+				return;
+			}
+			IOInst->LastCmd = IOInst->NumWords;
+			IOInst->Buf[IOInst->NumWords++] =
+				XAIE_SNAPSHOT_OP_BLOCKWRITE <<
+				XAIE_SNAPSHOT_OP_SHIFT;
+			IOInst->Buf[IOInst->NumWords++] = (u32)RegOff;
+			IOInst->NumCmds++;
+		}
+
+		Count = XAIE_SNAPSHOT_COUNT_MASK - Count;
+		if(Count > Size) {
+			Count = Size;
+		}
+
+		if(_XAie_SnapshotReserve(IOInst, Count) != XAIE_OK) {
+			return;
+		}
+		memcpy(&IOInst->Buf[IOInst->NumWords], Data,
+				Count * sizeof(u32));
+		IOInst->NumWords += Count;
+		IOInst->Buf[IOInst->LastCmd] += Count;
+
+		Data += Count;
+		RegOff += Count * 4U;
+		Size -= Count;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write 32bit data to the specified address.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Value: 32-bit data to be written.
+*
+* @return	None.
+*
+* @note		A write following a write to the previous register turns both
+*		into a block write.
+*
+*******************************************************************************/
+void XAie_SnapshotIO_Write32(void *IOInst, u64 RegOff, u32 Value)
+{
+	XAie_SnapshotIO *SnapshotIOInst = (XAie_SnapshotIO *)IOInst;
+	u32 *Cmd;
+	u32 Words[2U];
+
+	if(_XAie_SnapshotCheckOff(SnapshotIOInst, RegOff) != XAIE_OK) {
+		return;
+	}
+
+	if(_XAie_SnapshotCanAppend(SnapshotIOInst,
+				XAIE_SNAPSHOT_OP_BLOCKWRITE) == 1U) {
+		Cmd = &SnapshotIOInst->Buf[SnapshotIOInst->LastCmd];
+		if(Cmd[1U] + 4U * (u64)(*Cmd & XAIE_SNAPSHOT_COUNT_MASK) ==
+				RegOff) {
+			_XAie_SnapshotAddBlock(SnapshotIOInst, RegOff, &Value,
+					1U);
+			return;
+		}
+	}
+
+	if(_XAie_SnapshotCanAppend(SnapshotIOInst,
+				XAIE_SNAPSHOT_OP_WRITE) == 1U) {
+		Cmd = &SnapshotIOInst->Buf[SnapshotIOInst->LastCmd];
+		Words[0U] = SnapshotIOInst->Buf[SnapshotIOInst->NumWords - 2U];
+		Words[1U] = SnapshotIOInst->Buf[SnapshotIOInst->NumWords - 1U];
+		if((u64)Words[0U] + 4U == RegOff) {
+			/* Move the last write to a new block write */
+			SnapshotIOInst->NumWords -= 2U;
+			if(--(*Cmd) == (XAIE_SNAPSHOT_OP_WRITE <<
+						XAIE_SNAPSHOT_OP_SHIFT)) {
+				SnapshotIOInst->NumWords--;
+				SnapshotIOInst->NumCmds--;
+			}
+			SnapshotIOInst->LastCmd = XAIE_SNAPSHOT_NO_CMD;
+			_XAie_SnapshotAddBlock(SnapshotIOInst, Words[0U],
+					&Words[1U], 1U);
+			_XAie_SnapshotAddBlock(SnapshotIOInst, RegOff, &Value,
+					1U);
+			return;
+		}
+	}
+
+	Words[0U] = (u32)RegOff;
+	Words[1U] = Value;
+	_XAie_SnapshotAddElem(SnapshotIOInst, XAIE_SNAPSHOT_OP_WRITE, Words, 2U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read 32bit data from the specified address.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+*
+* @return	0.
+*
+* @note		Reads can't be recorded. The configuration may depend on the
+*		value read, so the snapshot can't be exported.
+*
+*******************************************************************************/
+u32 XAie_SnapshotIO_Read32(void *IOInst, u64 RegOff)
+{
+	XAie_SnapshotIO *SnapshotIOInst = (XAie_SnapshotIO *)IOInst;
+
+	XAIE_ERROR("Read of 0x%lx can't be recorded in the snapshot\n", RegOff);
+	SnapshotIOInst->NumErrors++;
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write masked 32bit data to the specified
+* address.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Mask: Mask to be applied to Data.
+* @param	Value: 32-bit data to be written.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAie_SnapshotIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value)
+{
+	XAie_SnapshotIO *SnapshotIOInst = (XAie_SnapshotIO *)IOInst;
+	u32 Words[3U];
+
+	if(_XAie_SnapshotCheckOff(SnapshotIOInst, RegOff) != XAIE_OK) {
+		return;
+	}
+
+	Words[0U] = (u32)RegOff;
+	Words[1U] = Mask;
+	Words[2U] = Value;
+	_XAie_SnapshotAddElem(SnapshotIOInst, XAIE_SNAPSHOT_OP_MASKWRITE,
+			Words, 3U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to mask poll an address for a value.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Mask: Mask to be applied to Data.
+* @param	Value: 32-bit value to poll for
+* @param	TimeOutUs: Timeout in micro seconds.
+*
+* @return	XAIE_SUCCESS.
+*
+* @note		The poll is done when the snapshot is replayed.
+*
+*******************************************************************************/
+u32 XAie_SnapshotIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
+		u32 TimeOutUs)
+{
+	XAie_SnapshotIO *SnapshotIOInst = (XAie_SnapshotIO *)IOInst;
+	u32 Words[4U];
+
+	if(_XAie_SnapshotCheckOff(SnapshotIOInst, RegOff) != XAIE_OK) {
+		return XAIE_FAILURE;
+	}
+
+	Words[0U] = (u32)RegOff;
+	Words[1U] = Mask;
+	Words[2U] = Value;
+	Words[3U] = TimeOutUs;
+	_XAie_SnapshotAddElem(SnapshotIOInst, XAIE_SNAPSHOT_OP_MASKPOLL,
+			Words, 4U);
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write a block of data to aie.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Pointer to the data buffer.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAie_SnapshotIO_BlockWrite32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	XAie_SnapshotIO *SnapshotIOInst = (XAie_SnapshotIO *)IOInst;
+
+	if(_XAie_SnapshotCheckOff(SnapshotIOInst,
+				RegOff + (u64)Size * 4U) != XAIE_OK) {
+		return;
+	}
+
+	_XAie_SnapshotAddBlock(SnapshotIOInst, RegOff, Data, Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to initialize a chunk of aie address space with
+* a specified value.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Data to initialize a chunk of aie address space..
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAie_SnapshotIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data, u32 Size)
+{
+	XAie_SnapshotIO *SnapshotIOInst = (XAie_SnapshotIO *)IOInst;
+	u32 Count;
+
+	if(_XAie_SnapshotCheckOff(SnapshotIOInst,
+				RegOff + (u64)Size * 4U) != XAIE_OK) {
+		return;
+	}
+
+	while(Size > 0U) {
+		if(_XAie_SnapshotReserve(SnapshotIOInst, 3U) != XAIE_OK) {
+			return;
+		}
+
+		Count = (Size > XAIE_SNAPSHOT_COUNT_MASK) ?
+			XAIE_SNAPSHOT_COUNT_MASK : Size;
+		SnapshotIOInst->LastCmd = SnapshotIOInst->NumWords;
+		SnapshotIOInst->Buf[SnapshotIOInst->NumWords++] =
+			(XAIE_SNAPSHOT_OP_BLOCKSET << XAIE_SNAPSHOT_OP_SHIFT) |
+			Count;
+		SnapshotIOInst->Buf[SnapshotIOInst->NumWords++] = (u32)RegOff;
+		SnapshotIOInst->Buf[SnapshotIOInst->NumWords++] = Data;
+		SnapshotIOInst->NumCmds++;
+
+		RegOff += Count * 4U;
+		Size -= Count;
+	}
+}
+
+void XAie_SnapshotIO_CmdWrite(void *IOInst, u8 Col, u8 Row, u8 Command,
+		u32 CmdWd0, u32 CmdWd1, const char *CmdStr)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)Col;
+	(void)Row;
+	(void)Command;
+	(void)CmdWd0;
+	(void)CmdWd1;
+	(void)CmdStr;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the function to run backend operations
+*
+* @param	IOInst: IO instance pointer
+* @param	DevInst: AI engine partition device instance
+* @param	Op: Backend operation code
+* @param	Arg: Backend operation argument
+*
+* @return	XAIE_OK for success and error code for failure.
+*
+* @note		The operations resulting in register writes are recorded,
+*		except for the shim DMA buffer descriptors.
+*
+*******************************************************************************/
+AieRC XAie_SnapshotIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
+		XAie_BackendOpCode Op, void *Arg)
+{
+	XAie_SnapshotIO *SnapshotIOInst = (XAie_SnapshotIO *)IOInst;
+	AieRC RC = XAIE_OK;
+
+	switch(Op) {
+		case XAIE_BACKEND_OP_NPIWR32:
+		{
+			XAie_BackendNpiWrReq *Req = Arg;
+			u32 Words[2U];
+
+			Words[0U] = Req->NpiRegOff;
+			Words[1U] = Req->Val;
+			_XAie_SnapshotAddElem(SnapshotIOInst,
+					XAIE_SNAPSHOT_OP_NPIWRITE, Words, 2U);
+			break;
+		}
+		case XAIE_BACKEND_OP_ASSERT_SHIMRST:
+		{
+			u8 RstEnable = (u8)((uintptr_t)Arg & 0xFF);
+
+			_XAie_NpiSetShimReset(DevInst, RstEnable);
+			break;
+		}
+		case XAIE_BACKEND_OP_SET_PROTREG:
+		{
+			RC = _XAie_NpiSetProtectedRegEnable(DevInst, Arg);
+			break;
+		}
+		case XAIE_BACKEND_OP_CONFIG_SHIMDMABD:
+		{
+			/*
+			 * The buffer descriptor holds the address of a host
+			 * buffer, which isn't valid when the snapshot is replayed.
+			 */
+			XAIE_ERROR("Shim DMA buffer descriptors can't be recorded "
+					"in the snapshot\n");
+			SnapshotIOInst->NumErrors++;
+			RC = XAIE_FEATURE_NOT_SUPPORTED;
+			break;
+		}
+		case XAIE_BACKEND_OP_REQUEST_TILES:
+		{
+			XAIE_DBG("Backend doesn't support Op %u.\n", Op);
+			return XAIE_FEATURE_NOT_SUPPORTED;
+		}
+		default:
+			XAIE_ERROR("Backend doesn't support Op %u.\n", Op);
+			RC = XAIE_FEATURE_NOT_SUPPORTED;
+			break;
+	}
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns a copy of the snapshot recorded by the snapshot backend.
+*
+* @param	DevInst: Device instance pointer. The snapshot backend has to
+*		be the current backend.
+* @param	Snapshot: Pointer to return the snapshot. It is allocated by
+*		this API and has to be freed with free().
+* @param	Size: Pointer to return the size of the snapshot in bytes.
+*
+* @return	XAIE_OK on success. XAIE_ERR if some of the operations could
+*		not be recorded.
+*
+* @note		The recording continues after the export. It is restarted by
+*		setting the snapshot backend again with XAie_SetIOBackend().
+*
+*******************************************************************************/
+AieRC XAie_SnapshotExport(XAie_DevInst *DevInst, void **Snapshot, u64 *Size)
+{
+	XAie_SnapshotIO *IOInst;
+	XAie_SnapshotHdr *Hdr;
+
+	if((DevInst == XAIE_NULL) || (Snapshot == XAIE_NULL) ||
+			(Size == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(DevInst->Backend->Type != XAIE_IO_BACKEND_SNAPSHOT) {
+		XAIE_ERROR("Snapshot backend is not set\n");
+		return XAIE_INVALID_BACKEND;
+	}
+
+	IOInst = (XAie_SnapshotIO *)DevInst->IOInst;
+	if(IOInst->NumErrors != 0U) {
+		XAIE_ERROR("%u operations could not be recorded\n",
+				IOInst->NumErrors);
+		return XAIE_ERR;
+	}
+
+	Hdr = (XAie_SnapshotHdr *)IOInst->Buf;
+	Hdr->Magic = XAIE_SNAPSHOT_MAGIC;
+	Hdr->VerMajor = XAIE_SNAPSHOT_VER_MAJOR;
+	Hdr->VerMinor = XAIE_SNAPSHOT_VER_MINOR;
+	Hdr->Size = IOInst->NumWords * sizeof(u32);
+	Hdr->NumCmds = IOInst->NumCmds;
+	Hdr->DevGen = IOInst->DevGen;
+	Hdr->NumRows = IOInst->NumRows;
+	Hdr->NumCols = IOInst->NumCols;
+	Hdr->Reserved = 0U;
+
+	*Snapshot = malloc(Hdr->Size);
+	if(*Snapshot == NULL) {
+		XAIE_ERROR("Memory allocation failed\n");
+		return XAIE_ERR;
+	}
+
+	memcpy(*Snapshot, IOInst->Buf, Hdr->Size);
+	*Size = Hdr->Size;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine returns the number of words of a snapshot command after the
+* command word.
+*
+* @param	Cmd: Command word.
+*
+* @return	Number of words, 0 for an invalid command.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static u64 _XAie_SnapshotCmdWords(u32 Cmd)
+{
+	u64 Count = Cmd & XAIE_SNAPSHOT_COUNT_MASK;
+
+	if(Count == 0U) {
+		return 0U;
+	}
+
+	switch(Cmd >> XAIE_SNAPSHOT_OP_SHIFT) {
+		case XAIE_SNAPSHOT_OP_WRITE:
+		case XAIE_SNAPSHOT_OP_NPIWRITE:
+			return Count * 2U;
+		case XAIE_SNAPSHOT_OP_BLOCKWRITE:
+			return Count + 1U;
+		case XAIE_SNAPSHOT_OP_BLOCKSET:
+			return 2U;
+		case XAIE_SNAPSHOT_OP_MASKWRITE:
+			return Count * 3U;
+		case XAIE_SNAPSHOT_OP_MASKPOLL:
+			return Count * 4U;
+		default:
+			return 0U;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine checks the register offsets of a snapshot command. The
+* registers have to be 32-bit aligned and within the partition, the NPI
+* registers have to be ones written by the driver.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Cmd: Pointer to the command word, followed by its words.
+*
+* @return	XAIE_OK if the registers are valid, XAIE_ERR otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_SnapshotCheckRegs(XAie_DevInst *DevInst, const u32 *Cmd)
+{
+	u64 PartSize = (u64)DevInst->NumCols << DevInst->DevProp.ColShift;
+	u32 Count = Cmd[0U] & XAIE_SNAPSHOT_COUNT_MASK;
+	u32 Op = Cmd[0U] >> XAIE_SNAPSHOT_OP_SHIFT;
+	u32 Stride;
+
+	switch(Op) {
+		case XAIE_SNAPSHOT_OP_BLOCKWRITE:
+		case XAIE_SNAPSHOT_OP_BLOCKSET:
+			if(((Cmd[1U] & 0x3U) != 0U) ||
+					((u64)Cmd[1U] + 4U * (u64)Count >
+					 PartSize)) {
+				return XAIE_ERR;
+			}
+			return XAIE_OK;
+		case XAIE_SNAPSHOT_OP_NPIWRITE:
+			for(u32 i = 0U; i < Count; i++) {
+				if(_XAie_NpiIsDriverReg(DevInst,
+						Cmd[1U + 2U * i]) == 0U) {
+					return XAIE_ERR;
+				}
+			}
+			return XAIE_OK;
+		case XAIE_SNAPSHOT_OP_WRITE:
+			Stride = 2U;
+			break;
+		case XAIE_SNAPSHOT_OP_MASKWRITE:
+			Stride = 3U;
+			break;
+		default:
+			/* XAIE_SNAPSHOT_OP_MASKPOLL */
+			Stride = 4U;
+			break;
+	}
+
+	for(u32 i = 0U; i < Count; i++) {
+		if(((Cmd[1U + Stride * i] & 0x3U) != 0U) ||
+				((u64)Cmd[1U + Stride * i] + 4U > PartSize)) {
+			return XAIE_ERR;
+		}
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine checks the header and the commands of a snapshot.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Snapshot: Pointer to the snapshot.
+* @param	Size: Size of the snapshot in bytes.
+*
+* @return	XAIE_OK if the snapshot can be replayed, error code otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_SnapshotCheck(XAie_DevInst *DevInst, const void *Snapshot,
+		u64 Size)
+{
+	const XAie_SnapshotHdr *Hdr = (const XAie_SnapshotHdr *)Snapshot;
+	const u32 *Words = (const u32 *)Snapshot;
+	u64 NumWords = Size / sizeof(u32);
+	u64 Index = XAIE_SNAPSHOT_HDR_WORDS;
+	u64 CmdWords;
+	u32 NumCmds = 0U;
+
+	if((((uintptr_t)Snapshot & 0x3U) != 0U) ||
+			(Size < sizeof(*Hdr)) ||
+			(Hdr->Magic != XAIE_SNAPSHOT_MAGIC) ||
+			(Hdr->Size != Size)) {
+		XAIE_ERROR("Invalid snapshot\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(Hdr->VerMajor != XAIE_SNAPSHOT_VER_MAJOR) {
+		XAIE_ERROR("Unsupported snapshot version %u.%u\n",
+				Hdr->VerMajor, Hdr->VerMinor);
+		return XAIE_INVALID_ARGS;
+	}
+
+	if((Hdr->DevGen != DevInst->DevProp.DevGen) ||
+			(Hdr->NumRows != DevInst->NumRows) ||
+			(Hdr->NumCols != DevInst->NumCols)) {
+		XAIE_ERROR("Snapshot is for another partition\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	while(Index < NumWords) {
+		CmdWords = _XAie_SnapshotCmdWords(Words[Index]);
+		if((CmdWords == 0U) || (CmdWords > NumWords - Index - 1U)) {
+			XAIE_ERROR("Invalid snapshot command at word %lu\n",
+					Index);
+			return XAIE_INVALID_ARGS;
+		}
+		if(_XAie_SnapshotCheckRegs(DevInst, &Words[Index]) != XAIE_OK) {
+			XAIE_ERROR("Invalid register in snapshot command at "
+					"word %lu\n", Index);
+			return XAIE_INVALID_ARGS;
+		}
+		Index += CmdWords + 1U;
+		NumCmds++;
+	}
+
+	if(NumCmds != Hdr->NumCmds) {
+		XAIE_ERROR("Invalid snapshot\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API replays a snapshot recorded with the snapshot backend to the
+* partition. The recorded register operations are done in order with the
+* current backend, without any of the configuration logic of the driver.
+* Block writes are done directly from the snapshot buffer.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Snapshot: Pointer to the snapshot, 32-bit aligned.
+* @param	Size: Size of the snapshot in bytes.
+*
+* @return	XAIE_OK on success. XAIE_INVALID_ARGS if the snapshot is invalid,
+*		for another partition or has registers outside of the
+*		partition, in which case nothing is written.
+*		XAIE_ERR if a mask poll timed out, in which case the replay
+*		stops there.
+*
+* @note		The software state of the driver, such as the ECC bitmaps or
+*		the tiles in use, is not updated by the replay.
+*
+*******************************************************************************/
+AieRC XAie_SnapshotReplay(XAie_DevInst *DevInst, const void *Snapshot,
+		u64 Size)
+{
+	AieRC RC;
+	const u32 *Words = (const u32 *)Snapshot;
+	u64 NumWords = Size / sizeof(u32);
+	u64 Index = XAIE_SNAPSHOT_HDR_WORDS;
+	u32 Count;
+	XAie_BackendNpiWrReq Req;
+
+	if((DevInst == XAIE_NULL) || (Snapshot == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	RC = _XAie_SnapshotCheck(DevInst, Snapshot, Size);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	while(Index < NumWords) {
+		Count = Words[Index] & XAIE_SNAPSHOT_COUNT_MASK;
+
+		switch(Words[Index++] >> XAIE_SNAPSHOT_OP_SHIFT) {
+			case XAIE_SNAPSHOT_OP_WRITE:
+				for(u32 i = 0U; i < Count; i++) {
+					XAie_Write32(DevInst, Words[Index],
+							Words[Index + 1U]);
+					Index += 2U;
+				}
+				break;
+			case XAIE_SNAPSHOT_OP_BLOCKWRITE:
+				XAie_BlockWrite32(DevInst, Words[Index],
+						(u32 *)&Words[Index + 1U],
+						Count);
+				Index += Count + 1U;
+				break;
+			case XAIE_SNAPSHOT_OP_BLOCKSET:
+				XAie_BlockSet32(DevInst, Words[Index],
+						Words[Index + 1U], Count);
+				Index += 2U;
+				break;
+			case XAIE_SNAPSHOT_OP_MASKWRITE:
+				for(u32 i = 0U; i < Count; i++) {
+					XAie_MaskWrite32(DevInst, Words[Index],
+							Words[Index + 1U],
+							Words[Index + 2U]);
+					Index += 3U;
+				}
+				break;
+			case XAIE_SNAPSHOT_OP_MASKPOLL:
+				for(u32 i = 0U; i < Count; i++) {
+					if(XAie_MaskPoll(DevInst, Words[Index],
+							Words[Index + 1U],
+							Words[Index + 2U],
+							Words[Index + 3U]) !=
+							XAIE_SUCCESS) {
+						XAIE_ERROR("Poll of 0x%x timed "
+								"out\n",
+								Words[Index]);
+						return XAIE_ERR;
+					}
+					Index += 4U;
+				}
+				break;
+			default:
+				/* XAIE_SNAPSHOT_OP_NPIWRITE */
+				for(u32 i = 0U; i < Count; i++) {
+					Req.NpiRegOff = Words[Index];
+					Req.Val = Words[Index + 1U];
+					XAie_RunOp(DevInst,
+						XAIE_BACKEND_OP_NPIWR32, &Req);
+					Index += 2U;
+				}
+				break;
+		}
+	}
+
+	return XAIE_OK;
+}
+
+/** @} */
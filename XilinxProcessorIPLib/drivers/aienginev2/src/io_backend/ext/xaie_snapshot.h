@@ -0,0 +1,99 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_snapshot.h
+* @{
+*
+* This file contains the data structures and routines for low level IO
+* operations for the snapshot backend, and the snapshot format.
+*
+* A snapshot is an array of 32-bit words in CPU byte order. It starts with
+* the XAie_SnapshotHdr and is followed by the commands. Each command starts
+* with a word holding the opcode in bits 31:24 and a count in bits 23:0:
+*
+*	WRITE      : Count times RegOff, Value
+*	BLOCKWRITE : RegOff, then Count data words
+*	BLOCKSET   : RegOff, Value. Count is the number of words set.
+*	MASKWRITE  : Count times RegOff, Mask, Value
+*	MASKPOLL   : Count times RegOff, Mask, Value, TimeOutUs
+*	NPIWRITE   : Count times NpiRegOff, Value
+*
+* Register offsets are relative to the partition base address, as for the
+* IO backends, and are checked against the partition before a replay.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   agent   10/17/2026  Initial creation.
+* </pre>
+*
+******************************************************************************/
+#ifndef XAIE_SNAPSHOT_H
+#define XAIE_SNAPSHOT_H
+/***************************** Include Files *********************************/
+#include "xaie_io.h"
+#include "xaiegbl.h"
+
+/***************************** Macro Definitions *****************************/
+#define XAIE_SNAPSHOT_MAGIC		0x50414E53U /* "SNAP" */
+#define XAIE_SNAPSHOT_VER_MAJOR		1U
+#define XAIE_SNAPSHOT_VER_MINOR		0U
+
+#define XAIE_SNAPSHOT_OP_WRITE		1U
+#define XAIE_SNAPSHOT_OP_BLOCKWRITE	2U
+#define XAIE_SNAPSHOT_OP_BLOCKSET	3U
+#define XAIE_SNAPSHOT_OP_MASKWRITE	4U
+#define XAIE_SNAPSHOT_OP_MASKPOLL	5U
+#define XAIE_SNAPSHOT_OP_NPIWRITE	6U
+
+#define XAIE_SNAPSHOT_OP_SHIFT		24U
+#define XAIE_SNAPSHOT_COUNT_MASK	0xFFFFFFU
+
+/****************************** Type Definitions *****************************/
+/*
+ * Typedef for structure of the snapshot header. The snapshot can only be
+ * replayed to a partition of the same device generation and size.
+ */
+typedef struct {
+	u32 Magic;	/* XAIE_SNAPSHOT_MAGIC */
+	u16 VerMinor;	/* Minor version of the format */
+	u16 VerMajor;	/* Major version of the format */
+	u32 Size;	/* Size of the snapshot in bytes, including header */
+	u32 NumCmds;	/* Number of commands */
+	u8 DevGen;	/* Device generation of the partition */
+	u8 NumRows;	/* Number of rows of the partition */
+	u8 NumCols;	/* Number of columns of the partition */
+	u8 Reserved;
+} XAie_SnapshotHdr;
+
+/************************** Function Prototypes  *****************************/
+AieRC XAie_SnapshotIO_Init(XAie_DevInst *DevInst);
+AieRC XAie_SnapshotIO_Finish(void *IOInst);
+void XAie_SnapshotIO_Write32(void *IOInst, u64 RegOff, u32 Value);
+u32 XAie_SnapshotIO_Read32(void *IOInst, u64 RegOff);
+void XAie_SnapshotIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value);
+u32 XAie_SnapshotIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
+		u32 TimeOutUs);
+void XAie_SnapshotIO_BlockWrite32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size);
+void XAie_SnapshotIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data, u32 Size);
+void XAie_SnapshotIO_CmdWrite(void *IOInst, u8 Col, u8 Row, u8 Command,
+		u32 CmdWd0, u32 CmdWd1, const char *CmdStr);
+AieRC XAie_SnapshotIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
+		XAie_BackendOpCode Op, void *Arg);
+
+AieRC XAie_SnapshotExport(XAie_DevInst *DevInst, void **Snapshot, u64 *Size);
+AieRC XAie_SnapshotReplay(XAie_DevInst *DevInst, const void *Snapshot,
+		u64 Size);
+
+#endif	/* End of protection macro */
+
+/** @} */
@@ -21,6 +21,7 @@
 * 1.1   Tejus   06/10/2020 Add ess simulation backend.
 * 1.2   Tejus   06/10/2020 Add cdo backend.
 * 1.3   Tejus   06/10/2020 Add helper function to get backend pointer.
+* 1.4   agent   10/17/2026 Add snapshot backend.
 * </pre>
 *
 ******************************************************************************/
@@ -50,6 +51,7 @@ extern const XAie_Backend CdoBackend;
 extern const XAie_Backend BaremetalBackend;
 extern const XAie_Backend DebugBackend;
 extern const XAie_Backend LinuxBackend;
+extern const XAie_Backend SnapshotBackend;
 
 static const XAie_Backend *IOBackend[XAIE_IO_BACKEND_MAX] =
 {
@@ -59,6 +61,7 @@ static const XAie_Backend *IOBackend[XAIE_IO_BACKEND_MAX] =
 	&BaremetalBackend,
 	&DebugBackend,
 	&LinuxBackend,
+	&SnapshotBackend,
 };
 
 /************************** Function Definitions *****************************/
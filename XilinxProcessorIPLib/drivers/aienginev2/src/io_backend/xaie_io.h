@@ -19,6 +19,7 @@
 * ----- ------  -------- -----------------------------------------------------
 * 1.0   Tejus   06/09/2020 Initial creation.
 * 1.1   Tejus   06/10/2020 Add helper function to get backend pointer.
+* 1.2   agent   10/17/2026 Add transaction data structures and backend op.
 * </pre>
 *
 ******************************************************************************/
@@ -59,6 +60,46 @@ typedef struct XAie_BackendTilesArray {
 	u32 NumTiles;
 } XAie_BackendTilesArray;
 
+/*
+ * Typedef for enum to capture transaction command opcodes
+ */
+typedef enum {
+	XAIE_TXN_OP_WRITE,
+	XAIE_TXN_OP_BLOCKWRITE,
+	XAIE_TXN_OP_BLOCKSET,
+	XAIE_TXN_OP_MASKWRITE,
+	XAIE_TXN_OP_MASKPOLL,
+} XAie_TxnOpcode;
+
+/*
+ * Typedef for structure to capture a recorded IO operation. Block write data
+ * is copied to the data buffer of the transaction, DataOff is the index of
+ * the first word in that buffer.
+ */
+typedef struct XAie_TxnCmd {
+	XAie_TxnOpcode Opcode;
+	u64 RegOff;
+	u32 Mask;
+	u32 Value;	/* Value for write, mask write, poll and block set */
+	u32 DataOff;	/* Data buffer index of block write data */
+	u32 Size;	/* Number of 32-bit words of block write and set */
+	u32 TimeOutUs;	/* Timeout of mask poll */
+} XAie_TxnCmd;
+
+/*
+ * Typedef for structure to capture a transaction, see xaie_txn.c
+ */
+struct XAie_TxnInst {
+	u32 Flags;
+	XAie_TxnCmd *CmdBuf;
+	u32 NumCmds;
+	u32 MaxCmds;
+	u32 *DataBuf;
+	u32 NumDataWords;
+	u32 MaxDataWords;
+	u32 NumErrors;	/* Timed out mask polls and dropped commands */
+};
+
 /*
  * Typdef to capture all the backend IO operations
  * Init        : Backend specific initialization function. Init should attach
@@ -84,6 +125,10 @@ typedef struct XAie_BackendTilesArray {
  * MemSyncForDev: Backend operation to prepare memory for Device access.
  * MemAttach    : Backend operation to attach memory to AI engine device.
  * MemDetach    : Backend operation to detach memory from AI engine device
+ * SubmitTxn    : Backend operation to execute all the commands of a
+ *		  transaction in order. Optional, if NULL the commands are
+ *		  replayed through the other IO operations of the backend.
+ *		  Returns XAIE_ERR if any of the mask polls timed out.
  */
 typedef struct XAie_BackendOps {
 	AieRC (*Init)(XAie_DevInst *DevInst);
@@ -105,6 +150,7 @@ typedef struct XAie_BackendOps {
 	AieRC (*MemSyncForDev)(XAie_MemInst *MemInst);
 	AieRC (*MemAttach)(XAie_MemInst *MemInst, u64 MemHandle);
 	AieRC (*MemDetach)(XAie_MemInst *MemInst);
+	AieRC (*SubmitTxn)(void *IOInst, XAie_TxnInst *TxnInst);
 } XAie_BackendOps;
 
 /* Typedef to capture all backend information */
@@ -0,0 +1,725 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_shadow.c
+* @{
+*
+* This file contains the routines for the shadow register cache. When the
+* cache is enabled, the driver keeps the last value written to every
+* configuration register of the partition, as listed by the shadow module of
+* the tile type. With it, writes of the value already in a register are
+* skipped, mask writes are computed without reading the register and reads
+* of configuration registers don't go to the backend.
+*
+* A cached value is valid once the register has been written or read through
+* a backend which can read. Backend operations which reset or reconfigure the
+* tiles, column resets, cancelled or failed transactions and backend changes
+* invalidate the cache.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   agent   10/17/2026  Initial creation
+*       agent   10/17/2026  Cache the registers in the gaps of repeated ranges
+* </pre>
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "xaie_helper.h"
+#include "xaie_io.h"
+#include "xaie_shadow.h"
+
+/**************************** Type Definitions *******************************/
+/*
+ * Typedef for the shadow register cache of a partition. The cached values of
+ * a tile start at TileBase[Col * NumRows + Row], in the order of the ranges
+ * of the shadow module of the tile type.
+ */
+struct XAie_ShadowInst {
+	u32 *Values;	/* Cached register values */
+	u32 *Valid;	/* Bitmap of the valid cached values */
+	u32 *TileBase;	/* Index of the first cached value of each tile */
+	u8 *TileType;	/* Tile type of each tile */
+	u32 NumValues;	/* Number of cached values of the partition */
+};
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This function frees a shadow register cache.
+*
+* @param	ShadowInst: Shadow register cache pointer.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_ShadowFree(XAie_ShadowInst *ShadowInst)
+{
+	free(ShadowInst->Values);
+	free(ShadowInst->Valid);
+	free(ShadowInst->TileBase);
+	free(ShadowInst->TileType);
+	free(ShadowInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the number of registers of a register range.
+*
+* @param	Range: Register range.
+*
+* @return	Number of registers.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static inline u32 _XAie_ShadowRangeRegs(const XAie_RegRange *Range)
+{
+	return (u32)Range->NumRegs * Range->NumRepeats;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the offset following the last register of a register
+* range.
+*
+* @param	Range: Register range.
+*
+* @return	End offset of the range.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static inline u32 _XAie_ShadowRangeEnd(const XAie_RegRange *Range)
+{
+	return Range->RegOff + ((Range->NumRepeats - 1U) * Range->Stride) +
+		(Range->NumRegs * 4U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function finds the tile of a register offset and the shadow module of
+* its tile type.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Register offset.
+* @param	Tile: Pointer to return the tile index.
+* @param	TileOff: Pointer to return the offset within the tile.
+*
+* @return	Shadow module of the tile, NULL if the tile has no cached
+*		registers.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static const XAie_ShadowMod* _XAie_ShadowGetTile(XAie_DevInst *DevInst,
+		u64 RegOff, u32 *Tile, u32 *TileOff)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+	u64 Col, Row;
+	u8 TileType;
+
+	Col = RegOff >> DevInst->DevProp.ColShift;
+	Row = (RegOff >> DevInst->DevProp.RowShift) &
+		((1U << (DevInst->DevProp.ColShift -
+			 DevInst->DevProp.RowShift)) - 1U);
+	if((Col >= DevInst->NumCols) || (Row >= DevInst->NumRows)) {
+		return NULL;
+	}
+
+	*Tile = (u32)((Col * DevInst->NumRows) + Row);
+	*TileOff = (u32)(RegOff & ((1U << DevInst->DevProp.RowShift) - 1U));
+	TileType = ShadowInst->TileType[*Tile];
+	if(TileType >= XAIEGBL_TILE_TYPE_MAX) {
+		return NULL;
+	}
+
+	return DevInst->DevProp.DevMod[TileType].ShadowMod;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the index of the cached value of a register.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Register offset.
+* @param	Index: Pointer to return the index of the cached value.
+*
+* @return	XAIE_OK if the register is cached, XAIE_ERR otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_ShadowGetIndex(XAie_DevInst *DevInst, u64 RegOff,
+		u32 *Index)
+{
+	const XAie_ShadowMod *ShadowMod;
+	const XAie_RegRange *Range;
+	u32 Tile, TileOff, Base, Rel, Rep, Word;
+
+	ShadowMod = _XAie_ShadowGetTile(DevInst, RegOff, &Tile, &TileOff);
+	if(ShadowMod == NULL) {
+		return XAIE_ERR;
+	}
+
+	Base = DevInst->ShadowInst->TileBase[Tile];
+	for(u8 R = 0U; R < ShadowMod->NumRanges; R++) {
+		Range = &ShadowMod->Ranges[R];
+		if(TileOff < Range->RegOff) {
+			break;
+		}
+
+		if(TileOff < _XAie_ShadowRangeEnd(Range)) {
+			Rel = TileOff - Range->RegOff;
+			Rep = (Range->Stride != 0U) ? (Rel / Range->Stride) :
+				0U;
+			Word = (Rel - (Rep * Range->Stride)) / 4U;
+			/* Gaps of repeated ranges can hold other ranges */
+			if(Word < Range->NumRegs) {
+				*Index = Base + (Rep * Range->NumRegs) + Word;
+				return XAIE_OK;
+			}
+		}
+
+		Base += _XAie_ShadowRangeRegs(Range);
+	}
+
+	return XAIE_ERR;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function updates the cache for a block of registers written with Data,
+* or set to Value if Data is NULL.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Offset of the first register.
+* @param	Data: Values written, NULL to set all registers to Value.
+* @param	Value: Value set if Data is NULL.
+* @param	Size: Number of registers.
+*
+* @return	1 if all the registers are cached and already hold the values
+*		written, 0 otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static u8 _XAie_ShadowUpdate(XAie_DevInst *DevInst, u64 RegOff,
+		const u32 *Data, u32 Value, u32 Size)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+	const XAie_ShadowMod *ShadowMod;
+	const XAie_RegRange *Range;
+	u32 Tile, TileOff, Base, Rel, Rep, Word, Index, NewVal;
+	u32 Start, End, RangeEnd, NumCached = 0U;
+	u8 Redundant = 1U;
+
+	ShadowMod = _XAie_ShadowGetTile(DevInst, RegOff, &Tile, &TileOff);
+	if(ShadowMod == NULL) {
+		return 0U;
+	}
+
+	if(((u64)TileOff + ((u64)Size * 4U)) >
+			(1U << DevInst->DevProp.RowShift)) {
+		/* Blocks don't span tiles, don't track them if they do */
+		_XAie_ShadowInvalidate(DevInst);
+		return 0U;
+	}
+
+	End = TileOff + (Size * 4U);
+	Base = ShadowInst->TileBase[Tile];
+	for(u8 R = 0U; R < ShadowMod->NumRanges; R++) {
+		Range = &ShadowMod->Ranges[R];
+		if(Range->RegOff >= End) {
+			break;
+		}
+
+		RangeEnd = _XAie_ShadowRangeEnd(Range);
+		if(RangeEnd <= TileOff) {
+			Base += _XAie_ShadowRangeRegs(Range);
+			continue;
+		}
+
+		Start = (TileOff > Range->RegOff) ? TileOff : Range->RegOff;
+		RangeEnd = (RangeEnd < End) ? RangeEnd : End;
+		for(u32 Off = Start; Off < RangeEnd; Off += 4U) {
+			Rel = Off - Range->RegOff;
+			Rep = (Range->Stride != 0U) ? (Rel / Range->Stride) :
+				0U;
+			Word = (Rel - (Rep * Range->Stride)) / 4U;
+			if(Word >= Range->NumRegs) {
+				continue;
+			}
+
+			Index = Base + (Rep * Range->NumRegs) + Word;
+			NewVal = (Data != NULL) ? Data[(Off - TileOff) / 4U] :
+				Value;
+			if((CheckBit(ShadowInst->Valid, Index) == 0U) ||
+					(ShadowInst->Values[Index] != NewVal)) {
+				Redundant = 0U;
+			}
+
+			ShadowInst->Values[Index] = NewVal;
+			_XAie_SetBitInBitmap(ShadowInst->Valid, Index, 1U);
+			NumCached++;
+		}
+
+		Base += _XAie_ShadowRangeRegs(Range);
+	}
+
+	return ((NumCached == Size) && (Redundant != 0U)) ? 1U : 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks if the backend reads the hardware registers, so that
+* values read can be cached.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	1 if the backend reads the registers, 0 otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static u8 _XAie_ShadowCanRead(XAie_DevInst *DevInst)
+{
+	switch(DevInst->Backend->Type) {
+	case XAIE_IO_BACKEND_METAL:
+	case XAIE_IO_BACKEND_SIM:
+	case XAIE_IO_BACKEND_BAREMETAL:
+	case XAIE_IO_BACKEND_LINUX:
+		return 1U;
+	default:
+		return 0U;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function updates the cache for a register write.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Register offset.
+* @param	Value: Value written.
+*
+* @return	1 if the register already holds the value and the write can be
+*		skipped, 0 otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+u8 _XAie_ShadowWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Value)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+	u32 Index;
+
+	if(_XAie_ShadowGetIndex(DevInst, RegOff, &Index) != XAIE_OK) {
+		return 0U;
+	}
+
+	if((CheckBit(ShadowInst->Valid, Index) != 0U) &&
+			(ShadowInst->Values[Index] == Value)) {
+		return 1U;
+	}
+
+	ShadowInst->Values[Index] = Value;
+	_XAie_SetBitInBitmap(ShadowInst->Valid, Index, 1U);
+
+	return 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads a register from the cache.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Register offset.
+* @param	Value: Pointer to return the register value.
+*
+* @return	1 if the value is cached, 0 if the register must be read.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+u8 _XAie_ShadowRead32(XAie_DevInst *DevInst, u64 RegOff, u32 *Value)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+	u32 Index;
+
+	if((_XAie_ShadowGetIndex(DevInst, RegOff, &Index) != XAIE_OK) ||
+			(CheckBit(ShadowInst->Valid, Index) == 0U)) {
+		return 0U;
+	}
+
+	*Value = ShadowInst->Values[Index];
+
+	return 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function caches the value read from a register.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Register offset.
+* @param	Value: Value read.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+void _XAie_ShadowFill(XAie_DevInst *DevInst, u64 RegOff, u32 Value)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+	u32 Index;
+
+	if((_XAie_ShadowCanRead(DevInst) == 0U) ||
+			(_XAie_ShadowGetIndex(DevInst, RegOff, &Index) !=
+			 XAIE_OK)) {
+		return;
+	}
+
+	ShadowInst->Values[Index] = Value;
+	_XAie_SetBitInBitmap(ShadowInst->Valid, Index, 1U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function computes the value of a register after a mask write. If the
+* register value isn't cached yet, it is read first when the backend can read
+* and no transaction is open.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Register offset.
+* @param	Mask: Mask of the bits written.
+* @param	Value: Value written.
+* @param	RegVal: Pointer to return the value to write to the register.
+*
+* @return	1 if the value is computed, 0 if the mask write must be issued
+*		to the backend.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+u8 _XAie_ShadowMaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 *RegVal)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+	const XAie_Backend *Backend = DevInst->Backend;
+	u32 Index;
+
+	if(_XAie_ShadowGetIndex(DevInst, RegOff, &Index) != XAIE_OK) {
+		return 0U;
+	}
+
+	if(CheckBit(ShadowInst->Valid, Index) == 0U) {
+		if((DevInst->TxnInst != NULL) ||
+				(_XAie_ShadowCanRead(DevInst) == 0U)) {
+			return 0U;
+		}
+
+		ShadowInst->Values[Index] = Backend->Ops.Read32(
+				DevInst->IOInst, RegOff);
+		_XAie_SetBitInBitmap(ShadowInst->Valid, Index, 1U);
+	}
+
+	/* Same result as the read modify write of the backends */
+	*RegVal = (ShadowInst->Values[Index] & ~Mask) | Value;
+
+	return 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function updates the cache for a block write.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Offset of the first register.
+* @param	Data: Values written.
+* @param	Size: Number of registers.
+*
+* @return	1 if all the registers already hold the values and the write
+*		can be skipped, 0 otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+u8 _XAie_ShadowBlockWrite32(XAie_DevInst *DevInst, u64 RegOff,
+		const u32 *Data, u32 Size)
+{
+	return _XAie_ShadowUpdate(DevInst, RegOff, Data, 0U, Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function updates the cache for a block set.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Offset of the first register.
+* @param	Data: Value set.
+* @param	Size: Number of registers.
+*
+* @return	1 if all the registers already hold the value and the write
+*		can be skipped, 0 otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+u8 _XAie_ShadowBlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	return _XAie_ShadowUpdate(DevInst, RegOff, NULL, Data, Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function invalidates the cache after a backend operation which may
+* change the registers behind the driver.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Op: Backend operation.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+void _XAie_ShadowRunOp(XAie_DevInst *DevInst, XAie_BackendOpCode Op)
+{
+	switch(Op) {
+	case XAIE_BACKEND_OP_NPIWR32:
+	case XAIE_BACKEND_OP_SET_PROTREG:
+		break;
+	default:
+		_XAie_ShadowInvalidate(DevInst);
+		break;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function invalidates all the cached values.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+void _XAie_ShadowInvalidate(XAie_DevInst *DevInst)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+
+	if(ShadowInst == NULL) {
+		return;
+	}
+
+	XAIE_DBG("Invalidating shadow register cache\n");
+	memset(ShadowInst->Valid, 0, ((ShadowInst->NumValues + 32U) / 32U) *
+			sizeof(*ShadowInst->Valid));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function invalidates the cached values of the tiles of a column.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Col: Column number.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+void _XAie_ShadowInvalidateCol(XAie_DevInst *DevInst, u8 Col)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+	u32 Start, End;
+
+	if((ShadowInst == NULL) || (Col >= DevInst->NumCols)) {
+		return;
+	}
+
+	Start = ShadowInst->TileBase[Col * DevInst->NumRows];
+	End = ShadowInst->TileBase[(Col + 1U) * DevInst->NumRows];
+	for(u32 Index = Start; Index < End; Index++) {
+		ShadowInst->Valid[Index / 32U] &= ~(1U << (Index % 32U));
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API enables the shadow register cache of the partition. From then on,
+* writes which don't change a configuration register are skipped, mask writes
+* are computed from the cached values and reads of cached configuration
+* registers don't go to the backend.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		The cache assumes the driver is the only one writing to the
+*		configuration registers of the partition. If the registers
+*		are changed outside of the driver, XAie_ShadowCacheInvalidate()
+*		must be called.
+*
+*******************************************************************************/
+AieRC XAie_ShadowCacheEnable(XAie_DevInst *DevInst)
+{
+	XAie_ShadowInst *ShadowInst;
+	const XAie_ShadowMod *ShadowMod;
+	u32 NumTiles, Tile;
+	u8 TileType;
+
+	if((DevInst == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(DevInst->ShadowInst != NULL) {
+		return XAIE_OK;
+	}
+
+	NumTiles = (u32)DevInst->NumCols * DevInst->NumRows;
+	ShadowInst = (XAie_ShadowInst *)calloc(1U, sizeof(*ShadowInst));
+	if(ShadowInst == NULL) {
+		XAIE_ERROR("Memory allocation failed\n");
+		return XAIE_ERR;
+	}
+
+	ShadowInst->TileBase = (u32 *)malloc((NumTiles + 1U) *
+			sizeof(*ShadowInst->TileBase));
+	ShadowInst->TileType = (u8 *)malloc(NumTiles);
+	if((ShadowInst->TileBase == NULL) || (ShadowInst->TileType == NULL)) {
+		XAIE_ERROR("Memory allocation failed\n");
+		_XAie_ShadowFree(ShadowInst);
+		return XAIE_ERR;
+	}
+
+	for(u8 C = 0U; C < DevInst->NumCols; C++) {
+		for(u8 R = 0U; R < DevInst->NumRows; R++) {
+			Tile = ((u32)C * DevInst->NumRows) + R;
+			TileType = _XAie_GetTileTypefromLoc(DevInst,
+					XAie_TileLoc(C, R));
+			ShadowInst->TileType[Tile] = TileType;
+			ShadowInst->TileBase[Tile] = ShadowInst->NumValues;
+			if(TileType >= XAIEGBL_TILE_TYPE_MAX) {
+				continue;
+			}
+
+			ShadowMod = DevInst->DevProp.DevMod[TileType].ShadowMod;
+			if(ShadowMod == NULL) {
+				continue;
+			}
+
+			for(u8 I = 0U; I < ShadowMod->NumRanges; I++) {
+				ShadowInst->NumValues += _XAie_ShadowRangeRegs(
+						&ShadowMod->Ranges[I]);
+			}
+		}
+	}
+	ShadowInst->TileBase[NumTiles] = ShadowInst->NumValues;
+
+	ShadowInst->Values = (u32 *)malloc((ShadowInst->NumValues + 1U) *
+			sizeof(*ShadowInst->Values));
+	ShadowInst->Valid = (u32 *)calloc((ShadowInst->NumValues + 32U) / 32U,
+			sizeof(*ShadowInst->Valid));
+	if((ShadowInst->Values == NULL) || (ShadowInst->Valid == NULL)) {
+		XAIE_ERROR("Memory allocation failed\n");
+		_XAie_ShadowFree(ShadowInst);
+		return XAIE_ERR;
+	}
+
+	XAIE_DBG("Shadow register cache of %u registers enabled\n",
+			ShadowInst->NumValues);
+	DevInst->ShadowInst = ShadowInst;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API disables the shadow register cache of the partition and frees it.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+*******************************************************************************/
+AieRC XAie_ShadowCacheDisable(XAie_DevInst *DevInst)
+{
+	if(DevInst == XAIE_NULL) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(DevInst->ShadowInst != NULL) {
+		_XAie_ShadowFree(DevInst->ShadowInst);
+		DevInst->ShadowInst = NULL;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API drops all the cached register values, for example after the
+* configuration registers were changed outside of the driver.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+*******************************************************************************/
+AieRC XAie_ShadowCacheInvalidate(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) || (DevInst->ShadowInst == NULL)) {
+		XAIE_ERROR("Shadow register cache is not enabled\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	_XAie_ShadowInvalidate(DevInst);
+
+	return XAIE_OK;
+}
+
+/** @} */
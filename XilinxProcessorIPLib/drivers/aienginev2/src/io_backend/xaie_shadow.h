@@ -0,0 +1,49 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_shadow.h
+* @{
+*
+* Header file for the shadow register cache.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   agent   10/17/2026  Initial creation
+* </pre>
+*
+******************************************************************************/
+#ifndef XAIESHADOW_H
+#define XAIESHADOW_H
+
+/***************************** Include Files *********************************/
+#include "xaie_io.h"
+#include "xaiegbl.h"
+
+/************************** Function Prototypes  *****************************/
+AieRC XAie_ShadowCacheEnable(XAie_DevInst *DevInst);
+AieRC XAie_ShadowCacheDisable(XAie_DevInst *DevInst);
+AieRC XAie_ShadowCacheInvalidate(XAie_DevInst *DevInst);
+
+u8 _XAie_ShadowWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Value);
+u8 _XAie_ShadowRead32(XAie_DevInst *DevInst, u64 RegOff, u32 *Value);
+void _XAie_ShadowFill(XAie_DevInst *DevInst, u64 RegOff, u32 Value);
+u8 _XAie_ShadowMaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 *RegVal);
+u8 _XAie_ShadowBlockWrite32(XAie_DevInst *DevInst, u64 RegOff,
+		const u32 *Data, u32 Size);
+u8 _XAie_ShadowBlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
+		u32 Size);
+void _XAie_ShadowRunOp(XAie_DevInst *DevInst, XAie_BackendOpCode Op);
+void _XAie_ShadowInvalidate(XAie_DevInst *DevInst);
+void _XAie_ShadowInvalidateCol(XAie_DevInst *DevInst, u8 Col);
+
+#endif		/* end of protection macro */
+/** @} */
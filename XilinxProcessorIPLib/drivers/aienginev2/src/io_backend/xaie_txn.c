@@ -0,0 +1,596 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_txn.c
+* @{
+*
+* This file contains the routines for IO transactions. Between
+* XAie_StartTransaction() and XAie_SubmitTransaction(), the writes, mask
+* writes, block writes, block sets and mask polls of the driver are recorded
+* instead of being issued to the backend. Writes to contiguous addresses are
+* merged into block writes while recording. On submit, the recorded commands
+* are given to the SubmitTxn operation of the backend, or replayed through
+* its IO operations if the backend has none.
+*
+* Reads, backend operations and command writes can't be deferred. They
+* execute the commands recorded so far first and the transaction stays open.
+* Recorded mask polls always return XAIE_SUCCESS to the caller, a timeout is
+* reported by XAie_SubmitTransaction().
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   agent   10/17/2026  Initial creation
+* 1.1   agent   10/17/2026  Invalidate the shadow register cache on dropped
+*                           commands.
+* </pre>
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "xaie_helper.h"
+#include "xaie_io.h"
+#include "xaie_txn.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_TXN_INIT_CMDS		64U
+#define XAIE_TXN_INIT_DATA_WORDS	256U
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This function frees a transaction instance.
+*
+* @param	TxnInst: Transaction instance pointer.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_TxnFree(XAie_TxnInst *TxnInst)
+{
+	free(TxnInst->CmdBuf);
+	free(TxnInst->DataBuf);
+	free(TxnInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns a new command at the end of the transaction, growing
+* the command buffer if required.
+*
+* @param	TxnInst: Transaction instance pointer.
+*
+* @return	Pointer to the new command, NULL if the allocation failed.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static XAie_TxnCmd* _XAie_TxnAllocCmd(XAie_TxnInst *TxnInst)
+{
+	XAie_TxnCmd *Cmd;
+
+	if(TxnInst->NumCmds == TxnInst->MaxCmds) {
+		Cmd = (XAie_TxnCmd *)realloc(TxnInst->CmdBuf,
+				2U * TxnInst->MaxCmds * sizeof(*Cmd));
+		if(Cmd == NULL) {
+			XAIE_ERROR("Failed to grow transaction commands\n");
+			TxnInst->NumErrors++;
+			return NULL;
+		}
+		TxnInst->CmdBuf = Cmd;
+		TxnInst->MaxCmds *= 2U;
+	}
+
+	Cmd = &TxnInst->CmdBuf[TxnInst->NumCmds];
+	memset(Cmd, 0, sizeof(*Cmd));
+
+	return Cmd;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function makes room for Size more words in the data buffer of the
+* transaction.
+*
+* @param	TxnInst: Transaction instance pointer.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, XAIE_ERR if the allocation failed.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_TxnReserveData(XAie_TxnInst *TxnInst, u32 Size)
+{
+	u32 MaxDataWords = TxnInst->MaxDataWords;
+	u32 *DataBuf;
+
+	if((TxnInst->NumDataWords + Size) <= MaxDataWords) {
+		return XAIE_OK;
+	}
+
+	while((TxnInst->NumDataWords + Size) > MaxDataWords) {
+		MaxDataWords *= 2U;
+	}
+
+	DataBuf = (u32 *)realloc(TxnInst->DataBuf,
+			MaxDataWords * sizeof(*DataBuf));
+	if(DataBuf == NULL) {
+		XAIE_ERROR("Failed to grow transaction data\n");
+		TxnInst->NumErrors++;
+		return XAIE_ERR;
+	}
+	TxnInst->DataBuf = DataBuf;
+	TxnInst->MaxDataWords = MaxDataWords;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the last command of the transaction if a write of
+* Size words at RegOff can be appended to it. That is the case for a write or
+* a block write which ends at RegOff and whose data is at the end of the data
+* buffer. A write is turned into a block write of one word. Room for Size
+* words is reserved in the data buffer.
+*
+* @param	TxnInst: Transaction instance pointer.
+* @param	RegOff: Register offset of the write.
+* @param	Size: Number of 32-bit words of the write.
+*
+* @return	Pointer to the command to append to, NULL if there is none.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static XAie_TxnCmd* _XAie_TxnMergeCmd(XAie_TxnInst *TxnInst, u64 RegOff,
+		u32 Size)
+{
+	XAie_TxnCmd *Cmd;
+
+	if(((TxnInst->Flags & XAIE_TXN_NO_MERGE) != 0U) ||
+			(TxnInst->NumCmds == 0U)) {
+		return NULL;
+	}
+
+	Cmd = &TxnInst->CmdBuf[TxnInst->NumCmds - 1U];
+	if((Cmd->Opcode == XAIE_TXN_OP_WRITE) &&
+			((Cmd->RegOff + 4U) == RegOff)) {
+		if(_XAie_TxnReserveData(TxnInst, Size + 1U) != XAIE_OK) {
+			return NULL;
+		}
+		Cmd->Opcode = XAIE_TXN_OP_BLOCKWRITE;
+		Cmd->DataOff = TxnInst->NumDataWords;
+		Cmd->Size = 1U;
+		TxnInst->DataBuf[TxnInst->NumDataWords++] = Cmd->Value;
+		return Cmd;
+	}
+
+	if((Cmd->Opcode == XAIE_TXN_OP_BLOCKWRITE) &&
+			((Cmd->RegOff + (u64)Cmd->Size * 4U) == RegOff) &&
+			((Cmd->DataOff + Cmd->Size) == TxnInst->NumDataWords)) {
+		if(_XAie_TxnReserveData(TxnInst, Size) != XAIE_OK) {
+			return NULL;
+		}
+		return Cmd;
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function records a block write. It is appended to the previous
+* command when that writes the addresses right before RegOff.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Register offset to write to.
+* @param	Data: Pointer to the data buffer.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only. Data is copied to the transaction.
+*
+*******************************************************************************/
+void _XAie_TxnBlockWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+	XAie_TxnCmd *Cmd;
+
+	Cmd = _XAie_TxnMergeCmd(TxnInst, RegOff, Size);
+	if(Cmd == NULL) {
+		if(_XAie_TxnReserveData(TxnInst, Size) != XAIE_OK) {
+			return;
+		}
+		Cmd = _XAie_TxnAllocCmd(TxnInst);
+		if(Cmd == NULL) {
+			return;
+		}
+		Cmd->Opcode = XAIE_TXN_OP_BLOCKWRITE;
+		Cmd->RegOff = RegOff;
+		Cmd->DataOff = TxnInst->NumDataWords;
+		TxnInst->NumCmds++;
+	}
+
+	memcpy(&TxnInst->DataBuf[TxnInst->NumDataWords], Data,
+			Size * sizeof(*Data));
+	TxnInst->NumDataWords += Size;
+	Cmd->Size += Size;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function records a 32-bit write.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Register offset to write to.
+* @param	Value: 32-bit data to be written.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+void _XAie_TxnWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Value)
+{
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+	XAie_TxnCmd *Cmd;
+
+	Cmd = _XAie_TxnMergeCmd(TxnInst, RegOff, 1U);
+	if(Cmd != NULL) {
+		TxnInst->DataBuf[TxnInst->NumDataWords++] = Value;
+		Cmd->Size++;
+		return;
+	}
+
+	Cmd = _XAie_TxnAllocCmd(TxnInst);
+	if(Cmd == NULL) {
+		return;
+	}
+	Cmd->Opcode = XAIE_TXN_OP_WRITE;
+	Cmd->RegOff = RegOff;
+	Cmd->Value = Value;
+	TxnInst->NumCmds++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function records a masked 32-bit write.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Register offset to write to.
+* @param	Mask: Mask to be applied to Data.
+* @param	Value: 32-bit data to be written.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+void _XAie_TxnMaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value)
+{
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+	XAie_TxnCmd *Cmd;
+
+	Cmd = _XAie_TxnAllocCmd(TxnInst);
+	if(Cmd == NULL) {
+		return;
+	}
+	Cmd->Opcode = XAIE_TXN_OP_MASKWRITE;
+	Cmd->RegOff = RegOff;
+	Cmd->Mask = Mask;
+	Cmd->Value = Value;
+	TxnInst->NumCmds++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function records a mask poll.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Register offset to poll.
+* @param	Mask: Mask to be applied to Data.
+* @param	Value: 32-bit value to poll for
+* @param	TimeOutUs: Timeout in micro seconds.
+*
+* @return	XAIE_SUCCESS, the result of the poll is known on submit only.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+u32 _XAie_TxnMaskPoll(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 TimeOutUs)
+{
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+	XAie_TxnCmd *Cmd;
+
+	Cmd = _XAie_TxnAllocCmd(TxnInst);
+	if(Cmd == NULL) {
+		return XAIE_FAILURE;
+	}
+	Cmd->Opcode = XAIE_TXN_OP_MASKPOLL;
+	Cmd->RegOff = RegOff;
+	Cmd->Mask = Mask;
+	Cmd->Value = Value;
+	Cmd->TimeOutUs = TimeOutUs;
+	TxnInst->NumCmds++;
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function records a block set.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Register offset to write to.
+* @param	Data: Data to initialize the address range with.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+void _XAie_TxnBlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+	XAie_TxnCmd *Cmd;
+
+	Cmd = _XAie_TxnAllocCmd(TxnInst);
+	if(Cmd == NULL) {
+		return;
+	}
+	Cmd->Opcode = XAIE_TXN_OP_BLOCKSET;
+	Cmd->RegOff = RegOff;
+	Cmd->Value = Data;
+	Cmd->Size = Size;
+	TxnInst->NumCmds++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function replays the commands of a transaction through the IO
+* operations of the backend.
+*
+* @param	Backend: Backend pointer.
+* @param	IOInst: IO instance pointer.
+* @param	TxnInst: Transaction instance pointer.
+*
+* @return	XAIE_OK on success, XAIE_ERR if any mask poll timed out.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_TxnReplay(const XAie_Backend *Backend, void *IOInst,
+		XAie_TxnInst *TxnInst)
+{
+	AieRC RC = XAIE_OK;
+	XAie_TxnCmd *Cmd;
+
+	for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
+		Cmd = &TxnInst->CmdBuf[i];
+
+		switch(Cmd->Opcode) {
+		case XAIE_TXN_OP_WRITE:
+			Backend->Ops.Write32(IOInst, Cmd->RegOff, Cmd->Value);
+			break;
+		case XAIE_TXN_OP_BLOCKWRITE:
+			Backend->Ops.BlockWrite32(IOInst, Cmd->RegOff,
+					&TxnInst->DataBuf[Cmd->DataOff],
+					Cmd->Size);
+			break;
+		case XAIE_TXN_OP_BLOCKSET:
+			Backend->Ops.BlockSet32(IOInst, Cmd->RegOff,
+					Cmd->Value, Cmd->Size);
+			break;
+		case XAIE_TXN_OP_MASKWRITE:
+			Backend->Ops.MaskWrite32(IOInst, Cmd->RegOff,
+					Cmd->Mask, Cmd->Value);
+			break;
+		case XAIE_TXN_OP_MASKPOLL:
+			if(Backend->Ops.MaskPoll(IOInst, Cmd->RegOff,
+					Cmd->Mask, Cmd->Value,
+					Cmd->TimeOutUs) != XAIE_SUCCESS) {
+				XAIE_ERROR("Mask poll of 0x%lx timed out\n",
+						Cmd->RegOff);
+				RC = XAIE_ERR;
+			}
+			break;
+		default:
+			XAIE_ERROR("Invalid transaction opcode %d\n",
+					Cmd->Opcode);
+			RC = XAIE_ERR;
+			break;
+		}
+	}
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function executes the commands recorded so far and empties the
+* transaction, which stays open.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	None.
+*
+* @note		Internal only. Called before any IO which can't be recorded.
+*
+*******************************************************************************/
+void _XAie_TxnFlush(XAie_DevInst *DevInst)
+{
+	const XAie_Backend *Backend = DevInst->Backend;
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+	AieRC RC;
+
+	if(TxnInst->NumCmds == 0U) {
+		return;
+	}
+
+	XAIE_DBG("Executing %u transaction commands\n", TxnInst->NumCmds);
+
+	if(Backend->Ops.SubmitTxn != NULL) {
+		RC = Backend->Ops.SubmitTxn(DevInst->IOInst, TxnInst);
+	} else {
+		RC = _XAie_TxnReplay(Backend, DevInst->IOInst, TxnInst);
+	}
+	if(RC != XAIE_OK) {
+		TxnInst->NumErrors++;
+		_XAie_ShadowInvalidate(DevInst);
+	}
+
+	TxnInst->NumCmds = 0U;
+	TxnInst->NumDataWords = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API starts a transaction on the partition. Until the transaction is
+* submitted, the register writes, mask writes, block writes and mask polls
+* of all the driver APIs are recorded and issued to the backend together on
+* XAie_SubmitTransaction().
+*
+* @param	DevInst: Device instance pointer.
+* @param	Flags: XAIE_TXN_NO_MERGE to keep contiguous writes separate.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Recorded mask polls return XAIE_SUCCESS, so APIs which
+*		depend on the result of a poll must not be called within a
+*		transaction. Reads see the effect of all the writes recorded
+*		before them.
+*
+*******************************************************************************/
+AieRC XAie_StartTransaction(XAie_DevInst *DevInst, u32 Flags)
+{
+	XAie_TxnInst *TxnInst;
+
+	if((DevInst == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(DevInst->TxnInst != NULL) {
+		XAIE_ERROR("Transaction already in progress\n");
+		return XAIE_ERR;
+	}
+
+	TxnInst = (XAie_TxnInst *)calloc(1U, sizeof(*TxnInst));
+	if(TxnInst == NULL) {
+		XAIE_ERROR("Memory allocation failed\n");
+		return XAIE_ERR;
+	}
+
+	TxnInst->CmdBuf = (XAie_TxnCmd *)malloc(XAIE_TXN_INIT_CMDS *
+			sizeof(*TxnInst->CmdBuf));
+	TxnInst->DataBuf = (u32 *)malloc(XAIE_TXN_INIT_DATA_WORDS *
+			sizeof(*TxnInst->DataBuf));
+	if((TxnInst->CmdBuf == NULL) || (TxnInst->DataBuf == NULL)) {
+		XAIE_ERROR("Memory allocation failed\n");
+		_XAie_TxnFree(TxnInst);
+		return XAIE_ERR;
+	}
+
+	TxnInst->Flags = Flags;
+	TxnInst->MaxCmds = XAIE_TXN_INIT_CMDS;
+	TxnInst->MaxDataWords = XAIE_TXN_INIT_DATA_WORDS;
+	DevInst->TxnInst = TxnInst;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API executes all the commands recorded since XAie_StartTransaction()
+* in order and ends the transaction.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success, XAIE_ERR if a recorded mask poll timed out.
+*
+* @note		None.
+*
+*******************************************************************************/
+AieRC XAie_SubmitTransaction(XAie_DevInst *DevInst)
+{
+	XAie_TxnInst *TxnInst;
+	AieRC RC = XAIE_OK;
+
+	if((DevInst == XAIE_NULL) || (DevInst->TxnInst == NULL)) {
+		XAIE_ERROR("No transaction in progress\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	TxnInst = DevInst->TxnInst;
+	_XAie_TxnFlush(DevInst);
+	if(TxnInst->NumErrors != 0U) {
+		RC = XAIE_ERR;
+	}
+
+	DevInst->TxnInst = NULL;
+	_XAie_TxnFree(TxnInst);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API ends the transaction and drops the commands which are not yet
+* executed.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Commands executed before a read in the transaction are not
+*		undone.
+*
+*******************************************************************************/
+AieRC XAie_CancelTransaction(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) || (DevInst->TxnInst == NULL)) {
+		XAIE_ERROR("No transaction in progress\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	_XAie_TxnFree(DevInst->TxnInst);
+	DevInst->TxnInst = NULL;
+	_XAie_ShadowInvalidate(DevInst);
+
+	return XAIE_OK;
+}
+
+/** @} */
@@ -0,0 +1,50 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_txn.h
+* @{
+*
+* Header file for IO transactions.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   agent   10/17/2026  Initial creation
+* </pre>
+*
+******************************************************************************/
+#ifndef XAIETXN_H
+#define XAIETXN_H
+
+/***************************** Include Files *********************************/
+#include "xaiegbl.h"
+
+/***************************** Macro Definitions *****************************/
+/* Transaction flags */
+#define XAIE_TXN_NO_MERGE	(1U << 0) /* Don't merge contiguous writes */
+
+/************************** Function Prototypes  *****************************/
+AieRC XAie_StartTransaction(XAie_DevInst *DevInst, u32 Flags);
+AieRC XAie_SubmitTransaction(XAie_DevInst *DevInst);
+AieRC XAie_CancelTransaction(XAie_DevInst *DevInst);
+
+void _XAie_TxnWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Value);
+void _XAie_TxnMaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value);
+u32 _XAie_TxnMaskPoll(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 TimeOutUs);
+void _XAie_TxnBlockWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data,
+		u32 Size);
+void _XAie_TxnBlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
+		u32 Size);
+void _XAie_TxnFlush(XAie_DevInst *DevInst);
+
+#endif		/* end of protection macro */
+/** @} */
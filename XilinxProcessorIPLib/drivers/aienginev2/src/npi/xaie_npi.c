@@ -296,4 +296,46 @@ AieRC _XAie_NpiIrqDisable(XAie_DevInst *DevInst, u8 NpiIrqID, u8 AieIrqID)
 	return _XAie_NpiIrqConfig(DevInst, XAIE_DISABLE, NpiIrqID, AieIrqID);
 }
 
+/*****************************************************************************/
+/**
+*
+* This NPI function checks if a register offset is one of the NPI registers
+* written by the driver.
+*
+* @param	DevInst : AI engine partition device pointer
+* @param	RegOff: NPI register offset.
+*
+* @return	1 if the driver writes the register, 0 otherwise
+*
+* @note		None.
+*
+*******************************************************************************/
+u8 _XAie_NpiIsDriverReg(XAie_DevInst *DevInst, u32 RegOff)
+{
+	XAie_NpiMod *NpiMod;
+
+	NpiMod = _XAie_NpiGetMod(DevInst);
+	if (NpiMod == NULL) {
+		return 0U;
+	}
+
+	if ((RegOff == NpiMod->PcsrMaskOff) ||
+			(RegOff == NpiMod->PcsrCntrOff) ||
+			(RegOff == NpiMod->PcsrLockOff) ||
+			(RegOff == NpiMod->ProtRegOff)) {
+		return 1U;
+	}
+
+	for (u32 i = 1U; i <= NpiMod->NpiIrqNum; i++) {
+		if ((RegOff == NpiMod->BaseIrqRegOff +
+					i * NpiMod->IrqEnableOff) ||
+				(RegOff == NpiMod->BaseIrqRegOff +
+					i * NpiMod->IrqDisableOff)) {
+			return 1U;
+		}
+	}
+
+	return 0U;
+}
+
 /** @} */
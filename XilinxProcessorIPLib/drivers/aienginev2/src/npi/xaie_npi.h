@@ -64,6 +64,7 @@ AieRC _XAie_NpiSetProtectedRegEnable(XAie_DevInst *DevInst,
 				    XAie_NpiProtRegReq *Req);
 AieRC _XAie_NpiIrqEnable(XAie_DevInst *DevInst, u8 NpiIrqID, u8 AieIrqID);
 AieRC _XAie_NpiIrqDisable(XAie_DevInst *DevInst, u8 NpiIrqID, u8 AieIrqID);
+u8 _XAie_NpiIsDriverReg(XAie_DevInst *DevInst, u32 RegOff);
 
 #endif	/* End of protection macro */
 
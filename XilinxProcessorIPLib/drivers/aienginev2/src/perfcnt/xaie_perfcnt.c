@@ -40,6 +40,7 @@
 * 1.3   Dishita 05/04/2020  Added Module argument to all apis
 * 1.4   Tejus   06/10/2020  Switch to new io backend apis.
 * 1.5   Dishita 09/15/2020  Add api to read perf counter control configuration.
+* 1.6   agent   10/17/2026  Add helper to get the address of a counter.
 *
 * </pre>
 *
@@ -53,37 +54,30 @@
 
 /************************** Function Definitions *****************************/
 /*****************************************************************************/
-/* This API reads the given performance counter for the given tile.
+/* This function returns the address of a performance counter register.
 *
 * @param	DevInst: Device Instance
-* @param	Loc: Location of AIE tile
+* @param	Loc: Location of the tile
 * @param	Module: Module of tile.
 *			For AIE Tile - XAIE_MEM_MOD or XAIE_CORE_MOD,
 *			For Pl or Shim tile - XAIE_PL_MOD,
 * @param	Counter:Performance Counter
-* @param	CounterVal: Pointer to store Counter Value
+* @param	CounterRegAddr: Pointer to store the register address
 * @return	XAIE_OK on success
 *		XAIE_INVALID_ARGS if any argument is invalid
 *		XAIE_INVALID_TILE if tile type from Loc is invalid
 *
-* @note
+* @note		Internal only.
 *
 ******************************************************************************/
-AieRC XAie_PerfCounterGet(XAie_DevInst *DevInst, XAie_LocType Loc,
-		XAie_ModuleType Module, u8 Counter, u32 *CounterVal)
+AieRC _XAie_PerfCounterGetRegAddr(XAie_DevInst *DevInst, XAie_LocType Loc,
+		XAie_ModuleType Module, u8 Counter, u64 *CounterRegAddr)
 {
 	u32 CounterRegOffset;
-	u64 CounterRegAddr;
 	u8 TileType;
 	AieRC RC;
 	const XAie_PerfMod *PerfMod;
 
-	if((DevInst == XAIE_NULL) || (CounterVal == XAIE_NULL) ||
-			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
-		XAIE_ERROR("Invalid Device Instance or CounterVal\n");
-		return XAIE_INVALID_ARGS;
-	}
-
 	TileType = _XAie_GetTileTypefromLoc(DevInst, Loc);
 	if(TileType == XAIEGBL_TILE_TYPE_MAX) {
 		XAIE_ERROR("Invalid Tile Type\n");
@@ -113,9 +107,48 @@ AieRC XAie_PerfCounterGet(XAie_DevInst *DevInst, XAie_LocType Loc,
 	CounterRegOffset = PerfMod->PerfCounterBaseAddr +
 				((Counter)*PerfMod->PerfCounterOffsetAdd);
 
-	/* Compute absolute address and write to register */
-	CounterRegAddr = _XAie_GetTileAddr(DevInst, Loc.Row, Loc.Col) +
+	/* Compute absolute address */
+	*CounterRegAddr = _XAie_GetTileAddr(DevInst, Loc.Row, Loc.Col) +
 		CounterRegOffset;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/* This API reads the given performance counter for the given tile.
+*
+* @param	DevInst: Device Instance
+* @param	Loc: Location of the tile
+* @param	Module: Module of tile.
+*			For AIE Tile - XAIE_MEM_MOD or XAIE_CORE_MOD,
+*			For Pl or Shim tile - XAIE_PL_MOD,
+* @param	Counter:Performance Counter
+* @param	CounterVal: Pointer to store Counter Value
+* @return	XAIE_OK on success
+*		XAIE_INVALID_ARGS if any argument is invalid
+*		XAIE_INVALID_TILE if tile type from Loc is invalid
+*
+* @note
+*
+******************************************************************************/
+AieRC XAie_PerfCounterGet(XAie_DevInst *DevInst, XAie_LocType Loc,
+		XAie_ModuleType Module, u8 Counter, u32 *CounterVal)
+{
+	u64 CounterRegAddr;
+	AieRC RC;
+
+	if((DevInst == XAIE_NULL) || (CounterVal == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance or CounterVal\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	RC = _XAie_PerfCounterGetRegAddr(DevInst, Loc, Module, Counter,
+			&CounterRegAddr);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
 	*CounterVal = XAie_Read32(DevInst, CounterRegAddr);
 
 	return XAIE_OK;
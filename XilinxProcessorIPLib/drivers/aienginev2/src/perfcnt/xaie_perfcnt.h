@@ -35,6 +35,7 @@
 * Ver   Who      Date     Changes
 * ----- ------   -------- -----------------------------------------------------
 * 1.0   Dishita  11/21/2019  Initial creation
+* 1.1   agent    10/17/2026  Add helper to get the address of a counter.
 * </pre>
 *
 ******************************************************************************/
@@ -71,4 +72,6 @@ AieRC XAie_PerfCounterEventValueReset(XAie_DevInst *DevInst, XAie_LocType Loc,
 AieRC XAie_PerfCounterGetControlConfig(XAie_DevInst *DevInst, XAie_LocType Loc,
 		XAie_ModuleType Module, u8 Counter, XAie_Events *StartEvent,
 		XAie_Events *StopEvent, XAie_Events *ResetEvent);
+AieRC _XAie_PerfCounterGetRegAddr(XAie_DevInst *DevInst, XAie_LocType Loc,
+		XAie_ModuleType Module, u8 Counter, u64 *CounterRegAddr);
 #endif		/* end of protection macro */
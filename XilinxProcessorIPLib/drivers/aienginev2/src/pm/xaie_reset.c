@@ -55,6 +55,9 @@ static void  _XAie_RstSetColumnReset(XAie_DevInst *DevInst,
 			PlIfMod->ColRst.Mask);
 
 	XAie_Write32(DevInst, RegAddr, FldVal);
+	if(RstEnable == XAIE_ENABLE) {
+		_XAie_ShadowInvalidateCol(DevInst, Loc.Col);
+	}
 }
 
 /*****************************************************************************/
@@ -9,6 +9,7 @@ extern "C" {
 #endif
 
 #include <xaiengine/xaie_clock.h>
+#include <xaiengine/xaie_collect.h>
 #include <xaiengine/xaie_core.h>
 #include <xaiengine/xaie_dma.h>
 #include <xaiengine/xaie_elfloader.h>
@@ -19,9 +20,12 @@ extern "C" {
 #include <xaiengine/xaie_perfcnt.h>
 #include <xaiengine/xaie_plif.h>
 #include <xaiengine/xaie_reset.h>
+#include <xaiengine/xaie_shadow.h>
+#include <xaiengine/xaie_snapshot.h>
 #include <xaiengine/xaie_ss.h>
 #include <xaiengine/xaie_timer.h>
 #include <xaiengine/xaie_trace.h>
+#include <xaiengine/xaie_txn.h>
 #include <xaiengine/xaiegbl.h>
 #include <xaiengine/xaiegbl_defs.h>
 
@@ -0,0 +1,357 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Host test of the trace and performance counter collection service
+ * (xaie_collect.c).
+ *
+ * The operations of the debug backend are replaced by a register file
+ * model. Lock acquires of the trace chunks succeed once the test marks the
+ * chunk as filled, as the shim DMA would, and the shim DMA BDs written by
+ * the driver are kept per BD. The backend type is changed to a hardware
+ * backend for the sampler thread, which the debug backend doesn't support.
+ *
+ * Checked are the counter snapshot and samples, the order of the drained
+ * trace chunks, that the drain is refused inside a transaction, that only
+ * one of concurrent starts creates a sampler thread, and that the trace BDs
+ * are invalidated when the setup fails and when the instance is destroyed.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <xaiengine.h>
+#include <xaiengine/xaie_helper.h>
+
+#define NUM_REGS	(1U << 16U)
+#define NUM_COUNTERS	4U
+#define MAX_SAMPLES	8U
+#define SHIM_COL	2U
+#define START_BD	4U
+#define NUM_BUFS	4U
+#define BUF_SIZE	64U
+#define MAX_BDS		16U
+#define SHIM_BD_WORDS	5U	/* Words of a shim BD, xaie_dma_aie.c */
+#define BD_EN_WORD	2U	/* Word of a shim BD with the valid bit */
+#define LOCK_VAL_OFF	0x20U	/* Locks with value, xaie_locks_aie.c */
+
+#define CHECK(Cond)	do { \
+	if (!(Cond)) { \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Cond); \
+		exit(EXIT_FAILURE); \
+	} \
+} while (0)
+
+static u64 RegOff[NUM_REGS];
+static u32 RegVal[NUM_REGS];
+static u8 RegUsed[NUM_REGS];
+static pthread_mutex_t RegLock = PTHREAD_MUTEX_INITIALIZER;
+static XAie_Backend Model;
+static XAie_DevInst *Dev;
+
+static u32 BdWords[MAX_BDS][SHIM_BD_WORDS];
+static void *BdVAddr[MAX_BDS];
+static u8 BdWritten[MAX_BDS];
+static u8 ChunkFull[MAX_BDS];
+static u32 NumReleases;
+
+/* Register file of the model, must be called with RegLock held */
+static u32 *Reg(u64 Off)
+{
+	u32 Idx = (u32)((Off * 0x9E3779B97F4A7C15ULL) >> 48U) &
+		(NUM_REGS - 1U);
+
+	while ((RegUsed[Idx] != 0U) && (RegOff[Idx] != Off)) {
+		Idx = (Idx + 1U) & (NUM_REGS - 1U);
+	}
+	if (RegUsed[Idx] == 0U) {
+		RegUsed[Idx] = 1U;
+		RegOff[Idx] = Off;
+		RegVal[Idx] = 0U;
+	}
+
+	return &RegVal[Idx];
+}
+
+static void SetReg(u64 Off, u32 Value)
+{
+	pthread_mutex_lock(&RegLock);
+	*Reg(Off) = Value;
+	pthread_mutex_unlock(&RegLock);
+}
+
+static void ModelWrite32(void *IOInst, u64 Off, u32 Value)
+{
+	(void)IOInst;
+	SetReg(Off, Value);
+}
+
+static u32 ModelRead32(void *IOInst, u64 Off)
+{
+	u32 Value;
+
+	(void)IOInst;
+	pthread_mutex_lock(&RegLock);
+	Value = *Reg(Off);
+	pthread_mutex_unlock(&RegLock);
+
+	return Value;
+}
+
+static void ModelMaskWrite32(void *IOInst, u64 Off, u32 Mask, u32 Value)
+{
+	u32 *Ptr;
+
+	(void)IOInst;
+	pthread_mutex_lock(&RegLock);
+	Ptr = Reg(Off);
+	*Ptr = (*Ptr & ~Mask) | Value;
+	pthread_mutex_unlock(&RegLock);
+}
+
+static u64 LockAddr(u8 LockId, u8 Acquire, u8 Value)
+{
+	const XAie_LockMod *LockMod =
+		Dev->DevProp.DevMod[XAIEGBL_TILE_TYPE_SHIMNOC].LockMod;
+
+	return _XAie_GetTileAddr(Dev, 0U, SHIM_COL) + LockMod->BaseAddr +
+		LockId * LockMod->LockIdOff +
+		(Acquire != 0U ? LockMod->RelAcqOff : 0U) + LOCK_VAL_OFF +
+		Value * LockMod->LockValOff;
+}
+
+/* Lock acquires of the trace chunks succeed once the chunk is filled */
+static u32 ModelMaskPoll(void *IOInst, u64 Off, u32 Mask, u32 Value,
+		u32 TimeOutUs)
+{
+	(void)IOInst;
+	(void)Mask;
+	(void)Value;
+	(void)TimeOutUs;
+	for (u8 Bd = 0U; Bd < MAX_BDS; Bd++) {
+		if (Off == LockAddr(Bd, 1U, 1U)) {
+			if (ChunkFull[Bd] == 0U) {
+				return XAIE_ERR;
+			}
+			ChunkFull[Bd] = 0U;
+			return XAIE_SUCCESS;
+		}
+		if (Off == LockAddr(Bd, 0U, 0U)) {
+			NumReleases++;
+			return XAIE_SUCCESS;
+		}
+	}
+
+	return XAIE_SUCCESS;
+}
+
+static void ModelBlockWrite32(void *IOInst, u64 Off, u32 *Data, u32 Size)
+{
+	for (u32 i = 0U; i < Size; i++) {
+		ModelWrite32(IOInst, Off + 4U * i, Data[i]);
+	}
+}
+
+static void ModelBlockSet32(void *IOInst, u64 Off, u32 Data, u32 Size)
+{
+	for (u32 i = 0U; i < Size; i++) {
+		ModelWrite32(IOInst, Off + 4U * i, Data);
+	}
+}
+
+static AieRC ModelRunOp(void *IOInst, XAie_DevInst *DevInst,
+		XAie_BackendOpCode Op, void *Arg)
+{
+	XAie_ShimDmaBdArgs *Args = Arg;
+	const XAie_DmaMod *DmaMod =
+		DevInst->DevProp.DevMod[XAIEGBL_TILE_TYPE_SHIMNOC].DmaMod;
+
+	(void)IOInst;
+	if (Op != XAIE_BACKEND_OP_CONFIG_SHIMDMABD) {
+		return XAIE_OK;
+	}
+
+	CHECK(Args->BdNum < MAX_BDS);
+	CHECK(Args->NumBdWords == SHIM_BD_WORDS);
+	memcpy(BdWords[Args->BdNum], Args->BdWords,
+		sizeof(BdWords[Args->BdNum]));
+	BdVAddr[Args->BdNum] = NULL;
+	if (Args->MemInst != NULL) {
+		BdVAddr[Args->BdNum] = (u8 *)XAie_MemGetVAddr(Args->MemInst) +
+			((Args->VAddr << DmaMod->BdProp->AddrAlignShift) -
+			 Args->MemInst->DevAddr);
+	}
+	BdWritten[Args->BdNum] = 1U;
+
+	return XAIE_OK;
+}
+
+static u8 BdIsValid(u8 Bd)
+{
+	const XAie_DmaMod *DmaMod =
+		Dev->DevProp.DevMod[XAIEGBL_TILE_TYPE_SHIMNOC].DmaMod;
+
+	return (BdWords[Bd][BD_EN_WORD] & DmaMod->BdProp->BdEn->ValidBd.Mask) !=
+		0U;
+}
+
+/* Fills a trace chunk, as the shim DMA does before releasing its lock */
+static void FillChunk(u8 Bd, u8 Pattern)
+{
+	CHECK(BdIsValid(Bd) && (BdVAddr[Bd] != NULL));
+	memset(BdVAddr[Bd], Pattern, BUF_SIZE);
+	ChunkFull[Bd] = 1U;
+}
+
+static void *StartThread(void *Arg)
+{
+	return (void *)(uintptr_t)XAie_CollectStart(Arg, 1000U);
+}
+
+int main(void)
+{
+	XAie_SetupConfig(Cfg, XAIE_DEV_GEN_AIE, 0, 23, 18, 50, 9, 0, 1, 0, 1, 8);
+	XAie_InstDeclare(DevInst, &Cfg);
+	XAie_Events Events[2U] = {
+		XAIE_EVENT_ACTIVE_CORE, XAIE_EVENT_DISABLED_CORE,
+	};
+	XAie_CollectTrace Trace = {
+		XAie_TileLoc(1, 1), XAIE_CORE_MOD, XAie_PacketInit(2, 0),
+		XAIE_TRACE_EVENT_TIME, XAIE_EVENT_ACTIVE_CORE,
+		XAIE_EVENT_DISABLED_CORE, Events, 2U,
+	};
+	XAie_CollectCounter Counters[NUM_COUNTERS];
+	XAie_CollectInst *Collect;
+	u64 Addr[NUM_COUNTERS];
+	u32 Values[NUM_COUNTERS];
+	u64 TimeStamps[MAX_SAMPLES];
+	u32 SampleValues[MAX_SAMPLES * NUM_COUNTERS];
+	u32 NumSamples;
+	u32 NumDropped;
+	u8 Drained[NUM_BUFS * BUF_SIZE];
+	u64 DrainedSize;
+	pthread_t Threads[2U];
+	void *Ret[2U];
+
+	CHECK(XAie_CfgInitialize(&DevInst, &Cfg) == XAIE_OK);
+	CHECK(XAie_SetIOBackend(&DevInst, XAIE_IO_BACKEND_DEBUG) == XAIE_OK);
+	Dev = &DevInst;
+	Model = *DevInst.Backend;
+	Model.Ops.Write32 = ModelWrite32;
+	Model.Ops.Read32 = ModelRead32;
+	Model.Ops.MaskWrite32 = ModelMaskWrite32;
+	Model.Ops.MaskPoll = ModelMaskPoll;
+	Model.Ops.BlockWrite32 = ModelBlockWrite32;
+	Model.Ops.BlockSet32 = ModelBlockSet32;
+	Model.Ops.RunOp = ModelRunOp;
+	DevInst.Backend = &Model;
+
+	/* Snapshots read the counters at their register addresses */
+	for (u32 i = 0U; i < NUM_COUNTERS; i++) {
+		Counters[i].Loc = XAie_TileLoc(i, 1 + i % 2U);
+		Counters[i].Module = XAIE_CORE_MOD;
+		Counters[i].Counter = (u8)(i % 2U);
+		Counters[i].StartEvent = XAIE_EVENT_ACTIVE_CORE;
+		Counters[i].StopEvent = XAIE_EVENT_DISABLED_CORE;
+	}
+	Collect = XAie_CollectCreate(&DevInst, Counters, NUM_COUNTERS,
+		MAX_SAMPLES);
+	CHECK(Collect != NULL);
+	for (u32 i = 0U; i < NUM_COUNTERS; i++) {
+		CHECK(_XAie_PerfCounterGetRegAddr(&DevInst, Counters[i].Loc,
+			Counters[i].Module, Counters[i].Counter, &Addr[i]) ==
+			XAIE_OK);
+		SetReg(Addr[i], 100U + i);
+	}
+	CHECK(XAie_CollectSnapshot(Collect, Values) == XAIE_OK);
+	for (u32 i = 0U; i < NUM_COUNTERS; i++) {
+		CHECK(Values[i] == 100U + i);
+	}
+	CHECK(XAie_CollectTraceConfig(Collect, &Trace, 1U) == XAIE_OK);
+
+	/* A failed setup leaves no valid BD behind */
+	CHECK(XAie_CollectTraceBufferSetup(Collect, XAie_TileLoc(SHIM_COL, 0),
+		7U, START_BD, 2U, BUF_SIZE) != XAIE_OK);
+	for (u8 Bd = START_BD; Bd < START_BD + 2U; Bd++) {
+		CHECK(BdWritten[Bd] && !BdIsValid(Bd));
+	}
+
+	/* Full chunks are drained in the order of the ring */
+	CHECK(XAie_CollectTraceBufferSetup(Collect, XAie_TileLoc(SHIM_COL, 0),
+		0U, START_BD, NUM_BUFS, BUF_SIZE) == XAIE_OK);
+	CHECK(XAie_CollectTraceDrain(Collect, Drained, sizeof(Drained),
+		&DrainedSize) == XAIE_OK);
+	CHECK(DrainedSize == 0U);
+	FillChunk(START_BD, 0x11U);
+	FillChunk(START_BD + 1U, 0x22U);
+	FillChunk(START_BD + 3U, 0x44U);
+	CHECK(XAie_CollectTraceDrain(Collect, Drained, sizeof(Drained),
+		&DrainedSize) == XAIE_OK);
+	CHECK((DrainedSize == 2U * BUF_SIZE) && (NumReleases == 2U));
+	CHECK((Drained[0U] == 0x11U) && (Drained[BUF_SIZE] == 0x22U));
+	FillChunk(START_BD + 2U, 0x33U);
+	/* Only whole chunks fit */
+	CHECK(XAie_CollectTraceDrain(Collect, Drained, BUF_SIZE + 1U,
+		&DrainedSize) == XAIE_OK);
+	CHECK((DrainedSize == BUF_SIZE) && (Drained[0U] == 0x33U));
+
+	/* Lock acquires are only recorded inside a transaction */
+	CHECK(XAie_StartTransaction(&DevInst, 0U) == XAIE_OK);
+	CHECK(XAie_CollectTraceDrain(Collect, Drained, sizeof(Drained),
+		&DrainedSize) == XAIE_ERR);
+	CHECK(XAie_CancelTransaction(&DevInst) == XAIE_OK);
+	CHECK(XAie_CollectTraceDrain(Collect, Drained, sizeof(Drained),
+		&DrainedSize) == XAIE_OK);
+	CHECK((DrainedSize == BUF_SIZE) && (Drained[0U] == 0x44U));
+
+	/* The sampler thread needs a backend serving concurrent reads */
+	CHECK(XAie_CollectStart(Collect, 1000U) == XAIE_INVALID_BACKEND);
+	Model.Type = XAIE_IO_BACKEND_METAL;
+
+	/* Only one of concurrent starts creates the sampler thread */
+	for (u32 Round = 0U; Round < 50U; Round++) {
+		for (u32 i = 0U; i < 2U; i++) {
+			CHECK(pthread_create(&Threads[i], NULL, StartThread,
+				Collect) == 0);
+		}
+		for (u32 i = 0U; i < 2U; i++) {
+			CHECK(pthread_join(Threads[i], &Ret[i]) == 0);
+		}
+		CHECK(((AieRC)(uintptr_t)Ret[0U] == XAIE_OK) !=
+			((AieRC)(uintptr_t)Ret[1U] == XAIE_OK));
+		CHECK(XAie_CollectStart(Collect, 1000U) == XAIE_ERR);
+		CHECK(XAie_CollectStop(Collect) == XAIE_OK);
+	}
+	CHECK(XAie_CollectGetSamples(Collect, TimeStamps, SampleValues,
+		MAX_SAMPLES, &NumSamples, &NumDropped) == XAIE_OK);
+
+	/* Samples are taken every period */
+	CHECK(XAie_CollectStart(Collect, 1000U) == XAIE_OK);
+	usleep(20000U);
+	CHECK(XAie_CollectStop(Collect) == XAIE_OK);
+	CHECK(XAie_CollectGetSamples(Collect, TimeStamps, SampleValues,
+		MAX_SAMPLES, &NumSamples, &NumDropped) == XAIE_OK);
+	CHECK((NumSamples == MAX_SAMPLES) && (NumDropped > 0U));
+	for (u32 i = 1U; i < NumSamples; i++) {
+		CHECK(TimeStamps[i] > TimeStamps[i - 1U]);
+	}
+	CHECK(SampleValues[NUM_COUNTERS * (NumSamples - 1U) + 3U] == 103U);
+
+	/* The trace BDs are invalidated before the buffer is freed */
+	for (u8 Bd = START_BD; Bd < START_BD + NUM_BUFS; Bd++) {
+		CHECK(BdIsValid(Bd));
+	}
+	CHECK(XAie_CollectDestroy(Collect) == XAIE_OK);
+	for (u8 Bd = START_BD; Bd < START_BD + NUM_BUFS; Bd++) {
+		CHECK(!BdIsValid(Bd));
+	}
+
+	printf("Collection service: all checks passed\n");
+
+	return EXIT_SUCCESS;
+}
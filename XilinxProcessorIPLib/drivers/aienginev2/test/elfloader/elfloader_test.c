@@ -0,0 +1,359 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Host test of the multi tile elf loader (XAie_LoadElfTiles() in
+ * xaie_elfloader.c).
+ *
+ * The operations of the debug backend are replaced by a register file
+ * model, which also records the threads doing the memory writes. The tiles
+ * are first loaded one by one with XAie_LoadElfMem() to get the expected
+ * register file.
+ *
+ * Checked are that XAie_LoadElfTiles() writes the same memories from
+ * several workers, from elf files and buffers, that it falls back to the
+ * calling thread with the snapshot backend, an open transaction or the
+ * shadow register cache, and that elfs whose program headers or sections
+ * are not within the elf are rejected before any write.
+ */
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <xaiengine.h>
+#include <xaiengine/xaie_helper.h>
+
+#define NUM_REGS	(1U << 16U)
+#define NUM_TILES	6U
+#define NUM_WORKERS	3U
+#define MAX_THREADS	8U
+#define TILE_ROW	1U
+#define DM_ADDR		0x38100U	/* Data memory of the tile on odd rows */
+
+#define CHECK(Cond)	do { \
+	if (!(Cond)) { \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Cond); \
+		exit(EXIT_FAILURE); \
+	} \
+} while (0)
+
+/* Elf with a program memory section and a data section with bss */
+typedef struct {
+	Elf32_Ehdr Ehdr;
+	Elf32_Phdr Phdr[2U];
+	u32 Text[16U];
+	u32 Data[8U];
+} TestElf;
+
+typedef struct {
+	u64 Off[NUM_REGS];
+	u32 Val[NUM_REGS];
+	u8 Used[NUM_REGS];
+	u32 Count;
+} RegFile;
+
+static RegFile Regs;
+static RegFile Expected;
+static pthread_mutex_t RegLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t Writers[MAX_THREADS];
+static u32 NumWriters;
+static u32 NumWrites;
+
+/* Returns the slot of a register, must be called with RegLock held */
+static u32 Slot(const RegFile *File, u64 Off)
+{
+	u32 Idx = (u32)((Off * 0x9E3779B97F4A7C15ULL) >> 48U) &
+		(NUM_REGS - 1U);
+
+	while ((File->Used[Idx] != 0U) && (File->Off[Idx] != Off)) {
+		Idx = (Idx + 1U) & (NUM_REGS - 1U);
+	}
+
+	return Idx;
+}
+
+static void SetReg(u64 Off, u32 Value)
+{
+	u32 Idx;
+
+	pthread_mutex_lock(&RegLock);
+	Idx = Slot(&Regs, Off);
+	if (Regs.Used[Idx] == 0U) {
+		Regs.Used[Idx] = 1U;
+		Regs.Off[Idx] = Off;
+		Regs.Count++;
+	}
+	Regs.Val[Idx] = Value;
+	pthread_mutex_unlock(&RegLock);
+}
+
+/* Memory writes record the calling thread */
+static void AddWriter(void)
+{
+	pthread_t Self = pthread_self();
+	u32 i;
+
+	pthread_mutex_lock(&RegLock);
+	NumWrites++;
+	for (i = 0U; i < NumWriters; i++) {
+		if (pthread_equal(Writers[i], Self)) {
+			break;
+		}
+	}
+	if (i == NumWriters) {
+		CHECK(NumWriters < MAX_THREADS);
+		Writers[NumWriters++] = Self;
+	}
+	pthread_mutex_unlock(&RegLock);
+}
+
+static void ModelWrite32(void *IOInst, u64 Off, u32 Value)
+{
+	(void)IOInst;
+	SetReg(Off, Value);
+}
+
+static u32 ModelRead32(void *IOInst, u64 Off)
+{
+	u32 Value = 0U;
+	u32 Idx;
+
+	(void)IOInst;
+	pthread_mutex_lock(&RegLock);
+	Idx = Slot(&Regs, Off);
+	if (Regs.Used[Idx] != 0U) {
+		Value = Regs.Val[Idx];
+	}
+	pthread_mutex_unlock(&RegLock);
+
+	return Value;
+}
+
+static void ModelMaskWrite32(void *IOInst, u64 Off, u32 Mask, u32 Value)
+{
+	SetReg(Off, (ModelRead32(IOInst, Off) & ~Mask) | Value);
+}
+
+static void ModelBlockWrite32(void *IOInst, u64 Off, u32 *Data, u32 Size)
+{
+	AddWriter();
+	for (u32 i = 0U; i < Size; i++) {
+		ModelWrite32(IOInst, Off + 4U * i, Data[i]);
+	}
+}
+
+static void ModelBlockSet32(void *IOInst, u64 Off, u32 Data, u32 Size)
+{
+	AddWriter();
+	for (u32 i = 0U; i < Size; i++) {
+		ModelWrite32(IOInst, Off + 4U * i, Data);
+	}
+}
+
+/* The ECC of the tiles is set up by their first load only, forget it */
+static void ResetModel(XAie_DevInst *DevInst)
+{
+	memset(DevInst->MemInUse, 0, sizeof(DevInst->MemInUse));
+	memset(DevInst->CoreInUse, 0, sizeof(DevInst->CoreInUse));
+	memset(&Regs, 0, sizeof(Regs));
+	NumWriters = 0U;
+	NumWrites = 0U;
+}
+
+/* The register file is the one of the reference load */
+static u8 SameRegs(void)
+{
+	u32 Idx;
+
+	if (Regs.Count != Expected.Count) {
+		return 0U;
+	}
+	for (u32 i = 0U; i < NUM_REGS; i++) {
+		if (Expected.Used[i] == 0U) {
+			continue;
+		}
+		Idx = Slot(&Regs, Expected.Off[i]);
+		if ((Regs.Used[Idx] == 0U) ||
+				(Regs.Val[Idx] != Expected.Val[i])) {
+			return 0U;
+		}
+	}
+
+	return 1U;
+}
+
+/* Only the calling thread wrote the memories */
+static u8 SerialWrites(void)
+{
+	return (NumWriters == 1U) && pthread_equal(Writers[0U], pthread_self());
+}
+
+static void MakeElf(TestElf *Elf)
+{
+	memset(Elf, 0, sizeof(*Elf));
+	memcpy(Elf->Ehdr.e_ident, ELFMAG, SELFMAG);
+	Elf->Ehdr.e_ident[EI_CLASS] = ELFCLASS32;
+	Elf->Ehdr.e_ident[EI_DATA] = ELFDATA2LSB;
+	Elf->Ehdr.e_ident[EI_VERSION] = EV_CURRENT;
+	Elf->Ehdr.e_type = ET_EXEC;
+	Elf->Ehdr.e_phoff = offsetof(TestElf, Phdr);
+	Elf->Ehdr.e_ehsize = sizeof(Elf32_Ehdr);
+	Elf->Ehdr.e_phentsize = sizeof(Elf32_Phdr);
+	Elf->Ehdr.e_phnum = 2U;
+
+	Elf->Phdr[0U].p_type = PT_LOAD;
+	Elf->Phdr[0U].p_offset = offsetof(TestElf, Text);
+	Elf->Phdr[0U].p_paddr = 0x40U;
+	Elf->Phdr[0U].p_filesz = sizeof(Elf->Text);
+	Elf->Phdr[0U].p_memsz = sizeof(Elf->Text);
+
+	Elf->Phdr[1U].p_type = PT_LOAD;
+	Elf->Phdr[1U].p_offset = offsetof(TestElf, Data);
+	Elf->Phdr[1U].p_paddr = DM_ADDR;
+	Elf->Phdr[1U].p_filesz = sizeof(Elf->Data);
+	Elf->Phdr[1U].p_memsz = 2U * sizeof(Elf->Data);
+
+	for (u32 i = 0U; i < 16U; i++) {
+		Elf->Text[i] = 0xC0DE0000U + i;
+	}
+	for (u32 i = 0U; i < 8U; i++) {
+		Elf->Data[i] = 0xDA7A0000U + i;
+	}
+}
+
+static void WriteFile(const char *Path, const void *Data, size_t Size)
+{
+	FILE *Fd = fopen(Path, "w");
+
+	CHECK(Fd != NULL);
+	CHECK(fwrite(Data, Size, 1U, Fd) == 1U);
+	CHECK(fclose(Fd) == 0);
+}
+
+int main(void)
+{
+	XAie_SetupConfig(Cfg, XAIE_DEV_GEN_AIE, 0, 23, 18, 50, 9, 0, 1, 0, 1, 8);
+	XAie_InstDeclare(DevInst, &Cfg);
+	char Path[] = "/tmp/elfloader_testXXXXXX";
+	XAie_ElfTile Tiles[NUM_TILES];
+	XAie_Backend Model;
+	TestElf Elf;
+	TestElf Bad;
+	int Fd;
+
+	CHECK(XAie_CfgInitialize(&DevInst, &Cfg) == XAIE_OK);
+	CHECK(XAie_SetIOBackend(&DevInst, XAIE_IO_BACKEND_DEBUG) == XAIE_OK);
+	Model = *DevInst.Backend;
+	Model.Ops.Write32 = ModelWrite32;
+	Model.Ops.Read32 = ModelRead32;
+	Model.Ops.MaskWrite32 = ModelMaskWrite32;
+	Model.Ops.BlockWrite32 = ModelBlockWrite32;
+	Model.Ops.BlockSet32 = ModelBlockSet32;
+	DevInst.Backend = &Model;
+
+	MakeElf(&Elf);
+	Fd = mkstemp(Path);
+	CHECK(Fd >= 0);
+	close(Fd);
+	WriteFile(Path, &Elf, sizeof(Elf));
+
+	/* Tiles of neighbour columns, half of them from the file */
+	for (u32 i = 0U; i < NUM_TILES; i++) {
+		Tiles[i].Loc = XAie_TileLoc(1U + i, TILE_ROW);
+		Tiles[i].ElfPath = ((i % 2U) == 0U) ? Path : NULL;
+		Tiles[i].ElfMem = (const unsigned char *)&Elf;
+		Tiles[i].ElfMemSz = sizeof(Elf);
+	}
+
+	/* Reference, one tile after the other */
+	ResetModel(&DevInst);
+	for (u32 i = 0U; i < NUM_TILES; i++) {
+		CHECK(XAie_LoadElfMem(&DevInst, Tiles[i].Loc,
+			(const unsigned char *)&Elf) == XAIE_OK);
+	}
+	CHECK(SerialWrites());
+	memcpy(&Expected, &Regs, sizeof(Expected));
+
+	/* The columns are split between the workers */
+	ResetModel(&DevInst);
+	CHECK(XAie_LoadElfTiles(&DevInst, Tiles, NUM_TILES, NUM_WORKERS) ==
+		XAIE_OK);
+	CHECK(SameRegs());
+	CHECK(NumWriters == NUM_WORKERS);
+	for (u32 i = 0U; i < NumWriters; i++) {
+		CHECK(!pthread_equal(Writers[i], pthread_self()));
+	}
+
+	/* The snapshot backend records into one buffer */
+	ResetModel(&DevInst);
+	Model.Type = XAIE_IO_BACKEND_SNAPSHOT;
+	CHECK(XAie_LoadElfTiles(&DevInst, Tiles, NUM_TILES, NUM_WORKERS) ==
+		XAIE_OK);
+	CHECK(SameRegs() && SerialWrites());
+	Model.Type = XAIE_IO_BACKEND_DEBUG;
+
+	/* The shadow register cache is not locked */
+	ResetModel(&DevInst);
+	CHECK(XAie_ShadowCacheEnable(&DevInst) == XAIE_OK);
+	CHECK(XAie_LoadElfTiles(&DevInst, Tiles, NUM_TILES, NUM_WORKERS) ==
+		XAIE_OK);
+	CHECK(SameRegs() && SerialWrites());
+	CHECK(XAie_ShadowCacheDisable(&DevInst) == XAIE_OK);
+
+	/* Nor are the transactions */
+	ResetModel(&DevInst);
+	CHECK(XAie_StartTransaction(&DevInst, 0U) == XAIE_OK);
+	CHECK(XAie_LoadElfTiles(&DevInst, Tiles, NUM_TILES, NUM_WORKERS) ==
+		XAIE_OK);
+	CHECK(XAie_SubmitTransaction(&DevInst) == XAIE_OK);
+	CHECK(SameRegs() && SerialWrites());
+
+	/* Program headers beyond the end of the elf */
+	ResetModel(&DevInst);
+	Bad = Elf;
+	Bad.Ehdr.e_phoff = sizeof(Bad) - sizeof(Elf32_Phdr);
+	Tiles[1U].ElfMem = (const unsigned char *)&Bad;
+	CHECK(XAie_LoadElfTiles(&DevInst, Tiles, NUM_TILES, NUM_WORKERS) ==
+		XAIE_INVALID_ELF);
+	Bad = Elf;
+	Bad.Ehdr.e_phnum = 0xFFFFU;
+	CHECK(XAie_LoadElfTiles(&DevInst, Tiles, NUM_TILES, NUM_WORKERS) ==
+		XAIE_INVALID_ELF);
+
+	/* Section beyond the end of the elf */
+	Bad = Elf;
+	Bad.Phdr[1U].p_filesz = 2U * sizeof(Bad.Data);
+	CHECK(XAie_LoadElfTiles(&DevInst, Tiles, NUM_TILES, NUM_WORKERS) ==
+		XAIE_INVALID_ELF);
+	Bad = Elf;
+	Bad.Phdr[0U].p_offset = 0xFFFFFFF0U;
+	CHECK(XAie_LoadElfTiles(&DevInst, Tiles, NUM_TILES, NUM_WORKERS) ==
+		XAIE_INVALID_ELF);
+
+	/* Buffer shorter than its elf, and truncated file */
+	Tiles[1U].ElfMem = (const unsigned char *)&Elf;
+	Tiles[1U].ElfMemSz = sizeof(Elf) - 4U;
+	CHECK(XAie_LoadElfTiles(&DevInst, Tiles, NUM_TILES, NUM_WORKERS) ==
+		XAIE_INVALID_ELF);
+	Tiles[1U].ElfMemSz = 0U;
+	CHECK(XAie_LoadElfTiles(&DevInst, Tiles, NUM_TILES, NUM_WORKERS) ==
+		XAIE_INVALID_ARGS);
+	Tiles[1U].ElfMemSz = sizeof(Elf);
+	WriteFile(Path, &Elf, offsetof(TestElf, Data));
+	CHECK(XAie_LoadElfTiles(&DevInst, Tiles, NUM_TILES, NUM_WORKERS) ==
+		XAIE_INVALID_ELF);
+	CHECK(XAie_LoadElf(&DevInst, Tiles[0U].Loc, Path, XAIE_DISABLE) ==
+		XAIE_INVALID_ELF);
+	CHECK(NumWrites == 0U);
+	unlink(Path);
+
+	printf("Elf loader: all checks passed\n");
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,367 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Host test of the shadow register cache (xaie_shadow.c).
+ *
+ * The operations of the debug backend are replaced by a register file
+ * model counting the accesses which reach the backend. The backend type is
+ * changed to the linux backend, whose reads are cached, and back to the
+ * debug backend, whose reads are not.
+ *
+ * Checked are that exactly the registers of the shadow module of each tile
+ * type are cached, the skipped writes, the reads and mask writes served
+ * from the cache, the blocks which are cached only if all their registers
+ * are, and that the reset of the partition (xaie_reset.c) invalidates each
+ * column when its reset is asserted.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <xaiengine.h>
+#include <xaiengine/xaie_helper.h>
+#include <xaiengine/xaiegbl_params.h>
+
+#define NUM_REGS	(1U << 16U)
+#define PL_COL		4U
+#define AIE_COL		5U
+#define NOC_COL		6U
+#define AIE_ROW		3U
+
+#define CHECK(Cond)	do { \
+	if (!(Cond)) { \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Cond); \
+		exit(EXIT_FAILURE); \
+	} \
+} while (0)
+
+/* Accesses which reached the backend */
+typedef struct {
+	u32 Write32;
+	u32 Read32;
+	u32 MaskWrite32;
+	u32 Block;
+	u32 RunOp;
+} Accesses;
+
+static u64 RegOff[NUM_REGS];
+static u32 RegVal[NUM_REGS];
+static u8 RegUsed[NUM_REGS];
+static Accesses Count;
+static XAie_DevInst *Dev;
+
+/* Registers checked when the reset register ProbeRstOff is asserted */
+static u64 ProbeRstOff;
+static u64 ProbeReset;
+static u64 ProbeNext;
+static u32 NumProbes;
+
+/* Register file of the model */
+static u32 *Reg(u64 Off)
+{
+	u32 Idx = (u32)((Off * 0x9E3779B97F4A7C15ULL) >> 48U) &
+		(NUM_REGS - 1U);
+
+	while ((RegUsed[Idx] != 0U) && (RegOff[Idx] != Off)) {
+		Idx = (Idx + 1U) & (NUM_REGS - 1U);
+	}
+	if (RegUsed[Idx] == 0U) {
+		RegUsed[Idx] = 1U;
+		RegOff[Idx] = Off;
+		RegVal[Idx] = 0U;
+	}
+
+	return &RegVal[Idx];
+}
+
+static void ModelWrite32(void *IOInst, u64 Off, u32 Value)
+{
+	u32 Cached;
+
+	(void)IOInst;
+	Count.Write32++;
+	*Reg(Off) = Value;
+
+	/*
+	 * The previous column is invalidated once its reset is asserted, the
+	 * column being reset not yet
+	 */
+	if ((ProbeRstOff != 0U) && (Off == ProbeRstOff) && (Value != 0U)) {
+		CHECK(_XAie_ShadowRead32(Dev, ProbeReset, &Cached) == 0U);
+		CHECK(_XAie_ShadowRead32(Dev, ProbeNext, &Cached) == 1U);
+		NumProbes++;
+	}
+}
+
+static u32 ModelRead32(void *IOInst, u64 Off)
+{
+	(void)IOInst;
+	Count.Read32++;
+
+	return *Reg(Off);
+}
+
+static void ModelMaskWrite32(void *IOInst, u64 Off, u32 Mask, u32 Value)
+{
+	u32 *Ptr;
+
+	(void)IOInst;
+	Count.MaskWrite32++;
+	Ptr = Reg(Off);
+	*Ptr = (*Ptr & ~Mask) | Value;
+}
+
+static void ModelBlockWrite32(void *IOInst, u64 Off, u32 *Data, u32 Size)
+{
+	(void)IOInst;
+	Count.Block++;
+	for (u32 i = 0U; i < Size; i++) {
+		*Reg(Off + 4U * i) = Data[i];
+	}
+}
+
+static void ModelBlockSet32(void *IOInst, u64 Off, u32 Data, u32 Size)
+{
+	(void)IOInst;
+	Count.Block++;
+	for (u32 i = 0U; i < Size; i++) {
+		*Reg(Off + 4U * i) = Data;
+	}
+}
+
+static AieRC ModelRunOp(void *IOInst, XAie_DevInst *DevInst,
+		XAie_BackendOpCode Op, void *Arg)
+{
+	(void)IOInst;
+	(void)DevInst;
+	(void)Op;
+	(void)Arg;
+	Count.RunOp++;
+
+	return XAIE_OK;
+}
+
+/* Tile offset is in a range of the shadow module, computed independently */
+static u8 InRanges(const XAie_ShadowMod *ShadowMod, u32 Off)
+{
+	const XAie_RegRange *Range;
+	u32 Start;
+
+	for (u8 r = 0U; r < ShadowMod->NumRanges; r++) {
+		Range = &ShadowMod->Ranges[r];
+		for (u32 Rep = 0U; Rep < Range->NumRepeats; Rep++) {
+			Start = Range->RegOff + Rep * Range->Stride;
+			if ((Off >= Start) && (Off < Start + Range->NumRegs * 4U)) {
+				return 1U;
+			}
+		}
+	}
+
+	return 0U;
+}
+
+/* Writes a register twice, returns the number of writes to the backend */
+static u32 WriteTwice(u64 Off, u32 Value)
+{
+	u32 Before = Count.Write32;
+
+	XAie_Write32(Dev, Off, Value);
+	CHECK(*Reg(Off) == Value);
+	XAie_Write32(Dev, Off, Value);
+
+	return Count.Write32 - Before;
+}
+
+/*
+ * All registers of the shadow module of a tile type are cached and read
+ * back from the cache, the registers around them and the ones of the other
+ * tile types are not
+ */
+static void CheckTileType(XAie_LocType Loc)
+{
+	u8 TileType = _XAie_GetTileTypefromLoc(Dev, Loc);
+	const XAie_ShadowMod *ShadowMod = Dev->DevProp.DevMod[TileType].ShadowMod;
+	const XAie_ShadowMod *Other;
+	const XAie_RegRange *Range;
+	u64 TileAddr = _XAie_GetTileAddr(Dev, Loc.Row, Loc.Col);
+	u32 Off, Reads;
+
+	CHECK(ShadowMod != NULL);
+	for (u8 r = 0U; r < ShadowMod->NumRanges; r++) {
+		Range = &ShadowMod->Ranges[r];
+		for (u32 Rep = 0U; Rep < Range->NumRepeats; Rep++) {
+			for (u32 i = 0U; i < Range->NumRegs; i++) {
+				Off = Range->RegOff + Rep * Range->Stride + 4U * i;
+				CHECK(WriteTwice(TileAddr + Off, Off ^ TileType) ==
+					1U);
+				Reads = Count.Read32;
+				CHECK(XAie_Read32(Dev, TileAddr + Off) ==
+					(Off ^ TileType));
+				CHECK(Count.Read32 == Reads);
+			}
+		}
+
+		/* Neighbours of the range and of its repeats */
+		for (u32 Rep = 0U; Rep <= Range->NumRepeats; Rep++) {
+			Off = Range->RegOff + Rep * Range->Stride +
+				Range->NumRegs * 4U;
+			if (!InRanges(ShadowMod, Off)) {
+				CHECK(WriteTwice(TileAddr + Off, 1U) == 2U);
+			}
+		}
+		Off = Range->RegOff - 4U;
+		if (!InRanges(ShadowMod, Off)) {
+			CHECK(WriteTwice(TileAddr + Off, 1U) == 2U);
+		}
+	}
+
+	for (u8 t = 0U; t < XAIEGBL_TILE_TYPE_MAX; t++) {
+		Other = Dev->DevProp.DevMod[t].ShadowMod;
+		if ((Other == NULL) || (Other == ShadowMod)) {
+			continue;
+		}
+		for (u8 r = 0U; r < Other->NumRanges; r++) {
+			Off = Other->Ranges[r].RegOff;
+			if (!InRanges(ShadowMod, Off)) {
+				CHECK(WriteTwice(TileAddr + Off, 2U) == 2U);
+			}
+		}
+	}
+}
+
+int main(void)
+{
+	XAie_SetupConfig(Cfg, XAIE_DEV_GEN_AIE, 0, 23, 18, 50, 9, 0, 1, 0, 1, 8);
+	XAie_InstDeclare(DevInst, &Cfg);
+	XAie_Backend Model;
+	const XAie_PlIfMod *PlIfMod;
+	u64 Tile, Below, Next;
+	u32 Data[8U];
+	Accesses Before;
+
+	CHECK(XAie_CfgInitialize(&DevInst, &Cfg) == XAIE_OK);
+	CHECK(XAie_SetIOBackend(&DevInst, XAIE_IO_BACKEND_DEBUG) == XAIE_OK);
+	Model = *DevInst.Backend;
+	Model.Type = XAIE_IO_BACKEND_LINUX;
+	Model.Ops.Write32 = ModelWrite32;
+	Model.Ops.Read32 = ModelRead32;
+	Model.Ops.MaskWrite32 = ModelMaskWrite32;
+	Model.Ops.BlockWrite32 = ModelBlockWrite32;
+	Model.Ops.BlockSet32 = ModelBlockSet32;
+	Model.Ops.RunOp = ModelRunOp;
+	DevInst.Backend = &Model;
+	Dev = &DevInst;
+	Tile = _XAie_GetTileAddr(&DevInst, AIE_ROW, AIE_COL);
+	Below = _XAie_GetTileAddr(&DevInst, AIE_ROW - 1U, AIE_COL);
+	Next = _XAie_GetTileAddr(&DevInst, AIE_ROW, AIE_COL + 1U);
+
+	CHECK(XAie_ShadowCacheInvalidate(&DevInst) == XAIE_INVALID_ARGS);
+	CHECK(XAie_ShadowCacheEnable(&DevInst) == XAIE_OK);
+	CHECK(XAie_ShadowCacheEnable(&DevInst) == XAIE_OK);
+
+	/* Ranges of each tile type */
+	CheckTileType(XAie_TileLoc(AIE_COL, AIE_ROW));
+	CHECK(_XAie_GetTileTypefromLoc(&DevInst, XAie_TileLoc(NOC_COL, 0U)) ==
+		XAIEGBL_TILE_TYPE_SHIMNOC);
+	CheckTileType(XAie_TileLoc(NOC_COL, 0U));
+	CHECK(_XAie_GetTileTypefromLoc(&DevInst, XAie_TileLoc(PL_COL, 0U)) ==
+		XAIEGBL_TILE_TYPE_SHIMPL);
+	CheckTileType(XAie_TileLoc(PL_COL, 0U));
+
+	/* Values are cached per tile */
+	CHECK(WriteTwice(Tile + XAIEGBL_CORE_TILCTRL, 3U) == 1U);
+	CHECK(WriteTwice(Below + XAIEGBL_CORE_TILCTRL, 3U) == 1U);
+	CHECK(WriteTwice(Next + XAIEGBL_CORE_TILCTRL, 3U) == 1U);
+	CHECK(WriteTwice(Tile + XAIEGBL_CORE_TILCTRL, 3U) == 0U);
+
+	/* First read misses and fills the cache, the next ones hit */
+	Before = Count;
+	*Reg(Next + XAIEGBL_CORE_PCEVT0) = 0x1234U;
+	CHECK(XAie_Read32(&DevInst, Next + XAIEGBL_CORE_PCEVT0) == 0x1234U);
+	CHECK(XAie_Read32(&DevInst, Next + XAIEGBL_CORE_PCEVT0) == 0x1234U);
+	CHECK(Count.Read32 == Before.Read32 + 1U);
+	CHECK(WriteTwice(Next + XAIEGBL_CORE_PCEVT0, 0x1234U) == 0U);
+
+	/* Status registers are always read */
+	CHECK(!InRanges(DevInst.DevProp.DevMod[XAIEGBL_TILE_TYPE_AIETILE].
+		ShadowMod, XAIEGBL_MEM_DMABD0INTSTA));
+	Before = Count;
+	XAie_Read32(&DevInst, Tile + XAIEGBL_MEM_DMABD0INTSTA);
+	XAie_Read32(&DevInst, Tile + XAIEGBL_MEM_DMABD0INTSTA);
+	CHECK(Count.Read32 == Before.Read32 + 2U);
+
+	/* Mask writes read once, then are computed from the cache */
+	Before = Count;
+	*Reg(Next + XAIEGBL_CORE_PCEVT1) = 0xF0F0U;
+	XAie_MaskWrite32(&DevInst, Next + XAIEGBL_CORE_PCEVT1, 0xFFU, 0x5AU);
+	CHECK(*Reg(Next + XAIEGBL_CORE_PCEVT1) == 0xF05AU);
+	XAie_MaskWrite32(&DevInst, Next + XAIEGBL_CORE_PCEVT1, 0xFU, 0xAU);
+	CHECK(XAie_Read32(&DevInst, Next + XAIEGBL_CORE_PCEVT1) == 0xF05AU);
+	CHECK(Count.Read32 == Before.Read32 + 1U);
+	CHECK(Count.Write32 == Before.Write32 + 1U);
+	CHECK(Count.MaskWrite32 == Before.MaskWrite32);
+
+	/* A block is skipped only if all of its registers are cached */
+	for (u32 i = 0U; i < 8U; i++) {
+		Data[i] = 0xB0U + i;
+	}
+	Before = Count;
+	XAie_BlockWrite32(&DevInst, Next + XAIEGBL_MEM_DMABD0ADDA, Data, 5U);
+	XAie_BlockWrite32(&DevInst, Next + XAIEGBL_MEM_DMABD0ADDA, Data, 5U);
+	CHECK(Count.Block == Before.Block + 1U);
+	XAie_BlockWrite32(&DevInst, Next + XAIEGBL_MEM_DMABD0ADDA, Data, 8U);
+	XAie_BlockWrite32(&DevInst, Next + XAIEGBL_MEM_DMABD0ADDA, Data, 8U);
+	CHECK(Count.Block == Before.Block + 3U);
+	CHECK(WriteTwice(Next + XAIEGBL_MEM_DMABD0CTRL, Data[6U]) == 0U);
+	XAie_BlockSet32(&DevInst, Next + XAIEGBL_MEM_DMABD0ADDA, 0U, 5U);
+	XAie_BlockSet32(&DevInst, Next + XAIEGBL_MEM_DMABD0ADDA, 0U, 5U);
+	CHECK(Count.Block == Before.Block + 4U);
+	CHECK(WriteTwice(Next + XAIEGBL_MEM_DMABD0ADDB, 0U) == 0U);
+
+	/* Reads of the debug backend don't fill the cache */
+	Model.Type = XAIE_IO_BACKEND_DEBUG;
+	Before = Count;
+	XAie_Read32(&DevInst, Next + XAIEGBL_CORE_PCEVT2);
+	XAie_Read32(&DevInst, Next + XAIEGBL_CORE_PCEVT2);
+	XAie_MaskWrite32(&DevInst, Next + XAIEGBL_CORE_PCEVT2, 0xFU, 0x1U);
+	CHECK(Count.Read32 == Before.Read32 + 2U);
+	CHECK(Count.MaskWrite32 == Before.MaskWrite32 + 1U);
+	Model.Type = XAIE_IO_BACKEND_LINUX;
+
+	/* Backend operations which reset the tiles invalidate the cache */
+	XAie_RunOp(&DevInst, XAIE_BACKEND_OP_NPIWR32, NULL);
+	CHECK(WriteTwice(Tile + XAIEGBL_CORE_TILCTRL, 3U) == 0U);
+	XAie_RunOp(&DevInst, XAIE_BACKEND_OP_ASSERT_SHIMRST, NULL);
+	CHECK(WriteTwice(Tile + XAIEGBL_CORE_TILCTRL, 3U) == 1U);
+	CHECK(XAie_ShadowCacheInvalidate(&DevInst) == XAIE_OK);
+	CHECK(WriteTwice(Tile + XAIEGBL_CORE_TILCTRL, 3U) == 1U);
+
+	/*
+	 * The partition reset invalidates each column as its reset is
+	 * asserted, checked while the reset of the next column is written
+	 */
+	CHECK(WriteTwice(Tile + XAIEGBL_CORE_TILCTRL, 3U) == 0U);
+	CHECK(WriteTwice(Next + XAIEGBL_CORE_TILCTRL, 3U) == 1U);
+	PlIfMod = DevInst.DevProp.DevMod[XAIEGBL_TILE_TYPE_SHIMNOC].PlIfMod;
+	ProbeRstOff = PlIfMod->ColRstOff +
+		_XAie_GetTileAddr(&DevInst, 0U, AIE_COL + 1U);
+	ProbeReset = Tile + XAIEGBL_CORE_TILCTRL;
+	ProbeNext = Next + XAIEGBL_CORE_TILCTRL;
+	CHECK(XAie_ResetPartition(&DevInst) == XAIE_OK);
+	CHECK(NumProbes == 1U);
+	ProbeRstOff = 0U;
+	CHECK(WriteTwice(Tile + XAIEGBL_CORE_TILCTRL, 3U) == 1U);
+	CHECK(WriteTwice(Next + XAIEGBL_CORE_TILCTRL, 3U) == 1U);
+
+	CHECK(XAie_ShadowCacheDisable(&DevInst) == XAIE_OK);
+	CHECK(WriteTwice(Tile + XAIEGBL_CORE_TILCTRL, 3U) == 2U);
+	CHECK(XAie_Finish(&DevInst) == XAIE_OK);
+
+	printf("Shadow register cache: all checks passed\n");
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,287 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Host test of the snapshot backend (xaie_snapshot.c).
+ *
+ * A configuration is done once on a capture backend, which logs the register
+ * operations, and once on the snapshot backend. Replaying the exported
+ * snapshot on the capture backend has to log the same register writes.
+ *
+ * Also checked are that recordings with register reads or shim DMA buffer
+ * descriptors can't be exported, and that snapshots with invalid commands or
+ * registers outside of the partition are rejected without any write.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <xaiengine.h>
+#include <xaiengine/xaie_helper.h>
+
+#define LOG_LEN		(1U << 20U)
+#define COL_SHIFT	23U
+#define NUM_COLS	50U
+#define PART_SIZE	(NUM_COLS << COL_SHIFT)
+
+#define CHECK(Cond)	do { \
+	if (!(Cond)) { \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Cond); \
+		exit(EXIT_FAILURE); \
+	} \
+} while (0)
+
+static char Log[LOG_LEN];
+static size_t LogLen;
+static u32 NumOps;
+static XAie_Backend Capture;
+
+#define LOG(...) do { \
+	LogLen += (size_t)snprintf(Log + LogLen, LOG_LEN - LogLen, __VA_ARGS__); \
+} while (0)
+
+/* Capture backend, block operations are logged as single writes */
+static void CaptureWrite32(void *IOInst, u64 RegOff, u32 Value)
+{
+	(void)IOInst;
+	NumOps++;
+	LOG("W %lx %x\n", RegOff, Value);
+}
+
+static u32 CaptureRead32(void *IOInst, u64 RegOff)
+{
+	(void)IOInst;
+	(void)RegOff;
+	return 0U;
+}
+
+static void CaptureMaskWrite32(void *IOInst, u64 RegOff, u32 Mask, u32 Value)
+{
+	(void)IOInst;
+	NumOps++;
+	LOG("MW %lx %x %x\n", RegOff, Mask, Value);
+}
+
+static u32 CaptureMaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
+		u32 TimeOutUs)
+{
+	(void)IOInst;
+	NumOps++;
+	LOG("MP %lx %x %x %u\n", RegOff, Mask, Value, TimeOutUs);
+	return XAIE_SUCCESS;
+}
+
+static void CaptureBlockWrite32(void *IOInst, u64 RegOff, u32 *Data, u32 Size)
+{
+	(void)IOInst;
+	NumOps++;
+	for (u32 i = 0U; i < Size; i++) {
+		LOG("W %lx %x\n", RegOff + 4U * i, Data[i]);
+	}
+}
+
+static void CaptureBlockSet32(void *IOInst, u64 RegOff, u32 Data, u32 Size)
+{
+	(void)IOInst;
+	NumOps++;
+	for (u32 i = 0U; i < Size; i++) {
+		LOG("W %lx %x\n", RegOff + 4U * i, Data);
+	}
+}
+
+static AieRC CaptureRunOp(void *IOInst, XAie_DevInst *DevInst,
+		XAie_BackendOpCode Op, void *Arg)
+{
+	XAie_BackendNpiWrReq *Req = Arg;
+
+	(void)IOInst;
+	(void)DevInst;
+	if (Op != XAIE_BACKEND_OP_NPIWR32) {
+		return XAIE_FEATURE_NOT_SUPPORTED;
+	}
+	NumOps++;
+	LOG("NPI %x %x\n", Req->NpiRegOff, Req->Val);
+	return XAIE_OK;
+}
+
+static void UseCapture(XAie_DevInst *DevInst)
+{
+	CHECK(XAie_SetIOBackend(DevInst, XAIE_IO_BACKEND_DEBUG) == XAIE_OK);
+	Capture = *DevInst->Backend;
+	Capture.Ops.Write32 = CaptureWrite32;
+	Capture.Ops.Read32 = CaptureRead32;
+	Capture.Ops.MaskWrite32 = CaptureMaskWrite32;
+	Capture.Ops.MaskPoll = CaptureMaskPoll;
+	Capture.Ops.BlockWrite32 = CaptureBlockWrite32;
+	Capture.Ops.BlockSet32 = CaptureBlockSet32;
+	Capture.Ops.RunOp = CaptureRunOp;
+	DevInst->Backend = &Capture;
+	LogLen = 0U;
+	Log[0U] = '\0';
+	NumOps = 0U;
+}
+
+static void UseSnapshot(XAie_DevInst *DevInst)
+{
+	/* Restore the debug backend the capture backend was copied from */
+	DevInst->Backend = _XAie_GetBackendPtr(XAIE_IO_BACKEND_DEBUG);
+	CHECK(XAie_SetIOBackend(DevInst, XAIE_IO_BACKEND_SNAPSHOT) == XAIE_OK);
+}
+
+static void Configure(XAie_DevInst *DevInst)
+{
+	XAie_LocType Tile = XAie_TileLoc(3, 2);
+	XAie_BackendNpiWrReq Req = { 0x0U, 0x1U };
+	u32 Buf[40U];
+	u32 Value = 0x77U;
+
+	for (u32 i = 0U; i < 40U; i++) {
+		Buf[i] = i * 0x1111U;
+	}
+
+	CHECK(XAie_StrmConnCctEnable(DevInst, Tile, CORE, 0, SOUTH, 1) ==
+		XAIE_OK);
+	CHECK(XAie_DataMemWrWord(DevInst, Tile, 0x100U, 5U) == XAIE_OK);
+	CHECK(XAie_DataMemWrWord(DevInst, Tile, 0x104U, 6U) == XAIE_OK);
+	CHECK(XAie_DataMemBlockWrite(DevInst, Tile, 0x1000U, Buf,
+		sizeof(Buf)) == XAIE_OK);
+	CHECK(XAie_PerfCounterControlSet(DevInst, Tile, XAIE_CORE_MOD, 0,
+		XAIE_EVENT_ACTIVE_CORE, XAIE_EVENT_DISABLED_CORE) == XAIE_OK);
+	CHECK(XAie_CoreEnable(DevInst, Tile) == XAIE_OK);
+	XAie_BlockSet32(DevInst, 0x4000U, 0xABU, 8U);
+	XAie_BlockWrite32(DevInst, 0x8000U, &Value, 1U);
+	CHECK(XAie_RunOp(DevInst, XAIE_BACKEND_OP_NPIWR32, &Req) == XAIE_OK);
+}
+
+/* Returns the word index of the first command with the opcode, 0 if none */
+static u32 FindCmd(const u32 *Snapshot, u64 Size, u32 Op)
+{
+	u32 Index = (u32)(sizeof(XAie_SnapshotHdr) / 4U);
+	u32 CmdOp;
+	u32 Count;
+
+	while (Index < Size / 4U) {
+		CmdOp = Snapshot[Index] >> XAIE_SNAPSHOT_OP_SHIFT;
+		Count = Snapshot[Index] & XAIE_SNAPSHOT_COUNT_MASK;
+		if (CmdOp == Op) {
+			return Index;
+		}
+		switch (CmdOp) {
+		case XAIE_SNAPSHOT_OP_BLOCKWRITE:
+			Index += Count + 2U;
+			break;
+		case XAIE_SNAPSHOT_OP_BLOCKSET:
+			Index += 3U;
+			break;
+		case XAIE_SNAPSHOT_OP_MASKWRITE:
+			Index += 3U * Count + 1U;
+			break;
+		case XAIE_SNAPSHOT_OP_MASKPOLL:
+			Index += 4U * Count + 1U;
+			break;
+		default:
+			/* WRITE and NPIWRITE */
+			Index += 2U * Count + 1U;
+			break;
+		}
+	}
+
+	return 0U;
+}
+
+/* Replays a modified copy of the snapshot, which has to be rejected */
+static void CheckRejected(XAie_DevInst *DevInst, const u32 *Snapshot,
+		u64 Size, u32 Word, u32 Value)
+{
+	u32 *Copy = malloc(Size);
+
+	CHECK(Copy != NULL);
+	memcpy(Copy, Snapshot, Size);
+	Copy[Word] = Value;
+	NumOps = 0U;
+	CHECK(XAie_SnapshotReplay(DevInst, Copy, Size) == XAIE_INVALID_ARGS);
+	CHECK(NumOps == 0U);
+	free(Copy);
+}
+
+int main(void)
+{
+	XAie_SetupConfig(Cfg, XAIE_DEV_GEN_AIE, 0, COL_SHIFT, 18, NUM_COLS, 9,
+		0, 1, 0, 1, 8);
+	XAie_InstDeclare(DevInst, &Cfg);
+	XAie_ShimDmaBdArgs BdArgs;
+	u32 BdWords[8U] = { 0U };
+	char *Direct;
+	u32 DirectOps;
+	u32 *Snapshot;
+	u64 Size;
+	u32 Word;
+
+	CHECK(XAie_CfgInitialize(&DevInst, &Cfg) == XAIE_OK);
+
+	/* Replay of a snapshot writes the registers of the direct config */
+	UseCapture(&DevInst);
+	Configure(&DevInst);
+	Direct = strdup(Log);
+	DirectOps = NumOps;
+	UseSnapshot(&DevInst);
+	Configure(&DevInst);
+	CHECK(XAie_SnapshotExport(&DevInst, (void **)&Snapshot, &Size) ==
+		XAIE_OK);
+	UseCapture(&DevInst);
+	CHECK(XAie_SnapshotReplay(&DevInst, Snapshot, Size) == XAIE_OK);
+	CHECK(strcmp(Direct, Log) == 0);
+	printf("Replay of %lu byte snapshot: %u operations, %u direct\n",
+		Size, NumOps, DirectOps);
+
+	/*
+	 * Invalid snapshots and registers outside of the partition are
+	 * rejected before any register is written
+	 */
+	CheckRejected(&DevInst, Snapshot, Size, 0U, ~Snapshot[0U]);
+	Word = FindCmd(Snapshot, Size, XAIE_SNAPSHOT_OP_WRITE);
+	CHECK(Word != 0U);
+	CheckRejected(&DevInst, Snapshot, Size, Word + 1U, PART_SIZE);
+	CheckRejected(&DevInst, Snapshot, Size, Word + 1U,
+		Snapshot[Word + 1U] | 0x2U);
+	Word = FindCmd(Snapshot, Size, XAIE_SNAPSHOT_OP_BLOCKWRITE);
+	CHECK((Word != 0U) &&
+		((Snapshot[Word] & XAIE_SNAPSHOT_COUNT_MASK) > 1U));
+	CheckRejected(&DevInst, Snapshot, Size, Word + 1U, PART_SIZE - 4U);
+	Word = FindCmd(Snapshot, Size, XAIE_SNAPSHOT_OP_BLOCKSET);
+	CHECK(Word != 0U);
+	CheckRejected(&DevInst, Snapshot, Size, Word + 1U, PART_SIZE - 4U);
+	Word = FindCmd(Snapshot, Size, XAIE_SNAPSHOT_OP_NPIWRITE);
+	CHECK(Word != 0U);
+	CheckRejected(&DevInst, Snapshot, Size, Word + 1U, 0x300U);
+	free(Snapshot);
+
+	/* Register reads can't be recorded */
+	UseSnapshot(&DevInst);
+	(void)XAie_Read32(&DevInst, 0x100U);
+	CHECK(XAie_SnapshotExport(&DevInst, (void **)&Snapshot, &Size) ==
+		XAIE_ERR);
+
+	/* Shim DMA buffer descriptors hold host addresses */
+	UseSnapshot(&DevInst);
+	BdArgs.NumBdWords = 8U;
+	BdArgs.BdWords = BdWords;
+	BdArgs.Loc = XAie_TileLoc(2, 0);
+	BdArgs.VAddr = 0x1000U;
+	BdArgs.BdNum = 0U;
+	BdArgs.Addr = 0x1D000U;
+	BdArgs.MemInst = XAIE_NULL;
+	CHECK(XAie_RunOp(&DevInst, XAIE_BACKEND_OP_CONFIG_SHIMDMABD, &BdArgs) ==
+		XAIE_FEATURE_NOT_SUPPORTED);
+	CHECK(XAie_SnapshotExport(&DevInst, (void **)&Snapshot, &Size) ==
+		XAIE_ERR);
+
+	CHECK(XAie_SetIOBackend(&DevInst, XAIE_IO_BACKEND_DEBUG) == XAIE_OK);
+	free(Direct);
+	printf("Snapshot backend: all checks passed\n");
+
+	return EXIT_SUCCESS;
+}
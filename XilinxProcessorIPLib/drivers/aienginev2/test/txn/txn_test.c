@@ -0,0 +1,377 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Host test of the IO transactions (xaie_txn.c).
+ *
+ * The operations of the debug backend are replaced by a register file
+ * model logging every access which reaches the backend. The recorded
+ * commands are checked through a SubmitTxn operation of the model, the
+ * replay through the IO operations without it.
+ *
+ * Checked are the recorded commands and the merging of contiguous writes,
+ * the replay order and data, mask poll timeouts, the growth of the command
+ * and data buffers, that reads, command writes and backend operations
+ * execute the commands recorded before them, and that cancelled
+ * transactions, including the one dropped by XAie_Finish(), don't reach the
+ * backend and invalidate the shadow register cache.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <xaiengine.h>
+#include <xaiengine/xaie_helper.h>
+#include <xaiengine/xaiegbl_params.h>
+
+#define NUM_REGS	(1U << 16U)
+#define MAX_LOG		512U
+#define MAX_CMDS	16U
+#define NUM_WORDS	300U	/* More than the initial data buffer */
+#define NUM_WRITES	100U	/* More than the initial command buffer */
+
+#define CHECK(Cond)	do { \
+	if (!(Cond)) { \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Cond); \
+		exit(EXIT_FAILURE); \
+	} \
+} while (0)
+
+/* Access which reached the backend */
+typedef struct {
+	char Op;	/* W, R, M, P, B, S, C for command write, O for op */
+	u64 Off;
+	u32 Value;
+	u32 Size;
+} Access;
+
+static u64 RegOff[NUM_REGS];
+static u32 RegVal[NUM_REGS];
+static u8 RegUsed[NUM_REGS];
+static Access Log[MAX_LOG];
+static u32 NumLog;
+static u32 PollResult = XAIE_SUCCESS;
+
+/* Commands given to the SubmitTxn operation */
+static XAie_TxnCmd Cmds[MAX_CMDS];
+static u32 CmdData[MAX_CMDS][8U];
+static u32 NumCmds;
+static u32 NumSubmits;
+
+/* Register file of the model */
+static u32 *Reg(u64 Off)
+{
+	u32 Idx = (u32)((Off * 0x9E3779B97F4A7C15ULL) >> 48U) &
+		(NUM_REGS - 1U);
+
+	while ((RegUsed[Idx] != 0U) && (RegOff[Idx] != Off)) {
+		Idx = (Idx + 1U) & (NUM_REGS - 1U);
+	}
+	if (RegUsed[Idx] == 0U) {
+		RegUsed[Idx] = 1U;
+		RegOff[Idx] = Off;
+		RegVal[Idx] = 0U;
+	}
+
+	return &RegVal[Idx];
+}
+
+static void AddLog(char Op, u64 Off, u32 Value, u32 Size)
+{
+	CHECK(NumLog < MAX_LOG);
+	Log[NumLog].Op = Op;
+	Log[NumLog].Off = Off;
+	Log[NumLog].Value = Value;
+	Log[NumLog].Size = Size;
+	NumLog++;
+}
+
+static u8 IsLog(u32 Index, char Op, u64 Off, u32 Value, u32 Size)
+{
+	return (Index < NumLog) && (Log[Index].Op == Op) &&
+		(Log[Index].Off == Off) && (Log[Index].Value == Value) &&
+		(Log[Index].Size == Size);
+}
+
+static void ModelWrite32(void *IOInst, u64 Off, u32 Value)
+{
+	(void)IOInst;
+	AddLog('W', Off, Value, 1U);
+	*Reg(Off) = Value;
+}
+
+static u32 ModelRead32(void *IOInst, u64 Off)
+{
+	(void)IOInst;
+	AddLog('R', Off, 0U, 1U);
+
+	return *Reg(Off);
+}
+
+static void ModelMaskWrite32(void *IOInst, u64 Off, u32 Mask, u32 Value)
+{
+	u32 *Ptr;
+
+	(void)IOInst;
+	AddLog('M', Off, Value, 1U);
+	Ptr = Reg(Off);
+	*Ptr = (*Ptr & ~Mask) | Value;
+}
+
+static u32 ModelMaskPoll(void *IOInst, u64 Off, u32 Mask, u32 Value,
+		u32 TimeOutUs)
+{
+	(void)IOInst;
+	(void)Mask;
+	(void)TimeOutUs;
+	AddLog('P', Off, Value, 1U);
+
+	return PollResult;
+}
+
+static void ModelBlockWrite32(void *IOInst, u64 Off, u32 *Data, u32 Size)
+{
+	(void)IOInst;
+	AddLog('B', Off, Data[0U], Size);
+	for (u32 i = 0U; i < Size; i++) {
+		*Reg(Off + 4U * i) = Data[i];
+	}
+}
+
+static void ModelBlockSet32(void *IOInst, u64 Off, u32 Data, u32 Size)
+{
+	(void)IOInst;
+	AddLog('S', Off, Data, Size);
+	for (u32 i = 0U; i < Size; i++) {
+		*Reg(Off + 4U * i) = Data;
+	}
+}
+
+static void ModelCmdWrite(void *IOInst, u8 Col, u8 Row, u8 Command,
+		u32 CmdWd0, u32 CmdWd1, const char *CmdStr)
+{
+	(void)IOInst;
+	(void)Col;
+	(void)Row;
+	(void)CmdWd1;
+	(void)CmdStr;
+	AddLog('C', Command, CmdWd0, 1U);
+}
+
+static AieRC ModelRunOp(void *IOInst, XAie_DevInst *DevInst,
+		XAie_BackendOpCode Op, void *Arg)
+{
+	(void)IOInst;
+	(void)DevInst;
+	(void)Arg;
+	AddLog('O', Op, 0U, 1U);
+
+	return XAIE_OK;
+}
+
+static AieRC ModelSubmitTxn(void *IOInst, XAie_TxnInst *TxnInst)
+{
+	(void)IOInst;
+	CHECK(TxnInst->NumCmds <= MAX_CMDS);
+	NumSubmits++;
+	NumCmds = TxnInst->NumCmds;
+	for (u32 i = 0U; i < NumCmds; i++) {
+		Cmds[i] = TxnInst->CmdBuf[i];
+		if (Cmds[i].Opcode != XAIE_TXN_OP_BLOCKWRITE) {
+			continue;
+		}
+		CHECK(Cmds[i].Size <= 8U);
+		memcpy(CmdData[i], &TxnInst->DataBuf[Cmds[i].DataOff],
+			Cmds[i].Size * sizeof(u32));
+	}
+
+	return XAIE_OK;
+}
+
+static u8 IsCmd(u32 Index, XAie_TxnOpcode Opcode, u64 Off, u32 Value,
+		u32 Size)
+{
+	return (Index < NumCmds) && (Cmds[Index].Opcode == Opcode) &&
+		(Cmds[Index].RegOff == Off) && (Cmds[Index].Size == Size) &&
+		((Opcode == XAIE_TXN_OP_BLOCKWRITE) ?
+		 (CmdData[Index][0U] == Value) : (Cmds[Index].Value == Value));
+}
+
+/* Writes of all kinds, with contiguous ones to merge */
+static void RecordSequence(XAie_DevInst *DevInst, u64 Base)
+{
+	u32 Data[2U] = {0xD3U, 0xD4U};
+
+	XAie_Write32(DevInst, Base, 0xD0U);
+	XAie_Write32(DevInst, Base + 0x4U, 0xD1U);
+	XAie_Write32(DevInst, Base + 0x8U, 0xD2U);
+	XAie_BlockWrite32(DevInst, Base + 0xCU, Data, 2U);
+	XAie_Write32(DevInst, Base + 0x100U, 0xE0U);
+	XAie_MaskWrite32(DevInst, Base + 0x200U, 0xFFU, 0xF0U);
+	XAie_Write32(DevInst, Base + 0x204U, 0xF1U);
+	XAie_BlockSet32(DevInst, Base + 0x300U, 0xAAU, 4U);
+	XAie_Write32(DevInst, Base + 0x310U, 0xABU);
+	XAie_MaskPoll(DevInst, Base + 0x400U, 0x1U, 0x1U, 10U);
+}
+
+int main(void)
+{
+	XAie_SetupConfig(Cfg, XAIE_DEV_GEN_AIE, 0, 23, 18, 50, 9, 0, 1, 0, 1, 8);
+	XAie_InstDeclare(DevInst, &Cfg);
+	XAie_Backend Model;
+	u64 Base, Tile;
+	u32 Data[NUM_WORDS];
+
+	CHECK(XAie_CfgInitialize(&DevInst, &Cfg) == XAIE_OK);
+	CHECK(XAie_SetIOBackend(&DevInst, XAIE_IO_BACKEND_DEBUG) == XAIE_OK);
+	Model = *DevInst.Backend;
+	CHECK(Model.Ops.SubmitTxn == NULL);
+	Model.Ops.Write32 = ModelWrite32;
+	Model.Ops.Read32 = ModelRead32;
+	Model.Ops.MaskWrite32 = ModelMaskWrite32;
+	Model.Ops.MaskPoll = ModelMaskPoll;
+	Model.Ops.BlockWrite32 = ModelBlockWrite32;
+	Model.Ops.BlockSet32 = ModelBlockSet32;
+	Model.Ops.CmdWrite = ModelCmdWrite;
+	Model.Ops.RunOp = ModelRunOp;
+	Model.Ops.SubmitTxn = ModelSubmitTxn;
+	DevInst.Backend = &Model;
+	Base = _XAie_GetTileAddr(&DevInst, 1U, 2U) + 0x1000U;
+	Tile = _XAie_GetTileAddr(&DevInst, 1U, 3U);
+
+	CHECK(XAie_SubmitTransaction(&DevInst) == XAIE_INVALID_ARGS);
+	CHECK(XAie_CancelTransaction(&DevInst) == XAIE_INVALID_ARGS);
+
+	/* Recording and merging */
+	CHECK(XAie_StartTransaction(&DevInst, 0U) == XAIE_OK);
+	CHECK(XAie_StartTransaction(&DevInst, 0U) == XAIE_ERR);
+	RecordSequence(&DevInst, Base);
+	CHECK(NumLog == 0U);
+	CHECK(XAie_SubmitTransaction(&DevInst) == XAIE_OK);
+	CHECK(DevInst.TxnInst == NULL);
+	CHECK((NumSubmits == 1U) && (NumCmds == 7U) && (NumLog == 0U));
+	CHECK(IsCmd(0U, XAIE_TXN_OP_BLOCKWRITE, Base, 0xD0U, 5U));
+	for (u32 i = 0U; i < 5U; i++) {
+		CHECK(CmdData[0U][i] == 0xD0U + i);
+	}
+	CHECK(IsCmd(1U, XAIE_TXN_OP_WRITE, Base + 0x100U, 0xE0U, 0U));
+	CHECK(IsCmd(2U, XAIE_TXN_OP_MASKWRITE, Base + 0x200U, 0xF0U, 0U));
+	CHECK(Cmds[2U].Mask == 0xFFU);
+	CHECK(IsCmd(3U, XAIE_TXN_OP_WRITE, Base + 0x204U, 0xF1U, 0U));
+	CHECK(IsCmd(4U, XAIE_TXN_OP_BLOCKSET, Base + 0x300U, 0xAAU, 4U));
+	CHECK(IsCmd(5U, XAIE_TXN_OP_WRITE, Base + 0x310U, 0xABU, 0U));
+	CHECK(IsCmd(6U, XAIE_TXN_OP_MASKPOLL, Base + 0x400U, 0x1U, 0U));
+	CHECK(Cmds[6U].TimeOutUs == 10U);
+
+	/* Contiguous writes are kept apart on request */
+	CHECK(XAie_StartTransaction(&DevInst, XAIE_TXN_NO_MERGE) == XAIE_OK);
+	XAie_Write32(&DevInst, Base, 1U);
+	XAie_Write32(&DevInst, Base + 0x4U, 2U);
+	CHECK(XAie_SubmitTransaction(&DevInst) == XAIE_OK);
+	CHECK(NumCmds == 2U);
+	CHECK(IsCmd(0U, XAIE_TXN_OP_WRITE, Base, 1U, 0U));
+	CHECK(IsCmd(1U, XAIE_TXN_OP_WRITE, Base + 0x4U, 2U, 0U));
+
+	/* Replay through the IO operations, in order */
+	Model.Ops.SubmitTxn = NULL;
+	CHECK(XAie_StartTransaction(&DevInst, 0U) == XAIE_OK);
+	RecordSequence(&DevInst, Base);
+	CHECK(NumLog == 0U);
+	CHECK(XAie_SubmitTransaction(&DevInst) == XAIE_OK);
+	CHECK(NumLog == 7U);
+	CHECK(IsLog(0U, 'B', Base, 0xD0U, 5U));
+	CHECK(IsLog(1U, 'W', Base + 0x100U, 0xE0U, 1U));
+	CHECK(IsLog(2U, 'M', Base + 0x200U, 0xF0U, 1U));
+	CHECK(IsLog(3U, 'W', Base + 0x204U, 0xF1U, 1U));
+	CHECK(IsLog(4U, 'S', Base + 0x300U, 0xAAU, 4U));
+	CHECK(IsLog(5U, 'W', Base + 0x310U, 0xABU, 1U));
+	CHECK(IsLog(6U, 'P', Base + 0x400U, 0x1U, 1U));
+	for (u32 i = 0U; i < 5U; i++) {
+		CHECK(*Reg(Base + 4U * i) == 0xD0U + i);
+	}
+
+	/* Timed out polls fail the submit */
+	NumLog = 0U;
+	PollResult = XAIE_FAILURE;
+	CHECK(XAie_StartTransaction(&DevInst, 0U) == XAIE_OK);
+	CHECK(XAie_MaskPoll(&DevInst, Base, 0x1U, 0x1U, 10U) == XAIE_SUCCESS);
+	XAie_Write32(&DevInst, Base, 3U);
+	CHECK(XAie_SubmitTransaction(&DevInst) == XAIE_ERR);
+	CHECK(IsLog(1U, 'W', Base, 3U, 1U));
+	PollResult = XAIE_SUCCESS;
+
+	/* The command and data buffers grow */
+	NumLog = 0U;
+	for (u32 i = 0U; i < NUM_WORDS; i++) {
+		Data[i] = 0x1000U + i;
+	}
+	CHECK(XAie_StartTransaction(&DevInst, 0U) == XAIE_OK);
+	XAie_Write32(&DevInst, Base, Data[0U]);
+	XAie_BlockWrite32(&DevInst, Base + 0x4U, &Data[1U], NUM_WORDS - 2U);
+	XAie_Write32(&DevInst, Base + 4U * (NUM_WORDS - 1U),
+		Data[NUM_WORDS - 1U]);
+	for (u32 i = 0U; i < NUM_WRITES; i++) {
+		XAie_Write32(&DevInst, Base + 0x10000U + 8U * i, i);
+	}
+	CHECK(XAie_SubmitTransaction(&DevInst) == XAIE_OK);
+	CHECK(NumLog == NUM_WRITES + 1U);
+	CHECK(IsLog(0U, 'B', Base, Data[0U], NUM_WORDS));
+	for (u32 i = 0U; i < NUM_WORDS; i++) {
+		CHECK(*Reg(Base + 4U * i) == Data[i]);
+	}
+	for (u32 i = 0U; i < NUM_WRITES; i++) {
+		CHECK(IsLog(1U + i, 'W', Base + 0x10000U + 8U * i, i, 1U));
+	}
+
+	/*
+	 * Reads, command writes and backend operations execute the recorded
+	 * commands first, the transaction stays open and is recorded anew
+	 */
+	NumLog = 0U;
+	CHECK(XAie_StartTransaction(&DevInst, 0U) == XAIE_OK);
+	XAie_Write32(&DevInst, Base, 4U);
+	CHECK(XAie_Read32(&DevInst, Base) == 4U);
+	XAie_Write32(&DevInst, Base + 0x4U, 5U);
+	XAie_CmdWrite(&DevInst, 2U, 1U, 7U, 0U, 0U, NULL);
+	XAie_Write32(&DevInst, Base + 0x8U, 6U);
+	XAie_RunOp(&DevInst, XAIE_BACKEND_OP_CONFIG_SHIMDMABD, NULL);
+	CHECK(NumLog == 6U);
+	CHECK(DevInst.TxnInst != NULL);
+	XAie_Write32(&DevInst, Base + 0xCU, 7U);
+	CHECK(XAie_SubmitTransaction(&DevInst) == XAIE_OK);
+	CHECK(NumLog == 7U);
+	CHECK(IsLog(0U, 'W', Base, 4U, 1U));
+	CHECK(IsLog(1U, 'R', Base, 0U, 1U));
+	CHECK(IsLog(2U, 'W', Base + 0x4U, 5U, 1U));
+	CHECK(IsLog(3U, 'C', 7U, 0U, 1U));
+	CHECK(IsLog(4U, 'W', Base + 0x8U, 6U, 1U));
+	CHECK(IsLog(5U, 'O', XAIE_BACKEND_OP_CONFIG_SHIMDMABD, 0U, 1U));
+	CHECK(IsLog(6U, 'W', Base + 0xCU, 7U, 1U));
+
+	/* Cancelled commands don't reach the backend nor the shadow cache */
+	NumLog = 0U;
+	CHECK(XAie_ShadowCacheEnable(&DevInst) == XAIE_OK);
+	XAie_Write32(&DevInst, Tile + XAIEGBL_CORE_TILCTRL, 1U);
+	CHECK(XAie_StartTransaction(&DevInst, 0U) == XAIE_OK);
+	XAie_Write32(&DevInst, Tile + XAIEGBL_CORE_TILCTRL, 2U);
+	CHECK(XAie_CancelTransaction(&DevInst) == XAIE_OK);
+	CHECK((DevInst.TxnInst == NULL) && (NumLog == 1U));
+	XAie_Write32(&DevInst, Tile + XAIEGBL_CORE_TILCTRL, 2U);
+	CHECK(IsLog(1U, 'W', Tile + XAIEGBL_CORE_TILCTRL, 2U, 1U));
+
+	/* XAie_Finish() drops the open transaction */
+	NumLog = 0U;
+	CHECK(XAie_StartTransaction(&DevInst, 0U) == XAIE_OK);
+	XAie_Write32(&DevInst, Base, 8U);
+	XAie_BlockSet32(&DevInst, Base + 0x100U, 0U, 4U);
+	CHECK(XAie_Finish(&DevInst) == XAIE_OK);
+	CHECK((DevInst.TxnInst == NULL) && (DevInst.ShadowInst == NULL));
+	CHECK(NumLog == 0U);
+
+	printf("Transactions: all checks passed\n");
+
+	return EXIT_SUCCESS;
+}
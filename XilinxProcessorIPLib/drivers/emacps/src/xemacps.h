@@ -429,6 +429,20 @@ extern "C" {
 /**< Default options set when device is initialized or reset */
 /*@}*/
 
+/** @name Screener match flags
+ *
+ * These constants are used as the Flags parameter of
+ * XEmacPs_SetScreenerType1() and XEmacPs_SetScreenerType2(). A screener with
+ * no match flag set is disabled.
+ * @{
+ */
+#define XEMACPS_SCREENER_MATCH_DSTC	0x00000001U /**< Match IP DS/TC field */
+#define XEMACPS_SCREENER_MATCH_UDPPORT	0x00000002U /**< Match UDP destination
+						      port */
+#define XEMACPS_SCREENER_MATCH_VLANPRIO	0x00000004U /**< Match VLAN priority */
+#define XEMACPS_SCREENER_MATCH_ETHTYPE	0x00000008U /**< Match ethertype */
+/*@}*/
+
 /** @name Callback identifiers
  *
  * These constants are used as parameters to XEmacPs_SetHandler()
@@ -824,6 +838,12 @@ LONG XEmacPs_PhyRead(XEmacPs *InstancePtr, u32 PhyAddress,
 LONG XEmacPs_PhyWrite(XEmacPs *InstancePtr, u32 PhyAddress,
 		      u32 RegisterNum, u16 PhyData);
 LONG XEmacPs_SetTypeIdCheck(XEmacPs *InstancePtr, u32 Id_Check, u8 Index);
+LONG XEmacPs_SetScreenerType1(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+				u32 Flags, u8 DsTc, u16 UdpPort);
+LONG XEmacPs_SetScreenerType2(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+				u32 Flags, u8 VlanPrio, u16 EtherType);
+void XEmacPs_ClearScreeners(XEmacPs *InstancePtr);
+LONG XEmacPs_SetIntrModeration(XEmacPs *InstancePtr, u8 RxDelay, u8 TxDelay);
 
 LONG XEmacPs_SendPausePacket(XEmacPs *InstancePtr);
 void XEmacPs_DMABLengthUpdate(XEmacPs *InstancePtr, s32 BLength);
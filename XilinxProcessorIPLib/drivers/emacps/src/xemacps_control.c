@@ -409,6 +409,189 @@ LONG XEmacPs_SetTypeIdCheck(XEmacPs *InstancePtr, u32 Id_Check, u8 Index)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * Program a type 1 screener. Type 1 screeners steer received IP frames to a
+ * priority queue based on the DS/TC field and/or the UDP destination port.
+ * The device must be stopped before calling this function.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener to program (0 to
+ *        XEMACPS_MAX_SCREENER_TYPE1 - 1).
+ * @param QueueNum is the RX queue matching frames are steered to.
+ * @param Flags is a combination of XEMACPS_SCREENER_MATCH_DSTC and
+ *        XEMACPS_SCREENER_MATCH_UDPPORT. 0 disables the screener.
+ * @param DsTc is the DS/TC value to match.
+ * @param UdpPort is the UDP destination port to match.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was programmed successfully
+ * - XST_DEVICE_IS_STARTED if the device has not yet been stopped
+ * - XST_NO_FEATURE if the GEM version has no priority queues
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetScreenerType1(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+				u32 Flags, u8 DsTc, u16 UdpPort)
+{
+	u32 RegVal;
+	LONG Status;
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Index < (u8)XEMACPS_MAX_SCREENER_TYPE1);
+
+	if (InstancePtr->Version <= 2) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else if (InstancePtr->IsStarted == (u32)XIL_COMPONENT_IS_STARTED) {
+		Status = (LONG)(XST_DEVICE_IS_STARTED);
+	} else {
+		RegVal = (u32)QueueNum & XEMACPS_SCRT1_QUEUE_MASK;
+		RegVal |= ((u32)DsTc << XEMACPS_SCRT1_DSTC_SHIFT) &
+				XEMACPS_SCRT1_DSTC_MASK;
+		RegVal |= ((u32)UdpPort << XEMACPS_SCRT1_UDPPORT_SHIFT) &
+				XEMACPS_SCRT1_UDPPORT_MASK;
+		if ((Flags & XEMACPS_SCREENER_MATCH_DSTC) != 0x00000000U) {
+			RegVal |= XEMACPS_SCRT1_DSTC_EN_MASK;
+		}
+		if ((Flags & XEMACPS_SCREENER_MATCH_UDPPORT) != 0x00000000U) {
+			RegVal |= XEMACPS_SCRT1_UDPPORT_EN_MASK;
+		}
+
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCREENING_TYPE1_OFFSET + ((u32)Index * (u32)4)),
+			RegVal);
+
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Program a type 2 screener. Type 2 screeners steer received frames to a
+ * priority queue based on the VLAN priority and/or the ethertype. The
+ * ethertype register with the same index as the screener is used for the
+ * ethertype comparison. The device must be stopped before calling this
+ * function.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener to program (0 to
+ *        XEMACPS_MAX_SCREENER_TYPE2 - 1).
+ * @param QueueNum is the RX queue matching frames are steered to.
+ * @param Flags is a combination of XEMACPS_SCREENER_MATCH_VLANPRIO and
+ *        XEMACPS_SCREENER_MATCH_ETHTYPE. 0 disables the screener.
+ * @param VlanPrio is the VLAN priority to match.
+ * @param EtherType is the ethertype to match.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was programmed successfully
+ * - XST_DEVICE_IS_STARTED if the device has not yet been stopped
+ * - XST_NO_FEATURE if the GEM version has no priority queues
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetScreenerType2(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+				u32 Flags, u8 VlanPrio, u16 EtherType)
+{
+	u32 RegVal;
+	LONG Status;
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Index < (u8)XEMACPS_MAX_SCREENER_TYPE2);
+
+	if (InstancePtr->Version <= 2) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else if (InstancePtr->IsStarted == (u32)XIL_COMPONENT_IS_STARTED) {
+		Status = (LONG)(XST_DEVICE_IS_STARTED);
+	} else {
+		RegVal = (u32)QueueNum & XEMACPS_SCRT2_QUEUE_MASK;
+		RegVal |= ((u32)VlanPrio << XEMACPS_SCRT2_VLANPRIO_SHIFT) &
+				XEMACPS_SCRT2_VLANPRIO_MASK;
+		if ((Flags & XEMACPS_SCREENER_MATCH_VLANPRIO) != 0x00000000U) {
+			RegVal |= XEMACPS_SCRT2_VLAN_EN_MASK;
+		}
+		if ((Flags & XEMACPS_SCREENER_MATCH_ETHTYPE) != 0x00000000U) {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				((u32)XEMACPS_SCREENING_ETHTYPE_OFFSET +
+				((u32)Index * (u32)4)), (u32)EtherType);
+			RegVal |= ((u32)Index << XEMACPS_SCRT2_ETHTYPE_IDX_SHIFT) &
+					XEMACPS_SCRT2_ETHTYPE_IDX_MASK;
+			RegVal |= XEMACPS_SCRT2_ETHTYPE_EN_MASK;
+		}
+
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCREENING_TYPE2_OFFSET + ((u32)Index * (u32)4)),
+			RegVal);
+
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Disable all type 1 and type 2 screeners so that every received frame goes
+ * to queue 0. Does nothing on GEM versions without priority queues.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ *
+ * @return None.
+ *
+ *****************************************************************************/
+void XEmacPs_ClearScreeners(XEmacPs *InstancePtr)
+{
+	u32 Index;
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->Version <= 2) {
+		return;
+	}
+
+	for (Index = 0U; Index < XEMACPS_MAX_SCREENER_TYPE1; Index++) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			(XEMACPS_SCREENING_TYPE1_OFFSET + (Index * (u32)4)), 0x0U);
+	}
+	for (Index = 0U; Index < XEMACPS_MAX_SCREENER_TYPE2; Index++) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			(XEMACPS_SCREENING_TYPE2_OFFSET + (Index * (u32)4)), 0x0U);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Set the interrupt moderation delays. Once a frame has been received
+ * (transmitted) the corresponding interrupt is held back for the given delay
+ * so that several completions are reported by a single interrupt.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param RxDelay is the RX interrupt delay in units of 800 ns at 1 Gbps
+ *        (8 us at 100 Mbps, 80 us at 10 Mbps). 0 disables RX moderation.
+ * @param TxDelay is the TX interrupt delay, in the same units.
+ *
+ * @return
+ * - XST_SUCCESS if the delays were set successfully
+ * - XST_NO_FEATURE if the GEM version has no interrupt moderation
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetIntrModeration(XEmacPs *InstancePtr, u8 RxDelay, u8 TxDelay)
+{
+	u32 RegVal;
+	LONG Status;
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->Version <= 2) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else {
+		RegVal = (u32)RxDelay & XEMACPS_INTMOD_RX_MASK;
+		RegVal |= ((u32)TxDelay << XEMACPS_INTMOD_TX_SHIFT) &
+				XEMACPS_INTMOD_TX_MASK;
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_INTMOD_OFFSET, RegVal);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * Set options for the driver/device. The driver should be stopped with
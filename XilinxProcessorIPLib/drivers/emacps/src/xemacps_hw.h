@@ -60,6 +60,12 @@ extern "C" {
 #define XEMACPS_MAX_MAC_ADDR     4U   /**< Maxmum number of mac address
                                            supported */
 #define XEMACPS_MAX_TYPE_ID      4U   /**< Maxmum number of type id supported */
+#define XEMACPS_MAX_SCREENER_TYPE1 4U /**< Maximum number of type 1
+						  screeners supported */
+#define XEMACPS_MAX_SCREENER_TYPE2 4U /**< Maximum number of type 2
+						  screeners supported */
+#define XEMACPS_MAX_SCREENER_ETHTYPE 4U /**< Maximum number of type 2
+						    ethertype registers */
 
 #ifdef __aarch64__
 #define XEMACPS_BD_ALIGNMENT     64U   /**< Minimum buffer descriptor alignment
@@ -131,6 +137,10 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 
 #define XEMACPS_JUMBOMAXLEN_OFFSET   0x00000048U /**< Jumbo max length reg */
 
+#define XEMACPS_INTMOD_OFFSET        0x0000005CU /**< Interrupt moderation reg,
+                                                      GEM with priority
+                                                      queues only */
+
 #define XEMACPS_RXWATERMARK_OFFSET   0x0000007CU /**< RX watermark reg */
 
 #define XEMACPS_HASHL_OFFSET         0x00000080U /**< Hash Low address reg */
@@ -281,6 +291,8 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 							reg */
 #define XEMACPS_RXQ1BASE_OFFSET	     0x00000480U /**< RX Q1 Base address
 							reg */
+#define XEMACPS_DMA_RXQ1_BUFSIZE_OFFSET 0x000004A0U /**< RX Q1 buffer size
+							reg */
 #define XEMACPS_MSBBUF_TXQBASE_OFFSET  0x000004C8U /**< MSB Buffer TX Q Base
 							reg */
 #define XEMACPS_MSBBUF_RXQBASE_OFFSET  0x000004D4U /**< MSB Buffer RX Q Base
@@ -291,6 +303,12 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 							reg */
 #define XEMACPS_INTQ1_IMR_OFFSET     0x00000640U /**< Interrupt Q1 Mask
 							reg */
+#define XEMACPS_SCREENING_TYPE1_OFFSET 0x00000500U /**< Screening type 1
+							reg 0 */
+#define XEMACPS_SCREENING_TYPE2_OFFSET 0x00000540U /**< Screening type 2
+							reg 0 */
+#define XEMACPS_SCREENING_ETHTYPE_OFFSET 0x000006E0U /**< Screening type 2
+							ethertype reg 0 */
 
 /* Define some bit positions for registers. */
 
@@ -445,10 +463,55 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
  */
 #define XEMACPS_INTQ1SR_TXCOMPL_MASK	0x00000080U /**< Transmit completed OK */
 #define XEMACPS_INTQ1SR_TXERR_MASK	0x00000040U /**< Transmit AMBA Error */
+#define XEMACPS_INTQ1SR_RXCOMPL_MASK	0x00000002U /**< Frame received OK */
 
 #define XEMACPS_INTQ1_IXR_ALL_MASK	((u32)XEMACPS_INTQ1SR_TXCOMPL_MASK | \
 					 (u32)XEMACPS_INTQ1SR_TXERR_MASK)
 
+#define XEMACPS_INTQ1_IXR_RX_MASK	((u32)XEMACPS_INTQ1SR_RXCOMPL_MASK) /**< Queue 1
+							receive interrupts, only for
+							users of RX queue 1 */
+
+/*@}*/
+
+/** @name screening type 1 register bit definitions
+ * @{
+ */
+#define XEMACPS_SCRT1_QUEUE_MASK	0x0000000FU /**< Queue number */
+#define XEMACPS_SCRT1_DSTC_MASK		0x00000FF0U /**< DS/TC field to match */
+#define XEMACPS_SCRT1_DSTC_SHIFT	4U
+#define XEMACPS_SCRT1_UDPPORT_MASK	0x0FFFF000U /**< UDP dest port to
+							match */
+#define XEMACPS_SCRT1_UDPPORT_SHIFT	12U
+#define XEMACPS_SCRT1_DSTC_EN_MASK	0x10000000U /**< Enable DS/TC match */
+#define XEMACPS_SCRT1_UDPPORT_EN_MASK	0x20000000U /**< Enable UDP port
+							match */
+/*@}*/
+
+/** @name screening type 2 register bit definitions
+ * @{
+ */
+#define XEMACPS_SCRT2_QUEUE_MASK	0x0000000FU /**< Queue number */
+#define XEMACPS_SCRT2_VLANPRIO_MASK	0x00000070U /**< VLAN priority to
+							match */
+#define XEMACPS_SCRT2_VLANPRIO_SHIFT	4U
+#define XEMACPS_SCRT2_VLAN_EN_MASK	0x00000100U /**< Enable VLAN priority
+							match */
+#define XEMACPS_SCRT2_ETHTYPE_IDX_MASK	0x00000E00U /**< Ethertype register
+							index */
+#define XEMACPS_SCRT2_ETHTYPE_IDX_SHIFT	9U
+#define XEMACPS_SCRT2_ETHTYPE_EN_MASK	0x00001000U /**< Enable ethertype
+							match */
+/*@}*/
+
+/** @name Interrupt moderation register masks
+ * The delays are counted in units of 800 ns at 1 Gbps (8 us at 100 Mbps,
+ * 80 us at 10 Mbps). 0 disables moderation.
+ * @{
+ */
+#define XEMACPS_INTMOD_RX_MASK       0x000000FFU /**< RX interrupt delay */
+#define XEMACPS_INTMOD_TX_MASK       0x00FF0000U /**< TX interrupt delay */
+#define XEMACPS_INTMOD_TX_SHIFT      16U
 /*@}*/
 
 /**
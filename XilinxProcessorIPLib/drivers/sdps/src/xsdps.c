@@ -167,6 +167,14 @@ s32 XSdPs_CfgInitialize(XSdPs *InstancePtr, XSdPs_Config *ConfigPtr,
 	InstancePtr->SlcrBaseAddr = XPS_SYS_CTRL_BASEADDR;
 	InstancePtr->IsBusy = FALSE;
 	InstancePtr->BlkSize = 0U;
+	InstancePtr->AsyncMode = 0U;
+	InstancePtr->AsyncHead = 0U;
+	InstancePtr->AsyncCount = 0U;
+	InstancePtr->AsyncRecover = XSDPS_ASYNC_RECOVER_NONE;
+	InstancePtr->CmdQueueDepth = 0U;
+	InstancePtr->CmdQueueEnabled = 0U;
+	InstancePtr->MaxPackedWrites = 0U;
+	InstancePtr->CmdQueuePending = 0U;
 
 	/* Host Controller version is read. */
 	InstancePtr->HC_Version =
@@ -296,7 +304,8 @@ s32 XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
-	if (InstancePtr->IsBusy == TRUE) {
+	if ((InstancePtr->IsBusy == TRUE) || (InstancePtr->AsyncMode != 0U) ||
+			(InstancePtr->CmdQueueEnabled != 0U)) {
 		Status = XST_FAILURE;
 		goto RETURN_PATH;
 	}
@@ -362,7 +371,8 @@ s32 XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff)
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
-	if (InstancePtr->IsBusy == TRUE) {
+	if ((InstancePtr->IsBusy == TRUE) || (InstancePtr->AsyncMode != 0U) ||
+			(InstancePtr->CmdQueueEnabled != 0U)) {
 		Status = XST_FAILURE;
 		goto RETURN_PATH;
 	}
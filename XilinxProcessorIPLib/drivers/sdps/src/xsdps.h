@@ -58,8 +58,22 @@
 * descriptor table and hence care will have to be taken to call read/write
 * API's in a loop for large file sizes.
 *
-* Interrupt mode is not supported because it offers no improvement when used
-* with file system.
+* Interrupt mode:
+* XSdPs_ReadAsync() and XSdPs_WriteAsync() queue up to
+* XSDPS_ASYNC_QUEUE_DEPTH transfers and return immediately. The ADMA2
+* descriptor table of the next queued transfer is built while the current
+* one is running, and XSdPs_IntrHandler() issues it as soon as the
+* transfer complete interrupt of the current one is seen, before calling
+* the completion handler of the finished request. XSdPs_IntrHandler() has
+* to be connected to the SD interrupt and async mode has to be enabled with
+* XSdPs_SetAsyncMode() before queueing transfers. The polled read/write
+* API's return XST_FAILURE and no other data transfer API's should be used
+* while async mode is enabled.
+* After an error XSdPs_IntrHandler() only completes the failed transfer
+* with XST_FAILURE. Resetting the lines, stopping the card with CMD12 and
+* waiting for it to release DAT0 would take too long in the interrupt, so
+* this is done by XSdPs_AsyncPoll(), which has to be called from the main
+* loop. It also starts the transfers that were queued in the meantime.
 *
 * eMMC support:
 * SD driver supports SD and eMMC based on the "enable MMC" parameter in SDK.
@@ -67,6 +81,16 @@
 * by the host controller. The current driver supports read/write on eMMC card
 * using 4-bit and high speed mode currently.
 *
+* eMMC command queue and packed commands:
+* On eMMC 5.1 devices that support it, XSdPs_CmdQueueEnable() switches the
+* device into command queue mode. Up to CmdQueueDepth tasks are queued in
+* the device with XSdPs_CmdQueueSubmit() (CMD44/CMD45) and
+* XSdPs_CmdQueueExecute() runs the data phase (CMD46/CMD47) of the tasks
+* the device reports as ready, in the order the device chooses. Legacy
+* read/write commands can not be used while command queue mode is on.
+* XSdPs_PackedWrite() sends several writes to different addresses as one
+* packed CMD25 on eMMC 4.5+ devices.
+*
 * Features not supported include - card write protect, password setting,
 * lock/unlock, interrupts, SDMA mode, programmed I/O mode and
 * 64-bit addressed ADMA2, erase/pre-erase commands.
@@ -190,11 +214,25 @@ extern "C" {
 #define CSD_SPEC_VER_3		0x3U
 #define SCR_SPEC_VER_3		0x80U
 #define ADDRESS_BEYOND_32BIT	0x100000000U
+#define XSDPS_ASYNC_QUEUE_DEPTH	8U	/**< Max queued async transfers */
+#define XSDPS_ASYNC_DESC_LINES	32U	/**< ADMA2 lines per async transfer */
+#define XSDPS_ASYNC_RECOVER_NONE	0U	/**< No error recovery pending */
+#define XSDPS_ASYNC_RECOVER_RESET	1U	/**< Reset the CMD/DAT lines */
+#define XSDPS_ASYNC_RECOVER_STOP	2U	/**< Reset the lines, send CMD12 */
+#define XSDPS_ASYNC_RECOVER_BUSY	3U	/**< Wait for DAT0 busy to end */
+#define XSDPS_CMDQ_MAX_TASKS	32U	/**< Max eMMC command queue depth */
+#define XSDPS_PACKED_MAX_CMDS	16U	/**< Max entries of a packed write */
 
 /**************************** Type Definitions *******************************/
 
 typedef void (*XSdPs_ConfigTap) (u32 Bank, u32 DeviceId, u32 CardType);
 
+/**
+ * Completion handler of an async transfer. Status is XST_SUCCESS or
+ * XST_FAILURE. It is called from XSdPs_IntrHandler().
+ */
+typedef void (*XSdPs_AsyncHandler) (void *CallBackRef, s32 Status);
+
 /**
  * This typedef contains configuration information for the device.
  */
@@ -237,6 +275,38 @@ typedef struct {
 }  __attribute__((__packed__))XSdPs_Adma2Descriptor64;
 #endif
 
+/**
+ * Task queued in the eMMC command queue
+ */
+typedef struct {
+	u8 *Buff;		/**< Data buffer */
+	u16 BlkCnt;		/**< Block count */
+	u8 IsWrite;		/**< Write task */
+} XSdPs_CmdQueueTask;
+
+/**
+ * Entry of an eMMC packed write
+ */
+typedef struct {
+	u32 Arg;		/**< Card address */
+	u32 BlkCnt;		/**< Block count */
+	const u8 *Buff;		/**< Data buffer */
+} XSdPs_PackedCmd;
+
+/**
+ * Queued async transfer
+ */
+typedef struct {
+	u32 Arg;			/**< Command argument (card address) */
+	u32 BlkCnt;			/**< Block count */
+	u8 *Buff;			/**< Data buffer */
+	XSdPs_AsyncHandler Handler;	/**< Completion handler */
+	void *CallBackRef;		/**< Completion handler argument */
+	u8 IsWrite;			/**< Write transfer */
+	u8 IsPrepared;			/**< Descriptor table is built */
+	u8 DescTbl;			/**< Descriptor table in use */
+} XSdPs_AsyncReq;
+
 /**
  * The XSdPs driver instance data. The user is required to allocate a
  * variable of this type for every SD device in the system. A pointer
@@ -267,6 +337,24 @@ typedef struct {
 	u32 SlcrBaseAddr;	/**< SLCR base address*/
 	u8  IsBusy;			/**< Busy Flag*/
 	u32 BlkSize;		/**< Block Size*/
+	u8  CmdQueueDepth;	/**< eMMC command queue depth, 0 if unsupported */
+	u8  CmdQueueEnabled;	/**< eMMC command queue mode is on */
+	u8  MaxPackedWrites;	/**< Max eMMC packed write entries, 0 if unsupported */
+	u32 CmdQueuePending;	/**< Bitmap of submitted command queue tasks */
+	XSdPs_CmdQueueTask CmdQueueTask[XSDPS_CMDQ_MAX_TASKS];	/**< Queued tasks */
+	u8  AsyncMode;		/**< Async transfers enabled */
+	u32 AsyncHead;		/**< Queue index of the active transfer */
+	u32 AsyncCount;		/**< Number of queued transfers */
+	u8  AsyncRecover;	/**< Pending step of the error recovery */
+	XSdPs_AsyncReq AsyncQueue[XSDPS_ASYNC_QUEUE_DEPTH];	/**< Async queue */
+#ifdef __ICCARM__
+#pragma data_alignment = 64
+	XSdPs_Adma2Descriptor64 AsyncDescTbl[2][XSDPS_ASYNC_DESC_LINES];
+#else
+	XSdPs_Adma2Descriptor64 AsyncDescTbl[2][XSDPS_ASYNC_DESC_LINES]
+				__attribute__ ((aligned(64)));
+#endif
+				/**< Ping-pong ADMA2 tables of async transfers */
 } XSdPs;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -294,6 +382,22 @@ s32 XSdPs_Select_Card(XSdPs *InstancePtr);
 s32 XSdPs_StartReadTransfer(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff);
 s32 XSdPs_CheckReadTransfer(XSdPs *InstancePtr);
 
+s32 XSdPs_SetAsyncMode(XSdPs *InstancePtr, u8 Enable);
+s32 XSdPs_ReadAsync(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff,
+			XSdPs_AsyncHandler Handler, void *CallBackRef);
+s32 XSdPs_WriteAsync(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff,
+			XSdPs_AsyncHandler Handler, void *CallBackRef);
+s32 XSdPs_AsyncPoll(XSdPs *InstancePtr);
+void XSdPs_IntrHandler(void *InstancePtr);
+
+s32 XSdPs_CmdQueueEnable(XSdPs *InstancePtr, u8 Enable);
+s32 XSdPs_CmdQueueSubmit(XSdPs *InstancePtr, u8 TaskId, u32 Arg, u32 BlkCnt,
+			u8 *Buff, u8 IsWrite);
+s32 XSdPs_CmdQueueStatus(XSdPs *InstancePtr, u32 *ReadyTasks);
+s32 XSdPs_CmdQueueExecute(XSdPs *InstancePtr, u32 *DoneTasks);
+s32 XSdPs_PackedWrite(XSdPs *InstancePtr, const XSdPs_PackedCmd *Cmds,
+			u32 NumCmds);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,505 @@
+/******************************************************************************
+* Copyright (C) 2013 - 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xsdps_emmc.c
+* @addtogroup sdps_v3_10
+* @{
+*
+* Contains the eMMC command queue and packed command API's of the XSdPs
+* driver. See xsdps.h for a detailed description of the device and driver.
+*
+* The command queue is the device side queue of eMMC 5.1: tasks are queued
+* with CMD44/CMD45, the queue status register is read with CMD13 and the
+* data phase of a ready task is started with CMD46/CMD47. It does not need
+* a command queue engine in the host controller.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsdps_core.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static s32 XSdPs_CmdQueueRun(XSdPs *InstancePtr, u8 TaskId);
+static s32 XSdPs_SetupPackedDescTbl(XSdPs *InstancePtr, const u8 *Header,
+		const XSdPs_PackedCmd *Cmds, u32 NumCmds);
+
+/*****************************************************************************/
+/**
+* @brief
+* This function enables or disables the command queue mode of an eMMC 5.1
+* device.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Enable is 1 to enable and 0 to disable command queue mode.
+*
+* @return
+* 		- XST_SUCCESS if successful
+* 		- XST_NO_FEATURE if the device has no command queue
+* 		- XST_FAILURE if tasks are pending or the switch fails
+*
+******************************************************************************/
+s32 XSdPs_CmdQueueEnable(XSdPs *InstancePtr, u8 Enable)
+{
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->CmdQueueDepth == 0U) {
+		Status = (s32)XST_NO_FEATURE;
+		goto RETURN_PATH;
+	}
+
+	if ((InstancePtr->IsBusy == TRUE) || (InstancePtr->AsyncMode != 0U) ||
+			(InstancePtr->CmdQueuePending != 0U)) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+#if defined  (XCLOCKING)
+	Xil_ClockEnable(InstancePtr->Config.RefClk);
+#endif
+
+	Status = XSdPs_Set_Mmc_ExtCsd(InstancePtr, (Enable != 0U) ?
+			XSDPS_MMC_CMDQ_EN_ARG : XSDPS_MMC_CMDQ_DIS_ARG);
+	if (Status == XST_SUCCESS) {
+		InstancePtr->CmdQueueEnabled = (Enable != 0U) ? 1U : 0U;
+	}
+
+#if defined  (XCLOCKING)
+	Xil_ClockDisable(InstancePtr->Config.RefClk);
+#endif
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function queues a read or write task in the eMMC command queue. The
+* data is transferred later by XSdPs_CmdQueueExecute(), Buff must not be
+* accessed until the task is reported as done.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	TaskId is the task ID, less than CmdQueueDepth and not in use.
+* @param	Arg is the card address of the task.
+* @param	BlkCnt - Block count passed by the user.
+* @param	Buff - Pointer to the data buffer for a DMA transfer.
+* @param	IsWrite is 1 for a write and 0 for a read task.
+*
+* @return
+* 		- XST_SUCCESS if the task is queued
+* 		- XST_FAILURE if command queue mode is off, the task ID is in
+* 		use or the device rejects the task
+*
+******************************************************************************/
+s32 XSdPs_CmdQueueSubmit(XSdPs *InstancePtr, u8 TaskId, u32 Arg, u32 BlkCnt,
+			u8 *Buff, u8 IsWrite)
+{
+	u32 TaskArg;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Buff != NULL);
+
+	if ((InstancePtr->CmdQueueEnabled == 0U) ||
+			(TaskId >= InstancePtr->CmdQueueDepth) ||
+			((InstancePtr->CmdQueuePending & ((u32)1U << TaskId)) != 0U) ||
+			(BlkCnt == 0U) || (BlkCnt > XSDPS_CMD44_BLKCNT_MASK)) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	TaskArg = ((u32)TaskId << XSDPS_CMD44_TASKID_SHIFT) | BlkCnt;
+	if (IsWrite == 0U) {
+		TaskArg |= XSDPS_CMD44_READ;
+	}
+
+	/* Queue task parameters and task address */
+	Status = XSdPs_CmdTransfer(InstancePtr, CMD44, TaskArg, 0U);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	Status = XSdPs_CmdTransfer(InstancePtr, CMD45, Arg, 0U);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	InstancePtr->CmdQueueTask[TaskId].Buff = Buff;
+	InstancePtr->CmdQueueTask[TaskId].BlkCnt = (u16)BlkCnt;
+	InstancePtr->CmdQueueTask[TaskId].IsWrite = IsWrite;
+	InstancePtr->CmdQueuePending |= (u32)1U << TaskId;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function reads the queue status register of the eMMC device, which
+* has a bit set for every queued task that is ready for execution.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	ReadyTasks is updated with the queue status register.
+*
+* @return	XST_SUCCESS or XST_FAILURE
+*
+******************************************************************************/
+s32 XSdPs_CmdQueueStatus(XSdPs *InstancePtr, u32 *ReadyTasks)
+{
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(ReadyTasks != NULL);
+
+	Status = XSdPs_CmdTransfer(InstancePtr, CMD13,
+			InstancePtr->RelCardAddr | XSDPS_CMD13_SQS, 0U);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	*ReadyTasks = XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+			XSDPS_RESP0_OFFSET);
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function executes all queued tasks the device reports as ready.
+* The queue status is read again after every task, so tasks the device
+* gets ready meanwhile are run in the same call.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	DoneTasks is updated with the bitmap of the completed tasks.
+*
+* @return
+* 		- XST_SUCCESS if all ready tasks completed
+* 		- XST_FAILURE if a task failed, DoneTasks has the tasks that
+* 		completed before it
+*
+******************************************************************************/
+s32 XSdPs_CmdQueueExecute(XSdPs *InstancePtr, u32 *DoneTasks)
+{
+	u32 ReadyTasks;
+	u8 TaskId;
+	s32 Status = XST_SUCCESS;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(DoneTasks != NULL);
+
+	*DoneTasks = 0U;
+
+	while (InstancePtr->CmdQueuePending != 0U) {
+		Status = XSdPs_CmdQueueStatus(InstancePtr, &ReadyTasks);
+		if (Status != XST_SUCCESS) {
+			break;
+		}
+
+		ReadyTasks &= InstancePtr->CmdQueuePending;
+		if (ReadyTasks == 0U) {
+			break;
+		}
+
+		for (TaskId = 0U; TaskId < InstancePtr->CmdQueueDepth; TaskId++) {
+			if ((ReadyTasks & ((u32)1U << TaskId)) == 0U) {
+				continue;
+			}
+			InstancePtr->CmdQueuePending &= ~((u32)1U << TaskId);
+			Status = XSdPs_CmdQueueRun(InstancePtr, TaskId);
+			if (Status != XST_SUCCESS) {
+				goto RETURN_PATH;
+			}
+			*DoneTasks |= (u32)1U << TaskId;
+		}
+	}
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function sends several writes to different card addresses as one
+* eMMC packed write command. Every entry is written as if it was sent with
+* its own CMD23/CMD25 pair.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Cmds is the array of write entries, in card address order of
+* 		the caller's choice.
+* @param	NumCmds is the number of entries, at most MaxPackedWrites and
+* 		XSDPS_PACKED_MAX_CMDS.
+*
+* @return
+* 		- XST_SUCCESS if successful
+* 		- XST_NO_FEATURE if the device has no packed command support
+* 		- XST_FAILURE if the transfer fails or the entries do not fit
+* 		in one ADMA2 descriptor table
+*
+* @note		The block size has to be 512 bytes.
+*
+******************************************************************************/
+s32 XSdPs_PackedWrite(XSdPs *InstancePtr, const XSdPs_PackedCmd *Cmds,
+			u32 NumCmds)
+{
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+	static u8 Header[XSDPS_PACKED_BLKSIZE];
+#else
+	static u8 Header[XSDPS_PACKED_BLKSIZE] __attribute__ ((aligned(32)));
+#endif
+	u32 TotalBlks = 1U;
+	u32 Index;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Cmds != NULL);
+
+	if (InstancePtr->MaxPackedWrites == 0U) {
+		Status = (s32)XST_NO_FEATURE;
+		goto RETURN_PATH;
+	}
+
+	if ((NumCmds == 0U) || (NumCmds > InstancePtr->MaxPackedWrites) ||
+			(NumCmds > XSDPS_PACKED_MAX_CMDS) ||
+			(InstancePtr->BlkSize != XSDPS_PACKED_BLKSIZE) ||
+			(InstancePtr->IsBusy == TRUE) ||
+			(InstancePtr->AsyncMode != 0U) ||
+			(InstancePtr->CmdQueueEnabled != 0U)) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	/* Packed command header, one CMD23/CMD25 argument pair per entry */
+	(void)memset(Header, 0, sizeof(Header));
+	Header[0] = XSDPS_PACKED_HDR_VERSION;
+	Header[1] = XSDPS_PACKED_HDR_WRITE;
+	Header[2] = (u8)NumCmds;
+	for (Index = 0U; Index < NumCmds; Index++) {
+		Header[(8U * (Index + 1U)) + 0U] = (u8)Cmds[Index].BlkCnt;
+		Header[(8U * (Index + 1U)) + 1U] = (u8)(Cmds[Index].BlkCnt >> 8U);
+		Header[(8U * (Index + 1U)) + 2U] = (u8)(Cmds[Index].BlkCnt >> 16U);
+		Header[(8U * (Index + 1U)) + 3U] = (u8)(Cmds[Index].BlkCnt >> 24U);
+		Header[(8U * (Index + 1U)) + 4U] = (u8)Cmds[Index].Arg;
+		Header[(8U * (Index + 1U)) + 5U] = (u8)(Cmds[Index].Arg >> 8U);
+		Header[(8U * (Index + 1U)) + 6U] = (u8)(Cmds[Index].Arg >> 16U);
+		Header[(8U * (Index + 1U)) + 7U] = (u8)(Cmds[Index].Arg >> 24U);
+		TotalBlks += Cmds[Index].BlkCnt;
+	}
+
+	if (TotalBlks > 0xFFFFU) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+#if defined  (XCLOCKING)
+	Xil_ClockEnable(InstancePtr->Config.RefClk);
+#endif
+
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_BLK_SIZE_OFFSET, (u16)XSDPS_PACKED_BLKSIZE);
+
+	Status = XSdPs_SetupPackedDescTbl(InstancePtr, Header, Cmds, NumCmds);
+	if (Status != XST_SUCCESS) {
+		goto CLOCK_PATH;
+	}
+
+	/* Packed commands are closed-ended, no Auto CMD12 */
+	InstancePtr->TransferMode = XSDPS_TM_BLK_CNT_EN_MASK |
+			XSDPS_TM_MUL_SIN_BLK_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+
+	Status = XSdPs_CmdTransfer(InstancePtr, CMD23,
+			XSDPS_CMD23_PACKED | TotalBlks, 0U);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto CLOCK_PATH;
+	}
+
+	Status = XSdPs_CmdTransfer(InstancePtr, CMD25, Cmds[0].Arg, TotalBlks);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto CLOCK_PATH;
+	}
+
+	Status = XSdps_CheckTransferDone(InstancePtr);
+
+CLOCK_PATH:
+#if defined  (XCLOCKING)
+	Xil_ClockDisable(InstancePtr->Config.RefClk);
+#endif
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function runs the data phase of a ready command queue task.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	TaskId is the task to execute.
+*
+* @return	XST_SUCCESS or XST_FAILURE
+*
+******************************************************************************/
+static s32 XSdPs_CmdQueueRun(XSdPs *InstancePtr, u8 TaskId)
+{
+	XSdPs_CmdQueueTask *Task = &InstancePtr->CmdQueueTask[TaskId];
+	u32 Cmd;
+	s32 Status;
+
+	if (Task->IsWrite != 0U) {
+		XSdPs_SetupWriteDma(InstancePtr, Task->BlkCnt,
+				(u16)InstancePtr->BlkSize, Task->Buff);
+		Cmd = CMD47;
+	} else {
+		XSdPs_SetupReadDma(InstancePtr, Task->BlkCnt,
+				(u16)InstancePtr->BlkSize, Task->Buff);
+		Cmd = CMD46;
+	}
+
+	/* The block count was given with CMD44, no Auto CMD12 */
+	InstancePtr->TransferMode &= (u16)~XSDPS_TM_AUTO_CMD12_EN_MASK;
+
+	Status = XSdPs_CmdTransfer(InstancePtr, Cmd,
+			(u32)TaskId << XSDPS_CMD46_TASKID_SHIFT, Task->BlkCnt);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	Status = XSdps_CheckTransferDone(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	if ((Task->IsWrite == 0U) &&
+			(InstancePtr->Config.IsCacheCoherent == 0U)) {
+		Xil_DCacheInvalidateRange((INTPTR)Task->Buff,
+				(INTPTR)Task->BlkCnt * InstancePtr->BlkSize);
+	}
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function builds the ADMA2 descriptor table of a packed write: the
+* header block followed by the data of every entry.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Header is the packed command header block.
+* @param	Cmds is the array of write entries.
+* @param	NumCmds is the number of entries.
+*
+* @return	XST_SUCCESS or XST_FAILURE if the table is too small
+*
+******************************************************************************/
+static s32 XSdPs_SetupPackedDescTbl(XSdPs *InstancePtr, const u8 *Header,
+		const XSdPs_PackedCmd *Cmds, u32 NumCmds)
+{
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+	static XSdPs_Adma2Descriptor64 Adma2_DescrTbl[32];
+#else
+	static XSdPs_Adma2Descriptor64 Adma2_DescrTbl[32] __attribute__ ((aligned(32)));
+#endif
+	XSdPs_Adma2Descriptor32 *Desc32 =
+			(XSdPs_Adma2Descriptor32 *)(void *)Adma2_DescrTbl;
+	UINTPTR Addr;
+	u32 Remaining;
+	u32 Length;
+	u32 DescNum = 0U;
+	u32 Index;
+	s32 Status = XST_SUCCESS;
+
+	for (Index = 0U; Index <= NumCmds; Index++) {
+		if (Index == 0U) {
+			Addr = (UINTPTR)Header;
+			Remaining = XSDPS_PACKED_BLKSIZE;
+		} else {
+			Addr = (UINTPTR)Cmds[Index - 1U].Buff;
+			Remaining = Cmds[Index - 1U].BlkCnt * XSDPS_PACKED_BLKSIZE;
+			if (InstancePtr->Config.IsCacheCoherent == 0U) {
+				Xil_DCacheFlushRange((INTPTR)Addr, (INTPTR)Remaining);
+			}
+		}
+
+		while (Remaining != 0U) {
+			if (DescNum == 32U) {
+				Status = XST_FAILURE;
+				goto RETURN_PATH;
+			}
+			Length = (Remaining > XSDPS_DESC_MAX_LENGTH) ?
+					XSDPS_DESC_MAX_LENGTH : Remaining;
+			/* A length of 0 means 64KB */
+			if (InstancePtr->HC_Version == XSDPS_HC_SPEC_V3) {
+				Adma2_DescrTbl[DescNum].Address = (u64)Addr;
+				Adma2_DescrTbl[DescNum].Attribute =
+						XSDPS_DESC_TRAN | XSDPS_DESC_VALID;
+				Adma2_DescrTbl[DescNum].Length = (u16)Length;
+			} else {
+				Desc32[DescNum].Address = (u32)Addr;
+				Desc32[DescNum].Attribute =
+						XSDPS_DESC_TRAN | XSDPS_DESC_VALID;
+				Desc32[DescNum].Length = (u16)Length;
+			}
+			Addr += Length;
+			Remaining -= Length;
+			DescNum++;
+		}
+	}
+
+	if (InstancePtr->HC_Version == XSDPS_HC_SPEC_V3) {
+		Adma2_DescrTbl[DescNum - 1U].Attribute |= XSDPS_DESC_END;
+	} else {
+		Desc32[DescNum - 1U].Attribute |= XSDPS_DESC_END;
+	}
+
+#if defined(__aarch64__) || defined(__arch64__)
+	if (InstancePtr->HC_Version == XSDPS_HC_SPEC_V3) {
+		XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XSDPS_ADMA_SAR_EXT_OFFSET,
+				(u32)((UINTPTR)(Adma2_DescrTbl) >> 32U));
+	}
+#endif
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress, XSDPS_ADMA_SAR_OFFSET,
+			(u32)((UINTPTR)&(Adma2_DescrTbl[0]) & (u32)~0x0));
+
+	if (InstancePtr->Config.IsCacheCoherent == 0U) {
+		Xil_DCacheFlushRange((INTPTR)Header, (INTPTR)XSDPS_PACKED_BLKSIZE);
+		Xil_DCacheFlushRange((INTPTR)&(Adma2_DescrTbl[0]),
+			sizeof(XSdPs_Adma2Descriptor64) * 32U);
+	}
+
+RETURN_PATH:
+	return Status;
+}
+/** @} */
@@ -425,6 +425,20 @@ s32 XSdPs_EmmcModeInit(XSdPs *InstancePtr)
 		}
 	}
 
+	/* Optional eMMC 4.5/5.1 features used by xsdps_emmc.c */
+	InstancePtr->MaxPackedWrites = 0U;
+	InstancePtr->CmdQueueDepth = 0U;
+	InstancePtr->CmdQueueEnabled = 0U;
+	if (ExtCsd[EXT_CSD_REV_BYTE] >= EXT_CSD_REV_1_5) {
+		InstancePtr->MaxPackedWrites =
+				ExtCsd[EXT_CSD_MAX_PACKED_WRITES_BYTE];
+	}
+	if ((ExtCsd[EXT_CSD_REV_BYTE] >= EXT_CSD_REV_1_8) &&
+			((ExtCsd[EXT_CSD_CMDQ_SUPPORT_BYTE] & 0x1U) != 0U)) {
+		InstancePtr->CmdQueueDepth = (ExtCsd[EXT_CSD_CMDQ_DEPTH_BYTE] &
+				EXT_CSD_CMDQ_DEPTH_MASK) + 1U;
+	}
+
 	/* Enable Rst_n_Fun bit if it is disabled */
 	if(ExtCsd[EXT_CSD_RST_N_FUN_BYTE] == EXT_CSD_RST_N_FUN_TEMP_DIS) {
 		Status = XSdPs_Set_Mmc_ExtCsd(InstancePtr, XSDPS_MMC_RST_FUN_EN_ARG);
@@ -1663,6 +1677,9 @@ u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd)
 	case CMD12:
 		RetVal |= RESP_R1;
 		break;
+	case CMD13:
+		RetVal |= RESP_R1;
+		break;
 	case ACMD13:
 		RetVal |= RESP_R1 | (u32)XSDPS_DAT_PRESENT_SEL_MASK;
 		break;
@@ -1684,6 +1701,14 @@ u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd)
 	case ACMD41:
 		RetVal |= RESP_R3;
 		break;
+	case CMD44:
+	case CMD45:
+		RetVal |= RESP_R1;
+		break;
+	case CMD46:
+	case CMD47:
+		RetVal |= RESP_R1 | (u32)XSDPS_DAT_PRESENT_SEL_MASK;
+		break;
 	case ACMD42:
 		RetVal |= RESP_R1;
 		break;
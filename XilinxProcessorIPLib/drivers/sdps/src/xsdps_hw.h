@@ -482,6 +482,8 @@ extern "C" {
 #define XSDPS_PSR_WPS_PL_MASK		0x00080000U /**< Write protect switch
 								pin level */
 #define XSDPS_PSR_DAT30_SG_LVL_MASK	0x00F00000U /**< Data 3:0 signal lvl */
+#define XSDPS_PSR_DAT0_SG_LVL_MASK	0x00100000U /**< Data 0 signal lvl,
+								low while busy */
 #define XSDPS_PSR_CMD_SG_LVL_MASK	0x01000000U /**< Cmd Line signal lvl */
 #define XSDPS_PSR_DAT74_SG_LVL_MASK	0x1E000000U /**< Data 7:4 signal lvl */
 
@@ -643,6 +645,7 @@ extern "C" {
 #define CMD10	 0x0A00U
 #define CMD11	 0x0B00U
 #define CMD12	 0x0C00U
+#define CMD13	 0x0D00U
 #define ACMD13	 (XSDPS_APP_CMD_PREFIX + 0x0D00U)
 #define CMD16	 0x1000U
 #define CMD17	 0x1100U
@@ -654,6 +657,10 @@ extern "C" {
 #define CMD24	 0x1800U
 #define CMD25	 0x1900U
 #define CMD41	 0x2900U
+#define CMD44	 0x2C00U
+#define CMD45	 0x2D00U
+#define CMD46	 0x2E00U
+#define CMD47	 0x2F00U
 #define ACMD41	 (XSDPS_APP_CMD_PREFIX + 0x2900U)
 #define ACMD42	 (XSDPS_APP_CMD_PREFIX + 0x2A00U)
 #define ACMD51	 (XSDPS_APP_CMD_PREFIX + 0x3300U)
@@ -898,10 +905,41 @@ extern "C" {
 					 | ((u32)EXT_CSD_RST_N_FUN_BYTE << 16) \
 					 | ((u32)EXT_CSD_RST_N_FUN_PERM_EN << 8))
 
+#define EXT_CSD_CMDQ_MODE_EN_BYTE	15U
+#define EXT_CSD_REV_BYTE		192U
+#define EXT_CSD_CMDQ_DEPTH_BYTE		307U
+#define EXT_CSD_CMDQ_SUPPORT_BYTE	308U
+#define EXT_CSD_MAX_PACKED_WRITES_BYTE	500U
+#define EXT_CSD_CMDQ_DEPTH_MASK		0x1FU
+#define EXT_CSD_REV_1_5			6U	/* eMMC 4.5, packed commands */
+#define EXT_CSD_REV_1_8			8U	/* eMMC 5.1, command queue */
+
+#define XSDPS_MMC_CMDQ_EN_ARG		(((u32)XSDPS_EXT_CSD_WRITE_BYTE << 24) \
+					 | ((u32)EXT_CSD_CMDQ_MODE_EN_BYTE << 16) \
+					 | ((u32)1U << 8))
+
+#define XSDPS_MMC_CMDQ_DIS_ARG		(((u32)XSDPS_EXT_CSD_WRITE_BYTE << 24) \
+					 | ((u32)EXT_CSD_CMDQ_MODE_EN_BYTE << 16))
+
 #define XSDPS_MMC_DELAY_FOR_SWITCH	1000U
 
 /* @} */
 
+/** @name eMMC command queue and packed command definitions
+ * @{
+ */
+#define XSDPS_CMD13_SQS			(1U << 15)	/**< Send queue status */
+#define XSDPS_CMD23_PACKED		(1U << 30)	/**< Packed command */
+#define XSDPS_CMD44_READ		(1U << 30)	/**< Task direction */
+#define XSDPS_CMD44_PRIORITY		(1U << 23)	/**< High priority task */
+#define XSDPS_CMD44_TASKID_SHIFT	16U
+#define XSDPS_CMD44_BLKCNT_MASK		0xFFFFU
+#define XSDPS_CMD46_TASKID_SHIFT	16U
+#define XSDPS_PACKED_HDR_VERSION	1U
+#define XSDPS_PACKED_HDR_WRITE		2U
+#define XSDPS_PACKED_BLKSIZE		512U
+/* @} */
+
 /* @400KHz, in usec */
 #define XSDPS_74CLK_DELAY	2960U
 #define XSDPS_100CLK_DELAY	4000U
@@ -0,0 +1,582 @@
+/******************************************************************************
+* Copyright (C) 2013 - 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xsdps_intr.c
+* @addtogroup sdps_v3_10
+* @{
+*
+* Contains the interrupt driven (async) read and write API's of the XSdPs
+* driver. See xsdps.h for a detailed description of the device and driver.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsdps_core.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static s32 XSdPs_AsyncQueue(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt,
+		u8 *Buff, u8 IsWrite, XSdPs_AsyncHandler Handler,
+		void *CallBackRef);
+static void XSdPs_AsyncPrepare(XSdPs *InstancePtr, XSdPs_AsyncReq *Req,
+		u8 DescTbl);
+static s32 XSdPs_AsyncIssue(XSdPs *InstancePtr, XSdPs_AsyncReq *Req);
+static void XSdPs_AsyncStart(XSdPs *InstancePtr);
+
+/*****************************************************************************/
+/**
+* @brief
+* This function enables or disables the async transfer mode. When enabled,
+* transfer complete and error interrupts are signalled and the
+* XSdPs_ReadAsync/XSdPs_WriteAsync API's can be used.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Enable is 1 to enable and 0 to disable async mode.
+*
+* @return
+* 		- XST_SUCCESS if successful
+* 		- XST_FAILURE if a polled transfer or queued async transfers
+* 		are in progress, or the error recovery of XSdPs_AsyncPoll()
+* 		is not done
+*
+******************************************************************************/
+s32 XSdPs_SetAsyncMode(XSdPs *InstancePtr, u8 Enable)
+{
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if ((InstancePtr->IsBusy == TRUE) || (InstancePtr->AsyncCount != 0U) ||
+		(InstancePtr->AsyncRecover != XSDPS_ASYNC_RECOVER_NONE)) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	if (Enable == InstancePtr->AsyncMode) {
+		Status = XST_SUCCESS;
+		goto RETURN_PATH;
+	}
+
+	if (Enable != 0U) {
+#if defined  (XCLOCKING)
+		Xil_ClockEnable(InstancePtr->Config.RefClk);
+#endif
+		InstancePtr->AsyncHead = 0U;
+		InstancePtr->AsyncMode = 1U;
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_ERR_INTR_SIG_EN_OFFSET, XSDPS_ERROR_INTR_ALL_MASK);
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET, XSDPS_INTR_TC_MASK);
+	} else {
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET, 0x0U);
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_ERR_INTR_SIG_EN_OFFSET, 0x0U);
+		InstancePtr->AsyncMode = 0U;
+#if defined  (XCLOCKING)
+		Xil_ClockDisable(InstancePtr->Config.RefClk);
+#endif
+	}
+
+	Status = XST_SUCCESS;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function queues an SD read. It returns without waiting for the
+* transfer, Handler is called from XSdPs_IntrHandler() once it is done.
+* Buff must not be accessed until then.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the address passed by the user that is to be sent as
+* 		argument along with the command.
+* @param	BlkCnt - Block count passed by the user.
+* @param	Buff - Pointer to the data buffer for a DMA transfer.
+* @param	Handler is the completion handler.
+* @param	CallBackRef is passed to the completion handler.
+*
+* @return
+* 		- XST_SUCCESS if the transfer is queued
+* 		- XST_DEVICE_BUSY if the queue is full
+* 		- XST_FAILURE if async mode is not enabled or the block count
+* 		is invalid
+*
+******************************************************************************/
+s32 XSdPs_ReadAsync(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff,
+			XSdPs_AsyncHandler Handler, void *CallBackRef)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Buff != NULL);
+	Xil_AssertNonvoid(Handler != NULL);
+
+	return XSdPs_AsyncQueue(InstancePtr, Arg, BlkCnt, Buff, 0U, Handler,
+			CallBackRef);
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function queues an SD write. It returns without waiting for the
+* transfer, Handler is called from XSdPs_IntrHandler() once it is done.
+* Buff must not be modified until then.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the address passed by the user that is to be sent as
+* 		argument along with the command.
+* @param	BlkCnt - Block count passed by the user.
+* @param	Buff - Pointer to the data buffer for a DMA transfer.
+* @param	Handler is the completion handler.
+* @param	CallBackRef is passed to the completion handler.
+*
+* @return
+* 		- XST_SUCCESS if the transfer is queued
+* 		- XST_DEVICE_BUSY if the queue is full
+* 		- XST_FAILURE if async mode is not enabled or the block count
+* 		is invalid
+*
+******************************************************************************/
+s32 XSdPs_WriteAsync(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff,
+			XSdPs_AsyncHandler Handler, void *CallBackRef)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Buff != NULL);
+	Xil_AssertNonvoid(Handler != NULL);
+
+	return XSdPs_AsyncQueue(InstancePtr, Arg, BlkCnt, (u8 *)(UINTPTR)Buff,
+			1U, Handler, CallBackRef);
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* Interrupt handler of the SD controller in async mode. It completes the
+* active transfer, issues the next queued one and then calls the
+* completion handler of the completed transfer.
+*
+* On an error the failed transfer is completed with XST_FAILURE and the
+* queue is stopped. Only the error is recorded here, the recovery is left
+* to XSdPs_AsyncPoll() as it has to wait for the controller and the card.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	None
+*
+******************************************************************************/
+void XSdPs_IntrHandler(void *InstancePtr)
+{
+	XSdPs *SdPtr = (XSdPs *)InstancePtr;
+	XSdPs_AsyncReq Done;
+	u16 StatusReg;
+	s32 Status;
+
+	Xil_AssertVoid(SdPtr != NULL);
+
+	StatusReg = XSdPs_ReadReg16(SdPtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_STS_OFFSET);
+
+	if ((StatusReg & XSDPS_INTR_ERR_MASK) != 0U) {
+		XSdPs_WriteReg16(SdPtr->Config.BaseAddress,
+				XSDPS_ERR_INTR_STS_OFFSET, XSDPS_ERROR_INTR_ALL_MASK);
+		/* A multi-block transfer leaves the card in the data state */
+		if ((SdPtr->AsyncCount != 0U) &&
+			(SdPtr->AsyncQueue[SdPtr->AsyncHead].BlkCnt > 1U)) {
+			SdPtr->AsyncRecover = XSDPS_ASYNC_RECOVER_STOP;
+		} else {
+			SdPtr->AsyncRecover = XSDPS_ASYNC_RECOVER_RESET;
+		}
+		Status = XST_FAILURE;
+	} else if ((StatusReg & XSDPS_INTR_TC_MASK) != 0U) {
+		Status = XST_SUCCESS;
+	} else {
+		return;
+	}
+
+	XSdPs_WriteReg16(SdPtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_STS_OFFSET,
+			XSDPS_INTR_TC_MASK | XSDPS_INTR_CC_MASK);
+
+	if (SdPtr->AsyncCount == 0U) {
+		return;
+	}
+
+	Done = SdPtr->AsyncQueue[SdPtr->AsyncHead];
+	SdPtr->AsyncHead = (SdPtr->AsyncHead + 1U) % XSDPS_ASYNC_QUEUE_DEPTH;
+	SdPtr->AsyncCount -= 1U;
+
+	/* Get the card working on the next transfer right away */
+	XSdPs_AsyncStart(SdPtr);
+
+	if ((Done.IsWrite == 0U) && (SdPtr->Config.IsCacheCoherent == 0U)) {
+		Xil_DCacheInvalidateRange((INTPTR)Done.Buff,
+				(INTPTR)Done.BlkCnt * SdPtr->BlkSize);
+	}
+
+	Done.Handler(Done.CallBackRef, Status);
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function does the error recovery of async mode and restarts the
+* queue. It must not be called from the interrupt handler, it waits for
+* the line resets and for the response of CMD12.
+*
+* After an error interrupt the CMD and DAT lines are reset. For a
+* multi-block transfer the card is still in the data state, so it is sent
+* CMD12 and the lines are reset once more. CMD12 has an R1b response, the
+* card keeps DAT0 low until it is done, and the next transfer is only
+* issued once DAT0 is high. This function returns instead of waiting for
+* that, it has to be called again until it returns XST_SUCCESS.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+*
+* @return
+* 		- XST_SUCCESS if no recovery is pending or it is done and the
+* 		queued transfers are started
+* 		- XST_DEVICE_BUSY if the card is still busy
+*
+******************************************************************************/
+s32 XSdPs_AsyncPoll(XSdPs *InstancePtr)
+{
+	u32 PresentStateReg;
+	u16 SigEnable;
+	s32 Status = XST_SUCCESS;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->AsyncRecover == XSDPS_ASYNC_RECOVER_NONE) {
+		goto RETURN_PATH;
+	}
+
+	/*
+	 * Mask the SD interrupt, the errors of the recovery itself are
+	 * cleared below and a completion handler may queue transfers
+	 */
+	SigEnable = XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET, 0x0U);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_SIG_EN_OFFSET, 0x0U);
+
+	if (InstancePtr->AsyncRecover != XSDPS_ASYNC_RECOVER_BUSY) {
+		(void)XSdPs_Reset(InstancePtr, XSDPS_SWRST_CMD_LINE_MASK |
+				XSDPS_SWRST_DAT_LINE_MASK);
+		if (InstancePtr->AsyncRecover == XSDPS_ASYNC_RECOVER_STOP) {
+			/* Stop transmission, errors of CMD12 itself are cleared below */
+			(void)XSdPs_CmdTransfer(InstancePtr, CMD12, 0U, 0U);
+			(void)XSdPs_Reset(InstancePtr, XSDPS_SWRST_CMD_LINE_MASK |
+					XSDPS_SWRST_DAT_LINE_MASK);
+		}
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_STS_OFFSET, XSDPS_NORM_INTR_ALL_MASK);
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_ERR_INTR_STS_OFFSET, XSDPS_ERROR_INTR_ALL_MASK);
+		InstancePtr->AsyncRecover = XSDPS_ASYNC_RECOVER_BUSY;
+	}
+
+	PresentStateReg = XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+				XSDPS_PRES_STATE_OFFSET);
+	if ((PresentStateReg & XSDPS_PSR_DAT0_SG_LVL_MASK) == 0U) {
+		Status = XST_DEVICE_BUSY;
+	} else {
+		InstancePtr->AsyncRecover = XSDPS_ASYNC_RECOVER_NONE;
+		XSdPs_AsyncStart(InstancePtr);
+	}
+
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_SIG_EN_OFFSET, XSDPS_ERROR_INTR_ALL_MASK);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET, SigEnable);
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function adds a transfer to the async queue. If the controller is
+* idle the transfer is issued, if it is next in line its descriptor table
+* is built right away.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the command argument.
+* @param	BlkCnt - Block count passed by the user.
+* @param	Buff - Pointer to the data buffer for a DMA transfer.
+* @param	IsWrite is 1 for a write and 0 for a read.
+* @param	Handler is the completion handler.
+* @param	CallBackRef is passed to the completion handler.
+*
+* @return	XST_SUCCESS, XST_DEVICE_BUSY or XST_FAILURE
+*
+******************************************************************************/
+static s32 XSdPs_AsyncQueue(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt,
+		u8 *Buff, u8 IsWrite, XSdPs_AsyncHandler Handler,
+		void *CallBackRef)
+{
+	XSdPs_AsyncReq *Req;
+	u16 SigEnable;
+	s32 Status;
+
+	if ((InstancePtr->AsyncMode == 0U) || (BlkCnt == 0U) ||
+		(BlkCnt > 0xFFFFU) || ((BlkCnt * InstancePtr->BlkSize) >
+			(XSDPS_ASYNC_DESC_LINES * XSDPS_DESC_MAX_LENGTH))) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	/*
+	 * Mask the SD interrupt while the queue is updated, this may also
+	 * be called from a completion handler.
+	 */
+	SigEnable = XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET, 0x0U);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_SIG_EN_OFFSET, 0x0U);
+
+	if (InstancePtr->AsyncCount == XSDPS_ASYNC_QUEUE_DEPTH) {
+		Status = XST_DEVICE_BUSY;
+		goto RESTORE;
+	}
+
+	Req = &InstancePtr->AsyncQueue[(InstancePtr->AsyncHead +
+			InstancePtr->AsyncCount) % XSDPS_ASYNC_QUEUE_DEPTH];
+	Req->Arg = Arg;
+	Req->BlkCnt = BlkCnt;
+	Req->Buff = Buff;
+	Req->IsWrite = IsWrite;
+	Req->Handler = Handler;
+	Req->CallBackRef = CallBackRef;
+	Req->IsPrepared = 0U;
+	InstancePtr->AsyncCount += 1U;
+
+	if (InstancePtr->AsyncCount == 1U) {
+		XSdPs_AsyncStart(InstancePtr);
+	} else if ((InstancePtr->AsyncCount == 2U) &&
+			(InstancePtr->IsBusy == TRUE)) {
+		/* Next in line, use the table the active transfer is not using */
+		XSdPs_AsyncPrepare(InstancePtr, Req,
+			InstancePtr->AsyncQueue[InstancePtr->AsyncHead].DescTbl ^ 1U);
+	} else {
+		/* Built by XSdPs_AsyncStart() when it gets next in line */
+	}
+
+	Status = XST_SUCCESS;
+
+RESTORE:
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_SIG_EN_OFFSET, XSDPS_ERROR_INTR_ALL_MASK);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET, SigEnable);
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function builds the ADMA2 descriptor table of a queued transfer and
+* does the cache maintenance of its buffer.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Req is the queued transfer.
+* @param	DescTbl is the descriptor table (0 or 1) to use.
+*
+* @return	None
+*
+******************************************************************************/
+static void XSdPs_AsyncPrepare(XSdPs *InstancePtr, XSdPs_AsyncReq *Req,
+		u8 DescTbl)
+{
+	XSdPs_Adma2Descriptor64 *Desc64 = InstancePtr->AsyncDescTbl[DescTbl];
+	XSdPs_Adma2Descriptor32 *Desc32 =
+			(XSdPs_Adma2Descriptor32 *)(void *)Desc64;
+	u32 Length = Req->BlkCnt * InstancePtr->BlkSize;
+	u32 TotalDescLines;
+	u32 DescNum;
+	u32 Remaining;
+	u16 Attribute;
+
+	TotalDescLines = (Length + XSDPS_DESC_MAX_LENGTH - 1U) /
+				XSDPS_DESC_MAX_LENGTH;
+
+	for (DescNum = 0U; DescNum < TotalDescLines; DescNum++) {
+		Remaining = Length - (DescNum * XSDPS_DESC_MAX_LENGTH);
+		Attribute = XSDPS_DESC_TRAN | XSDPS_DESC_VALID;
+		if (DescNum == (TotalDescLines - 1U)) {
+			Attribute |= XSDPS_DESC_END;
+		}
+		/* A length of 0 means 64KB */
+		if (InstancePtr->HC_Version == XSDPS_HC_SPEC_V3) {
+			Desc64[DescNum].Address = (u64)((UINTPTR)Req->Buff +
+					(DescNum * XSDPS_DESC_MAX_LENGTH));
+			Desc64[DescNum].Attribute = Attribute;
+			Desc64[DescNum].Length = (u16)Remaining;
+		} else {
+			Desc32[DescNum].Address = (u32)((UINTPTR)Req->Buff +
+					(DescNum * XSDPS_DESC_MAX_LENGTH));
+			Desc32[DescNum].Attribute = Attribute;
+			Desc32[DescNum].Length = (u16)Remaining;
+		}
+	}
+
+	if (InstancePtr->Config.IsCacheCoherent == 0U) {
+		Xil_DCacheFlushRange((INTPTR)Desc64,
+			sizeof(XSdPs_Adma2Descriptor64) * XSDPS_ASYNC_DESC_LINES);
+		if (Req->IsWrite != 0U) {
+			Xil_DCacheFlushRange((INTPTR)Req->Buff, (INTPTR)Length);
+		} else {
+			Xil_DCacheInvalidateRange((INTPTR)Req->Buff,
+					(INTPTR)Length);
+		}
+	}
+
+	Req->DescTbl = DescTbl;
+	Req->IsPrepared = 1U;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function points the ADMA2 engine at the descriptor table of a
+* prepared transfer and sends its read or write command.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Req is the queued transfer.
+*
+* @return	XST_SUCCESS or XST_FAILURE
+*
+******************************************************************************/
+static s32 XSdPs_AsyncIssue(XSdPs *InstancePtr, XSdPs_AsyncReq *Req)
+{
+	UINTPTR DescAddr = (UINTPTR)InstancePtr->AsyncDescTbl[Req->DescTbl];
+	u32 Cmd;
+	s32 Status;
+
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_BLK_SIZE_OFFSET,
+			(u16)(InstancePtr->BlkSize & XSDPS_BLK_SIZE_MASK));
+
+#if defined(__aarch64__) || defined(__arch64__)
+	if (InstancePtr->HC_Version == XSDPS_HC_SPEC_V3) {
+		XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XSDPS_ADMA_SAR_EXT_OFFSET, (u32)(DescAddr >> 32U));
+	}
+#endif
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress, XSDPS_ADMA_SAR_OFFSET,
+			(u32)(DescAddr & (u32)~0x0));
+
+	if (Req->BlkCnt == 1U) {
+		InstancePtr->TransferMode = XSDPS_TM_BLK_CNT_EN_MASK |
+			XSDPS_TM_DMA_EN_MASK;
+		Cmd = (Req->IsWrite != 0U) ? CMD24 : CMD17;
+	} else {
+		InstancePtr->TransferMode = XSDPS_TM_AUTO_CMD12_EN_MASK |
+			XSDPS_TM_BLK_CNT_EN_MASK |
+			XSDPS_TM_MUL_SIN_BLK_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+		Cmd = (Req->IsWrite != 0U) ? CMD25 : CMD18;
+	}
+	if (Req->IsWrite == 0U) {
+		InstancePtr->TransferMode |= XSDPS_TM_DAT_DIR_SEL_MASK;
+	}
+
+	Status = XSdPs_SetupCmd(InstancePtr, Req->Arg, Req->BlkCnt);
+	if (Status != XST_SUCCESS) {
+		goto RETURN_PATH;
+	}
+
+	/* Completion is reported by the transfer complete interrupt */
+	Status = XSdPs_SendCmd(InstancePtr, Cmd);
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function issues the transfer at the head of the async queue and
+* builds the descriptor table of the one after it. Transfers that can not
+* be issued are completed with XST_FAILURE. Nothing is issued while an
+* error recovery is pending or the card holds DAT0 low, XSdPs_AsyncPoll()
+* starts the queue once the card is ready.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+*
+* @return	None
+*
+******************************************************************************/
+static void XSdPs_AsyncStart(XSdPs *InstancePtr)
+{
+	XSdPs_AsyncReq *Req;
+	XSdPs_AsyncReq *Next;
+	XSdPs_AsyncReq Failed;
+	u32 PresentStateReg;
+
+	while (InstancePtr->AsyncCount != 0U) {
+		if (InstancePtr->AsyncRecover != XSDPS_ASYNC_RECOVER_NONE) {
+			break;
+		}
+		PresentStateReg = XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+					XSDPS_PRES_STATE_OFFSET);
+		if ((PresentStateReg & XSDPS_PSR_DAT0_SG_LVL_MASK) == 0U) {
+			InstancePtr->AsyncRecover = XSDPS_ASYNC_RECOVER_BUSY;
+			break;
+		}
+
+
+		Req = &InstancePtr->AsyncQueue[InstancePtr->AsyncHead];
+		if (Req->IsPrepared == 0U) {
+			XSdPs_AsyncPrepare(InstancePtr, Req, 0U);
+		}
+
+		if (XSdPs_AsyncIssue(InstancePtr, Req) == XST_SUCCESS) {
+			InstancePtr->IsBusy = TRUE;
+			if (InstancePtr->AsyncCount > 1U) {
+				Next = &InstancePtr->AsyncQueue[(InstancePtr->AsyncHead +
+						1U) % XSDPS_ASYNC_QUEUE_DEPTH];
+				if (Next->IsPrepared == 0U) {
+					XSdPs_AsyncPrepare(InstancePtr, Next,
+							Req->DescTbl ^ 1U);
+				}
+			}
+			return;
+		}
+
+		Failed = *Req;
+		InstancePtr->AsyncHead = (InstancePtr->AsyncHead + 1U) %
+					XSDPS_ASYNC_QUEUE_DEPTH;
+		InstancePtr->AsyncCount -= 1U;
+		InstancePtr->IsBusy = FALSE;
+		Failed.Handler(Failed.CallBackRef, XST_FAILURE);
+		/* The handler may have queued and started a new transfer */
+		if (InstancePtr->IsBusy == TRUE) {
+			return;
+		}
+	}
+
+	InstancePtr->IsBusy = FALSE;
+}
+/** @} */
@@ -60,6 +60,13 @@
 *                    Xil_DCacheFlushRange function implementation and defined it as
 *                    macro. Xil_DCacheFlushRange macro points to the
 *                    Xil_DCacheInvalidateRange API to avoid code duplication.
+* 7.3 agent 10/17/2026 Read the cache line sizes from CTR_EL0, mask interrupts
+*                    only per chunk of lines in Xil_DCacheInvalidateRange,
+*                    fall back to a set/way flush for ranges larger than
+*                    XIL_DCACHE_SETWAY_THRESHOLD and added
+*                    Xil_DCacheInvalidateRangeList. Fixed
+*                    Xil_ICacheInvalidateRange invalidating only the first
+*                    line of the range.
 *
 * </pre>
 *
@@ -77,9 +84,18 @@
 
 /************************** Function Prototypes ******************************/
 
+static INTPTR Xil_DCacheLineSize(void);
+static INTPTR Xil_ICacheLineSize(void);
+static void Xil_DCacheRangeCIVAC(INTPTR adr, INTPTR len);
+static void Xil_DCacheSetWayCISW(void);
+static void Xil_DCacheLevelCISW(u32 CacheLevel);
+
 /************************** Variable Definitions *****************************/
 #define IRQ_FIQ_MASK 0xC0U	/* Mask IRQ and FIQ interrupts in cpsr */
 
+static INTPTR DCacheLineSize;	/* Smallest D cache line, read from CTR_EL0 */
+static INTPTR ICacheLineSize;	/* Smallest I cache line, read from CTR_EL0 */
+
 /****************************************************************************/
 /**
 * @brief	Enable the Data cache.
@@ -408,25 +424,224 @@ void Xil_DCacheInvalidateLine(INTPTR adr)
 * 			a line belonging to another OS. This could lead to the other OS
 * 			crashing because of the loss of essential data. Hence, such
 * 			operations are promoted to clean and invalidate which avoids such
-*			corruption.
+*			corruption. Ranges of XIL_DCACHE_SETWAY_THRESHOLD bytes or more
+*			flush the entire Data cache by set/way instead, with
+*			interrupts masked only per XIL_CACHE_LINES_PER_CHUNK lines.
 *
 ****************************************************************************/
 void Xil_DCacheInvalidateRange(INTPTR  adr, INTPTR len)
 {
-	const INTPTR cacheline = 64U;
+	if ((XIL_DCACHE_SETWAY_THRESHOLD != 0U) &&
+			(len >= (INTPTR)XIL_DCACHE_SETWAY_THRESHOLD)) {
+		/* Cheaper to clean and invalidate the whole cache by set/way */
+		Xil_DCacheSetWayCISW();
+		return;
+	}
+
+	if (len != 0U) {
+		Xil_DCacheRangeCIVAC(adr, len);
+	}
+	/* Wait for invalidate to complete */
+	dsb();
+}
+
+/****************************************************************************/
+/**
+* @brief	Invalidate the Data cache for a list of address ranges. The
+*			cachelines present in all the ranges are cleaned and
+*			invalidated, and a single barrier waits for all of them.
+*
+* @param	List: Array of the address ranges to be invalidated.
+* @param	Count: Number of entries in List.
+*
+* @return	None.
+*
+* @note		When the ranges add up to XIL_DCACHE_SETWAY_THRESHOLD bytes or
+*			more, the entire Data cache is flushed instead. Similar to
+*			Xil_DCacheInvalidateRange, the operation is always promoted to
+*			clean and invalidate.
+*
+****************************************************************************/
+void Xil_DCacheInvalidateRangeList(const Xil_CacheRange *List, u32 Count)
+{
+	INTPTR Total = 0;
+	u32 Index;
+
+	if (XIL_DCACHE_SETWAY_THRESHOLD != 0U) {
+		for (Index = 0U; Index < Count; Index++) {
+			Total += List[Index].Len;
+		}
+		if (Total >= (INTPTR)XIL_DCACHE_SETWAY_THRESHOLD) {
+			Xil_DCacheSetWayCISW();
+			return;
+		}
+	}
+
+	for (Index = 0U; Index < Count; Index++) {
+		if (List[Index].Len != 0) {
+			Xil_DCacheRangeCIVAC(List[Index].Adr, List[Index].Len);
+		}
+	}
+	/* Wait for all the ranges to complete */
+	dsb();
+}
+
+/****************************************************************************/
+/**
+* @brief	Issue clean and invalidate by VA for every cacheline of a range.
+*			Interrupts are masked for XIL_CACHE_LINES_PER_CHUNK lines at
+*			a time, so that a large range does not hold off interrupts
+*			for its whole duration.
+*
+* @param	adr: 64bit start address of the range.
+* @param	len: Length of the range in bytes, must not be 0.
+*
+* @return	None.
+*
+* @note		The caller issues the dsb which waits for completion.
+*
+****************************************************************************/
+static void Xil_DCacheRangeCIVAC(INTPTR adr, INTPTR len)
+{
+	const INTPTR cacheline = Xil_DCacheLineSize();
+	const INTPTR chunk = cacheline * (INTPTR)XIL_CACHE_LINES_PER_CHUNK;
 	INTPTR end = adr + len;
-	adr = adr & (~0x3F);
+	INTPTR chunkend;
 	u32 currmask = mfcpsr();
-	mtcpsr(currmask | IRQ_FIQ_MASK);
-	if (len != 0U) {
-		while (adr < end) {
+
+	adr &= ~(cacheline - 1);
+	while (adr < end) {
+		chunkend = end;
+		if ((end - adr) > chunk) {
+			chunkend = adr + chunk;
+		}
+		mtcpsr(currmask | IRQ_FIQ_MASK);
+		while (adr < chunkend) {
 			mtcpdc(CIVAC,adr);
 			adr += cacheline;
 		}
+		mtcpsr(currmask);
+	}
+}
+
+/****************************************************************************/
+/**
+* @brief	Clean and invalidate the L1 and L2 Data caches by set/way, like
+*			Xil_DCacheFlush. Unlike Xil_DCacheFlush, which keeps IRQ and
+*			FIQ masked for the whole walk (up to some 32K set/way
+*			operations on a 1MB L2), interrupts are masked for
+*			XIL_CACHE_LINES_PER_CHUNK lines at a time only.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		Lines written by an interrupt handler during the walk may stay
+*			in the cache; this is the same as for the range operations.
+*
+****************************************************************************/
+static void Xil_DCacheSetWayCISW(void)
+{
+	/* L1 Data cache */
+	Xil_DCacheLevelCISW(0U);
+	/* L2 cache */
+	Xil_DCacheLevelCISW(0x00000001U << 1U);
+}
+
+/****************************************************************************/
+/**
+* @brief	Clean and invalidate one level of the Data cache by set/way,
+*			with interrupts masked per chunk of lines.
+*
+* @param	CacheLevel: Level of the cache, as written to CSSELR_EL1.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void Xil_DCacheLevelCISW(u32 CacheLevel)
+{
+	u32 CsidReg, LineSize, NumWays, NumSet, WayAdjust;
+	u32 Way, Set, WayIndex, SetIndex;
+	u32 Lines = 0U;
+	u32 currmask = mfcpsr();
+
+	/* CSSELR_EL1 may be changed by an interrupt handler */
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+	mtcp(CSSELR_EL1,CacheLevel);
+	isb();
+	CsidReg = mfcp(CCSIDR_EL1);
+	mtcpsr(currmask);
+
+	/* Get the cacheline size, way size, index size from csidr */
+	LineSize = (CsidReg & 0x00000007U) + 0x00000004U;
+	NumWays = ((CsidReg & 0x00001FFFU) >> 3U) + 0x00000001U;
+	NumSet = ((CsidReg >> 13U) & 0x00007FFFU) + 0x00000001U;
+	WayAdjust = clz(NumWays) - (u32)0x0000001FU;
+
+	Way = 0U;
+	for (WayIndex = 0U; WayIndex < NumWays; WayIndex++) {
+		Set = 0U;
+		for (SetIndex = 0U; SetIndex < NumSet; SetIndex++) {
+			if (Lines == 0U) {
+				mtcpsr(currmask | IRQ_FIQ_MASK);
+			}
+			mtcpdc(CISW,Way | Set | CacheLevel);
+			Set += (0x00000001U << LineSize);
+			Lines++;
+			if (Lines == XIL_CACHE_LINES_PER_CHUNK) {
+				mtcpsr(currmask);
+				Lines = 0U;
+			}
+		}
+		Way += (0x00000001U << WayAdjust);
 	}
-	/* Wait for invalidate to complete */
-	dsb();
 	mtcpsr(currmask);
+
+	/* Wait for Flush to complete */
+	dsb();
+}
+
+/****************************************************************************/
+/**
+* @brief	Get the smallest Data cache line size in the system.
+*
+* @param	None.
+*
+* @return	Line size in bytes, from the DminLine field of CTR_EL0.
+*
+* @note		None.
+*
+****************************************************************************/
+static INTPTR Xil_DCacheLineSize(void)
+{
+	if (DCacheLineSize == 0) {
+		/* DminLine is log2 of the number of 4 byte words */
+		DCacheLineSize = (INTPTR)4 <<
+				((mfcp(CTR_EL0) >> 16U) & 0xFU);
+	}
+	return DCacheLineSize;
+}
+
+/****************************************************************************/
+/**
+* @brief	Get the smallest Instruction cache line size in the system.
+*
+* @param	None.
+*
+* @return	Line size in bytes, from the IminLine field of CTR_EL0.
+*
+* @note		None.
+*
+****************************************************************************/
+static INTPTR Xil_ICacheLineSize(void)
+{
+	if (ICacheLineSize == 0) {
+		/* IminLine is log2 of the number of 4 byte words */
+		ICacheLineSize = (INTPTR)4 << (mfcp(CTR_EL0) & 0xFU);
+	}
+	return ICacheLineSize;
 }
 
 /****************************************************************************/
@@ -708,7 +923,7 @@ void Xil_ICacheInvalidateLine(INTPTR  adr)
 ****************************************************************************/
 void Xil_ICacheInvalidateRange(INTPTR  adr, INTPTR len)
 {
-	const INTPTR cacheline = 64U;
+	const INTPTR cacheline = Xil_ICacheLineSize();
 	INTPTR end;
 	INTPTR tempadr = adr;
 	INTPTR tempend;
@@ -725,7 +940,7 @@ void Xil_ICacheInvalidateRange(INTPTR  adr, INTPTR len)
 		mtcp(CSSELR_EL1,0x1);
 		while (tempadr < tempend) {
 			/*Invalidate I Cache line*/
-			mtcpic(IVAU,adr & (~0x3F));
+			mtcpic(IVAU,tempadr);
 
 			tempadr += cacheline;
 		}
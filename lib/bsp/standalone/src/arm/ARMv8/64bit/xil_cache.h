@@ -23,6 +23,7 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 5.00 	pkp  05/29/14 First release
+* 7.3   agent 10/17/2026 Added Xil_DCacheInvalidateRangeList and the range tunables.
 * </pre>
 *
 ******************************************************************************/
@@ -39,14 +40,41 @@ extern "C" {
 #define L1_DATA_PREFETCH_CONTROL_MASK  0xE000
 #define L1_DATA_PREFETCH_CONTROL_SHIFT  13
 
+/*
+ * Ranges of at least this many bytes are handled by flushing the entire Data
+ * cache by set/way, which is cheaper than walking the range once it exceeds
+ * the size of the L2 cache. Set/way operations only act on the caches of the
+ * executing core, define it as 0 to always maintain by address. Interrupts
+ * are masked per XIL_CACHE_LINES_PER_CHUNK lines in both cases.
+ */
+#ifndef XIL_DCACHE_SETWAY_THRESHOLD
+#define XIL_DCACHE_SETWAY_THRESHOLD	0x200000U
+#endif
+
+/* Cachelines maintained per interrupt masked chunk of a range operation */
+#ifndef XIL_CACHE_LINES_PER_CHUNK
+#define XIL_CACHE_LINES_PER_CHUNK	64U
+#endif
+
+/**************************** Type Definitions *******************************/
+/**
+ * Address range for Xil_DCacheInvalidateRangeList/Xil_DCacheFlushRangeList
+ */
+typedef struct {
+	INTPTR Adr;	/**< Start address of the range */
+	INTPTR Len;	/**< Length of the range in bytes */
+} Xil_CacheRange;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 #define Xil_DCacheFlushRange Xil_DCacheInvalidateRange
+#define Xil_DCacheFlushRangeList Xil_DCacheInvalidateRangeList
 
 /************************** Function Prototypes ******************************/
 void Xil_DCacheEnable(void);
 void Xil_DCacheDisable(void);
 void Xil_DCacheInvalidate(void);
 void Xil_DCacheInvalidateRange(INTPTR adr, INTPTR len);
+void Xil_DCacheInvalidateRangeList(const Xil_CacheRange *List, u32 Count);
 void Xil_DCacheInvalidateLine(INTPTR adr);
 void Xil_DCacheFlush(void);
 void Xil_DCacheFlushLine(INTPTR adr);
@@ -8,8 +8,11 @@
 /**
 * @file xil_mem.c
 *
-* This file contains xil mem copy function to use in case of word aligned
-* data copies.
+* This file contains xil mem copy and mem set functions. When source and
+* destination are equally aligned, the bulk of the data is copied with
+* burst loads/stores: ldp/stp on AArch64, ldm/stm on AArch32 (Cortex-R5,
+* Cortex-A9, Cortex-A53 32-bit) and unrolled word copies on other
+* processors, which is also the path used when building for a host.
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -17,6 +20,7 @@
 * Ver   Who      Date     Changes
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
+* 7.3   agent    10/17/2026 Added aligned burst copies and Xil_MemSet.
 *
 * </pre>
 *
@@ -25,6 +29,18 @@
 /***************************** Include Files ********************************/
 
 #include "xil_types.h"
+#include "xil_mem.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_MEM_WORD_SIZE	sizeof(UINTPTR)
+#define XIL_MEM_WORD_MASK	(XIL_MEM_WORD_SIZE - 1U)
+#define XIL_MEM_BURST_SIZE	(8U * XIL_MEM_WORD_SIZE)	/* Bytes per burst */
+
+/************************** Function Prototypes ******************************/
+
+static void Xil_MemCpyBurst(UINTPTR *d, const UINTPTR *s, u32 cnt);
+static void Xil_MemSetBurst(UINTPTR *d, UINTPTR v, u32 cnt);
 
 /***************** Inline Functions Definitions ********************/
 /*****************************************************************************/
@@ -42,6 +58,27 @@ void Xil_MemCpy(void* dst, const void* src, u32 cnt)
 {
 	char *d = (char*)(void *)dst;
 	const char *s = src;
+	u32 Burst;
+
+	if ((cnt >= (2U * XIL_MEM_BURST_SIZE)) &&
+			((((UINTPTR)d ^ (UINTPTR)s) & XIL_MEM_WORD_MASK) == 0U)) {
+		/* Equally aligned, copy the head bytewise and then in bursts */
+		while ((cnt > 0U) && (((UINTPTR)d & XIL_MEM_WORD_MASK) != 0U)) {
+			*d = *s;
+			d += 1U;
+			s += 1U;
+			cnt -= 1U;
+		}
+
+		Burst = cnt & ~(XIL_MEM_BURST_SIZE - 1U);
+		if (Burst != 0U) {
+			Xil_MemCpyBurst((UINTPTR *)(void *)d,
+					(const UINTPTR *)(const void *)s, Burst);
+			d += Burst;
+			s += Burst;
+			cnt -= Burst;
+		}
+	}
 
 	while (cnt >= sizeof (int)) {
 		*(int*)d = *(int*)s;
@@ -62,3 +99,155 @@ void Xil_MemCpy(void* dst, const void* src, u32 cnt)
 		cnt -= 1U;
 	}
 }
+
+/*****************************************************************************/
+/**
+* @brief       This  function fills memory with a byte value.
+*
+* @param       dst: pointer pointing to destination memory
+*
+* @param       val: byte value to be written
+*
+* @param       cnt: 32 bit length of bytes to be written
+*
+*****************************************************************************/
+void Xil_MemSet(void* dst, s32 val, u32 cnt)
+{
+	char *d = (char*)(void *)dst;
+	char c = (char)val;
+	UINTPTR v;
+	u32 Burst;
+
+	while ((cnt >= XIL_MEM_BURST_SIZE) &&
+			(((UINTPTR)d & XIL_MEM_WORD_MASK) != 0U)) {
+		*d = c;
+		d += 1U;
+		cnt -= 1U;
+	}
+
+	Burst = cnt & ~(XIL_MEM_BURST_SIZE - 1U);
+	if (Burst != 0U) {
+		/* Replicate the byte in every byte lane of a word */
+		v = (UINTPTR)(u8)c;
+		v |= v << 8U;
+		v |= v << 16U;
+#if defined (__aarch64__) || defined (__LP64__)
+		v |= v << 32U;
+#endif
+		Xil_MemSetBurst((UINTPTR *)(void *)d, v, Burst);
+		d += Burst;
+		cnt -= Burst;
+	}
+
+	while ((cnt) > 0U){
+		*d = c;
+		d += 1U;
+		cnt -= 1U;
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief       Copies a word aligned, burst sized block.
+*
+* @param       d: word aligned destination
+*
+* @param       s: word aligned source
+*
+* @param       cnt: length in bytes, a multiple of XIL_MEM_BURST_SIZE
+*
+*****************************************************************************/
+static void Xil_MemCpyBurst(UINTPTR *d, const UINTPTR *s, u32 cnt)
+{
+#if defined (__aarch64__)
+	u64 Tmp0, Tmp1, Tmp2, Tmp3, Tmp4, Tmp5, Tmp6, Tmp7;
+
+	__asm__ __volatile__(
+		"1:\n"
+		"ldp	%3, %4, [%1]\n"
+		"ldp	%5, %6, [%1, #16]\n"
+		"ldp	%7, %8, [%1, #32]\n"
+		"ldp	%9, %10, [%1, #48]\n"
+		"add	%1, %1, #64\n"
+		"stp	%3, %4, [%0]\n"
+		"stp	%5, %6, [%0, #16]\n"
+		"stp	%7, %8, [%0, #32]\n"
+		"stp	%9, %10, [%0, #48]\n"
+		"add	%0, %0, #64\n"
+		"subs	%w2, %w2, #64\n"
+		"b.ne	1b\n"
+		: "+r" (d), "+r" (s), "+r" (cnt),
+		  "=&r" (Tmp0), "=&r" (Tmp1), "=&r" (Tmp2), "=&r" (Tmp3),
+		  "=&r" (Tmp4), "=&r" (Tmp5), "=&r" (Tmp6), "=&r" (Tmp7)
+		:
+		: "cc", "memory");
+#elif defined (__arm__) && !defined (__ICCARM__)
+	__asm__ __volatile__(
+		"1:\n"
+		/* r7/r11 may be the frame pointer, leave them alone */
+		"ldmia	%1!, {r3, r4, r5, r6, r8, r9, r10, r12}\n"
+		"stmia	%0!, {r3, r4, r5, r6, r8, r9, r10, r12}\n"
+		"subs	%2, %2, #32\n"
+		"bne	1b\n"
+		: "+r" (d), "+r" (s), "+r" (cnt)
+		:
+		: "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12",
+		  "cc", "memory");
+#else
+	while (cnt != 0U) {
+		d[0] = s[0];
+		d[1] = s[1];
+		d[2] = s[2];
+		d[3] = s[3];
+		d[4] = s[4];
+		d[5] = s[5];
+		d[6] = s[6];
+		d[7] = s[7];
+		d += 8U;
+		s += 8U;
+		cnt -= XIL_MEM_BURST_SIZE;
+	}
+#endif
+}
+
+/*****************************************************************************/
+/**
+* @brief       Fills a word aligned, burst sized block.
+*
+* @param       d: word aligned destination
+*
+* @param       v: word to be written
+*
+* @param       cnt: length in bytes, a multiple of XIL_MEM_BURST_SIZE
+*
+*****************************************************************************/
+static void Xil_MemSetBurst(UINTPTR *d, UINTPTR v, u32 cnt)
+{
+#if defined (__aarch64__)
+	__asm__ __volatile__(
+		"1:\n"
+		"stp	%2, %2, [%0]\n"
+		"stp	%2, %2, [%0, #16]\n"
+		"stp	%2, %2, [%0, #32]\n"
+		"stp	%2, %2, [%0, #48]\n"
+		"add	%0, %0, #64\n"
+		"subs	%w1, %w1, #64\n"
+		"b.ne	1b\n"
+		: "+r" (d), "+r" (cnt)
+		: "r" (v)
+		: "cc", "memory");
+#else
+	while (cnt != 0U) {
+		d[0] = v;
+		d[1] = v;
+		d[2] = v;
+		d[3] = v;
+		d[4] = v;
+		d[5] = v;
+		d[6] = v;
+		d[7] = v;
+		d += 8U;
+		cnt -= XIL_MEM_BURST_SIZE;
+	}
+#endif
+}
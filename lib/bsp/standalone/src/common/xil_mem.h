@@ -22,6 +22,7 @@
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
 * 7.0   mus      01/07/19 Add cpp extern macro
+* 7.3   agent    10/17/2026 Added Xil_MemSet
 *
 * </pre>
 *
@@ -36,6 +37,7 @@ extern "C" {
 /************************** Function Prototypes *****************************/
 
 void Xil_MemCpy(void* dst, const void* src, u32 cnt);
+void Xil_MemSet(void* dst, s32 val, u32 cnt);
 
 #ifdef __cplusplus
 }
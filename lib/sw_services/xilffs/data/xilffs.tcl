@@ -93,6 +93,8 @@ proc xgen_opts_file {libhandle} {
 	set set_fs_rpath [common::get_property CONFIG.set_fs_rpath $libhandle]
 	set word_access [common::get_property CONFIG.word_access $libhandle]
 	set use_chmod [common::get_property CONFIG.use_chmod $libhandle]
+	set use_fastseek [common::get_property CONFIG.use_fastseek $libhandle]
+	set sector_cache_size [common::get_property CONFIG.sector_cache_size $libhandle]
 
 	# do processor specific checks
 	set proc  [hsi::get_sw_processor];
@@ -149,6 +151,16 @@ proc xgen_opts_file {libhandle} {
 		if {$use_mkfs == true} {
 			puts $file_handle "\#define FILE_SYSTEM_USE_MKFS"
 		}
+		if {$use_fastseek == true} {
+			puts $file_handle "\#define FILE_SYSTEM_USE_FASTSEEK"
+		}
+		if {$sector_cache_size > 0} {
+			if {[expr $sector_cache_size % 4] != 0} {
+				set sector_cache_size [expr (($sector_cache_size + 3) / 4) * 4]
+				puts "WARNING : sector_cache_size rounded up to $sector_cache_size sectors"
+			}
+			puts $file_handle "\#define FILE_SYSTEM_SECTOR_CACHE_SIZE $sector_cache_size"
+		}
 		if {$enable_multi_partition == true} {
 			puts $file_handle "\#define FILE_SYSTEM_MULTI_PARTITION"
 		}
@@ -60,6 +60,9 @@
 *       mn   09/25/19 Check if the SD is powered on or not in disk_status()
 * 4.3   mn   02/24/20 Remove unused macro defines
 *       mn   04/08/20 Set IsReady to '0' before calling XSdPs_CfgInitialize
+* 4.4   agent 10/17/2026 Added optional write-back sector cache with merged write-back
+*       agent 10/17/2026 Learn the FAT area only from sector 0 and the partition
+*                     start sectors of the MBR
 *
 * </pre>
 *
@@ -88,6 +91,57 @@ static char *dataramfs = NULL;
 #define SECTORCNT       (RAMFS_SIZE / SECTORSIZE)
 #endif
 
+#ifdef FILE_SYSTEM_SECTOR_CACHE_SIZE
+/*
+ * Sector cache.
+ * FILE_SYSTEM_SECTOR_CACHE_SIZE sectors organised as 4-way set associative
+ * cache, indexed by sector number so that consecutive sectors land in
+ * consecutive sets. Writes of fewer than DISK_CACHE_BYPASS sectors are
+ * kept in the cache and only written to the media on eviction or on
+ * CTRL_SYNC (f_sync/f_close), where adjacent dirty sectors are merged into
+ * multi-block transfers. Larger requests go straight to the media.
+ * Sectors of the FAT area (and the FAT12/16 root directory), learnt from
+ * the boot sector, are replaced only when a set holds nothing else. Boot
+ * sectors are only looked for in sector 0 and in the partition start
+ * sectors of the MBR, never in file data.
+ */
+#include <string.h>
+
+#define DISK_SECTOR_SIZE	512U
+#define DISK_CACHE_WAYS		4U
+#define DISK_CACHE_SETS		(FILE_SYSTEM_SECTOR_CACHE_SIZE / DISK_CACHE_WAYS)
+#define DISK_CACHE_BYPASS	8U	/* Requests this large bypass the cache */
+#define DISK_CACHE_MERGE_MAX	32U	/* Max sectors per merged write-back */
+#define DISK_MBR_TABLE		446U	/* Partition table offset in the MBR */
+#define DISK_MBR_ENTRY_SIZE	16U
+#define DISK_MBR_ENTRIES	4U
+
+#if (FILE_SYSTEM_SECTOR_CACHE_SIZE < DISK_CACHE_WAYS) || \
+	((FILE_SYSTEM_SECTOR_CACHE_SIZE % DISK_CACHE_WAYS) != 0)
+#error "FILE_SYSTEM_SECTOR_CACHE_SIZE must be a non-zero multiple of 4"
+#endif
+
+typedef struct {
+	DWORD Sector;
+	u32 Stamp;	/* Last use, for LRU replacement */
+	BYTE Drive;
+	BYTE Valid;
+	BYTE Dirty;
+	BYTE Meta;	/* FAT area sector */
+} DiskCacheLine;
+
+static DiskCacheLine CacheLine[FILE_SYSTEM_SECTOR_CACHE_SIZE];
+static BYTE CacheData[FILE_SYSTEM_SECTOR_CACHE_SIZE][DISK_SECTOR_SIZE]
+					__attribute__ ((aligned(64)));
+static BYTE CacheMergeBuf[DISK_CACHE_MERGE_MAX * DISK_SECTOR_SIZE]
+					__attribute__ ((aligned(64)));
+static u16 CacheFlushList[FILE_SYSTEM_SECTOR_CACHE_SIZE];
+static u32 CacheClock;
+static DWORD MetaStart[2];
+static DWORD MetaEnd[2];
+static DWORD PartStart[2][DISK_MBR_ENTRIES];	/* From the MBR, 0 if unused */
+#endif
+
 /*--------------------------------------------------------------------------
 
 	Public Functions
@@ -108,6 +162,19 @@ static u32 SlotType[2];
 static u8 HostCntrlrVer[2];
 #endif
 
+static DRESULT disk_read_sectors(BYTE pdrv, BYTE *buff, DWORD sector,
+				UINT count);
+static DRESULT disk_write_sectors(BYTE pdrv, const BYTE *buff, DWORD sector,
+				UINT count);
+#ifdef FILE_SYSTEM_SECTOR_CACHE_SIZE
+static DRESULT disk_cache_read(BYTE pdrv, BYTE *buff, DWORD sector,
+				UINT count);
+static DRESULT disk_cache_write(BYTE pdrv, const BYTE *buff, DWORD sector,
+				UINT count);
+static DRESULT disk_cache_flush(BYTE pdrv);
+static DRESULT disk_cache_invalidate(BYTE pdrv);
+#endif
+
 /*-----------------------------------------------------------------------*/
 /* Get Disk Status							*/
 /*-----------------------------------------------------------------------*/
@@ -303,6 +370,18 @@ DSTATUS disk_initialize (
 	Stat[pdrv] = s;
 #endif
 
+#ifdef FILE_SYSTEM_SECTOR_CACHE_SIZE
+	/*
+	 * The card may have been changed. Sectors still dirty from before the
+	 * re-initialization are written back first; if that fails the drive
+	 * stays uninitialized and the cache keeps them.
+	 */
+	if (disk_cache_invalidate(pdrv) != RES_OK) {
+		s |= STA_NOINIT;
+		Stat[pdrv] = s;
+	}
+#endif
+
 	return s;
 }
 
@@ -337,10 +416,6 @@ DRESULT disk_read (
 )
 {
 	DSTATUS s;
-#ifdef FILE_SYSTEM_INTERFACE_SD
-	s32 Status = XST_FAILURE;
-	DWORD LocSector = sector;
-#endif
 
 	s = disk_status(pdrv);
 
@@ -351,7 +426,37 @@ DRESULT disk_read (
 		return RES_PARERR;
 	}
 
+#ifdef FILE_SYSTEM_SECTOR_CACHE_SIZE
+	return disk_cache_read(pdrv, buff, sector, count);
+#else
+	return disk_read_sectors(pdrv, buff, sector, count);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors from the media, without going through the sector cache.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK or RES_ERROR
+*
+******************************************************************************/
+static DRESULT disk_read_sectors (
+		BYTE pdrv,
+		BYTE *buff,
+		DWORD sector,
+		UINT count
+)
+{
 #ifdef FILE_SYSTEM_INTERFACE_SD
+	s32 Status = XST_FAILURE;
+	DWORD LocSector = sector;
+
 	/* Convert LBA to byte address if needed */
 	if ((SdInstance[pdrv].HCS) == 0U) {
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
@@ -371,6 +476,7 @@ DRESULT disk_read (
 	(void)buff;
 	(void)sector;
 #endif
+	(void)pdrv;
 
     return RES_OK;
 }
@@ -395,7 +501,11 @@ DRESULT disk_ioctl (
 
 	switch (cmd) {
 		case (BYTE)CTRL_SYNC :	/* Make sure that no pending write process */
+#ifdef FILE_SYSTEM_SECTOR_CACHE_SIZE
+			res = disk_cache_flush(pdrv);
+#else
 			res = RES_OK;
+#endif
 			break;
 
 		case (BYTE)GET_SECTOR_COUNT : /* Get number of sectors on the disk (DWORD) */
@@ -417,7 +527,11 @@ DRESULT disk_ioctl (
 #ifdef FILE_SYSTEM_INTERFACE_RAM
 	switch (cmd) {
 	case (BYTE)CTRL_SYNC:
+#ifdef FILE_SYSTEM_SECTOR_CACHE_SIZE
+		res = disk_cache_flush(pdrv);
+#else
 		res = RES_OK;
+#endif
 		break;
 	case (BYTE)GET_BLOCK_SIZE:
 		*(WORD *)buff = BLOCKSIZE;
@@ -494,10 +608,6 @@ DRESULT disk_write (
 )
 {
 	DSTATUS s;
-#ifdef FILE_SYSTEM_INTERFACE_SD
-	s32 Status = XST_FAILURE;
-	DWORD LocSector = sector;
-#endif
 
 	s = disk_status(pdrv);
 	if ((s & STA_NOINIT) != 0U) {
@@ -507,7 +617,37 @@ DRESULT disk_write (
 		return RES_PARERR;
 	}
 
+#ifdef FILE_SYSTEM_SECTOR_CACHE_SIZE
+	return disk_cache_write(pdrv, buff, sector, count);
+#else
+	return disk_write_sectors(pdrv, buff, sector, count);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors to the media, without going through the sector cache.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK or RES_ERROR
+*
+******************************************************************************/
+static DRESULT disk_write_sectors (
+	BYTE pdrv,
+	const BYTE *buff,
+	DWORD sector,
+	UINT count
+)
+{
 #ifdef FILE_SYSTEM_INTERFACE_SD
+	s32 Status = XST_FAILURE;
+	DWORD LocSector = sector;
+
 	/* Convert LBA to byte address if needed */
 	if ((SdInstance[pdrv].HCS) == 0U) {
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
@@ -528,6 +668,455 @@ DRESULT disk_write (
 	(void)buff;
 	(void)sector;
 #endif
+	(void)pdrv;
+
+	return RES_OK;
+}
+
+#ifdef FILE_SYSTEM_SECTOR_CACHE_SIZE
+/*****************************************************************************/
+/**
+*
+* Looks up a sector in the sector cache.
+*
+* @param	pdrv - Drive number
+* @param	sector - Sector number
+*
+* @return	Index of the cache line holding the sector, -1 on a miss
+*
+******************************************************************************/
+static s32 disk_cache_lookup(BYTE pdrv, DWORD sector)
+{
+	u32 Base = (u32)(sector % DISK_CACHE_SETS) * DISK_CACHE_WAYS;
+	u32 Way;
+
+	for (Way = 0U; Way < DISK_CACHE_WAYS; Way++) {
+		if ((CacheLine[Base + Way].Valid != 0U) &&
+			(CacheLine[Base + Way].Sector == sector) &&
+			(CacheLine[Base + Way].Drive == pdrv)) {
+			CacheLine[Base + Way].Stamp = ++CacheClock;
+			return (s32)(Base + Way);
+		}
+	}
+
+	return -1;
+}
+
+/*****************************************************************************/
+/**
+*
+* Learns the FAT area of a volume from its boot sector, so that FAT sectors
+* can be kept in the cache in preference to file data.
+*
+* @param	pdrv - Drive number
+* @param	sector - Sector number of the boot sector
+* @param	*buff - Sector contents
+*
+* @return	1 if the sector is a FAT12/16/32 boot sector, else 0
+*
+******************************************************************************/
+static u32 disk_cache_note_vbr(BYTE pdrv, DWORD sector, const BYTE *buff)
+{
+	DWORD FatSize;
+	DWORD RootSecs;
+	DWORD Reserved;
+
+	if ((buff[0] != 0xEBU) && (buff[0] != 0xE9U)) {
+		return 0U;
+	}
+	/* Bytes per sector and number of FATs */
+	if ((((WORD)buff[12] << 8) | buff[11]) != DISK_SECTOR_SIZE ||
+		(buff[16] == 0U) || (buff[16] > 2U)) {
+		return 0U;
+	}
+
+	Reserved = ((DWORD)buff[15] << 8) | buff[14];
+	FatSize = ((DWORD)buff[23] << 8) | buff[22];
+	if (FatSize == 0U) {
+		FatSize = ((DWORD)buff[39] << 24) | ((DWORD)buff[38] << 16) |
+				((DWORD)buff[37] << 8) | buff[36];
+	}
+	RootSecs = (((((DWORD)buff[18] << 8) | buff[17]) * 32U) +
+			DISK_SECTOR_SIZE - 1U) / DISK_SECTOR_SIZE;
+
+	MetaStart[pdrv] = sector + Reserved;
+	MetaEnd[pdrv] = MetaStart[pdrv] + (FatSize * buff[16]) + RootSecs;
+
+	return 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* Looks for the boot sector of the FAT volume in a sector read from or
+* written to the media. Sector 0 holds either the boot sector of an
+* unpartitioned drive or the MBR, whose partition start sectors are
+* recorded. Only those sectors are checked, so that file data that happens
+* to look like a boot sector cannot move the FAT area.
+*
+* @param	pdrv - Drive number
+* @param	sector - Sector number
+* @param	*buff - Sector contents
+*
+******************************************************************************/
+static void disk_cache_note_sector(BYTE pdrv, DWORD sector, const BYTE *buff)
+{
+	const BYTE *Entry;
+	u32 Part;
+
+	if ((buff[510] != 0x55U) || (buff[511] != 0xAAU)) {
+		return;
+	}
+
+	if (sector == 0U) {
+		(void)memset(PartStart[pdrv], 0, sizeof(PartStart[pdrv]));
+		if (disk_cache_note_vbr(pdrv, sector, buff) != 0U) {
+			return;
+		}
+		for (Part = 0U; Part < DISK_MBR_ENTRIES; Part++) {
+			Entry = buff + DISK_MBR_TABLE + (Part * DISK_MBR_ENTRY_SIZE);
+			/* Partition type 0 is an unused entry */
+			if (Entry[4] != 0U) {
+				PartStart[pdrv][Part] = ((DWORD)Entry[11] << 24) |
+					((DWORD)Entry[10] << 16) |
+					((DWORD)Entry[9] << 8) | Entry[8];
+			}
+		}
+		return;
+	}
+
+	for (Part = 0U; Part < DISK_MBR_ENTRIES; Part++) {
+		if (PartStart[pdrv][Part] == sector) {
+			(void)disk_cache_note_vbr(pdrv, sector, buff);
+			break;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes back a dirty cache line.
+*
+* @param	Line - Cache line index
+*
+* @return	RES_OK or RES_ERROR
+*
+******************************************************************************/
+static DRESULT disk_cache_clean(u32 Line)
+{
+	DRESULT res = RES_OK;
+
+	if (CacheLine[Line].Dirty != 0U) {
+		res = disk_write_sectors(CacheLine[Line].Drive, CacheData[Line],
+					CacheLine[Line].Sector, 1U);
+		if (res == RES_OK) {
+			CacheLine[Line].Dirty = 0U;
+		}
+	}
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Allocates a cache line for a sector that is not in the cache. Free lines
+* are used first, then the least recently used non-FAT line, then the least
+* recently used line. A dirty victim is written back first.
+*
+* @param	pdrv - Drive number
+* @param	sector - Sector number
+* @param	*Line - Allocated cache line index
+*
+* @return	RES_OK or RES_ERROR
+*
+******************************************************************************/
+static DRESULT disk_cache_alloc(BYTE pdrv, DWORD sector, u32 *Line)
+{
+	u32 Base = (u32)(sector % DISK_CACHE_SETS) * DISK_CACHE_WAYS;
+	u32 Victim = Base;
+	u32 Way;
+	u32 Index;
+	u32 VictimAge = 0U;
+	u32 VictimMeta = 1U;
+	DRESULT res;
+
+	for (Way = 0U; Way < DISK_CACHE_WAYS; Way++) {
+		Index = Base + Way;
+		if (CacheLine[Index].Valid == 0U) {
+			Victim = Index;
+			break;
+		}
+		/* Prefer non-FAT lines, then the oldest one */
+		if ((CacheLine[Index].Meta < VictimMeta) ||
+			((CacheLine[Index].Meta == VictimMeta) &&
+			 ((CacheClock - CacheLine[Index].Stamp) >= VictimAge))) {
+			Victim = Index;
+			VictimMeta = CacheLine[Index].Meta;
+			VictimAge = CacheClock - CacheLine[Index].Stamp;
+		}
+	}
+
+	if (CacheLine[Victim].Valid != 0U) {
+		res = disk_cache_clean(Victim);
+		if (res != RES_OK) {
+			return res;
+		}
+	}
+
+	CacheLine[Victim].Sector = sector;
+	CacheLine[Victim].Drive = pdrv;
+	CacheLine[Victim].Valid = 1U;
+	CacheLine[Victim].Dirty = 0U;
+	CacheLine[Victim].Meta = ((sector >= MetaStart[pdrv]) &&
+				(sector < MetaEnd[pdrv])) ? 1U : 0U;
+	CacheLine[Victim].Stamp = ++CacheClock;
+	*Line = Victim;
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors through the sector cache. Cached sectors are copied from the
+* cache; runs of missing sectors are read from the media with one command
+* each. Large requests are read from the media directly and only patched
+* with sectors that are dirty in the cache.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK or RES_ERROR
+*
+******************************************************************************/
+static DRESULT disk_cache_read(BYTE pdrv, BYTE *buff, DWORD sector,
+				UINT count)
+{
+	DRESULT res;
+	UINT Index = 0U;
+	UINT Run;
+	UINT Cnt;
+	s32 Line;
+	u32 NewLine;
+
+	if (count >= DISK_CACHE_BYPASS) {
+		res = disk_read_sectors(pdrv, buff, sector, count);
+		if (res != RES_OK) {
+			return res;
+		}
+		for (Cnt = 0U; Cnt < count; Cnt++) {
+			Line = disk_cache_lookup(pdrv, sector + Cnt);
+			if ((Line >= 0) && (CacheLine[Line].Dirty != 0U)) {
+				(void)memcpy(buff + (Cnt * DISK_SECTOR_SIZE),
+					CacheData[Line], DISK_SECTOR_SIZE);
+			}
+		}
+		return RES_OK;
+	}
+
+	while (Index < count) {
+		Line = disk_cache_lookup(pdrv, sector + Index);
+		if (Line >= 0) {
+			(void)memcpy(buff + (Index * DISK_SECTOR_SIZE),
+				CacheData[Line], DISK_SECTOR_SIZE);
+			Index++;
+			continue;
+		}
+
+		/* Read the whole run of missing sectors with one command */
+		Run = 1U;
+		while (((Index + Run) < count) &&
+			(disk_cache_lookup(pdrv, sector + Index + Run) < 0)) {
+			Run++;
+		}
+		res = disk_read_sectors(pdrv, buff + (Index * DISK_SECTOR_SIZE),
+					sector + Index, Run);
+		if (res != RES_OK) {
+			return res;
+		}
+
+		for (Cnt = Index; Cnt < (Index + Run); Cnt++) {
+			disk_cache_note_sector(pdrv, sector + Cnt,
+					buff + (Cnt * DISK_SECTOR_SIZE));
+			res = disk_cache_alloc(pdrv, sector + Cnt, &NewLine);
+			if (res != RES_OK) {
+				return res;
+			}
+			(void)memcpy(CacheData[NewLine],
+				buff + (Cnt * DISK_SECTOR_SIZE), DISK_SECTOR_SIZE);
+		}
+		Index += Run;
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors through the sector cache. Small writes only update the
+* cache; large writes go to the media directly and refresh any cached copy
+* once the media write has succeeded. If it fails, the cached copies are left
+* as they were so that dirty sectors are not lost.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK or RES_ERROR
+*
+******************************************************************************/
+static DRESULT disk_cache_write(BYTE pdrv, const BYTE *buff, DWORD sector,
+				UINT count)
+{
+	DRESULT res;
+	UINT Cnt;
+	s32 Line;
+	u32 NewLine;
+
+	if (count >= DISK_CACHE_BYPASS) {
+		res = disk_write_sectors(pdrv, buff, sector, count);
+		if (res != RES_OK) {
+			return res;
+		}
+		for (Cnt = 0U; Cnt < count; Cnt++) {
+			Line = disk_cache_lookup(pdrv, sector + Cnt);
+			if (Line >= 0) {
+				(void)memcpy(CacheData[Line],
+					buff + (Cnt * DISK_SECTOR_SIZE), DISK_SECTOR_SIZE);
+				CacheLine[Line].Dirty = 0U;
+			}
+		}
+		return RES_OK;
+	}
+
+	for (Cnt = 0U; Cnt < count; Cnt++) {
+		disk_cache_note_sector(pdrv, sector + Cnt,
+				buff + (Cnt * DISK_SECTOR_SIZE));
+		Line = disk_cache_lookup(pdrv, sector + Cnt);
+		if (Line < 0) {
+			res = disk_cache_alloc(pdrv, sector + Cnt, &NewLine);
+			if (res != RES_OK) {
+				return res;
+			}
+			Line = (s32)NewLine;
+		}
+		(void)memcpy(CacheData[Line], buff + (Cnt * DISK_SECTOR_SIZE),
+				DISK_SECTOR_SIZE);
+		CacheLine[Line].Dirty = 1U;
+	}
 
 	return RES_OK;
 }
+
+/*****************************************************************************/
+/**
+*
+* Writes back all dirty sectors of a drive. The dirty sectors are sorted by
+* sector number and runs of adjacent sectors are written with one
+* multi-block command each.
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK or RES_ERROR
+*
+******************************************************************************/
+static DRESULT disk_cache_flush(BYTE pdrv)
+{
+	DRESULT res;
+	u32 Line;
+	u32 NumDirty = 0U;
+	u32 Index;
+	u32 Pos;
+	u32 Run;
+	u16 Tmp;
+
+	for (Line = 0U; Line < FILE_SYSTEM_SECTOR_CACHE_SIZE; Line++) {
+		if ((CacheLine[Line].Valid != 0U) && (CacheLine[Line].Dirty != 0U) &&
+			(CacheLine[Line].Drive == pdrv)) {
+			/* Insertion sort by sector number */
+			Tmp = (u16)Line;
+			Pos = NumDirty;
+			while ((Pos > 0U) && (CacheLine[CacheFlushList[Pos - 1U]].Sector >
+					CacheLine[Tmp].Sector)) {
+				CacheFlushList[Pos] = CacheFlushList[Pos - 1U];
+				Pos--;
+			}
+			CacheFlushList[Pos] = Tmp;
+			NumDirty++;
+		}
+	}
+
+	Index = 0U;
+	while (Index < NumDirty) {
+		Run = 1U;
+		while (((Index + Run) < NumDirty) && (Run < DISK_CACHE_MERGE_MAX) &&
+			(CacheLine[CacheFlushList[Index + Run]].Sector ==
+			 (CacheLine[CacheFlushList[Index]].Sector + Run))) {
+			Run++;
+		}
+
+		if (Run == 1U) {
+			res = disk_cache_clean(CacheFlushList[Index]);
+		} else {
+			for (Pos = 0U; Pos < Run; Pos++) {
+				(void)memcpy(CacheMergeBuf + (Pos * DISK_SECTOR_SIZE),
+					CacheData[CacheFlushList[Index + Pos]],
+					DISK_SECTOR_SIZE);
+			}
+			res = disk_write_sectors(pdrv, CacheMergeBuf,
+				CacheLine[CacheFlushList[Index]].Sector, Run);
+			if (res == RES_OK) {
+				for (Pos = 0U; Pos < Run; Pos++) {
+					CacheLine[CacheFlushList[Index + Pos]].Dirty = 0U;
+				}
+			}
+		}
+		if (res != RES_OK) {
+			return res;
+		}
+		Index += Run;
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Drops all cached sectors of a drive. Dirty sectors are written back first
+* and nothing is dropped if that fails.
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK or the error returned by the write-back
+*
+******************************************************************************/
+static DRESULT disk_cache_invalidate(BYTE pdrv)
+{
+	DRESULT res;
+	u32 Line;
+
+	res = disk_cache_flush(pdrv);
+	if (res != RES_OK) {
+		return res;
+	}
+
+	for (Line = 0U; Line < FILE_SYSTEM_SECTOR_CACHE_SIZE; Line++) {
+		if (CacheLine[Line].Drive == pdrv) {
+			CacheLine[Line].Valid = 0U;
+			CacheLine[Line].Dirty = 0U;
+		}
+	}
+	MetaStart[pdrv] = 0U;
+	MetaEnd[pdrv] = 0U;
+	(void)memset(PartStart[pdrv], 0, sizeof(PartStart[pdrv]));
+
+	return RES_OK;
+}
+#endif
@@ -62,7 +62,11 @@ extern "C" {
 /* This option switches f_mkfs() function. (0:Disable or 1:Enable) */
 
 
-#define FF_USE_FASTSEEK	0
+#ifdef FILE_SYSTEM_USE_FASTSEEK
+#define FF_USE_FASTSEEK	1	/* 1:Enable */
+#else
+#define FF_USE_FASTSEEK	0	/* 0:Disable */
+#endif
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
 
@@ -0,0 +1,347 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Host test of the write-back sector cache of diskio.c.
+ *
+ * diskio.c is built for the SD interface against the stand-in xsdps.h of
+ * this directory. The SD driver functions below keep the card in a RAM
+ * array and log every read and write command, so that the test can check
+ * which commands the cache issues and in which order.
+ *
+ * Checked are that small writes stay in the cache until CTRL_SYNC, that
+ * the write-back is sorted by sector and merges adjacent sectors into
+ * commands of up to 32 sectors, that dirty sectors are kept and written
+ * again after a failed write-back, that reads see dirty sectors, that
+ * large writes go straight to the card and supersede cached copies, and
+ * that the FAT area is only learnt from sector 0 and the partition boot
+ * sectors of the MBR, not from file data that looks like a boot sector.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xparameters.h"
+#include "diskio.h"
+#include "xsdps.h"
+
+#define SECTOR_SIZE	512U
+#define NUM_SECTORS	512U
+#define MAX_CMDS	64U
+
+#define PART_START	64U	/* Partition start sector in the MBR */
+#define FAT_START	(PART_START + 2U)
+#define NUM_SETS	(FILE_SYSTEM_SECTOR_CACHE_SIZE / 4U)
+
+#define CHECK(Cond)	do { \
+	if (!(Cond)) { \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Cond); \
+		exit(EXIT_FAILURE); \
+	} \
+} while (0)
+
+typedef struct {
+	char Op;
+	u32 Sector;
+	u32 Count;
+} Cmd;
+
+static BYTE Card[NUM_SECTORS][SECTOR_SIZE];
+static Cmd Cmds[MAX_CMDS];
+static u32 NumCmds;
+static u32 FailWrites;
+static XSdPs_Config SdConfig = {0U, 0xFF160000U, 0U, 0U};
+
+static void Log(char Op, u32 Sector, u32 Count)
+{
+	CHECK(NumCmds < MAX_CMDS);
+	Cmds[NumCmds].Op = Op;
+	Cmds[NumCmds].Sector = Sector;
+	Cmds[NumCmds].Count = Count;
+	NumCmds++;
+}
+
+u32 XSdPs_ReadReg(u32 BaseAddress, u32 RegOffset)
+{
+	(void)BaseAddress;
+
+	switch (RegOffset) {
+	case XSDPS_POWER_CTRL_OFFSET:
+		return XSDPS_PC_BUS_PWR_MASK;
+	case XSDPS_HOST_CTRL_VER_OFFSET:
+		return XSDPS_HC_SPEC_V3;
+	case XSDPS_CAPS_OFFSET:
+		return XSDPS_CAPS_EMB_SLOT;
+	default:
+		return 0U;
+	}
+}
+
+XSdPs_Config *XSdPs_LookupConfig(u16 DeviceId)
+{
+	return (DeviceId == 0U) ? &SdConfig : NULL;
+}
+
+s32 XSdPs_CfgInitialize(XSdPs *InstancePtr, XSdPs_Config *ConfigPtr,
+				u32 EffectiveAddr)
+{
+	InstancePtr->Config = *ConfigPtr;
+	InstancePtr->Config.BaseAddress = EffectiveAddr;
+	InstancePtr->IsReady = 1U;
+
+	return XST_SUCCESS;
+}
+
+s32 XSdPs_CardInitialize(XSdPs *InstancePtr)
+{
+	InstancePtr->HCS = 1U;
+	InstancePtr->SectorCount = NUM_SECTORS;
+
+	return XST_SUCCESS;
+}
+
+s32 XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
+{
+	(void)InstancePtr;
+	CHECK((Arg + BlkCnt) <= NUM_SECTORS);
+	Log('R', Arg, BlkCnt);
+	(void)memcpy(Buff, Card[Arg], BlkCnt * SECTOR_SIZE);
+
+	return XST_SUCCESS;
+}
+
+s32 XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt,
+				const u8 *Buff)
+{
+	(void)InstancePtr;
+	CHECK((Arg + BlkCnt) <= NUM_SECTORS);
+	Log('W', Arg, BlkCnt);
+	if (FailWrites != 0U) {
+		return XST_FAILURE;
+	}
+	(void)memcpy(Card[Arg], Buff, BlkCnt * SECTOR_SIZE);
+
+	return XST_SUCCESS;
+}
+
+static void CheckCmd(u32 Index, char Op, u32 Sector, u32 Count)
+{
+	CHECK(Index < NumCmds);
+	CHECK(Cmds[Index].Op == Op);
+	CHECK(Cmds[Index].Sector == Sector);
+	CHECK(Cmds[Index].Count == Count);
+}
+
+/* Sector contents: the sector number and a generation in every word */
+static void Fill(BYTE *Buff, u32 Sector, u32 Gen)
+{
+	u32 Word = (Sector << 8) | Gen;
+	u32 Off;
+
+	for (Off = 0U; Off < SECTOR_SIZE; Off += 4U) {
+		(void)memcpy(Buff + Off, &Word, 4U);
+	}
+}
+
+static u32 Holds(const BYTE *Buff, u32 Sector, u32 Gen)
+{
+	BYTE Expected[SECTOR_SIZE];
+
+	Fill(Expected, Sector, Gen);
+
+	return (memcmp(Buff, Expected, SECTOR_SIZE) == 0) ? 1U : 0U;
+}
+
+static void WriteOne(u32 Sector, u32 Gen)
+{
+	BYTE Buff[SECTOR_SIZE];
+
+	Fill(Buff, Sector, Gen);
+	CHECK(disk_write(0U, Buff, Sector, 1U) == RES_OK);
+}
+
+static void ReadOne(u32 Sector, BYTE *Buff)
+{
+	CHECK(disk_read(0U, Buff, Sector, 1U) == RES_OK);
+}
+
+static DRESULT Sync(void)
+{
+	return disk_ioctl(0U, CTRL_SYNC, NULL);
+}
+
+/* FAT boot sector with two FATs of FatSize sectors after the reserved ones */
+static void MakeVbr(BYTE *Buff, u32 Reserved, u32 FatSize)
+{
+	(void)memset(Buff, 0, SECTOR_SIZE);
+	Buff[0] = 0xEBU;
+	Buff[11] = (BYTE)(SECTOR_SIZE & 0xFFU);
+	Buff[12] = (BYTE)(SECTOR_SIZE >> 8);
+	Buff[14] = (BYTE)Reserved;
+	Buff[16] = 2U;
+	Buff[22] = (BYTE)FatSize;
+	Buff[510] = 0x55U;
+	Buff[511] = 0xAAU;
+}
+
+static void TestFatArea(void)
+{
+	BYTE Buff[SECTOR_SIZE];
+	u32 Way;
+
+	/* MBR with one partition at PART_START, its FATs are sectors 66..73 */
+	(void)memset(Card[0], 0, SECTOR_SIZE);
+	Card[0][0] = 0xFAU;
+	Card[0][446U + 4U] = 0x0CU;
+	Card[0][446U + 8U] = (BYTE)PART_START;
+	Card[0][510] = 0x55U;
+	Card[0][511] = 0xAAU;
+	MakeVbr(Card[PART_START], 2U, 4U);
+	/* File data that looks like a boot sector with its FAT at 301 */
+	MakeVbr(Card[300], 1U, 1U);
+
+	ReadOne(0U, Buff);
+	ReadOne(PART_START, Buff);
+	ReadOne(300U, Buff);
+	ReadOne(FAT_START, Buff);
+
+	/* Fill the set of the FAT sector with file data sectors */
+	for (Way = 1U; Way <= 4U; Way++) {
+		ReadOne(FAT_START + (Way * NUM_SETS), Buff);
+	}
+	NumCmds = 0U;
+
+	/* The FAT sector is kept in preference to file data */
+	ReadOne(FAT_START, Buff);
+	CHECK(NumCmds == 0U);
+	CHECK(memcmp(Buff, Card[FAT_START], SECTOR_SIZE) == 0);
+}
+
+static void TestFlushOrder(void)
+{
+	BYTE Buff[SECTOR_SIZE];
+	u32 Sector;
+
+	/* Small writes stay in the cache until CTRL_SYNC */
+	NumCmds = 0U;
+	WriteOne(10U, 1U);
+	WriteOne(7U, 1U);
+	WriteOne(9U, 1U);
+	WriteOne(8U, 1U);
+	WriteOne(20U, 1U);
+	WriteOne(22U, 1U);
+	CHECK(NumCmds == 0U);
+	CHECK(!Holds(Card[8], 8U, 1U));
+
+	/* Reads of dirty sectors are served from the cache */
+	ReadOne(9U, Buff);
+	CHECK(NumCmds == 0U);
+	CHECK(Holds(Buff, 9U, 1U));
+
+	/* Sorted by sector, adjacent sectors merged into one command */
+	CHECK(Sync() == RES_OK);
+	CHECK(NumCmds == 3U);
+	CheckCmd(0U, 'W', 7U, 4U);
+	CheckCmd(1U, 'W', 20U, 1U);
+	CheckCmd(2U, 'W', 22U, 1U);
+	for (Sector = 7U; Sector <= 10U; Sector++) {
+		CHECK(Holds(Card[Sector], Sector, 1U));
+	}
+	CHECK(Holds(Card[20], 20U, 1U));
+	CHECK(Holds(Card[22], 22U, 1U));
+
+	/* Nothing is left to write back */
+	NumCmds = 0U;
+	CHECK(Sync() == RES_OK);
+	CHECK(NumCmds == 0U);
+
+	/* Runs longer than 32 sectors are split */
+	for (Sector = 239U; Sector >= 200U; Sector--) {
+		WriteOne(Sector, 2U);
+	}
+	CHECK(NumCmds == 0U);
+	CHECK(Sync() == RES_OK);
+	CHECK(NumCmds == 2U);
+	CheckCmd(0U, 'W', 200U, 32U);
+	CheckCmd(1U, 'W', 232U, 8U);
+	for (Sector = 200U; Sector < 240U; Sector++) {
+		CHECK(Holds(Card[Sector], Sector, 2U));
+	}
+}
+
+static void TestFailedFlush(void)
+{
+	BYTE Buff[SECTOR_SIZE];
+
+	NumCmds = 0U;
+	WriteOne(40U, 3U);
+	WriteOne(41U, 3U);
+
+	/* A failed write-back keeps the sectors dirty */
+	FailWrites = 1U;
+	CHECK(Sync() == RES_ERROR);
+	CHECK(NumCmds == 1U);
+	CheckCmd(0U, 'W', 40U, 2U);
+	FailWrites = 0U;
+	ReadOne(41U, Buff);
+	CHECK(Holds(Buff, 41U, 3U));
+
+	CHECK(Sync() == RES_OK);
+	CHECK(NumCmds == 2U);
+	CheckCmd(1U, 'W', 40U, 2U);
+	CHECK(Holds(Card[40], 40U, 3U));
+	CHECK(Holds(Card[41], 41U, 3U));
+}
+
+static void TestLargeRequests(void)
+{
+	BYTE Buff[12U * SECTOR_SIZE];
+	u32 Sector;
+
+	/* Large reads go to the card and are patched with dirty sectors */
+	for (Sector = 28U; Sector < 40U; Sector++) {
+		Fill(Card[Sector], Sector, 4U);
+	}
+	NumCmds = 0U;
+	WriteOne(30U, 5U);
+	CHECK(disk_read(0U, Buff, 28U, 12U) == RES_OK);
+	CHECK(NumCmds == 1U);
+	CheckCmd(0U, 'R', 28U, 12U);
+	CHECK(Holds(Buff, 28U, 4U));
+	CHECK(Holds(Buff + (2U * SECTOR_SIZE), 30U, 5U));
+	CHECK(Holds(Buff + (11U * SECTOR_SIZE), 39U, 4U));
+
+	/*
+	 * Large writes go straight to the card and supersede the cached copy,
+	 * the older dirty sector must not be written back over them
+	 */
+	for (Sector = 0U; Sector < 8U; Sector++) {
+		Fill(Buff + (Sector * SECTOR_SIZE), 28U + Sector, 6U);
+	}
+	CHECK(disk_write(0U, Buff, 28U, 8U) == RES_OK);
+	CHECK(NumCmds == 2U);
+	CheckCmd(1U, 'W', 28U, 8U);
+	CHECK(Sync() == RES_OK);
+	CHECK(NumCmds == 2U);
+	CHECK(Holds(Card[30], 30U, 6U));
+	ReadOne(30U, Buff);
+	CHECK(NumCmds == 2U);
+	CHECK(Holds(Buff, 30U, 6U));
+}
+
+int main(void)
+{
+	CHECK(disk_initialize(0U) == 0U);
+
+	TestFatArea();
+	TestFlushOrder();
+	TestFailedFlush();
+	TestLargeRequests();
+
+	printf("Sector cache: all checks passed\n");
+
+	return EXIT_SUCCESS;
+}
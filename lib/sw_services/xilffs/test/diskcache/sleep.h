@@ -0,0 +1,20 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test/diskcache/sleep.h
+*
+* Host replacement of the standalone sleep.h. usleep is provided by the
+* host C library.
+*
+******************************************************************************/
+#ifndef SLEEP_H
+#define SLEEP_H
+
+#include <unistd.h>
+
+#endif /* SLEEP_H */
@@ -0,0 +1,27 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test/diskcache/xparameters.h
+*
+* xilffs options of the host test, as generated by xilffs.tcl for an SD
+* interface with a sector cache.
+*
+******************************************************************************/
+#ifndef XPARAMETERS_H
+#define XPARAMETERS_H
+
+#define STDOUT_BASEADDRESS		0xFF000000U
+#define FILE_SYSTEM_INTERFACE_SD
+#define FILE_SYSTEM_USE_MKFS
+#define FILE_SYSTEM_NUM_LOGIC_VOL	2
+#define FILE_SYSTEM_USE_STRFUNC		0
+#define FILE_SYSTEM_SET_FS_RPATH	0
+#define FILE_SYSTEM_WORD_ACCESS
+#define FILE_SYSTEM_SECTOR_CACHE_SIZE	64
+
+#endif /* XPARAMETERS_H */
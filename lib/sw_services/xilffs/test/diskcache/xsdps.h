@@ -0,0 +1,68 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test/diskcache/xsdps.h
+*
+* Host stand-in for the SD driver. It declares the part of the XSdPs API
+* used by diskio.c; diskcache_test.c implements it on a RAM disk and records
+* the read and write commands. The register values are those of an embedded
+* slot that is powered up.
+*
+******************************************************************************/
+#ifndef SDPS_H_
+#define SDPS_H_
+
+#include "xil_types.h"
+#include "xstatus.h"
+
+#define XSDPS_PRES_STATE_OFFSET		0x24U
+#define XSDPS_POWER_CTRL_OFFSET		0x29U
+#define XSDPS_CAPS_OFFSET		0x40U
+#define XSDPS_HOST_CTRL_VER_OFFSET	0xFEU
+#define XSDPS_PC_BUS_PWR_MASK		0x00000001U
+#define XSDPS_CAPS_SLOT_TYPE_MASK	0xC0000000U
+#define XSDPS_CAPS_EMB_SLOT		0x40000000U
+#define XSDPS_PSR_CARD_INSRT_MASK	0x00010000U
+#define XSDPS_PSR_CARD_STABLE_MASK	0x00020000U
+#define XSDPS_PSR_CARD_DPL_MASK		0x00040000U
+#define XSDPS_PSR_WPS_PL_MASK		0x00080000U
+#define XSDPS_HC_SPEC_VER_MASK		0x00FFU
+#define XSDPS_HC_SPEC_V3		0x0002U
+#define XSDPS_BLK_SIZE_512_MASK		0x200U
+
+typedef struct {
+	u16 DeviceId;
+	u32 BaseAddress;
+	u32 CardDetect;
+	u32 WriteProtect;
+} XSdPs_Config;
+
+typedef struct {
+	XSdPs_Config Config;
+	u32 IsReady;
+	u32 HCS;
+	u32 SectorCount;
+} XSdPs;
+
+u32 XSdPs_ReadReg(u32 BaseAddress, u32 RegOffset);
+#define XSdPs_ReadReg16(BaseAddress, RegOffset) \
+	((u16)XSdPs_ReadReg((BaseAddress), (RegOffset)))
+#define XSdPs_ReadReg8(BaseAddress, RegOffset) \
+	((u8)XSdPs_ReadReg((BaseAddress), (RegOffset)))
+#define XSdPs_GetPresentStatusReg(BaseAddress) \
+	XSdPs_ReadReg((BaseAddress), XSDPS_PRES_STATE_OFFSET)
+
+XSdPs_Config *XSdPs_LookupConfig(u16 DeviceId);
+s32 XSdPs_CfgInitialize(XSdPs *InstancePtr, XSdPs_Config *ConfigPtr,
+				u32 EffectiveAddr);
+s32 XSdPs_CardInitialize(XSdPs *InstancePtr);
+s32 XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff);
+s32 XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt,
+				const u8 *Buff);
+
+#endif /* SDPS_H_ */
@@ -74,6 +74,7 @@
 *       kpt  10/19/2020 Renamed XLoader_UpdateKekRdKeyStatus to
 *                       XLoader_UpdateKekSrc
 *       td	 10/19/2020 MISRA C Fixes
+* 1.03  agent 10/17/2026 Added subsystem restart from the DDR image cache
 *
 * </pre>
 *
@@ -101,6 +102,7 @@
 #include "xplmi_err.h"
 #include "xplmi_event_logging.h"
 #include "xplmi_wdt.h"
+#include "xloader_img_cache.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -643,6 +645,13 @@ static int XLoader_LoadAndStartSubSystemImages(XilPdi *PdiPtr)
 		PdiPtr->DelayLoad = XilPdi_GetDelayLoad(
 			&PdiPtr->MetaHdr.ImgHdr[PdiPtr->ImageNum]) >>
 			XILPDI_IH_ATTRIB_DELAY_LOAD_SHIFT;
+#ifdef PLM_ENABLE_IMAGE_CACHE
+		if ((PdiPtr->PdiType == XLOADER_PDI_TYPE_FULL) &&
+			(PdiPtr->CopyToMem == (u8)FALSE) &&
+			(PdiPtr->DelayLoad == (u8)FALSE)) {
+			XLoader_ImgCacheAlloc(PdiPtr, &DdrRequested);
+		}
+#endif
 
 		if (PdiPtr->DelayHandoff == (u8)TRUE) {
 			if (PdiPtr->DelayLoad == (u8)TRUE) {
@@ -676,6 +685,9 @@ static int XLoader_LoadAndStartSubSystemImages(XilPdi *PdiPtr)
 			}
 			goto END;
 		}
+#ifdef PLM_ENABLE_IMAGE_CACHE
+		XLoader_ImgCacheStore(PdiPtr);
+#endif
 
 		if ((PdiPtr->DelayLoad == (u8)TRUE) ||
 			(PdiPtr->DelayHandoff == (u8)TRUE)) {
@@ -1385,7 +1397,7 @@ static int XLoader_LoadImage(XilPdi *PdiPtr)
 		}
 	}
 	/* Log the image load to the Trace Log buffer */
-	XPlmi_TraceLog3(XPLMI_TRACE_LOG_LOAD_IMAGE, PdiPtr->CurImgId);
+	XPlmi_TraceLog3((u32)XPLMI_TRACE_LOG_LOAD_IMAGE, PdiPtr->CurImgId);
 
 #if defined(XPLM_SEM) && defined(XSEM_CFRSCAN_EN)
 	/* Resume the SEM scan after PL load */
@@ -1492,6 +1504,19 @@ static int XLoader_ReloadImage(u32 ImageId, u32 *FuncID)
 		PdiPtr->CopyToMemAddr =
 				PdiPtr->MetaHdr.ImgHdr[PdiPtr->ImageNum].CopyToMemoryAddr;
 	}
+#ifdef PLM_ENABLE_IMAGE_CACHE
+	else if (XLoader_ImgCacheLookup(PdiPtr) == (u8)TRUE) {
+		PdiPtr->PdiSrc = XLOADER_PDI_SRC_DDR;
+		UPdiSrc = (u32)(PdiPtr->PdiSrc);
+		DeviceFlags = UPdiSrc & XLOADER_PDISRC_FLAGS_MASK;
+		PdiPtr->PdiType = XLOADER_PDI_TYPE_RESTORE;
+	}
+#endif
+	else {
+		/*
+		 * MISRA-C compliance
+		 */
+	}
 	PdiPtr->DelayHandoff = (u16)FALSE;
 	PdiPtr->DelayLoad = (u8)FALSE;
 
@@ -0,0 +1,258 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xloader_img_cache.c
+*
+* This file contains the DDR image cache used for subsystem restart. While
+* the boot PDI is loaded, every subsystem image is copied to a reserved DDR
+* region using the CopyToMemory flow and the SHA3 hash of the copy is
+* recorded. A restart of the subsystem then loads the image from DDR once
+* the hash of the copy is verified, instead of reading the boot device.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agent 10/17/2026 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xloader_img_cache.h"
+#ifdef PLM_ENABLE_IMAGE_CACHE
+#include "xloader_secure.h"
+#include "xplmi_dma.h"
+#include "xpm_api.h"
+#include "xpm_node.h"
+#include "xpm_nodeid.h"
+#include "xil_util.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u32 ImgID; /**< Image ID of the cached image */
+	u32 Len; /**< Length of the cached image in bytes */
+	u64 Addr; /**< DDR address of the cached image */
+	u8 IsValid; /**< TRUE if the cached image can be used */
+	XSecure_Sha3Hash Sha3Hash; /**< Hash of the cached image */
+} XLoader_ImgCacheEntry;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static int XLoader_ImgCacheHash(u64 Addr, u32 Len, XSecure_Sha3Hash *Sha3Hash);
+
+/************************** Variable Definitions *****************************/
+static XLoader_ImgCacheEntry ImgCache[XLOADER_IMAGE_CACHE_MAX_NUM];
+static u32 ImgCacheCnt = 0U;
+static u64 ImgCacheNextAddr = XLOADER_IMAGE_CACHE_ADDR;
+static u8 ImgCachePending = (u8)FALSE;
+
+/*****************************************************************************/
+/**
+ * @brief	This function calculates the SHA3 hash of a cached image.
+ *
+ * @param	Addr is the DDR address of the cached image
+ * @param	Len is the length of the cached image in bytes
+ * @param	Sha3Hash is pointer to the calculated hash
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XLoader_ImgCacheHash(u64 Addr, u32 Len, XSecure_Sha3Hash *Sha3Hash)
+{
+	int Status = XST_FAILURE;
+	XSecure_Sha3 Sha3Instance;
+	XPmcDma *PmcDmaPtr = XPlmi_GetDmaInstance((u32)PMCDMA_0_DEVICE_ID);
+
+	if (PmcDmaPtr == NULL) {
+		goto END;
+	}
+
+	Status = XSecure_Sha3Initialize(&Sha3Instance, PmcDmaPtr);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	Status = XSecure_Sha3Digest(&Sha3Instance, (UINTPTR)Addr, Len, Sha3Hash);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function reserves space in the image cache for the current
+ * image of the boot PDI and makes the loader copy the image there before
+ * loading it. Only subsystem images other than the PMC subsystem are cached.
+ * The image is not cached if it does not fit in the remaining space or if
+ * DDR can not be requested, the image is then loaded as usual.
+ *
+ * @param	PdiPtr is pointer to the XilPdi instance
+ * @param	DdrRequested is set to TRUE once DDR is requested for PMC
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XLoader_ImgCacheAlloc(XilPdi *PdiPtr, u8 *DdrRequested)
+{
+	int Status = XST_FAILURE;
+	const XilPdi_ImgHdr *ImgHdr = &PdiPtr->MetaHdr.ImgHdr[PdiPtr->ImageNum];
+	XLoader_ImgCacheEntry *Entry;
+	u64 Len = 0U;
+	u32 PrtnIndex;
+	u32 Pm_CapAccess = (u32)PM_CAP_ACCESS;
+	u32 Pm_CapContext = (u32)PM_CAP_CONTEXT;
+
+	ImgCachePending = (u8)FALSE;
+	if ((PdiPtr != BootPdiPtr) ||
+		(ImgCacheCnt == XLOADER_IMAGE_CACHE_MAX_NUM) ||
+		(NODECLASS(ImgHdr->ImgID) != (u32)XPM_NODECLASS_SUBSYSTEM) ||
+		(ImgHdr->ImgID == PM_SUBSYS_PMC)) {
+		goto END;
+	}
+
+	for (PrtnIndex = 0U; PrtnIndex < ImgHdr->NoOfPrtns; ++PrtnIndex) {
+		Len += (u64)PdiPtr->MetaHdr.PrtnHdr[PdiPtr->PrtnNum +
+			PrtnIndex].TotalDataWordLen * XIH_PRTN_WORD_LEN;
+	}
+	if (Len > ((u64)XLOADER_IMAGE_CACHE_ADDR + XLOADER_IMAGE_CACHE_SIZE -
+		ImgCacheNextAddr)) {
+		XPlmi_Printf(DEBUG_INFO, "Image 0x%08x does not fit in image cache\n\r",
+			ImgHdr->ImgID);
+		goto END;
+	}
+
+	if (*DdrRequested == (u8)FALSE) {
+		Status = XPm_RequestDevice(PM_SUBSYS_PMC, PM_DEV_DDR_0,
+			Pm_CapAccess | Pm_CapContext, XPM_DEF_QOS, 0U);
+		if (Status != XST_SUCCESS) {
+			XPlmi_Printf(DEBUG_INFO, "DDR not available for image cache\n\r");
+			goto END;
+		}
+		*DdrRequested = (u8)TRUE;
+	}
+
+	Entry = &ImgCache[ImgCacheCnt];
+	Entry->ImgID = ImgHdr->ImgID;
+	Entry->Addr = ImgCacheNextAddr;
+	Entry->Len = 0U;
+	Entry->IsValid = (u8)FALSE;
+	ImgCachePending = (u8)TRUE;
+
+	PdiPtr->CopyToMem = (u8)TRUE;
+	PdiPtr->CopyToMemAddr = ImgCacheNextAddr;
+
+END:
+	return;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function records the image copied to the image cache by
+ * the last load. It must be called after the image is loaded successfully.
+ * If the hash of the copy can not be calculated, the image is not cached.
+ *
+ * @param	PdiPtr is pointer to the XilPdi instance
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XLoader_ImgCacheStore(const XilPdi *PdiPtr)
+{
+	int Status = XST_FAILURE;
+	XLoader_ImgCacheEntry *Entry = &ImgCache[ImgCacheCnt];
+	u64 Len;
+
+	if (ImgCachePending == (u8)FALSE) {
+		goto END;
+	}
+	ImgCachePending = (u8)FALSE;
+
+	Len = PdiPtr->CopyToMemAddr - Entry->Addr;
+	Status = XLoader_ImgCacheHash(Entry->Addr, (u32)Len, &Entry->Sha3Hash);
+	if (Status != XST_SUCCESS) {
+		XPlmi_Printf(DEBUG_GENERAL, "Image 0x%08x not cached, error: 0x%x\n\r",
+			Entry->ImgID, Status);
+		goto END;
+	}
+
+	Entry->Len = (u32)Len;
+	Entry->IsValid = (u8)TRUE;
+	++ImgCacheCnt;
+	ImgCacheNextAddr += Len;
+	if ((ImgCacheNextAddr % XLOADER_DMA_LEN_ALIGN) != 0U) {
+		ImgCacheNextAddr += (XLOADER_DMA_LEN_ALIGN -
+			(ImgCacheNextAddr % XLOADER_DMA_LEN_ALIGN));
+	}
+
+END:
+	return;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function looks up the current image of the PDI in the image
+ * cache and verifies the hash of the cached copy. If the copy is intact, the
+ * CopyToMemAddr of the PDI is set to it so that the image can be restored
+ * from DDR. A corrupted copy is dropped from the cache.
+ *
+ * @param	PdiPtr is pointer to the XilPdi instance
+ *
+ * @return	TRUE if the image can be restored from the cache, else FALSE
+ *
+ *****************************************************************************/
+u8 XLoader_ImgCacheLookup(XilPdi *PdiPtr)
+{
+	int Status = XST_FAILURE;
+	u8 IsCached = (u8)FALSE;
+	u32 ImgID = PdiPtr->MetaHdr.ImgHdr[PdiPtr->ImageNum].ImgID;
+	XLoader_ImgCacheEntry *Entry = NULL;
+	XSecure_Sha3Hash Sha3Hash;
+	u32 Index;
+
+	if (PdiPtr != BootPdiPtr) {
+		goto END;
+	}
+
+	for (Index = 0U; Index < ImgCacheCnt; ++Index) {
+		if ((ImgCache[Index].ImgID == ImgID) &&
+			(ImgCache[Index].IsValid == (u8)TRUE)) {
+			Entry = &ImgCache[Index];
+			break;
+		}
+	}
+	if (Entry == NULL) {
+		goto END;
+	}
+
+	Status = XLoader_ImgCacheHash(Entry->Addr, Entry->Len, &Sha3Hash);
+	if (Status == XST_SUCCESS) {
+		Status = Xil_MemCmp(Sha3Hash.Hash, Entry->Sha3Hash.Hash,
+			XLOADER_SHA3_LEN);
+	}
+	if (Status != XST_SUCCESS) {
+		XPlmi_Printf(DEBUG_GENERAL, "Cached image 0x%08x is corrupted, "
+			"reading it from boot device\n\r", ImgID);
+		Entry->IsValid = (u8)FALSE;
+		goto END;
+	}
+
+	PdiPtr->CopyToMemAddr = Entry->Addr;
+	IsCached = (u8)TRUE;
+
+END:
+	return IsCached;
+}
+#endif /* PLM_ENABLE_IMAGE_CACHE */
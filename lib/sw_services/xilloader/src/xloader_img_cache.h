@@ -0,0 +1,67 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xloader_img_cache.h
+*
+* This is the header file which contains the declarations of the DDR image
+* cache used for subsystem restart.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agent 10/17/2026 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+#ifndef XLOADER_IMG_CACHE_H
+#define XLOADER_IMG_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xloader.h"
+
+#ifdef PLM_ENABLE_IMAGE_CACHE
+/************************** Constant Definitions *****************************/
+/*
+ * DDR region holding the cached images. It must be below 4GB and must not
+ * be used by any subsystem or by the CopyToMemory addresses of the PDI.
+ */
+#ifndef XLOADER_IMAGE_CACHE_ADDR
+#define XLOADER_IMAGE_CACHE_ADDR	(0x70000000U)
+#endif
+#ifndef XLOADER_IMAGE_CACHE_SIZE
+#define XLOADER_IMAGE_CACHE_SIZE	(0x8000000U) /* 128M */
+#endif
+#define XLOADER_IMAGE_CACHE_MAX_NUM	(8U)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+void XLoader_ImgCacheAlloc(XilPdi *PdiPtr, u8 *DdrRequested);
+void XLoader_ImgCacheStore(const XilPdi *PdiPtr);
+u8 XLoader_ImgCacheLookup(XilPdi *PdiPtr);
+
+/************************** Variable Definitions *****************************/
+#endif /* PLM_ENABLE_IMAGE_CACHE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* XLOADER_IMG_CACHE_H */
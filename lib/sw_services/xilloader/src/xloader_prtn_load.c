@@ -47,6 +47,8 @@
 *                       boot modes
 *       bsv  10/13/2020 Code clean up
 *       td   10/19/2020 MISRA C Fixes
+*       agent 10/17/2026 Process keyhole leftovers of prefetched chunks in place
+*       agent 10/17/2026 Log partition processing as trace events
 *
 * </pre>
 *
@@ -167,6 +169,9 @@ int XLoader_LoadImagePrtns(XilPdi* PdiPtr)
 		if (XST_SUCCESS != Status) {
 			goto END;
 		}
+		XPlmi_TraceLog4((u32)XPLMI_TRACE_LOG_PRTN_DONE, PdiPtr->PrtnNum,
+			(PdiPtr->MetaHdr.PrtnHdr[PdiPtr->PrtnNum].TotalDataWordLen) *
+			XPLMI_WORD_LEN);
 		XPlmi_MeasurePerfTime(PrtnLoadTime, &PerfTime);
 		XPlmi_Printf(DEBUG_PRINT_PERF,
 			" %u.%06u ms for PrtnNum: %u, Size: %u Bytes\n\r",
@@ -531,15 +536,16 @@ static int XLoader_ProcessCdo(const XilPdi* PdiPtr, XLoader_DeviceCopy* DeviceCo
 {
 	int Status = XST_FAILURE;
 	u32 ChunkLen;
-	u32 ChunkLenTemp;
+	u32 BufLen;
 	XPlmiCdo Cdo = {0U};
 	u32 PdiVer;
 	u32 ChunkAddr = XPLMI_PMCRAM_CHUNK_MEMORY;
-	u32 ChunkAddrTemp;
+	u32 ResidentOfst = 0U;
+	u32 ResidentLen = 0U;
 	u8 LastChunk = (u8)FALSE;
 	u8 IsNextChunkCopyStarted = (u8)FALSE;
 
-	XPlmi_Printf(DEBUG_INFO, "Processing CDO partition \n\r");
+	XPlmi_TraceLog3((u32)XPLMI_TRACE_LOG_PRTN_CDO, PdiPtr->PrtnNum);
 	/*
 	 * Initialize the Cdo Pointer and
 	 * check CDO header contents
@@ -587,33 +593,49 @@ static int XLoader_ProcessCdo(const XilPdi* PdiPtr, XLoader_DeviceCopy* DeviceCo
 	}
 
 	while (DeviceCopy->Len > 0U) {
-		/* Update the len for last chunk */
-		if (DeviceCopy->Len <= ChunkLen) {
-			LastChunk = (u8)TRUE;
-			ChunkLen = DeviceCopy->Len;
+		if (ResidentLen == 0U) {
+			/* Update the len for last chunk */
+			if (DeviceCopy->Len <= ChunkLen) {
+				LastChunk = (u8)TRUE;
+				ChunkLen = DeviceCopy->Len;
+			}
 		}
 
 		if ((SecureParams->SecureEn == (u8)FALSE) &&
 			(SecureParams->SecureEnTmp == (u8)FALSE)) {
-			if (IsNextChunkCopyStarted == (u8)TRUE) {
-				IsNextChunkCopyStarted = (u8)FALSE;
-				/* Wait for copy to get completed */
-				Status = PdiPtr->DeviceCopy(DeviceCopy->SrcAddr, ChunkAddr, ChunkLen,
-					DeviceCopy->Flags | XPLMI_DEVICE_COPY_STATE_WAIT_DONE);
+			if (ResidentLen != 0U) {
+				/*
+				 * Start of the chunk is already consumed by a
+				 * keyhole command, process the rest in place
+				 */
+				BufLen = ResidentLen;
+				ResidentLen = 0U;
 			}
 			else {
-				/* Copy the data to PRAM buffer */
-				Status = PdiPtr->DeviceCopy(DeviceCopy->SrcAddr, ChunkAddr, ChunkLen,
-					DeviceCopy->Flags | XPLMI_DEVICE_COPY_STATE_BLK);
-			}
-			if (Status != XST_SUCCESS) {
+				ResidentOfst = 0U;
+				BufLen = ChunkLen;
+				if (IsNextChunkCopyStarted == (u8)TRUE) {
+					IsNextChunkCopyStarted = (u8)FALSE;
+					/* Wait for copy to get completed */
+					Status = PdiPtr->DeviceCopy(DeviceCopy->SrcAddr, ChunkAddr,
+						ChunkLen, DeviceCopy->Flags |
+						XPLMI_DEVICE_COPY_STATE_WAIT_DONE);
+				}
+				else {
+					/* Copy the data to PRAM buffer */
+					Status = PdiPtr->DeviceCopy(DeviceCopy->SrcAddr, ChunkAddr,
+						ChunkLen, DeviceCopy->Flags |
+						XPLMI_DEVICE_COPY_STATE_BLK);
+				}
+				if (Status != XST_SUCCESS) {
 					goto END;
+				}
 			}
 			/* Update variables for next chunk */
-			Cdo.BufPtr = (u32 *)ChunkAddr;
-			Cdo.BufLen = ChunkLen / XIH_PRTN_WORD_LEN;
-			DeviceCopy->SrcAddr += ChunkLen;
-			DeviceCopy->Len -= ChunkLen;
+			Cdo.BufPtr = (u32 *)(ChunkAddr + ResidentOfst);
+			Cdo.BufLen = BufLen / XIH_PRTN_WORD_LEN;
+			DeviceCopy->SrcAddr += BufLen;
+			DeviceCopy->Len -= BufLen;
 			if (DeviceCopy->IsDoubleBuffering == (u8)TRUE) {
 				Cdo.Cmd.KeyHoleParams.Func = PdiPtr->DeviceCopy;
 				Cdo.Cmd.KeyHoleParams.SrcAddr = DeviceCopy->SrcAddr;
@@ -629,7 +651,7 @@ static int XLoader_ProcessCdo(const XilPdi* PdiPtr, XLoader_DeviceCopy* DeviceCo
 			 * next chunk for increasing performance
 			 */
 			if ((DeviceCopy->IsDoubleBuffering == (u8)TRUE)
-			    && (LastChunk != (u8)TRUE)) {
+			    && (DeviceCopy->Len > 0U)) {
 				/* Update the next chunk address to other part */
 				if (ChunkAddr == XPLMI_PMCRAM_CHUNK_MEMORY) {
 					ChunkAddr = XPLMI_PMCRAM_CHUNK_MEMORY_1;
@@ -682,41 +704,15 @@ static int XLoader_ProcessCdo(const XilPdi* PdiPtr, XLoader_DeviceCopy* DeviceCo
 			if ((IsNextChunkCopyStarted == (u8)TRUE) &&
 					(Cdo.Cmd.KeyHoleParams.ExtraWords < ChunkLen)) {
 				/*
-				 * There are some CDO commands to be processed in
-				 * memory pointed to by ChunkAddr
+				 * Keyhole command has waited for the next chunk and
+				 * consumed its start. The rest of it is processed
+				 * from where it is, without copying it again.
 				 */
-				ChunkAddrTemp = (ChunkAddr + Cdo.Cmd.KeyHoleParams.ExtraWords);
-				ChunkLenTemp = (ChunkLen - Cdo.Cmd.KeyHoleParams.ExtraWords);
-				if (ChunkAddr == XPLMI_PMCRAM_CHUNK_MEMORY) {
-					ChunkAddr = XPLMI_PMCRAM_CHUNK_MEMORY_1;
-				}
-				else {
-					ChunkAddr = XPLMI_PMCRAM_CHUNK_MEMORY;
-				}
-				Status = XPlmi_DmaXfr(ChunkAddrTemp, ChunkAddr,
-						(ChunkLenTemp / XPLMI_WORD_LEN), XPLMI_PMCDMA_0);
-				if (Status != XST_SUCCESS) {
-					goto END;
-				}
-
-				if (Cdo.Cmd.KeyHoleParams.ExtraWords < (DeviceCopy->Len - ChunkLenTemp)) {
-					Status = PdiPtr->DeviceCopy(DeviceCopy->SrcAddr + ChunkLenTemp,
-							ChunkAddr + ChunkLenTemp, Cdo.Cmd.KeyHoleParams.ExtraWords,
-							DeviceCopy->Flags | XPLMI_DEVICE_COPY_STATE_INITIATE);
-				}
-				else {
-					Status = PdiPtr->DeviceCopy(DeviceCopy->SrcAddr + ChunkLenTemp,
-							ChunkAddr + ChunkLenTemp, (DeviceCopy->Len - ChunkLenTemp),
-							DeviceCopy->Flags | XPLMI_DEVICE_COPY_STATE_INITIATE);
-				}
-				if (Status != XST_SUCCESS) {
-					goto END;
-				}
-			}
-			else {
-				IsNextChunkCopyStarted = (u8)FALSE;
-				SecureParams->IsNextChunkCopyStarted = (u8)FALSE;
+				ResidentOfst = Cdo.Cmd.KeyHoleParams.ExtraWords;
+				ResidentLen = ChunkLen - Cdo.Cmd.KeyHoleParams.ExtraWords;
 			}
+			IsNextChunkCopyStarted = (u8)FALSE;
+			SecureParams->IsNextChunkCopyStarted = (u8)FALSE;
 			Cdo.Cmd.KeyHoleParams.ExtraWords = 0x0U;
 		}
 	}
@@ -882,11 +878,17 @@ static int XLoader_ProcessPrtn(XilPdi* PdiPtr)
 		Status = XLoader_ProcessCdo(PdiPtr, &PrtnParams.DeviceCopy, &SecureParams);
 	}
 	else if (PrtnType == XIH_PH_ATTRB_PRTN_TYPE_ELF) {
-		XPlmi_Printf(DEBUG_INFO, "Copying elf partitions\n\r");
+		XPlmi_TraceLog6((u32)XPLMI_TRACE_LOG_PRTN_ELF, PrtnNum,
+			(u32)(PrtnParams.DeviceCopy.DestAddr >> 32U),
+			(u32)(PrtnParams.DeviceCopy.DestAddr & 0xFFFFFFFFU),
+			PrtnParams.DeviceCopy.Len);
 		Status = XLoader_ProcessElf(PdiPtr, PrtnHdr, &PrtnParams, &SecureParams);
 	}
 	else {
-		XPlmi_Printf(DEBUG_INFO, "Copying data partition\n\r");
+		XPlmi_TraceLog6((u32)XPLMI_TRACE_LOG_PRTN_DATA, PrtnNum,
+			(u32)(PrtnParams.DeviceCopy.DestAddr >> 32U),
+			(u32)(PrtnParams.DeviceCopy.DestAddr & 0xFFFFFFFFU),
+			PrtnParams.DeviceCopy.Len);
 		/* Partition Copy */
 		Status = XLoader_PrtnCopy(PdiPtr, &PrtnParams.DeviceCopy, &SecureParams);
 	}
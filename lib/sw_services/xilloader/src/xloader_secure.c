@@ -70,6 +70,9 @@
 *       td   10/19/20 MISRA C Fixes
 *       bsv  10/19/20 Parallel DMA related changes
 *       har  10/19/20 Replaced ECDSA in function calls
+* 1.04  agent 10/17/2026 Copy authenticated chunk to destination on PMCDMA1
+*                      while PMCDMA0 feeds it to SHA3 engine, enabled with
+*                      PLM_ENABLE_SECURE_COPY_OVERLAP
 *
 * </pre>
 *
@@ -468,6 +471,11 @@ int XLoader_ProcessSecurePrtn(XLoader_SecureParams *SecurePtr, u64 DestAddr,
 	u32 TotalSize = BlockSize;
 	u64 SrcAddr;
 	u64 OutAddr;
+	u8 IsDataCopyStarted = (u8)FALSE;
+#ifdef PLM_ENABLE_SECURE_COPY_OVERLAP
+	int SStatus = XST_FAILURE;
+	u32 DataOfst = 0U;
+#endif
 
 	XPlmi_Printf(DEBUG_DETAILED,
 			"Processing Block %d \n\r", SecurePtr->BlockNum);
@@ -556,12 +564,41 @@ int XLoader_ProcessSecurePrtn(XLoader_SecureParams *SecurePtr, u64 DestAddr,
 	if ((SecurePtr->IsAuthenticated == (u8)TRUE) ||
 				(SecurePtr->IsAuthenticatedTmp == (u8)TRUE) ||
 				(SecurePtr->IsCheckSumEnabled == (u8)TRUE)) {
+#ifdef PLM_ENABLE_SECURE_COPY_OVERLAP
+		if ((SecurePtr->IsEncrypted != (u8)TRUE) &&
+			(SecurePtr->IsCdo != (u8)TRUE) &&
+			(SecurePtr->BlockNum != 0x0U) &&
+			((XPlmi_GetNonBlkDmaFlags() & XPLMI_PMCDMA_1) == 0U)) {
+			/*
+			 * Copy the chunk data to destination on PMCDMA1 while
+			 * PMCDMA0 feeds the chunk to SHA3 engine. The destination
+			 * is cleared by XLoader_SecureCopy if verification fails.
+			 * The first block is copied only after its hash is
+			 * verified against the signed hash.
+			 */
+			if (Last != (u8)TRUE) {
+				DataOfst = XLOADER_SHA3_LEN;
+			}
+			Status = XPlmi_DmaXfr((u64)SecurePtr->ChunkAddr + DataOfst,
+					DestAddr, (TotalSize - DataOfst) / XIH_PRTN_WORD_LEN,
+					XPLMI_PMCDMA_1 | XPLMI_DMA_SRC_NONBLK |
+					XPLMI_DMA_DST_NONBLK);
+			if (Status != XST_SUCCESS) {
+				Status = XPlmi_UpdateStatus(
+						XLOADER_ERR_DMA_TRANSFER, Status);
+				goto END;
+			}
+			IsDataCopyStarted = (u8)TRUE;
+		}
+#endif
+
 		/* Verify hash */
 		XSECURE_TEMPORAL_CHECK(END, Status,
 					XLoader_VerifyHashNUpdateNext,
 					SecurePtr, TotalSize, Last);
 		if ((SecurePtr->IsEncrypted != (u8)TRUE) &&
-			(SecurePtr->IsCdo != (u8)TRUE)) {
+			(SecurePtr->IsCdo != (u8)TRUE) &&
+			(IsDataCopyStarted == (u8)FALSE)) {
 				/* Copy to destination address */
 			Status = XPlmi_DmaXfr((u64)SecurePtr->SecureData,
 							(u64)DestAddr,
@@ -605,6 +642,14 @@ int XLoader_ProcessSecurePrtn(XLoader_SecureParams *SecurePtr, u64 DestAddr,
 	SecurePtr->BlockNum++;
 
 END:
+#ifdef PLM_ENABLE_SECURE_COPY_OVERLAP
+	if (IsDataCopyStarted == (u8)TRUE) {
+		SStatus = XPlmi_WaitForNonBlkDma(XPLMI_PMCDMA_1);
+		if ((SStatus != XST_SUCCESS) && (Status == XLOADER_SUCCESS)) {
+			Status = XPlmi_UpdateStatus(XLOADER_ERR_DMA_TRANSFER, SStatus);
+		}
+	}
+#endif
 	/* Clears whole intermediate buffers on failure */
 	if (Status != XLOADER_SUCCESS) {
 		ClrStatus = XPlmi_InitNVerifyMem(SecurePtr->ChunkAddr, TotalSize);
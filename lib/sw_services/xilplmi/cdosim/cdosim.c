@@ -0,0 +1,432 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file cdosim.c
+*
+* This file contains the host CDO replay simulator. It runs the xilplmi CDO
+* parser and generic command handlers against a sparse register model and
+* reports the executed commands, the simulated time and the commands which
+* take most of it.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agent 10/17/2026 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "xplmi_cdo.h"
+#include "xplmi_generic.h"
+#include "xplmi_modules.h"
+#include "cdosim.h"
+
+/************************** Constant Definitions *****************************/
+#define CDOSIM_CMD_IDS			(0x10000U)
+#define CDOSIM_DEF_CHUNK_SIZE		(0x10000U)
+#define CDOSIM_DEF_TOP_CMDS		(10U)
+#define CDOSIM_MAX_CDO_SIZE		(0x10000000U)
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u64 Count;		/**< Number of executions */
+	u64 Resumes;		/**< Number of resumes of partial commands */
+	u64 Coalesced;		/**< Executions within coalesced write runs */
+	u64 Ns;			/**< Total simulated time */
+	u64 MaxNs;		/**< Maximum simulated time of an execution */
+	u64 PayloadWords;	/**< Total payload words */
+	u64 Unmodelled;		/**< Executions without a simulated handler */
+} CdoSim_CmdStats;
+
+/************************** Function Prototypes ******************************/
+static void CdoSim_Usage(const char *Name);
+static int CdoSim_Replay(const char *File, XPlmiCdo *Cdo, u8 *Arena,
+	u32 ArenaLen);
+static void CdoSim_PrintTop(u32 Top);
+static const char *CdoSim_CmdName(u32 CmdId);
+
+/************************** Variable Definitions *****************************/
+CdoSim_Latency CdoSimLatency = {
+	.NpiNs = 100U,
+	.RegNs = 40U,
+	.DmaSetupNs = 1000U,
+	.DmaWordNs = 4U,
+	.PollNs = 1000U,
+	.CmdNs = 300U,
+};
+
+static CdoSim_CmdStats CmdStats[CDOSIM_CMD_IDS];
+static u32 ChunkSize = CDOSIM_DEF_CHUNK_SIZE;
+static u64 TotalCmds;
+
+/* Names of the PLM generic commands, indexed by API ID */
+static const char *GenericCmdNames[] = {
+	"Features", "MaskPoll", "MaskWrite", "Write", "Delay", "DmaWrite",
+	"MaskPoll64", "MaskWrite64", "Write64", "DmaXfer", "InitSeq",
+	"CfiRead", "Set", "DmaWriteKeyHole", "SsitSyncMaster",
+	"SsitSyncSlaves", "SsitWaitSlaves", "Nop", "GetDeviceID",
+	"EventLogging", "SetBoard", "GetBoard", "SetWdtParam",
+	"SetIpiRingWindow",
+};
+
+/* Linker provided bounds of the simulator image */
+extern char __executable_start;
+extern char _end;
+
+/*****************************************************************************/
+static void CdoSim_Usage(const char *Name)
+{
+	printf("Usage: %s [options] <cdo file>...\n"
+		"\n"
+		"Replays CDO binaries through the PLM CDO parser and reports\n"
+		"the simulated execution time. Files are replayed in order on\n"
+		"the same register model, as the partitions of a PDI.\n"
+		"\n"
+		"Options:\n"
+		"\t-n <ns>\tNPI register access latency (default %llu)\n"
+		"\t-r <ns>\tOther register access latency (default %llu)\n"
+		"\t-s <ns>\tDMA setup latency (default %llu)\n"
+		"\t-w <ns>\tDMA latency per word (default %llu)\n"
+		"\t-p <ns>\tMask poll latency (default %llu)\n"
+		"\t-c <ns>\tCommand decode latency (default %llu)\n"
+		"\t-b <bytes>\tChunk size (default 0x%x)\n"
+		"\t-t <n>\tNumber of hot commands reported (default %u)\n"
+		"\t-v\tEnable PLM prints\n"
+		"\t-h\tThis help\n", Name,
+		(unsigned long long)CdoSimLatency.NpiNs,
+		(unsigned long long)CdoSimLatency.RegNs,
+		(unsigned long long)CdoSimLatency.DmaSetupNs,
+		(unsigned long long)CdoSimLatency.DmaWordNs,
+		(unsigned long long)CdoSimLatency.PollNs,
+		(unsigned long long)CdoSimLatency.CmdNs,
+		CDOSIM_DEF_CHUNK_SIZE, CDOSIM_DEF_TOP_CMDS);
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function records an executed command. It is called from
+ * the command profiling hook of the PLM command layer.
+ *
+ * @param	CmdId is the command header
+ * @param	Ns is the simulated time of the execution
+ * @param	PayloadLen is the payload length in words
+ * @param	IsResume is TRUE if a partially executed command is resumed
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void CdoSim_CountCmd(u32 CmdId, u64 Ns, u32 PayloadLen, u8 IsResume)
+{
+	CdoSim_CmdStats *Stats = &CmdStats[CmdId & (CDOSIM_CMD_IDS - 1U)];
+
+	if (IsResume == (u8)TRUE) {
+		Stats->Resumes++;
+	} else {
+		Stats->Count++;
+		TotalCmds++;
+	}
+	Stats->Ns += Ns;
+	if (Ns > Stats->MaxNs) {
+		Stats->MaxNs = Ns;
+	}
+	Stats->PayloadWords += PayloadLen;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function records a run of commands executed together
+ * without their handler, such as coalesced writes. It is called from the
+ * run profiling hook of the PLM command layer.
+ *
+ * @param	CmdId is the command header
+ * @param	Ns is the simulated time of all commands of the run
+ * @param	Count is the number of commands
+ * @param	PayloadLen is the payload length of all commands in words
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void CdoSim_CountCmdRun(u32 CmdId, u64 Ns, u32 Count, u32 PayloadLen)
+{
+	CdoSim_CmdStats *Stats = &CmdStats[CmdId & (CDOSIM_CMD_IDS - 1U)];
+
+	if (Count == 0U) {
+		return;
+	}
+	Stats->Count += Count;
+	Stats->Coalesced += Count;
+	TotalCmds += Count;
+	Stats->Ns += Ns;
+	if ((Ns / Count) > Stats->MaxNs) {
+		Stats->MaxNs = Ns / Count;
+	}
+	Stats->PayloadWords += PayloadLen;
+}
+
+void CdoSim_CountUnmodelled(u32 CmdId)
+{
+	CmdStats[CmdId & (CDOSIM_CMD_IDS - 1U)].Unmodelled++;
+}
+
+static const char *CdoSim_CmdName(u32 CmdId)
+{
+	u32 ModuleId = (CmdId & XPLMI_CMD_MODULE_ID_MASK) >> 8U;
+	u32 ApiId = CmdId & XPLMI_CMD_API_ID_MASK;
+	const char *Name = "";
+
+	if ((ModuleId == XPLMI_MODULE_GENERIC_ID) &&
+		(ApiId < XPLMI_ARRAY_SIZE(GenericCmdNames))) {
+		Name = GenericCmdNames[ApiId];
+	}
+
+	return Name;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function prints the commands with the highest total
+ * simulated time.
+ *
+ * @param	Top is the number of commands printed
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void CdoSim_PrintTop(u32 Top)
+{
+	static u8 Printed[CDOSIM_CMD_IDS];
+	u32 Index;
+	u32 Rank;
+	u32 Best;
+
+	printf("\nHot commands:\n");
+	printf("  Module:Api %-16s %10s %10s %10s %12s %10s %12s\n", "Name",
+		"Count", "Coalesced", "Resumes", "Total us", "Max ns",
+		"Payload B");
+	for (Rank = 0U; Rank < Top; Rank++) {
+		Best = CDOSIM_CMD_IDS;
+		for (Index = 0U; Index < CDOSIM_CMD_IDS; Index++) {
+			if ((Printed[Index] == 0U) &&
+				((CmdStats[Index].Count + CmdStats[Index].Resumes) != 0U) &&
+				((Best == CDOSIM_CMD_IDS) ||
+				(CmdStats[Index].Ns > CmdStats[Best].Ns))) {
+				Best = Index;
+			}
+		}
+		if (Best == CDOSIM_CMD_IDS) {
+			break;
+		}
+		Printed[Best] = 1U;
+		printf("  0x%02x:0x%02x  %-16s %10llu %10llu %10llu %12.3f %10llu "
+			"%12llu%s\n",
+			Best >> 8U, Best & 0xFFU, CdoSim_CmdName(Best),
+			(unsigned long long)CmdStats[Best].Count,
+			(unsigned long long)CmdStats[Best].Coalesced,
+			(unsigned long long)CmdStats[Best].Resumes,
+			(double)CmdStats[Best].Ns / 1000.0,
+			(unsigned long long)CmdStats[Best].MaxNs,
+			(unsigned long long)CmdStats[Best].PayloadWords * XPLMI_WORD_LEN,
+			(CmdStats[Best].Unmodelled != 0U) ? " (unmodelled)" : "");
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function replays one CDO file, chunk by chunk as the
+ * loader passes it to XPlmi_ProcessCdo.
+ *
+ * @param	File is the CDO file name
+ * @param	Cdo is pointer to the CDO instance
+ * @param	Arena is the host buffer below 4GB for the CDO data
+ * @param	ArenaLen is the length of the arena
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int CdoSim_Replay(const char *File, XPlmiCdo *Cdo, u8 *Arena,
+	u32 ArenaLen)
+{
+	int Status = XST_FAILURE;
+	FILE *Fp;
+	size_t Len;
+	u32 Offset = 0U;
+	u32 BufLen;
+	u64 StartNs = CdoSim_GetTime();
+	u64 StartCmds = TotalCmds;
+
+	Fp = fopen(File, "rb");
+	if (Fp == NULL) {
+		fprintf(stderr, "cdosim: cannot open %s\n", File);
+		goto END;
+	}
+	Len = fread(Arena, 1U, ArenaLen, Fp);
+	(void)fclose(Fp);
+	if ((Len < (XPLMI_CDO_HDR_LEN * XPLMI_WORD_LEN)) ||
+		((Len % XPLMI_WORD_LEN) != 0U) ||
+		(((u32 *)(void *)Arena)[1U] != XPLMI_CDO_HDR_IDN_WRD)) {
+		fprintf(stderr, "cdosim: %s is not a CDO binary\n", File);
+		goto END;
+	}
+
+	Status = XPlmi_InitCdo(Cdo);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+	while ((Offset < Len) && (Cdo->CmdEndDetected == (u8)FALSE)) {
+		BufLen = (u32)Len - Offset;
+		if (BufLen > ChunkSize) {
+			BufLen = ChunkSize;
+		}
+		Cdo->BufPtr = (u32 *)(void *)(Arena + Offset);
+		Cdo->BufLen = BufLen / XPLMI_WORD_LEN;
+		Status = XPlmi_ProcessCdo(Cdo);
+		if (Status != XST_SUCCESS) {
+			fprintf(stderr, "cdosim: %s failed with 0x%x at word 0x%x\n",
+				File, (u32)Status, Cdo->ProcessedCdoLen);
+			goto END;
+		}
+		Offset += BufLen;
+	}
+	if ((Cdo->CmdState == XPLMI_CMD_STATE_RESUME) ||
+		(Cdo->CopiedCmdLen != 0U)) {
+		fprintf(stderr, "cdosim: %s ends within a command\n", File);
+		Status = XST_FAILURE;
+		goto END;
+	}
+
+	printf("%s: %llu commands, %.3f us%s\n", File,
+		(unsigned long long)(TotalCmds - StartCmds),
+		(double)(CdoSim_GetTime() - StartNs) / 1000.0,
+		(Cdo->DeferredError != 0U) ? ", deferred error" : "");
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+int main(int argc, char **argv)
+{
+	int Status = XST_FAILURE;
+	u32 Top = CDOSIM_DEF_TOP_CMDS;
+	u8 *Arena;
+	XPlmiCdo *Cdo;
+	const CdoSim_Stats *Stats;
+	u64 CmdNs = 0U;
+	u32 Index;
+	int Opt;
+
+	while ((Opt = getopt(argc, argv, "n:r:s:w:p:c:b:t:vh")) != -1) {
+		switch (Opt) {
+		case 'n':
+			CdoSimLatency.NpiNs = strtoull(optarg, NULL, 0);
+			break;
+		case 'r':
+			CdoSimLatency.RegNs = strtoull(optarg, NULL, 0);
+			break;
+		case 's':
+			CdoSimLatency.DmaSetupNs = strtoull(optarg, NULL, 0);
+			break;
+		case 'w':
+			CdoSimLatency.DmaWordNs = strtoull(optarg, NULL, 0);
+			break;
+		case 'p':
+			CdoSimLatency.PollNs = strtoull(optarg, NULL, 0);
+			break;
+		case 'c':
+			CdoSimLatency.CmdNs = strtoull(optarg, NULL, 0);
+			break;
+		case 'b':
+			ChunkSize = (u32)strtoul(optarg, NULL, 0) &
+				~(XPLMI_WORD_LEN - 1U);
+			break;
+		case 't':
+			Top = (u32)strtoul(optarg, NULL, 0);
+			break;
+		case 'v':
+			CdoSimVerbose = 1U;
+			DebugLog.LogLevel = 0xFFU;
+			break;
+		default:
+			CdoSim_Usage(argv[0]);
+			goto END;
+		}
+	}
+	if ((optind >= argc) || (ChunkSize == 0U)) {
+		CdoSim_Usage(argv[0]);
+		goto END;
+	}
+
+	/*
+	 * The PLM code passes 32 bit addresses of the CDO buffer and its own
+	 * variables to the DMA. The simulator is linked without PIE and the
+	 * CDO buffer is mapped below 4GB for these to stay valid.
+	 */
+	if ((UINTPTR)&_end > 0xFFFFFFFFU) {
+		fprintf(stderr, "cdosim: must be linked with -no-pie\n");
+		goto END;
+	}
+	Arena = mmap(NULL, CDOSIM_MAX_CDO_SIZE + sizeof(XPlmiCdo),
+		PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT,
+		-1, 0);
+	if (Arena == MAP_FAILED) {
+		fprintf(stderr, "cdosim: cannot map the CDO buffer\n");
+		goto END;
+	}
+	Cdo = (XPlmiCdo *)(void *)(Arena + CDOSIM_MAX_CDO_SIZE);
+
+	CdoSim_ModelInit(&CdoSimLatency);
+	CdoSim_AddHostRange((UINTPTR)&__executable_start,
+		(UINTPTR)&_end - (UINTPTR)&__executable_start);
+	CdoSim_AddHostRange((UINTPTR)Arena,
+		CDOSIM_MAX_CDO_SIZE + sizeof(XPlmiCdo));
+	XPlmi_GenericInit();
+	CdoSim_RegisterUnmodelled();
+
+	for (Index = (u32)optind; Index < (u32)argc; Index++) {
+		Status = CdoSim_Replay(argv[Index], Cdo, Arena, CDOSIM_MAX_CDO_SIZE);
+		if (Status != XST_SUCCESS) {
+			goto END;
+		}
+	}
+
+	Stats = CdoSim_GetStats();
+	for (Index = 0U; Index < CDOSIM_CMD_IDS; Index++) {
+		CmdNs += CmdStats[Index].Ns;
+	}
+	printf("\nTotal: %llu commands, %.3f us simulated, %.3f us outside "
+		"commands\n", (unsigned long long)TotalCmds,
+		(double)CdoSim_GetTime() / 1000.0,
+		(double)(CdoSim_GetTime() - CmdNs) / 1000.0);
+	printf("NPI: %llu reads, %llu writes  Other: %llu reads, %llu writes\n",
+		(unsigned long long)Stats->NpiReads,
+		(unsigned long long)Stats->NpiWrites,
+		(unsigned long long)Stats->RegReads,
+		(unsigned long long)Stats->RegWrites);
+	printf("DMA: %llu transfers, %llu words  Polls: %llu\n",
+		(unsigned long long)Stats->DmaXfers,
+		(unsigned long long)Stats->DmaWords,
+		(unsigned long long)Stats->Polls);
+	printf("Register state signature: 0x%016llx\n",
+		(unsigned long long)CdoSim_GetSignature());
+	CdoSim_PrintTop(Top);
+	CdoSim_ModelFree();
+
+END:
+	return (Status == XST_SUCCESS) ? 0 : 1;
+}
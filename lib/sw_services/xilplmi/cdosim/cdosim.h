@@ -0,0 +1,51 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file cdosim.h
+*
+* This file contains the declarations shared by the host CDO simulator
+* application and its PLM platform layer.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agent 10/17/2026 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#ifndef CDOSIM_H
+#define CDOSIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+#include "cdosim_model.h"
+
+/************************** Function Prototypes ******************************/
+void CdoSim_RegisterUnmodelled(void);
+void CdoSim_CountCmd(u32 CmdId, u64 Ns, u32 PayloadLen, u8 IsResume);
+void CdoSim_CountCmdRun(u32 CmdId, u64 Ns, u32 Count, u32 PayloadLen);
+void CdoSim_CountUnmodelled(u32 CmdId);
+
+/************************** Variable Definitions *****************************/
+extern CdoSim_Latency CdoSimLatency;
+extern u32 CdoSimVerbose;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CDOSIM_H */
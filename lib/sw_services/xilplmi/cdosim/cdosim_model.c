@@ -0,0 +1,397 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file cdosim_model.c
+*
+* This file contains the sparse register model of the host CDO simulator.
+* Words are stored in an open addressing hash table keyed by the word
+* address. Registers never written read as zero. Polls complete after the
+* configured poll latency and leave the polled bits at the expected value,
+* as the hardware would.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agent 10/17/2026 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "xstatus.h"
+#include "cdosim_model.h"
+
+/************************** Constant Definitions *****************************/
+#define CDOSIM_MODEL_INIT_SLOTS		(4096U)
+#define CDOSIM_WORD_LEN			(4U)
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u64 WordAddr;
+	u32 Value;
+	u32 Used;
+} CdoSim_Slot;
+
+/************************** Function Prototypes ******************************/
+static CdoSim_Slot *CdoSim_Lookup(u64 WordAddr, u32 Insert);
+static u32 CdoSim_ReadWord(u64 WordAddr);
+static void CdoSim_WriteWord(u64 WordAddr, u32 Value);
+static void CdoSim_Account(u64 Addr, u32 IsWrite);
+static u32 CdoSim_IsHostAddr(u64 Addr);
+
+/************************** Variable Definitions *****************************/
+static CdoSim_Slot *Slots;
+static u32 SlotCnt;
+static u32 UsedCnt;
+static CdoSim_Latency Lat;
+static CdoSim_Stats Stats;
+static u64 SimTimeNs;
+static u64 HostRange[CDOSIM_MAX_HOST_RANGES][2U];
+static u32 HostRangeCnt;
+
+/*****************************************************************************/
+/**
+ * @brief	This function initializes the register model.
+ *
+ * @param	Latency is pointer to the access latencies
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void CdoSim_ModelInit(const CdoSim_Latency *Latency)
+{
+	CdoSim_ModelFree();
+	SlotCnt = CDOSIM_MODEL_INIT_SLOTS;
+	Slots = calloc(SlotCnt, sizeof(CdoSim_Slot));
+	if (Slots == NULL) {
+		fprintf(stderr, "cdosim: out of memory\n");
+		exit(1);
+	}
+	Lat = *Latency;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function frees the register model.
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void CdoSim_ModelFree(void)
+{
+	free(Slots);
+	Slots = NULL;
+	SlotCnt = 0U;
+	UsedCnt = 0U;
+	SimTimeNs = 0U;
+	HostRangeCnt = 0U;
+	memset(&Stats, 0, sizeof(Stats));
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function registers a range of host memory. The PLM code
+ * passes 32 bit addresses of its own buffers to the DMA, so the simulator
+ * keeps them below 4GB. DMA addresses in a host range access the host
+ * memory, all others the register model.
+ *
+ * @param	Addr is the start address of the range
+ * @param	Len is the length of the range in bytes
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void CdoSim_AddHostRange(u64 Addr, u64 Len)
+{
+	if (HostRangeCnt < CDOSIM_MAX_HOST_RANGES) {
+		HostRange[HostRangeCnt][0U] = Addr;
+		HostRange[HostRangeCnt][1U] = Addr + Len;
+		HostRangeCnt++;
+	}
+}
+
+static u32 CdoSim_IsHostAddr(u64 Addr)
+{
+	u32 IsHost = 0U;
+	u32 Index;
+
+	for (Index = 0U; Index < HostRangeCnt; Index++) {
+		if ((Addr >= HostRange[Index][0U]) && (Addr < HostRange[Index][1U])) {
+			IsHost = 1U;
+		}
+	}
+
+	return IsHost;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function finds the slot of a word address, optionally
+ * inserting it. The table is doubled when it is half full.
+ *
+ * @param	WordAddr is the address divided by the word length
+ * @param	Insert is non zero to insert the address if not present
+ *
+ * @return	Pointer to the slot, NULL if not present and not inserted
+ *
+ *****************************************************************************/
+static CdoSim_Slot *CdoSim_Lookup(u64 WordAddr, u32 Insert)
+{
+	CdoSim_Slot *Old;
+	u32 OldCnt;
+	u32 Index;
+	u32 Idx;
+
+	if ((Insert != 0U) && ((UsedCnt * 2U) >= SlotCnt)) {
+		Old = Slots;
+		OldCnt = SlotCnt;
+		SlotCnt *= 2U;
+		Slots = calloc(SlotCnt, sizeof(CdoSim_Slot));
+		if (Slots == NULL) {
+			fprintf(stderr, "cdosim: out of memory\n");
+			exit(1);
+		}
+		UsedCnt = 0U;
+		for (Index = 0U; Index < OldCnt; Index++) {
+			if (Old[Index].Used != 0U) {
+				*CdoSim_Lookup(Old[Index].WordAddr, 1U) = Old[Index];
+			}
+		}
+		free(Old);
+	}
+
+	Idx = (u32)((WordAddr * 0x9E3779B97F4A7C15ULL) >> 40U) & (SlotCnt - 1U);
+	while (Slots[Idx].Used != 0U) {
+		if (Slots[Idx].WordAddr == WordAddr) {
+			return &Slots[Idx];
+		}
+		Idx = (Idx + 1U) & (SlotCnt - 1U);
+	}
+	if (Insert == 0U) {
+		return NULL;
+	}
+	Slots[Idx].Used = 1U;
+	Slots[Idx].WordAddr = WordAddr;
+	Slots[Idx].Value = 0U;
+	UsedCnt++;
+
+	return &Slots[Idx];
+}
+
+static u32 CdoSim_ReadWord(u64 WordAddr)
+{
+	const CdoSim_Slot *Slot = CdoSim_Lookup(WordAddr, 0U);
+
+	return (Slot != NULL) ? Slot->Value : 0U;
+}
+
+static void CdoSim_WriteWord(u64 WordAddr, u32 Value)
+{
+	CdoSim_Lookup(WordAddr, 1U)->Value = Value;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function advances the simulated time and the counters for
+ * a single register access.
+ *
+ * @param	Addr is the accessed address
+ * @param	IsWrite is non zero for writes
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void CdoSim_Account(u64 Addr, u32 IsWrite)
+{
+	if ((Addr >= CDOSIM_NPI_BASEADDR) && (Addr <= CDOSIM_NPI_HIGHADDR)) {
+		SimTimeNs += Lat.NpiNs;
+		if (IsWrite != 0U) {
+			Stats.NpiWrites++;
+		} else {
+			Stats.NpiReads++;
+		}
+	} else {
+		SimTimeNs += Lat.RegNs;
+		if (IsWrite != 0U) {
+			Stats.RegWrites++;
+		} else {
+			Stats.RegReads++;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function reads a device address of 1, 2, 4 or 8 bytes.
+ *
+ * @param	Addr is the device address
+ * @param	Size is the access size in bytes
+ *
+ * @return	Value read
+ *
+ *****************************************************************************/
+u64 CdoSim_Read(u64 Addr, u32 Size)
+{
+	u64 WordAddr = Addr / CDOSIM_WORD_LEN;
+	u32 Shift = (u32)(Addr % CDOSIM_WORD_LEN) * 8U;
+	u64 Value;
+
+	CdoSim_Account(Addr, 0U);
+	if (Size == 8U) {
+		Value = CdoSim_ReadWord(WordAddr) |
+			((u64)CdoSim_ReadWord(WordAddr + 1U) << 32U);
+	} else if (Size == 4U) {
+		Value = CdoSim_ReadWord(WordAddr);
+	} else {
+		Value = (CdoSim_ReadWord(WordAddr) >> Shift) &
+			((1U << (Size * 8U)) - 1U);
+	}
+
+	return Value;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function writes a device address of 1, 2, 4 or 8 bytes.
+ *
+ * @param	Addr is the device address
+ * @param	Value is the value to be written
+ * @param	Size is the access size in bytes
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void CdoSim_Write(u64 Addr, u64 Value, u32 Size)
+{
+	u64 WordAddr = Addr / CDOSIM_WORD_LEN;
+	u32 Shift = (u32)(Addr % CDOSIM_WORD_LEN) * 8U;
+	u32 Mask;
+
+	CdoSim_Account(Addr, 1U);
+	if (Size == 8U) {
+		CdoSim_WriteWord(WordAddr, (u32)Value);
+		CdoSim_WriteWord(WordAddr + 1U, (u32)(Value >> 32U));
+	} else if (Size == 4U) {
+		CdoSim_WriteWord(WordAddr, (u32)Value);
+	} else {
+		Mask = ((1U << (Size * 8U)) - 1U) << Shift;
+		CdoSim_WriteWord(WordAddr, (CdoSim_ReadWord(WordAddr) & ~Mask) |
+			(((u32)Value << Shift) & Mask));
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function models a DMA transfer between host buffers and
+ * device addresses.
+ *
+ * @param	SrcAddr is the source address
+ * @param	DestAddr is the destination address
+ * @param	Len is the number of words
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void CdoSim_Dma(u64 SrcAddr, u64 DestAddr, u32 Len)
+{
+	u32 SrcIsHost = CdoSim_IsHostAddr(SrcAddr);
+	u32 DestIsHost = CdoSim_IsHostAddr(DestAddr);
+	u32 Index;
+	u32 Value;
+
+	for (Index = 0U; Index < Len; Index++) {
+		if (SrcIsHost != 0U) {
+			Value = ((const u32 *)(UINTPTR)SrcAddr)[Index];
+		} else {
+			Value = CdoSim_ReadWord((SrcAddr / CDOSIM_WORD_LEN) + Index);
+		}
+		if (DestIsHost != 0U) {
+			((u32 *)(UINTPTR)DestAddr)[Index] = Value;
+		} else {
+			CdoSim_WriteWord((DestAddr / CDOSIM_WORD_LEN) + Index, Value);
+		}
+	}
+	SimTimeNs += Lat.DmaSetupNs + (Lat.DmaWordNs * Len);
+	Stats.DmaXfers++;
+	Stats.DmaWords += Len;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function models a register poll. The condition is met
+ * after the poll latency.
+ *
+ * @param	Addr is the polled address
+ * @param	Mask is the bit field to be polled
+ * @param	ExpectedValue is the expected value of the bit field
+ *
+ * @return	XST_SUCCESS
+ *
+ *****************************************************************************/
+int CdoSim_Poll(u64 Addr, u32 Mask, u32 ExpectedValue)
+{
+	u64 WordAddr = Addr / CDOSIM_WORD_LEN;
+
+	CdoSim_Account(Addr, 0U);
+	SimTimeNs += Lat.PollNs;
+	CdoSim_WriteWord(WordAddr, (CdoSim_ReadWord(WordAddr) & ~Mask) |
+		(ExpectedValue & Mask));
+	Stats.Polls++;
+
+	return XST_SUCCESS;
+}
+
+void CdoSim_Delay(u64 Ns)
+{
+	SimTimeNs += Ns;
+}
+
+u64 CdoSim_GetTime(void)
+{
+	return SimTimeNs;
+}
+
+const CdoSim_Stats *CdoSim_GetStats(void)
+{
+	return &Stats;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function computes an order independent signature of the
+ * register state. Replays of the same CDO with different PLM options must
+ * give the same signature.
+ *
+ * @return	Signature
+ *
+ *****************************************************************************/
+u64 CdoSim_GetSignature(void)
+{
+	u64 Sig = 0U;
+	u64 Hash;
+	u32 Index;
+
+	for (Index = 0U; Index < SlotCnt; Index++) {
+		if ((Slots[Index].Used != 0U) && (Slots[Index].Value != 0U)) {
+			Hash = (Slots[Index].WordAddr ^
+				((u64)Slots[Index].Value << 32U)) *
+				0x9E3779B97F4A7C15ULL;
+			Sig += Hash ^ (Hash >> 29U);
+		}
+	}
+
+	return Sig;
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file cdosim_model.h
+*
+* This file contains the register and memory model of the host CDO
+* simulator. Every device address accessed by the PLM code is backed by a
+* sparse word store and every access advances the simulated time by the
+* latency configured for the address region.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agent 10/17/2026 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#ifndef CDOSIM_MODEL_H
+#define CDOSIM_MODEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+/* NPI address range, all configuration writes of the PL and NoC go here */
+#define CDOSIM_NPI_BASEADDR		(0xF6000000U)
+#define CDOSIM_NPI_HIGHADDR		(0xF7FFFFFFU)
+
+/* Maximum number of host memory ranges, see CdoSim_AddHostRange */
+#define CDOSIM_MAX_HOST_RANGES		(4U)
+
+/**************************** Type Definitions *******************************/
+/**
+ * Latencies of the modelled accesses in nano seconds
+ */
+typedef struct {
+	u64 NpiNs;		/**< NPI register read or write */
+	u64 RegNs;		/**< Any other register or memory access */
+	u64 DmaSetupNs;		/**< DMA transfer setup and completion */
+	u64 DmaWordNs;		/**< DMA transfer per word */
+	u64 PollNs;		/**< Time until a polled condition is met */
+	u64 CmdNs;		/**< Command decode and dispatch */
+} CdoSim_Latency;
+
+/**
+ * Access counters of the model
+ */
+typedef struct {
+	u64 NpiReads;
+	u64 NpiWrites;
+	u64 RegReads;
+	u64 RegWrites;
+	u64 DmaXfers;
+	u64 DmaWords;
+	u64 Polls;
+} CdoSim_Stats;
+
+/************************** Function Prototypes ******************************/
+void CdoSim_ModelInit(const CdoSim_Latency *Latency);
+void CdoSim_ModelFree(void);
+void CdoSim_AddHostRange(u64 Addr, u64 Len);
+u64 CdoSim_Read(u64 Addr, u32 Size);
+void CdoSim_Write(u64 Addr, u64 Value, u32 Size);
+void CdoSim_Dma(u64 SrcAddr, u64 DestAddr, u32 Len);
+int CdoSim_Poll(u64 Addr, u32 Mask, u32 ExpectedValue);
+void CdoSim_Delay(u64 Ns);
+u64 CdoSim_GetTime(void);
+const CdoSim_Stats *CdoSim_GetStats(void);
+u64 CdoSim_GetSignature(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CDOSIM_MODEL_H */
@@ -0,0 +1,398 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file cdosim_plat.c
+*
+* This file contains the host implementation of the PLM platform services
+* used by the CDO processing code: DMA, polling utilities, timer, prints
+* and the handlers of modules which are not part of the simulator.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agent 10/17/2026 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "xplmi_dma.h"
+#include "xplmi_proc.h"
+#include "xplmi_util.h"
+#include "xplmi_modules.h"
+#include "xplmi_event_logging.h"
+#include "xplmi_ssit.h"
+#include "xplmi_wdt.h"
+#include "xplmi_ipi.h"
+#include "xil_util.h"
+#include "sleep.h"
+#include "cdosim.h"
+
+/************************** Constant Definitions *****************************/
+#define CDOSIM_MAX_API_IDS		(256U)
+
+/************************** Function Prototypes ******************************/
+static int CdoSim_UnmodelledCmd(XPlmi_Cmd *Cmd);
+
+/************************** Variable Definitions *****************************/
+XPlmi_LogInfo DebugLog;
+u32 Xil_AssertStatus;
+u32 CdoSimVerbose;
+
+static XPlmi_ModuleCmd CdoSim_UnmodelledCmds[CDOSIM_MAX_API_IDS];
+static XPlmi_Module CdoSim_UnmodelledModules[XPLMI_MAX_MODULES];
+
+/*****************************************************************************/
+/**
+ * @brief	This function registers a placeholder for every module which is
+ * not built into the simulator. Commands of those modules only cost the
+ * command latency and are reported as unmodelled.
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void CdoSim_RegisterUnmodelled(void)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < CDOSIM_MAX_API_IDS; Index++) {
+		CdoSim_UnmodelledCmds[Index].Handler = CdoSim_UnmodelledCmd;
+	}
+	for (Index = 0U; Index < XPLMI_MAX_MODULES; Index++) {
+		if (Modules[Index] == NULL) {
+			CdoSim_UnmodelledModules[Index].Id = Index;
+			CdoSim_UnmodelledModules[Index].CmdAry = CdoSim_UnmodelledCmds;
+			CdoSim_UnmodelledModules[Index].CmdCnt = CDOSIM_MAX_API_IDS;
+			XPlmi_ModuleRegister(&CdoSim_UnmodelledModules[Index]);
+		}
+	}
+}
+
+static int CdoSim_UnmodelledCmd(XPlmi_Cmd *Cmd)
+{
+	CdoSim_CountUnmodelled(Cmd->CmdId);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/* PLM platform services */
+
+int XPlmi_DmaXfr(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags)
+{
+	(void)Flags;
+	CdoSim_Dma(SrcAddr, DestAddr, Len);
+
+	return XST_SUCCESS;
+}
+
+int XPlmi_DmaSbiXfer(u64 SrcAddr, u32 Len, u32 Flags)
+{
+	/* Read back through SBI is not modelled */
+	(void)SrcAddr;
+	(void)Len;
+	(void)Flags;
+
+	return XST_SUCCESS;
+}
+
+int XPlmi_WaitForNonBlkSrcDma(u32 DmaFlags)
+{
+	(void)DmaFlags;
+
+	return XST_SUCCESS;
+}
+
+int XPlmi_WaitForNonBlkDestDma(u32 DmaFlags)
+{
+	(void)DmaFlags;
+
+	return XST_SUCCESS;
+}
+
+int XPlmi_WaitForNonBlkDma(u32 DmaFlags)
+{
+	(void)DmaFlags;
+
+	return XST_SUCCESS;
+}
+
+void XPlmi_SetMaxOutCmds(u8 Val)
+{
+	(void)Val;
+}
+
+int XPlmi_MemSet(u64 DestAddr, u32 Val, u32 Len)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Len; Index++) {
+		CdoSim_Write(DestAddr + ((u64)Index * XPLMI_WORD_LEN), Val,
+			XPLMI_WORD_LEN);
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	Memory initialization is done right away in the simulator, so
+ * there is never anything to wait for.
+ *
+ *****************************************************************************/
+int XPlmi_MemSetNonBlk(u64 DestAddr, u32 Val, u32 Len)
+{
+	return XPlmi_MemSet(DestAddr, Val, Len);
+}
+
+int XPlmi_WaitForMemInit(void)
+{
+	return XST_SUCCESS;
+}
+
+int XPlmi_WaitForMemInitRange(u64 Addr, u32 Len)
+{
+	(void)Addr;
+	(void)Len;
+
+	return XST_SUCCESS;
+}
+
+int XPlmi_MemSetBytes(void *DestPtr, u32 DestLen, u8 Val, u32 Len)
+{
+	int Status = XST_FAILURE;
+
+	if ((DestPtr != NULL) && (Len <= DestLen)) {
+		(void)memset(DestPtr, Val, Len);
+		Status = XST_SUCCESS;
+	}
+
+	return Status;
+}
+
+int Xil_SecureMemCpy(void *DestPtr, u32 DestPtrLen, const void *SrcPtr,
+	u32 Len)
+{
+	int Status = XST_FAILURE;
+
+	if ((DestPtr != NULL) && (SrcPtr != NULL) && (Len <= DestPtrLen)) {
+		(void)memmove(DestPtr, SrcPtr, Len);
+		Status = XST_SUCCESS;
+	}
+
+	return Status;
+}
+
+void XPlmi_UtilRMW(u32 RegAddr, u32 Mask, u32 Value)
+{
+	u32 Val = (u32)CdoSim_Read(RegAddr, XPLMI_WORD_LEN);
+
+	CdoSim_Write(RegAddr, (Val & ~Mask) | (Value & Mask), XPLMI_WORD_LEN);
+}
+
+void XPlmi_UtilRMW64(u32 HighAddr, u32 LowAddr, u32 Mask, u32 Value)
+{
+	u64 Addr = ((u64)HighAddr << 32U) | LowAddr;
+	u32 Val = (u32)CdoSim_Read(Addr, XPLMI_WORD_LEN);
+
+	CdoSim_Write(Addr, (Val & ~Mask) | (Value & Mask), XPLMI_WORD_LEN);
+}
+
+int XPlmi_UtilSafetyWrite(u32 RegAddr, u32 Mask, u32 Value)
+{
+	XPlmi_UtilRMW(RegAddr, Mask, Value);
+
+	return XST_SUCCESS;
+}
+
+int XPlmi_UtilSafetyRMW64(u32 HighAddr, u32 LowAddr, u32 Mask, u32 Value)
+{
+	XPlmi_UtilRMW64(HighAddr, LowAddr, Mask, Value);
+
+	return XST_SUCCESS;
+}
+
+void XPlmi_UtilWrite64(u32 HighAddr, u32 LowAddr, u32 Value)
+{
+	CdoSim_Write(((u64)HighAddr << 32U) | LowAddr, Value, XPLMI_WORD_LEN);
+}
+
+int XPlmi_UtilPoll(u32 RegAddr, u32 Mask, u32 ExpectedValue, u32 TimeOutInUs)
+{
+	(void)TimeOutInUs;
+
+	return CdoSim_Poll(RegAddr, Mask, ExpectedValue);
+}
+
+int XPlmi_UtilPoll64(u64 RegAddr, u32 Mask, u32 ExpectedValue, u32 TimeOutInUs)
+{
+	(void)TimeOutInUs;
+
+	return CdoSim_Poll(RegAddr, Mask, ExpectedValue);
+}
+
+int XPlmi_UtilPollForMask(u32 RegAddr, u32 Mask, u32 TimeOutInUs)
+{
+	(void)TimeOutInUs;
+
+	return CdoSim_Poll(RegAddr, Mask, Mask);
+}
+
+int XPlmi_UtilPollForMask64(u32 HighAddr, u32 LowAddr, u32 Mask,
+	u32 TimeOutInUs)
+{
+	(void)TimeOutInUs;
+
+	return CdoSim_Poll(((u64)HighAddr << 32U) | LowAddr, Mask, Mask);
+}
+
+void XPlmi_PrintArray(u32 DebugType, const u64 BufAddr, u32 Len,
+	const char *Str)
+{
+	u32 Index;
+
+	if ((DebugType & DebugLog.LogLevel) != 0U) {
+		printf("%s START, Len: 0x%08x\n", Str, Len);
+		for (Index = 0U; Index < Len; Index++) {
+			printf("0x%08x ", ((const u32 *)(UINTPTR)BufAddr)[Index]);
+		}
+		printf("\n%s END\n", Str);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief	The PLM timer counts down, the simulated time counts up.
+ *
+ * @return	Simulated timer value
+ *
+ *****************************************************************************/
+u64 XPlmi_GetTimerValue(void)
+{
+	return ~CdoSim_GetTime();
+}
+
+void XPlmi_PrintPlmTimeStamp(void)
+{
+	u64 Time = CdoSim_GetTime();
+
+	printf("[%llu.%03llu]", (unsigned long long)(Time / 1000000U),
+		(unsigned long long)((Time / 1000U) % 1000U));
+}
+
+/*****************************************************************************/
+/**
+ * @brief	Command profiling hook of XPlmi_CmdExecute and
+ * XPlmi_CmdResume. Every command is charged the command latency on top
+ * of the accesses done by its handler.
+ *
+ *****************************************************************************/
+void XPlmi_StoreCmdProfile(u32 CmdId, u64 StartTime, u32 PayloadLen,
+	u8 IsResume)
+{
+	CdoSim_Delay(CdoSimLatency.CmdNs);
+	CdoSim_CountCmd(CmdId, StartTime - XPlmi_GetTimerValue(), PayloadLen,
+		IsResume);
+}
+
+/*****************************************************************************/
+/**
+ * @brief	Run profiling hook of coalesced CDO writes. The time of the
+ * run is the DMA time measured by the caller, there is no command decode.
+ *
+ *****************************************************************************/
+void XPlmi_StoreCmdProfileRun(u32 CmdId, u64 Cycles, u32 Count,
+	u32 PayloadLen)
+{
+	CdoSim_CountCmdRun(CmdId, Cycles, Count, PayloadLen);
+}
+
+/*****************************************************************************/
+/**
+ * @brief	Trace events are not stored by the simulator, they do not touch
+ * the modelled registers.
+ *
+ *****************************************************************************/
+void XPlmi_StoreTraceLog(u32 *TraceData, u32 Len)
+{
+	(void)TraceData;
+	(void)Len;
+}
+
+int usleep(useconds_t Us)
+{
+	CdoSim_Delay((u64)Us * 1000U);
+
+	return 0;
+}
+
+void xil_printf(const char8 *Ctrl1, ...)
+{
+	va_list Args;
+
+	if (CdoSimVerbose != 0U) {
+		va_start(Args, Ctrl1);
+		(void)vprintf(Ctrl1, Args);
+		va_end(Args);
+	}
+}
+
+void Xil_Assert(const char8 *File, s32 Line)
+{
+	fprintf(stderr, "cdosim: assert at %s:%d\n", File, (int)Line);
+	exit(1);
+}
+
+/*****************************************************************************/
+/* Handlers of generic commands which need PLM services not simulated */
+
+int XPlmi_EventLogging(XPlmi_Cmd *Cmd)
+{
+	return CdoSim_UnmodelledCmd(Cmd);
+}
+
+int XPlmi_SsitSyncMaster(XPlmi_Cmd *Cmd)
+{
+	return CdoSim_UnmodelledCmd(Cmd);
+}
+
+int XPlmi_SsitSyncSlaves(XPlmi_Cmd *Cmd)
+{
+	return CdoSim_UnmodelledCmd(Cmd);
+}
+
+int XPlmi_SsitWaitSlaves(XPlmi_Cmd *Cmd)
+{
+	return CdoSim_UnmodelledCmd(Cmd);
+}
+
+int XPlmi_EnableWdt(u32 NodeId, u32 Periodicity)
+{
+	(void)NodeId;
+	(void)Periodicity;
+
+	return XST_SUCCESS;
+}
+
+int XPlmi_IpiRingSetWindow(u32 IpiMask, u64 Addr, u64 Size)
+{
+	(void)IpiMask;
+	(void)Addr;
+	(void)Size;
+
+	return XST_SUCCESS;
+}
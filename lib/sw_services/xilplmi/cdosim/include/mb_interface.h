@@ -0,0 +1,52 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file cdosim/include/mb_interface.h
+*
+* Host replacement of the MicroBlaze interface macros used by xilplmi.
+* Extended address accesses go to the CDO simulator register model and
+* the MSR and interrupt controls are no-ops. Host tests can provide their
+* own mfmsr() and mb_sleep() by defining them on the command line.
+*
+******************************************************************************/
+#ifndef _MICROBLAZE_INTERFACE_H_
+#define _MICROBLAZE_INTERFACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+#include "xil_assert.h"
+#include "cdosim_model.h"
+
+/***************** Macros (Inline Functions) Definitions *********************/
+#define lwea(Addr)		((u32)CdoSim_Read((u64)(Addr), 4U))
+#define lhuea(Addr)		((u16)CdoSim_Read((u64)(Addr), 2U))
+#define lbuea(Addr)		((u8)CdoSim_Read((u64)(Addr), 1U))
+#define swea(Addr, Data)	CdoSim_Write((u64)(Addr), (u32)(Data), 4U)
+#define shea(Addr, Data)	CdoSim_Write((u64)(Addr), (u16)(Data), 2U)
+#define sbea(Addr, Data)	CdoSim_Write((u64)(Addr), (u8)(Data), 1U)
+
+#ifndef mfmsr
+#define mfmsr()			((UINTPTR)0U)
+#endif
+#define mtmsr(Value)		((void)(Value))
+#ifndef mb_sleep
+#define mb_sleep()		((void)0)
+#endif
+#define mbar(Mask)		((void)0)
+#define microblaze_enable_interrupts()	((void)0)
+#define microblaze_disable_interrupts()	((void)0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MICROBLAZE_INTERFACE_H_ */
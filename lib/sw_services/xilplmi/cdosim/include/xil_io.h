@@ -0,0 +1,109 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file cdosim/include/xil_io.h
+*
+* Host replacement of the standalone xil_io.h. All register accesses are
+* routed to the CDO simulator register model.
+*
+******************************************************************************/
+#ifndef XIL_IO_H
+#define XIL_IO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+#include "xil_printf.h"
+#include "xstatus.h"
+#include "mb_interface.h"
+#include "cdosim_model.h"
+
+/***************** Macros (Inline Functions) Definitions *********************/
+#define INLINE		inline
+#define INST_SYNC
+#define DATA_SYNC
+
+static INLINE u8 Xil_In8(UINTPTR Addr)
+{
+	return (u8)CdoSim_Read((u64)Addr, 1U);
+}
+
+static INLINE u16 Xil_In16(UINTPTR Addr)
+{
+	return (u16)CdoSim_Read((u64)Addr, 2U);
+}
+
+static INLINE u32 Xil_In32(UINTPTR Addr)
+{
+	return (u32)CdoSim_Read((u64)Addr, 4U);
+}
+
+static INLINE u64 Xil_In64(UINTPTR Addr)
+{
+	return CdoSim_Read((u64)Addr, 8U);
+}
+
+static INLINE void Xil_Out8(UINTPTR Addr, u8 Value)
+{
+	CdoSim_Write((u64)Addr, Value, 1U);
+}
+
+static INLINE void Xil_Out16(UINTPTR Addr, u16 Value)
+{
+	CdoSim_Write((u64)Addr, Value, 2U);
+}
+
+static INLINE void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+	CdoSim_Write((u64)Addr, Value, 4U);
+}
+
+static INLINE void Xil_Out64(UINTPTR Addr, u64 Value)
+{
+	CdoSim_Write((u64)Addr, Value, 8U);
+}
+
+static INLINE int Xil_SecureOut32(UINTPTR Addr, u32 Value)
+{
+	int Status = XST_FAILURE;
+
+	Xil_Out32(Addr, Value);
+	if (Xil_In32(Addr) == Value) {
+		Status = XST_SUCCESS;
+	}
+
+	return Status;
+}
+
+static INLINE u16 Xil_EndianSwap16(u16 Data)
+{
+	return (u16)(((Data & 0xFF00U) >> 8U) | ((Data & 0x00FFU) << 8U));
+}
+
+static INLINE u32 Xil_EndianSwap32(u32 Data)
+{
+	return __builtin_bswap32(Data);
+}
+
+#define Xil_In16LE	Xil_In16
+#define Xil_In32LE	Xil_In32
+#define Xil_Out16LE	Xil_Out16
+#define Xil_Out32LE	Xil_Out32
+#define Xil_Htons	Xil_EndianSwap16
+#define Xil_Htonl	Xil_EndianSwap32
+#define Xil_Ntohs	Xil_EndianSwap16
+#define Xil_Ntohl	Xil_EndianSwap32
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XIL_IO_H */
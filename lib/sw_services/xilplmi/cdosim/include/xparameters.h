@@ -0,0 +1,29 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file cdosim/include/xparameters.h
+*
+* Minimal hardware parameters of a Versal PMC needed to build the xilplmi
+* CDO processing code on a host.
+*
+******************************************************************************/
+#ifndef XPARAMETERS_H
+#define XPARAMETERS_H
+
+#define STDOUT_BASEADDRESS				0xF1920000U
+#define XPAR_PSV_PMC_RAM_INSTR_CNTLR_S_AXI_BASEADDR	0xF0200000U
+#define XPAR_PSV_PMC_RAM_DATA_CNTLR_S_AXI_HIGHADDR	0xF023FFFFU
+#define XPAR_XUARTPSV_NUM_INSTANCES			1U
+#define XPAR_XIPIPSU_NUM_INSTANCES			1U
+#define XPAR_XIPIPSU_0_DEVICE_ID			0U
+#define XPAR_XIPIPSU_NUM_TARGETS			7U
+#define XPAR_XCSUDMA_NUM_INSTANCES			2U
+#define XPAR_IOMODULE_INTC_MAX_INTR_SIZE		32U
+#define XPAR_IOMODULE_0_DEVICE_ID			0U
+
+#endif /* XPARAMETERS_H */
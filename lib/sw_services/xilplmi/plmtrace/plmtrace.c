@@ -0,0 +1,254 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file plmtrace.c
+*
+* This file contains the host decoder of the PLM trace log. It reads the
+* trace buffer retrieved with the event logging command and prints every
+* event with its time stamp, using the format strings of
+* xplmi_trace_events.h. It also writes the event table to a side file.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agent 10/17/2026 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "xplmi_modules.h"
+
+/************************** Constant Definitions *****************************/
+/* Trace event header fields, see xplmi_event_logging.h */
+#define PLMTRACE_MODULE_SHIFT		(8U)
+#define PLMTRACE_LEN_SHIFT		(16U)
+#define PLMTRACE_WORD_LEN		(4U)
+#define PLMTRACE_HDR_WORDS		(3U)
+#define PLMTRACE_MAX_ARGS		(4U)
+#define PLMTRACE_ID_MASK		(0xFFFFU)
+#define PLMTRACE_LEN_MASK		(0xFFU)
+#define PLMTRACE_MAX_DUMP_SIZE		(0x1000000U)
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u32 Id;			/**< Module ID and event number */
+	const char *Name;	/**< Event name in the PLM sources */
+	const char *Format;	/**< printf format of the arguments */
+} PlmTrace_Event;
+
+/************************** Function Prototypes ******************************/
+static void PlmTrace_Usage(const char *Name);
+static const PlmTrace_Event *PlmTrace_Lookup(u32 Id);
+static int PlmTrace_WriteTable(const char *File);
+static int PlmTrace_Decode(const char *File, int Raw);
+
+/************************** Variable Definitions *****************************/
+static const PlmTrace_Event Events[] = {
+#define XPLMI_TRACE_EVENT(Name, ModuleId, EventNum, Format) \
+	{ (((ModuleId) << PLMTRACE_MODULE_SHIFT) | (EventNum)), #Name, Format },
+#include "xplmi_trace_events.h"
+#undef XPLMI_TRACE_EVENT
+};
+
+static void PlmTrace_Usage(const char *Name)
+{
+	fprintf(stderr,
+		"usage: %s [-r] [-t <table file>] [trace file]\n"
+		"  -r	print the raw words of every event\n"
+		"  -t	write the trace event table to <table file>\n",
+		Name);
+}
+
+static const PlmTrace_Event *PlmTrace_Lookup(u32 Id)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < (sizeof(Events) / sizeof(Events[0U]));
+		Index++) {
+		if (Events[Index].Id == Id) {
+			return &Events[Index];
+		}
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function writes the trace event table, one event per line
+ * with the event ID, name and format, so that traces can be read without
+ * the decoder.
+ *
+ * @param	File is the table file to be written
+ *
+ * @return	0 on success, -1 otherwise
+ *
+ *****************************************************************************/
+static int PlmTrace_WriteTable(const char *File)
+{
+	FILE *Fp;
+	u32 Index;
+
+	Fp = fopen(File, "w");
+	if (Fp == NULL) {
+		perror(File);
+		return -1;
+	}
+	fprintf(Fp, "# PLM trace events: id name format\n");
+	for (Index = 0U; Index < (sizeof(Events) / sizeof(Events[0U]));
+		Index++) {
+		fprintf(Fp, "0x%04x %s \"%s\"\n", Events[Index].Id,
+			Events[Index].Name, Events[Index].Format);
+	}
+
+	return (fclose(Fp) == 0) ? 0 : -1;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function decodes a trace buffer dump. The dump is the
+ * little endian word stream copied by the retrieve trace data command,
+ * oldest event first. When the buffer has wrapped, the first event is
+ * usually cut, so words which do not start a known event are skipped
+ * until the stream is in sync again.
+ *
+ * @param	File is the trace dump, NULL for stdin
+ * @param	Raw prints the words of every event if not 0
+ *
+ * @return	0 on success, -1 otherwise
+ *
+ *****************************************************************************/
+static int PlmTrace_Decode(const char *File, int Raw)
+{
+	FILE *Fp = stdin;
+	u8 *Buf;
+	size_t Size;
+	u32 NumWords;
+	u32 Index = 0U;
+	u32 Skipped = 0U;
+	u32 NumEvents = 0U;
+	u32 Word;
+	u32 Len;
+	u32 ArgIndex;
+	u32 Args[PLMTRACE_MAX_ARGS];
+	const PlmTrace_Event *Event;
+
+	if (File != NULL) {
+		Fp = fopen(File, "rb");
+		if (Fp == NULL) {
+			perror(File);
+			return -1;
+		}
+	}
+	Buf = malloc(PLMTRACE_MAX_DUMP_SIZE);
+	if (Buf == NULL) {
+		if (Fp != stdin) {
+			fclose(Fp);
+		}
+		return -1;
+	}
+	Size = fread(Buf, 1U, PLMTRACE_MAX_DUMP_SIZE, Fp);
+	if (Fp != stdin) {
+		fclose(Fp);
+	}
+	NumWords = (u32)(Size / PLMTRACE_WORD_LEN);
+
+#define PLMTRACE_WORD(Idx) \
+	((u32)Buf[(Idx) * 4U] | ((u32)Buf[((Idx) * 4U) + 1U] << 8U) | \
+	((u32)Buf[((Idx) * 4U) + 2U] << 16U) | \
+	((u32)Buf[((Idx) * 4U) + 3U] << 24U))
+
+	while (Index < NumWords) {
+		Word = PLMTRACE_WORD(Index);
+		Len = (Word >> PLMTRACE_LEN_SHIFT) & PLMTRACE_LEN_MASK;
+		Event = PlmTrace_Lookup(Word & PLMTRACE_ID_MASK);
+		if ((Event == NULL) || ((Word >> 24U) != 0U) ||
+			(Len < PLMTRACE_HDR_WORDS) ||
+			(Len > (PLMTRACE_HDR_WORDS + PLMTRACE_MAX_ARGS)) ||
+			(Len > (NumWords - Index))) {
+			/* Erased buffer or cut event, resync on the next word */
+			++Skipped;
+			++Index;
+			continue;
+		}
+
+		(void)memset(Args, 0, sizeof(Args));
+		for (ArgIndex = PLMTRACE_HDR_WORDS; ArgIndex < Len; ArgIndex++) {
+			Args[ArgIndex - PLMTRACE_HDR_WORDS] =
+				PLMTRACE_WORD(Index + ArgIndex);
+		}
+		printf("[%u.%06u] %s: ", PLMTRACE_WORD(Index + 1U),
+			PLMTRACE_WORD(Index + 2U), Event->Name);
+		printf(Event->Format, Args[0U], Args[1U], Args[2U], Args[3U]);
+		if (Raw != 0) {
+			printf("  {");
+			for (ArgIndex = 0U; ArgIndex < Len; ArgIndex++) {
+				printf(" %08x", PLMTRACE_WORD(Index + ArgIndex));
+			}
+			printf(" }");
+		}
+		printf("\n");
+		++NumEvents;
+		Index += Len;
+	}
+
+#undef PLMTRACE_WORD
+
+	fprintf(stderr, "%u events decoded, %u words skipped\n", NumEvents,
+		Skipped);
+	free(Buf);
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	int Opt;
+	int Raw = 0;
+	const char *TableFile = NULL;
+
+	while ((Opt = getopt(argc, argv, "rt:h")) != -1) {
+		switch (Opt) {
+		case 'r':
+			Raw = 1;
+			break;
+		case 't':
+			TableFile = optarg;
+			break;
+		default:
+			PlmTrace_Usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (TableFile != NULL) {
+		if (PlmTrace_WriteTable(TableFile) != 0) {
+			return 1;
+		}
+		if (optind >= argc) {
+			return 0;
+		}
+	}
+	if ((argc - optind) > 1) {
+		PlmTrace_Usage(argv[0]);
+		return 1;
+	}
+
+	return (PlmTrace_Decode((optind < argc) ? argv[optind] : NULL,
+		Raw) == 0) ? 0 : 1;
+}
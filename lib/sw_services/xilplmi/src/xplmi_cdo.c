@@ -30,6 +30,9 @@
 *                       boot modes
 *       bm   10/14/2020 Code clean up
 *       td	 10/19/2020 MISRA C Fixes
+* 1.03  agent 10/17/2026 Added coalescing of contiguous write commands
+*       agent 10/17/2026 Wait for background memory initialization at CDO end
+*       agent 10/17/2026 Log CDO header and end as trace events
 *
 * </pre>
 *
@@ -41,10 +44,26 @@
 #include "xplmi_cdo.h"
 #include "xplmi_proc.h"
 #include "xil_util.h"
+#include "xplmi_dma.h"
 
 /************************** Constant Definitions *****************************/
 #define XPLMI_CMD_LEN_TEMPBUF		(0x8U)
 
+#ifdef PLM_ENABLE_CDO_WRITE_COALESCE
+/* Command headers of the PLM Write and MaskWrite commands */
+#define XPLMI_CMD_WRITE			(0x00020103U)
+#define XPLMI_CMD_MASK_WRITE		(0x00030102U)
+#define XPLMI_CMD_WRITE_LEN		(3U)
+#define XPLMI_CMD_MASK_WRITE_LEN	(4U)
+#define XPLMI_CMD_MASK_WRITE_FULL	(0xFFFFFFFFU)
+
+/* Minimum and maximum number of writes coalesced into one DMA transfer */
+#ifndef XPLMI_CDO_WR_BURST_MIN_LEN
+#define XPLMI_CDO_WR_BURST_MIN_LEN	(8U)
+#endif
+#define XPLMI_CDO_WR_BURST_MAX_LEN	(64U)
+#endif
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -52,6 +71,9 @@
 /************************** Function Prototypes ******************************/
 
 /************************** Variable Definitions *****************************/
+#ifdef PLM_ENABLE_CDO_WRITE_COALESCE
+static u32 XPlmi_CdoWrBurstBuf[XPLMI_CDO_WR_BURST_MAX_LEN];
+#endif
 
 /*****************************************************************************/
 
@@ -155,10 +177,7 @@ static int XPlmi_CdoVerifyHeader(XPlmiCdo *CdoPtr)
 		Status = XST_SUCCESS;
 	}
 
-	XPlmi_Printf(DEBUG_INFO,
-		"Config Object Version 0x%08x\n\r", CdoHdr[2U]);
-	XPlmi_Printf(DEBUG_INFO,
-		"Length 0x%08x\n\r", CdoHdr[3U]);
+	XPlmi_TraceLog4((u32)XPLMI_TRACE_LOG_CDO_HDR, CdoHdr[2U], CdoHdr[3U]);
 
 END:
 	return Status;
@@ -328,7 +347,7 @@ static int XPlmi_CdoCmdExecute(XPlmiCdo *CdoPtr, u32 *BufPtr, u32 BufLen, u32 *S
 	 * irrespective of the CDO length
 	 */
 	if (BufPtr[0U] == XPLMI_CMD_END) {
-		XPlmi_Printf(DEBUG_INFO, "CMD END detected \n\r");
+		XPlmi_TraceLog2((u32)XPLMI_TRACE_LOG_CDO_END);
 		CdoPtr->CmdEndDetected = (u8)TRUE;
 		Status = XST_SUCCESS;
 		goto END;
@@ -394,6 +413,118 @@ END:
 	return Status;
 }
 
+#ifdef PLM_ENABLE_CDO_WRITE_COALESCE
+/*****************************************************************************/
+/**
+ * @brief	This function checks if the buffer starts with a run of Write
+ * commands, or MaskWrite commands with all mask bits set, to consecutive
+ * word addresses. If the run is long enough, the values are gathered and
+ * written to the registers with a single DMA transfer.
+ * The run ends at any other command, such as MaskPoll, at a non
+ * consecutive address or at the end of the buffer. Commands split across
+ * buffers are left to the regular command execution.
+ *
+ * @param	BufPtr is pointer to the buffer
+ * @param	BufLen is length of the buffer
+ * @param	Size is pointer to the Size consumed, 0 if the buffer does not
+ *		start with a run that is worth coalescing
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XPlmi_CdoWriteBurst(const u32 *BufPtr, u32 BufLen, u32 *Size)
+{
+	int Status = XST_FAILURE;
+	u32 Count = 0U;
+	u32 Offset = 0U;
+	u32 Addr = 0U;
+	u32 CmdAddr;
+	u32 CmdLen;
+	u32 Value;
+#ifdef PLM_ENABLE_CMD_PROFILE
+	u32 NumMaskWrites = 0U;
+	u64 StartTime;
+	u64 Cycles;
+	u64 MaskWriteCycles;
+#endif
+
+	*Size = 0U;
+	while (Count < XPLMI_CDO_WR_BURST_MAX_LEN) {
+		if ((BufPtr[Offset] == XPLMI_CMD_WRITE) &&
+			((BufLen - Offset) >= XPLMI_CMD_WRITE_LEN)) {
+			CmdAddr = BufPtr[Offset + 1U];
+			Value = BufPtr[Offset + 2U];
+			CmdLen = XPLMI_CMD_WRITE_LEN;
+		}
+		else if ((BufPtr[Offset] == XPLMI_CMD_MASK_WRITE) &&
+			((BufLen - Offset) >= XPLMI_CMD_MASK_WRITE_LEN) &&
+			(BufPtr[Offset + 2U] == XPLMI_CMD_MASK_WRITE_FULL)) {
+			CmdAddr = BufPtr[Offset + 1U];
+			Value = BufPtr[Offset + 3U];
+			CmdLen = XPLMI_CMD_MASK_WRITE_LEN;
+		}
+		else {
+			break;
+		}
+
+		if (Count == 0U) {
+			if ((CmdAddr & (XPLMI_WORD_LEN - 1U)) != 0U) {
+				break;
+			}
+			Addr = CmdAddr;
+		}
+		else if (CmdAddr != (Addr + (Count * XPLMI_WORD_LEN))) {
+			break;
+		}
+		else {
+			/* Consecutive address, add to the run */
+		}
+
+		XPlmi_CdoWrBurstBuf[Count] = Value;
+		++Count;
+#ifdef PLM_ENABLE_CMD_PROFILE
+		if (CmdLen == XPLMI_CMD_MASK_WRITE_LEN) {
+			++NumMaskWrites;
+		}
+#endif
+		Offset += CmdLen;
+		if (Offset >= BufLen) {
+			break;
+		}
+	}
+
+	if (Count < XPLMI_CDO_WR_BURST_MIN_LEN) {
+		Status = XST_SUCCESS;
+		goto END;
+	}
+
+	XPlmi_Printf(DEBUG_DETAILED, "Coalesced %u writes to 0x%08x\n\r",
+		Count, Addr);
+#ifdef PLM_ENABLE_CMD_PROFILE
+	StartTime = XPlmi_GetTimerValue();
+#endif
+	Status = XPlmi_DmaXfr((u64)(UINTPTR)XPlmi_CdoWrBurstBuf, (u64)Addr,
+		Count, XPLMI_PMCDMA_0);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+#ifdef PLM_ENABLE_CMD_PROFILE
+	/* Account every coalesced command, sharing the time of the DMA */
+	Cycles = StartTime - XPlmi_GetTimerValue();
+	MaskWriteCycles = (Cycles * NumMaskWrites) / Count;
+	XPlmi_StoreCmdProfileRun(XPLMI_CMD_WRITE, Cycles - MaskWriteCycles,
+		Count - NumMaskWrites,
+		(Count - NumMaskWrites) * (XPLMI_CMD_WRITE_LEN - 1U));
+	XPlmi_StoreCmdProfileRun(XPLMI_CMD_MASK_WRITE, MaskWriteCycles,
+		NumMaskWrites, NumMaskWrites * (XPLMI_CMD_MASK_WRITE_LEN - 1U));
+#endif
+	*Size = Offset;
+
+END:
+	return Status;
+}
+#endif
+
 /*****************************************************************************/
 /**
  * @brief	This function process the CDO file.
@@ -449,8 +580,6 @@ int XPlmi_ProcessCdo(XPlmiCdo *CdoPtr)
 		goto END;
 	}
 
-	XPlmi_Printf(DEBUG_INFO,
-			"Processing CDO, Chunk Len 0x%08x\n\r", BufLen);
 	/*
 	 * Check if cmd data is copied
 	 * partially during the last iteration
@@ -466,6 +595,21 @@ int XPlmi_ProcessCdo(XPlmiCdo *CdoPtr)
 
 	/* Execute the commands in the Cdo Buffer */
 	while (BufLen > 0U) {
+#ifdef PLM_ENABLE_CDO_WRITE_COALESCE
+		/* Write runs fully present in the CDO buffer go as one DMA */
+		if ((CdoPtr->CmdState == XPLMI_CMD_STATE_START) &&
+			(CopiedCmdLen == 0U)) {
+			Status = XPlmi_CdoWriteBurst(BufPtr, BufLen, &Size);
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
+			if (Size != 0U) {
+				BufPtr += Size;
+				BufLen -= Size;
+				continue;
+			}
+		}
+#endif
 		/* Check if cmd has to be resumed */
 		if (CdoPtr->CmdState == XPLMI_CMD_STATE_RESUME) {
 			Status =
@@ -499,6 +643,12 @@ int XPlmi_ProcessCdo(XPlmiCdo *CdoPtr)
 	Status = XST_SUCCESS;
 
 END:
+	/* Memory initialization started by the CDO completes with it */
+	if ((Status == XST_SUCCESS) &&
+		((CdoPtr->CmdEndDetected == (u8)TRUE) ||
+		(CdoPtr->ProcessedCdoLen == CdoPtr->CdoLen))) {
+		Status = XPlmi_WaitForMemInit();
+	}
 #ifdef PLM_PRINT_PERF_CDO_PROCESS
 	XPlmi_MeasurePerfTime(ProcessTime, &PerfTime);
 	XPlmi_Printf(DEBUG_PRINT_PERF,
@@ -21,6 +21,8 @@
 *                       IDs
 *       bm   10/14/2020 Code clean up
 *       td   10/19/2020 MISRA C Fixes
+* 1.03  agent 10/17/2026 Added command profiling
+*       agent 10/17/2026 Sync commands with background memory initialization
 * </pre>
 *
 * </pre>
@@ -33,6 +35,8 @@
 #include "xplmi_cmd.h"
 #include "xplmi_debug.h"
 #include "xplmi_modules.h"
+#include "xplmi_generic.h"
+#include "xplmi_dma.h"
 #include "xil_assert.h"
 
 /************************** Constant Definitions *****************************/
@@ -42,9 +46,53 @@
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
+static int XPlmi_CmdWaitForMemInit(const XPlmi_Cmd *CmdPtr, u32 ModuleId,
+		u32 ApiId);
 
 /************************** Variable Definitions *****************************/
 
+/*****************************************************************************/
+/**
+ * @brief	This function waits for the memory initialization running in
+ * background if the command can access the memory being initialized.
+ * Generic register commands wait only if their address is in the region,
+ * delay and nop commands never wait.
+ *
+ * @param	CmdPtr is pointer to command structure
+ * @param	ModuleId is module ID of the command
+ * @param	ApiId is API ID of the command
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XPlmi_CmdWaitForMemInit(const XPlmi_Cmd *CmdPtr, u32 ModuleId,
+		u32 ApiId)
+{
+	int Status = XST_FAILURE;
+	u64 Addr;
+
+	if (ModuleId != XPLMI_MODULE_GENERIC_ID) {
+		Status = XPlmi_WaitForMemInit();
+	} else if ((ApiId == XPLMI_PLM_GENERIC_MASK_POLL_VAL) ||
+		(ApiId == XPLMI_PLM_GENERIC_MASK_WRITE_VAL) ||
+		(ApiId == XPLMI_PLM_GENERIC_WRITE_VAL)) {
+		Status = XPlmi_WaitForMemInitRange((u64)CmdPtr->Payload[0U],
+			XPLMI_WORD_LEN);
+	} else if ((ApiId == XPLMI_PLM_GENERIC_MASK_POLL64_VAL) ||
+		(ApiId == XPLMI_PLM_GENERIC_MASK_WRITE64_VAL) ||
+		(ApiId == XPLMI_PLM_GENERIC_WRITE64_VAL)) {
+		Addr = ((u64)CmdPtr->Payload[0U] << 32U) | CmdPtr->Payload[1U];
+		Status = XPlmi_WaitForMemInitRange(Addr, XPLMI_WORD_LEN);
+	} else if ((ApiId == XPLMI_PLM_GENERIC_DELAY_VAL) ||
+		(ApiId == XPLMI_PLM_GENERIC_NOP_VAL)) {
+		Status = XST_SUCCESS;
+	} else {
+		Status = XPlmi_WaitForMemInit();
+	}
+
+	return Status;
+}
+
 /*****************************************************************************/
 /*****************************************************************************/
 /**
@@ -64,6 +112,9 @@ int XPlmi_CmdExecute(XPlmi_Cmd *CmdPtr)
 	u32 ApiId = CmdPtr->CmdId & XPLMI_CMD_API_ID_MASK;
 	const XPlmi_Module *Module = NULL;
 	const XPlmi_ModuleCmd *ModuleCmd = NULL;
+#ifdef PLM_ENABLE_CMD_PROFILE
+	u64 CmdTime;
+#endif
 
 	XPlmi_Printf(DEBUG_DETAILED, "CMD Execute \n\r");
 	/* Assign Module */
@@ -90,8 +141,20 @@ int XPlmi_CmdExecute(XPlmi_Cmd *CmdPtr)
 	XPlmi_Printf(DEBUG_DETAILED, "CMD 0x%0x, Len 0x%0x, PayloadLen 0x%0x \n\r",
 			CmdPtr->CmdId, CmdPtr->Len, CmdPtr->PayloadLen);
 
+	Status = XPlmi_CmdWaitForMemInit(CmdPtr, ModuleId, ApiId);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
 	/* Run the command handler */
+#ifdef PLM_ENABLE_CMD_PROFILE
+	CmdTime = XPlmi_GetTimerValue();
+#endif
 	Status = ModuleCmd->Handler(CmdPtr);
+#ifdef PLM_ENABLE_CMD_PROFILE
+	XPlmi_StoreCmdProfile(CmdPtr->CmdId, CmdTime, CmdPtr->PayloadLen,
+		(u8)FALSE);
+#endif
 	if (Status != XST_SUCCESS) {
 		CdoErr = (u32)XPLMI_ERR_CDO_CMD + (CmdPtr->CmdId & XPLMI_ERR_CDO_CMD_MASK);
 		Status = XPlmi_UpdateStatus((XPlmiStatus_t)CdoErr, Status);
@@ -120,10 +183,20 @@ END:
 int XPlmi_CmdResume(XPlmi_Cmd * CmdPtr)
 {
 	int Status = XST_FAILURE;
+#ifdef PLM_ENABLE_CMD_PROFILE
+	u64 CmdTime;
+#endif
 
 	XPlmi_Printf(DEBUG_DETAILED, "CMD Resume \n\r");
 	Xil_AssertNonvoid(CmdPtr->ResumeHandler != NULL);
+#ifdef PLM_ENABLE_CMD_PROFILE
+	CmdTime = XPlmi_GetTimerValue();
+#endif
 	Status = CmdPtr->ResumeHandler(CmdPtr);
+#ifdef PLM_ENABLE_CMD_PROFILE
+	XPlmi_StoreCmdProfile(CmdPtr->CmdId, CmdTime, CmdPtr->PayloadLen,
+		(u8)TRUE);
+#endif
 	if (Status != XST_SUCCESS) {
 		Status = XPlmi_UpdateStatus(XPLMI_ERR_RESUME_HANDLER, Status);
 		goto END;
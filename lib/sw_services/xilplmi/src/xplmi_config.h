@@ -26,6 +26,11 @@
 * 1.04  kc   01/07/2020 Added MACRO to get performance number for keyhole
 * 1.05  rama 08/12/2020 Added macro to exclude STL by default
 *       bm   10/14/2020 Code clean up
+* 1.06  agent 10/17/2026 Added macro to enable the command profiler
+*       agent 10/17/2026 Added macro to enable CDO write coalescing
+*       agent 10/17/2026 Added macro to enable the subsystem image cache
+*       agent 10/17/2026 Added macro to enable the secure copy overlap
+*       agent 10/17/2026 Added macro to set the default trace modules
 *
 * </pre>
 *
@@ -99,6 +104,47 @@ extern "C" {
 //#define PLM_PRINT_PERF_KEYHOLE
 //#define PLM_PRINT_PERF_PL
 
+/**
+ * Enabling PLM_ENABLE_CMD_PROFILE records the call count, total and maximum
+ * timer cycles and payload bytes of every CDO/IPI command, per module and
+ * API ID. The table is retrieved with the event logging commands and does
+ * not depend on PLM_PRINT_PERF.
+ */
+//#define PLM_ENABLE_CMD_PROFILE
+
+/**
+ * Enabling PLM_ENABLE_CDO_WRITE_COALESCE executes runs of CDO Write
+ * commands to consecutive addresses as a single PMCDMA0 transfer.
+ * MaskWrite commands with all mask bits set are treated as Write commands.
+ */
+//#define PLM_ENABLE_CDO_WRITE_COALESCE
+
+/**
+ * Enabling PLM_ENABLE_IMAGE_CACHE keeps a copy of the subsystem images of
+ * the boot PDI in the DDR region defined by XLOADER_IMAGE_CACHE_ADDR and
+ * XLOADER_IMAGE_CACHE_SIZE. Subsystem restart then loads the image from DDR
+ * instead of the boot device. The region must be reserved for the PLM.
+ */
+//#define PLM_ENABLE_IMAGE_CACHE
+
+/**
+ * Enabling PLM_ENABLE_SECURE_COPY_OVERLAP copies the chunks of authenticated
+ * and checksummed partitions to their destination on PMCDMA1 while PMCDMA0
+ * feeds them to the SHA3 engine. The destination then holds each chunk
+ * before its hash is verified and is cleared if verification fails. The
+ * first block, whose hash is covered by the signature, is always copied
+ * after verification.
+ */
+//#define PLM_ENABLE_SECURE_COPY_OVERLAP
+
+/**
+ * PLM_TRACE_LOG_MODULES sets the modules whose trace events are logged from
+ * boot, bit N for module ID N. Module 0 events are always logged. By
+ * default the XilPlmi CDO and XilLoader partition events are logged too.
+ * The mask can be changed at run time with the event logging command.
+ */
+//#define PLM_TRACE_LOG_MODULES		(0x0U)
+
 /**
  * @name PLM code include options
  *
@@ -27,6 +27,9 @@
 *                       boot modes
 *       bm   10/14/2020 Code clean up
 *       td   10/19/2020 MISRA C Fixes
+* 1.04  agent 10/17/2026 Split memory initialization across both PMC DMAs and
+*                        added non blocking memory initialization
+*       agent 10/17/2026 Added API to get PMC DMAs with non blocking transfers
 *
 * </pre>
 *
@@ -44,10 +47,25 @@
 #include "xplmi_hw.h"
 
 /************************** Constant Definitions *****************************/
+/* Memory initialization smaller than this (in bytes) uses PMCDMA0 alone */
+#define XPLMI_MEMINIT_SPLIT_MIN_LEN	(0x4000U)
+#define XPLMI_MEMINIT_PATTERN_WORDS	(XPLMI_PZM_WORD_LEN / XPLMI_WORD_LEN)
+#define XPLMI_MEMINIT_PATTERN_MASK	((u32)XPLMI_PZM_WORD_LEN - 1U)
 
 /**************************** Type Definitions *******************************/
+/**
+ * Memory initialization which is in progress on the PMC DMAs
+ */
+typedef struct {
+	u32 DmaFlags;		/**< PMC DMAs running the initialization */
+	u32 LoopbackFlags;	/**< PMC DMAs running DMA to DMA transfers */
+	u64 Addr;		/**< Start address of the region */
+	u64 Len;		/**< Length of the region in bytes */
+} XPlmi_MemInit;
 
 /***************** Macros (Inline Functions) Definitions *********************/
+#define XPLMI_GET_DMA_FLAG(Flags)	((((Flags) & XPLMI_PMCDMA_0) == \
+		XPLMI_PMCDMA_0) ? XPLMI_PMCDMA_0 : XPLMI_PMCDMA_1)
 
 /************************** Function Prototypes ******************************/
 static int XPlmi_DmaDrvInit(XPmcDma *DmaPtr, u32 DeviceId);
@@ -58,12 +76,25 @@ static void XPlmi_SSSCfgDmaSbi(u32 Flags);
 static int XPlmi_DmaChXfer(u64 Addr, u32 Len, XPmcDma_Channel Channel, u32 Flags);
 static int XPlmi_StartDma(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags,
                 XPmcDma** DmaPtrAddr);
+static u32 XPlmi_SetMemInitPattern(u32 Val);
+static u32 XPlmi_GetMemInitDmas(u64 Len);
+static void XPlmi_StartMemSet(u64 DestAddr, u32 PatternAddr, u32 Len,
+		u32 Flags);
+static int XPlmi_WaitForMemInitDma(u32 DmaFlags);
 
 /************************** Variable Definitions *****************************/
 static XPmcDma PmcDma0;		/**<Instance of the Pmc_Dma Device */
 static XPmcDma PmcDma1;		/**<Instance of the Pmc_Dma Device */
 static XPmcDma_Configure DmaCtrl = {0x40U, 0U, 0U, 0U, 0xFFEU, 0x80U,
 			0U, 0U, 0U, 0xFFFU, 0x8U};  /* Default values of CTRL */
+static XPlmi_MemInit MemInit;	/**< Memory initialization in progress */
+static u32 NonBlkDmaFlags;	/**< PMC DMAs with non blocking transfers of
+				  other users in flight */
+/*
+ * Source of the memory set transfers. Read with AXI FIXED bursts from its
+ * 16 byte aligned half, so it holds twice the PZM word.
+ */
+static u32 MemInitPattern[XPLMI_MEMINIT_PATTERN_WORDS * 2U];
 
 /*****************************************************************************/
 /**
@@ -143,13 +174,19 @@ END:
  *
  * @param	DeviceId is PMC DMA's device ID
  *
- * @return	PMC DMA instance pointer.
+ * @return	PMC DMA instance pointer, NULL if the DMA is not ready or
+ *		memory initialization running on it failed
  *
  *****************************************************************************/
 XPmcDma *XPlmi_GetDmaInstance(u32 DeviceId)
 {
 	XPmcDma *PmcDmaPtr = NULL;
 
+	/* The caller takes over the DMA, so memory initialization must end */
+	if (XPlmi_WaitForMemInit() != XST_SUCCESS) {
+		goto END;
+	}
+
 	if (DeviceId == (u32)PMCDMA_0_DEVICE_ID) {
 		if (PmcDma0.IsReady != (u32)FALSE) {
 			PmcDmaPtr = &PmcDma0;
@@ -162,6 +199,7 @@ XPmcDma *XPlmi_GetDmaInstance(u32 DeviceId)
 		/* Do nothing */
 	}
 
+END:
 	return PmcDmaPtr;
 }
 
@@ -324,6 +362,7 @@ static int XPlmi_DmaChXfer(u64 Addr, u32 Len, XPmcDma_Channel Channel, u32 Flags
 
 	if (((Flags & XPLMI_DMA_SRC_NONBLK) != 0U) ||
 		((Flags & XPLMI_DMA_DST_NONBLK) != 0U)) {
+		NonBlkDmaFlags |= XPLMI_GET_DMA_FLAG(Flags);
 		Status = XST_SUCCESS;
 		goto END;
 	}
@@ -399,6 +438,7 @@ int XPlmi_WaitForNonBlkDma(u32 DmaFlags)
 	XPmcDma_SetConfig(PmcDmaPtr, XPMCDMA_DST_CHANNEL, &DmaCtrl);
 
 END:
+	NonBlkDmaFlags &= ~XPLMI_GET_DMA_FLAG(DmaFlags);
 	return Status;
 }
 
@@ -439,6 +479,7 @@ int XPlmi_WaitForNonBlkSrcDma(u32 DmaFlags)
 	XPmcDma_SetConfig(PmcDmaPtr, XPMCDMA_SRC_CHANNEL, &DmaCtrl);
 
 END:
+	NonBlkDmaFlags &= ~XPLMI_GET_DMA_FLAG(DmaFlags);
 	return Status;
 }
 
@@ -478,6 +519,7 @@ int XPlmi_WaitForNonBlkDestDma(u32 DmaFlags)
 	XPmcDma_SetConfig(PmcDmaPtr, XPMCDMA_DST_CHANNEL, &DmaCtrl);
 
 END:
+	NonBlkDmaFlags &= ~XPLMI_GET_DMA_FLAG(DmaFlags);
 	return Status;
 }
 
@@ -499,12 +541,18 @@ int XPlmi_SbiDmaXfer(u64 DestAddr, u32 Len, u32 Flags)
 	XPlmi_Printf(DEBUG_INFO, "SBI to Dma Xfer Dest 0x%0x%08x, Len 0x%0x: ",
 		(u32)(DestAddr >> 32U), (u32)DestAddr, Len);
 
+	Status = XPlmi_WaitForMemInit();
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
 	/* Configure the secure stream switch */
 	XPlmi_SSSCfgSbiDma(Flags);
 
 	/* Receive the data from destination channel */
 	Status = XPlmi_DmaChXfer(DestAddr, Len, XPMCDMA_DST_CHANNEL, Flags);
 
+END:
 	return Status;
 }
 
@@ -526,12 +574,18 @@ int XPlmi_DmaSbiXfer(u64 SrcAddr, u32 Len, u32 Flags)
 	XPlmi_Printf(DEBUG_INFO, "Dma to SBI Xfer Src 0x%0x%08x, Len 0x%0x: ",
 		(u32)(SrcAddr >> 32U), (u32)SrcAddr, Len);
 
+	Status = XPlmi_WaitForMemInit();
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
 	/* Configure the secure stream switch */
 	XPlmi_SSSCfgDmaSbi(Flags);
 
 	/* Receive the data from destination channel */
 	Status = XPlmi_DmaChXfer(SrcAddr, Len, XPMCDMA_SRC_CHANNEL, Flags);
 
+END:
 	return Status;
 }
 
@@ -556,11 +610,19 @@ int XPlmi_DmaXfr(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags)
 	XPlmi_PerfTime PerfTime = {0U};
 #endif
 
+	Status = XPlmi_WaitForMemInit();
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
 	Status = XPlmi_StartDma(SrcAddr, DestAddr, Len, Flags, &DmaPtr);
 	if (Status != XST_SUCCESS) {
 		goto END;
 	}
 
+	if ((Flags & (XPLMI_DMA_SRC_NONBLK | XPLMI_DMA_DST_NONBLK)) != (u32)FALSE) {
+		NonBlkDmaFlags |= XPLMI_GET_DMA_FLAG(Flags);
+	}
 	if ((Flags & XPLMI_DMA_SRC_NONBLK) != (u32)FALSE) {
 		goto END;
 	}
@@ -675,89 +737,369 @@ static int XPlmi_StartDma(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags,
 
 /*****************************************************************************/
 /**
- * @brief	This function is used to ECC initialize the memory.
+ * @brief	This function fills the memory set pattern with a value.
+ *
+ * @param	Val is the value of the pattern
+ *
+ * @return	Address of the 16 byte aligned pattern
+ *
+ *****************************************************************************/
+static u32 XPlmi_SetMemInitPattern(u32 Val)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < (XPLMI_MEMINIT_PATTERN_WORDS * 2U); ++Index) {
+		MemInitPattern[Index] = Val;
+	}
+
+	return ((u32)(UINTPTR)&MemInitPattern[0U] + XPLMI_MEMINIT_PATTERN_MASK) &
+		(~XPLMI_MEMINIT_PATTERN_MASK);
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function returns the PMC DMAs to be used for a memory
+ * initialization. PMC DMAs with non blocking transfers of other users in
+ * flight are skipped, and small regions are not split.
  *
- * @param	Addr is  memory address to be initialized
  * @param	Len is size of memory to be initialized in bytes
  *
- * @return	Status of the DMA transfer
+ * @return	PMC DMA flags, 0 if no PMC DMA is free
  *
  *****************************************************************************/
-int XPlmi_EccInit(u64 Addr, u32 Len)
+static u32 XPlmi_GetMemInitDmas(u64 Len)
+{
+	u32 DmaFlags = (XPLMI_PMCDMA_0 | XPLMI_PMCDMA_1) & (~NonBlkDmaFlags);
+
+	if ((Len < XPLMI_MEMINIT_SPLIT_MIN_LEN) &&
+		(DmaFlags == (XPLMI_PMCDMA_0 | XPLMI_PMCDMA_1))) {
+		DmaFlags = XPLMI_PMCDMA_0;
+	}
+
+	return DmaFlags;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function starts a non blocking memory set on a PMC DMA. The
+ * SRC channel reads the pattern with AXI FIXED bursts, so a single transfer
+ * covers the complete region.
+ *
+ * @param	DestAddr is the address of the region
+ * @param	PatternAddr is the address of the 16 byte aligned pattern
+ * @param	Len is size of the region in words
+ * @param	Flags to select PMC DMA
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XPlmi_StartMemSet(u64 DestAddr, u32 PatternAddr, u32 Len,
+		u32 Flags)
+{
+	XPmcDma *DmaPtr;
+	u8 AxiBurstType = DmaCtrl.AxiBurstType;
+
+	if ((Flags & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0) {
+		DmaPtr = &PmcDma0;
+	} else {
+		DmaPtr = &PmcDma1;
+	}
+
+	XPlmi_SSSCfgDmaDma(Flags);
+
+	/*
+	 * The SRC channel keeps AXI FIXED till the transfer is waited on,
+	 * the shared CTRL settings are left as they were for other users
+	 */
+	DmaCtrl.AxiBurstType = 1U;
+	XPmcDma_SetConfig(DmaPtr, XPMCDMA_SRC_CHANNEL, &DmaCtrl);
+	DmaCtrl.AxiBurstType = AxiBurstType;
+
+	XPmcDma_64BitTransfer(DmaPtr, XPMCDMA_DST_CHANNEL,
+		(u32)(DestAddr & 0xFFFFFFFFU), (u32)(DestAddr >> 32U), Len, 0U);
+	XPmcDma_64BitTransfer(DmaPtr, XPMCDMA_SRC_CHANNEL, PatternAddr, 0U,
+		Len, 0U);
+
+	MemInit.DmaFlags |= Flags;
+	MemInit.LoopbackFlags |= Flags;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function waits for the memory initialization on a PMC DMA.
+ *
+ * @param	DmaFlags to differentiate between PMCDMA_0 and PMCDMA_1
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XPlmi_WaitForMemInitDma(u32 DmaFlags)
+{
+	int Status = XST_FAILURE;
+	XPmcDma *DmaPtr;
+
+	if ((DmaFlags & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0) {
+		DmaPtr = &PmcDma0;
+	} else {
+		DmaPtr = &PmcDma1;
+	}
+
+	Status = XPmcDma_WaitForDone(DmaPtr, XPMCDMA_DST_CHANNEL);
+	if (Status != XST_SUCCESS) {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_NON_BLOCK_DEST_DMA_WAIT,
+				Status);
+		goto END;
+	}
+	XPmcDma_IntrClear(DmaPtr, XPMCDMA_DST_CHANNEL, XPMCDMA_IXR_DONE_MASK);
+
+	if ((MemInit.LoopbackFlags & DmaFlags) != 0U) {
+		Status = XPmcDma_WaitForDone(DmaPtr, XPMCDMA_SRC_CHANNEL);
+		if (Status != XST_SUCCESS) {
+			Status = XPlmi_UpdateStatus(XPLMI_ERR_NON_BLOCK_SRC_DMA_WAIT,
+					Status);
+			goto END;
+		}
+		XPmcDma_IntrClear(DmaPtr, XPMCDMA_SRC_CHANNEL,
+				XPMCDMA_IXR_DONE_MASK);
+
+		/* Revert the AXI FIXED setting of the SRC channel */
+		DmaCtrl.AxiBurstType = 0U;
+		XPmcDma_SetConfig(DmaPtr, XPMCDMA_SRC_CHANNEL, &DmaCtrl);
+	}
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function waits till the memory initialization started by
+ * XPlmi_EccInitNonBlk or XPlmi_MemSetNonBlk is complete. It returns
+ * immediately if no memory initialization is in progress.
+ *
+ * @param	None
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+int XPlmi_WaitForMemInit(void)
+{
+	int Status = XST_SUCCESS;
+	int SStatus = XST_FAILURE;
+	u32 DmaFlags = MemInit.DmaFlags;
+
+	if (DmaFlags == 0U) {
+		goto END;
+	}
+	MemInit.DmaFlags = 0U;
+
+	if ((DmaFlags & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0) {
+		Status = XPlmi_WaitForMemInitDma(XPLMI_PMCDMA_0);
+	}
+	if ((DmaFlags & XPLMI_PMCDMA_1) == XPLMI_PMCDMA_1) {
+		SStatus = XPlmi_WaitForMemInitDma(XPLMI_PMCDMA_1);
+		if (Status == XST_SUCCESS) {
+			Status = SStatus;
+		}
+	}
+	MemInit.LoopbackFlags = 0U;
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function waits for the memory initialization in progress
+ * only if it overlaps with the given memory range.
+ *
+ * @param	Addr is start address of the range
+ * @param	Len is size of the range in bytes
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+int XPlmi_WaitForMemInitRange(u64 Addr, u32 Len)
+{
+	int Status = XST_SUCCESS;
+
+	if ((MemInit.DmaFlags != 0U) &&
+		(Addr < (MemInit.Addr + MemInit.Len)) &&
+		((Addr + Len) > MemInit.Addr)) {
+		Status = XPlmi_WaitForMemInit();
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function starts the ECC initialization of the memory and
+ * returns without waiting for it. PZM feeds one PMC DMA and, for large
+ * regions, the other PMC DMA writes the same pattern to the second half as
+ * DMA to DMA transfer. XPlmi_WaitForMemInit completes the initialization,
+ * any other PMC DMA transfer waits for it as well.
+ *
+ * @param	Addr is memory address to be initialized
+ * @param	Len is size of memory to be initialized in bytes
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+int XPlmi_EccInitNonBlk(u64 Addr, u32 Len)
 {
+	int Status = XST_FAILURE;
+	u32 DmaFlags;
+	u32 PzmLen = Len;
+	u32 PatternAddr;
+
 	XPlmi_Printf(DEBUG_INFO, "PZM to Dma Xfer Dest 0x%0x%08x, Len 0x%0x: ",
 		(u32)(Addr >> 32U), (u32)Addr, Len / XPLMI_WORD_LEN);
 
+	Status = XPlmi_WaitForMemInit();
+	if ((Status != XST_SUCCESS) || (Len == 0U)) {
+		goto END;
+	}
+
+	DmaFlags = XPlmi_GetMemInitDmas((u64)Len);
+	if (DmaFlags == 0U) {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_MEMINIT_DMA_BUSY, 0);
+		goto END;
+	}
+	MemInit.Addr = Addr;
+	MemInit.Len = (u64)Len;
+
+	if (DmaFlags == (XPLMI_PMCDMA_0 | XPLMI_PMCDMA_1)) {
+		PzmLen = (Len >> 1U) & (~XPLMI_MEMINIT_PATTERN_MASK);
+		PatternAddr = XPlmi_SetMemInitPattern(XPLMI_DATA_INIT_PZM);
+		XPlmi_StartMemSet(Addr + PzmLen, PatternAddr,
+			(Len - PzmLen) / XPLMI_WORD_LEN, XPLMI_PMCDMA_1);
+		DmaFlags = XPLMI_PMCDMA_0;
+	}
+
 	/* Configure the secure stream switch */
-	XPlmi_SSSCfgDmaPzm(XPLMI_PMCDMA_0);
+	XPlmi_SSSCfgDmaPzm(DmaFlags);
 
 	/* Configure PZM length in 128bit */
-	XPlmi_Out32(PMC_GLOBAL_PRAM_ZEROIZE_SIZE, Len / XPLMI_PZM_WORD_LEN);
+	XPlmi_Out32(PMC_GLOBAL_PRAM_ZEROIZE_SIZE, PzmLen / XPLMI_PZM_WORD_LEN);
 
 	/* Receive the data from destination channel */
-	return XPlmi_DmaChXfer(Addr, Len / XPLMI_WORD_LEN, XPMCDMA_DST_CHANNEL,
-		XPLMI_PMCDMA_0);
+	if ((DmaFlags & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0) {
+		XPmcDma_64BitTransfer(&PmcDma0, XPMCDMA_DST_CHANNEL,
+			(u32)(Addr & 0xFFFFFFFFU), (u32)(Addr >> 32U),
+			PzmLen / XPLMI_WORD_LEN, 0U);
+	} else {
+		XPmcDma_64BitTransfer(&PmcDma1, XPMCDMA_DST_CHANNEL,
+			(u32)(Addr & 0xFFFFFFFFU), (u32)(Addr >> 32U),
+			PzmLen / XPLMI_WORD_LEN, 0U);
+	}
+	MemInit.DmaFlags |= DmaFlags;
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * @brief	This function is used to ECC initialize the memory.
+ *
+ * @param	Addr is  memory address to be initialized
+ * @param	Len is size of memory to be initialized in bytes
+ *
+ * @return	Status of the DMA transfer
+ *
+ *****************************************************************************/
+int XPlmi_EccInit(u64 Addr, u32 Len)
+{
+	int Status = XST_FAILURE;
+
+	Status = XPlmi_EccInitNonBlk(Addr, Len);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	Status = XPlmi_WaitForMemInit();
+
+END:
+	return Status;
+}
 
 /*****************************************************************************/
 /**
- * @brief	This function is used to Set the memory with a value.
+ * @brief	This function starts to set the memory with a value and returns
+ * without waiting for it. Large regions are split across both PMC DMAs.
+ * XPlmi_WaitForMemInit completes the memory set, any other PMC DMA transfer
+ * waits for it as well.
  *
- * @param	DestAddress is the address where the val need to be set
+ * @param	DestAddr is the address where the val need to be set
  * @param	Val is the value that has to be set
  * @param	Len is size of memory to be set in words
  *
- * @return	Status of the DMA transfer
+ * @return	XST_SUCCESS on success and error code on failure
  *
  *****************************************************************************/
-int XPlmi_MemSet(u64 DestAddr, u32 Val, u32 Len)
+int XPlmi_MemSetNonBlk(u64 DestAddr, u32 Val, u32 Len)
 {
 	int Status = XST_FAILURE;
-	u32 Src[XPLMI_SET_CHUNK_SIZE];
-	u32 Count;
-	u32 Index;
-	u32 SrcAddrLow = (u32)(&Src[0U]);
-	u64 SrcAddr = (u64)(SrcAddrLow);
-	u32 ChunkSize;
+	u32 DmaFlags;
+	u32 PatternAddr;
+	u32 Len0 = Len;
 
-	if (Val == XPLMI_DATA_INIT_PZM)	{
-		Status = XPlmi_EccInit(DestAddr, Len * XPLMI_WORD_LEN);
-		if (Status != XST_SUCCESS) {
-			goto END;
-		}
-	} else {
+	if (Val == XPLMI_DATA_INIT_PZM) {
+		Status = XPlmi_EccInitNonBlk(DestAddr, Len * XPLMI_WORD_LEN);
+		goto END;
+	}
 
-		if (Len < XPLMI_SET_CHUNK_SIZE) {
-			ChunkSize = Len;
-		} else {
-			ChunkSize = XPLMI_SET_CHUNK_SIZE;
-		}
+	Status = XPlmi_WaitForMemInit();
+	if ((Status != XST_SUCCESS) || (Len == 0U)) {
+		goto END;
+	}
 
-		for (Index = 0U; Index < ChunkSize; ++Index) {
-			Src[Index] = Val;
-		}
+	DmaFlags = XPlmi_GetMemInitDmas((u64)Len * XPLMI_WORD_LEN);
+	if (DmaFlags == 0U) {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_MEMINIT_DMA_BUSY, 0);
+		goto END;
+	}
+	MemInit.Addr = DestAddr;
+	MemInit.Len = (u64)Len * XPLMI_WORD_LEN;
+	PatternAddr = XPlmi_SetMemInitPattern(Val);
+
+	if (DmaFlags == (XPLMI_PMCDMA_0 | XPLMI_PMCDMA_1)) {
+		Len0 = (Len >> 1U) & (~(XPLMI_MEMINIT_PATTERN_WORDS - 1U));
+		XPlmi_StartMemSet(DestAddr + ((u64)Len0 * XPLMI_WORD_LEN),
+			PatternAddr, Len - Len0, XPLMI_PMCDMA_1);
+		DmaFlags = XPLMI_PMCDMA_0;
+	}
+	XPlmi_StartMemSet(DestAddr, PatternAddr, Len0, DmaFlags);
+	Status = XST_SUCCESS;
 
-		Count = Len / XPLMI_SET_CHUNK_SIZE ;
+END:
+	return Status;
+}
 
-		/* DMA in chunks of 512 Bytes */
-		for (Index = 0U; Index < Count; ++Index) {
-			Status = XPlmi_DmaXfr(SrcAddr, DestAddr, XPLMI_SET_CHUNK_SIZE,
-					XPLMI_PMCDMA_0);
-			if (Status != XST_SUCCESS) {
-				goto END;
-			}
-			DestAddr += (XPLMI_SET_CHUNK_SIZE * XPLMI_WORD_LEN);
-		}
+/*****************************************************************************/
+/**
+ * @brief	This function is used to Set the memory with a value.
+ *
+ * @param	DestAddress is the address where the val need to be set
+ * @param	Val is the value that has to be set
+ * @param	Len is size of memory to be set in words
+ *
+ * @return	Status of the DMA transfer
+ *
+ *****************************************************************************/
+int XPlmi_MemSet(u64 DestAddr, u32 Val, u32 Len)
+{
+	int Status = XST_FAILURE;
 
-		/* DMA of residual bytes */
-		Status = XPlmi_DmaXfr(SrcAddr, DestAddr, Len % XPLMI_SET_CHUNK_SIZE,
-				XPLMI_PMCDMA_0);
-		if (Status != XST_SUCCESS) {
-			goto END;
-		}
+	Status = XPlmi_MemSetNonBlk(DestAddr, Val, Len);
+	if (Status != XST_SUCCESS) {
+		goto END;
 	}
 
+	Status = XPlmi_WaitForMemInit();
+
 END:
 	return Status;
 }
@@ -822,6 +1164,19 @@ void XPlmi_SetMaxOutCmds(u8 Val)
 	DmaCtrl.MaxOutCmds = Val;
 }
 
+/*****************************************************************************/
+/**
+ * @brief	This function returns the PMC DMAs which have non blocking
+ * transfers in flight, which are not waited for yet.
+ *
+ * @return	XPLMI_PMCDMA_0 and XPLMI_PMCDMA_1 flags of the busy PMC DMAs
+ *
+ *****************************************************************************/
+u32 XPlmi_GetNonBlkDmaFlags(void)
+{
+	return NonBlkDmaFlags;
+}
+
 /*****************************************************************************/
 /**
  * @brief	This function is used to Set the memory with a value. If Len is
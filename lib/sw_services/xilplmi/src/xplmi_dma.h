@@ -24,6 +24,8 @@
 * 1.03  bm   09/02/2020 Add XPlmi_MemSet API
 *       bsv  09/30/2020 Added wait for non blocking SBI DMA
 *       bm   10/14/2020 Code clean up
+* 1.04  agent 10/17/2026 Added non blocking memory initialization APIs
+*       agent 10/17/2026 Added API to get PMC DMAs with non blocking transfers
 *
 * </pre>
 *
@@ -101,6 +103,11 @@ int XPlmi_WaitForNonBlkDestDma(u32 DmaFlags);
 int XPlmi_WaitForNonBlkDma(u32 DmaFlags);
 void XPlmi_SetMaxOutCmds(u8 Val);
 int XPlmi_MemSet(u64 DestAddr, u32 Val, u32 Len);
+int XPlmi_EccInitNonBlk(u64 Addr, u32 Len);
+int XPlmi_MemSetNonBlk(u64 DestAddr, u32 Val, u32 Len);
+int XPlmi_WaitForMemInit(void);
+int XPlmi_WaitForMemInitRange(u64 Addr, u32 Len);
+u32 XPlmi_GetNonBlkDmaFlags(void);
 int XPlmi_MemSetBytes(void * DestPtr, u32 DestLen, u8 Val, u32 Len);
 
 #ifdef __cplusplus
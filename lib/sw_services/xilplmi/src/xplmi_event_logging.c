@@ -26,6 +26,8 @@
 * 1.02  bm   10/14/2020 Code clean up
 * 		td   10/19/2020 MISRA C Fixes
 *       ana  10/19/2020 Added doxygen comments
+* 1.03  agent 10/17/2026 Added support for the command profile
+*       agent 10/17/2026 Added trace module mask
 *
 * </pre>
 *
@@ -70,6 +72,16 @@ static XPlmi_CircularBuffer TraceLog = {
 	.IsBufferFull = (u8)FALSE,
 };
 
+/* Modules whose trace events are logged, bit N for module ID N */
+static u32 TraceModuleMask = XPLMI_TRACE_LOG_DEFAULT_MODULES;
+
+#ifdef PLM_ENABLE_CMD_PROFILE
+/* Command profile, hashed on the command ID */
+static XPlmi_CmdProfile CmdProfile[XPLMI_CMD_PROFILE_ENTRIES];
+static u32 CmdProfileUsed;
+static u32 CmdProfileDropped;
+static u8 CmdProfileEnabled = (u8)TRUE;
+#endif
 
 /*****************************************************************************/
 /**
@@ -142,6 +154,43 @@ static int XPlmi_RetrieveBufferData(XPlmi_CircularBuffer * Buffer, u64 DestAddr)
 END:
 	return Status;
 }
+
+#ifdef PLM_ENABLE_CMD_PROFILE
+/*****************************************************************************/
+/**
+ * @brief	This function copies the command profile table to the destination
+ * location, XPLMI_CMD_PROFILE_ENTRY_WORDS words per used entry.
+ *
+ * @param 	DestAddr to which the profile is to be copied
+ *
+ * @return	Number of entries copied
+ *
+ *****************************************************************************/
+static u32 XPlmi_RetrieveCmdProfile(u64 DestAddr)
+{
+	u32 Index;
+	u32 Count = 0U;
+	const XPlmi_CmdProfile *Entry;
+
+	for (Index = 0U; Index < XPLMI_CMD_PROFILE_ENTRIES; ++Index) {
+		Entry = &CmdProfile[Index];
+		if (Entry->Count == 0U) {
+			continue;
+		}
+		XPlmi_Out64(DestAddr, Entry->CmdId);
+		XPlmi_Out64(DestAddr + 4U, Entry->Count);
+		XPlmi_Out64(DestAddr + 8U, Entry->MaxCycles);
+		XPlmi_Out64(DestAddr + 12U, (u32)(Entry->TotalCycles >> 32U));
+		XPlmi_Out64(DestAddr + 16U, (u32)(Entry->TotalCycles & 0xFFFFFFFFU));
+		XPlmi_Out64(DestAddr + 20U, (u32)(Entry->PayloadBytes >> 32U));
+		XPlmi_Out64(DestAddr + 24U, (u32)(Entry->PayloadBytes & 0xFFFFFFFFU));
+		DestAddr += (XPLMI_CMD_PROFILE_ENTRY_WORDS * XPLMI_WORD_LEN);
+		++Count;
+	}
+
+	return Count;
+}
+#endif
 /**
  * @}
  * @endcond
@@ -170,6 +219,15 @@ END:
  *			@Arg1 - High Address
  *			@Arg2 - Low Address
  *		7 - Retrieve Trace Log buffer information
+ *		8 - Configure command profile
+ *			@Arg1 - XPLMI_CMD_PROFILE_ENABLE and XPLMI_CMD_PROFILE_CLEAR flags
+ *		9 - Retrieve command profile
+ *			@Arg1 - High Address
+ *			@Arg2 - Low Address
+ *		10 - Retrieve command profile information
+ *		11 - Configure trace modules
+ *			@Arg1 - Mask of module IDs whose trace events are logged,
+ *			bit N for module ID N
  *
  * @param	Pointer to the command structure
 
@@ -255,8 +313,40 @@ int XPlmi_EventLogging(XPlmi_Cmd * Cmd)
 					TraceLog.StartAddr);
 			Cmd->Response[4U] = TraceLog.Len;
 			Cmd->Response[5U] = TraceLog.IsBufferFull;
+			Cmd->Response[6U] = TraceModuleMask;
 			Status = XST_SUCCESS;
 			break;
+		case XPLMI_LOGGING_CMD_CONFIG_TRACE_MODULES:
+			TraceModuleMask = Arg1;
+			Status = XST_SUCCESS;
+			break;
+#ifdef PLM_ENABLE_CMD_PROFILE
+		case XPLMI_LOGGING_CMD_CONFIG_CMD_PROFILE:
+			if ((Arg1 & XPLMI_CMD_PROFILE_CLEAR) != 0U) {
+				Status = XPlmi_MemSetBytes(CmdProfile, sizeof(CmdProfile),
+					0U, sizeof(CmdProfile));
+				if (Status != XST_SUCCESS) {
+					break;
+				}
+				CmdProfileUsed = 0U;
+				CmdProfileDropped = 0U;
+			}
+			CmdProfileEnabled = (u8)(Arg1 & XPLMI_CMD_PROFILE_ENABLE);
+			Status = XST_SUCCESS;
+			break;
+		case XPLMI_LOGGING_CMD_RETRIEVE_CMD_PROFILE_DATA:
+			Cmd->Response[1U] = XPlmi_RetrieveCmdProfile(
+				((u64)Arg1 << 32U) | Arg2);
+			Status = XST_SUCCESS;
+			break;
+		case XPLMI_LOGGING_CMD_RETRIEVE_CMD_PROFILE_INFO:
+			Cmd->Response[1U] = CmdProfileUsed;
+			Cmd->Response[2U] = XPLMI_CMD_PROFILE_ENTRY_WORDS;
+			Cmd->Response[3U] = CmdProfileDropped;
+			Cmd->Response[4U] = CmdProfileEnabled;
+			Status = XST_SUCCESS;
+			break;
+#endif
 		default:
 			XPlmi_Printf(DEBUG_GENERAL,
 				"Received invalid event logging command\n\r");
@@ -284,6 +374,13 @@ void XPlmi_StoreTraceLog(u32 *TraceData, u32 Len)
 {
 	u32 Index;
 	XPlmi_PerfTime PerfTime = {0U};
+	u32 ModuleId = (TraceData[0U] & XPLMI_TRACE_LOG_MODULE_MASK) >>
+		XPLMI_TRACE_LOG_MODULE_SHIFT;
+
+	if ((ModuleId != 0U) && ((ModuleId >= 32U) ||
+		((TraceModuleMask & ((u32)1U << ModuleId)) == 0U))) {
+		goto END;
+	}
 
 	/* Get time stamp of PLM */
 	XPlmi_MeasurePerfTime((XPLMI_PIT1_CYCLE_VALUE << 32U) |
@@ -303,7 +400,120 @@ void XPlmi_StoreTraceLog(u32 *TraceData, u32 Len)
 		XPlmi_Out64(TraceLog.CurrentAddr, TraceData[Index]);
 		TraceLog.CurrentAddr += XPLMI_WORD_LEN;
 	}
+
+END:
+	return;
+}
+
+#ifdef PLM_ENABLE_CMD_PROFILE
+/*****************************************************************************/
+/**
+ * @brief	This function adds executions of a command to its command
+ * profile entry, allocating the entry on first use.
+ *
+ * @param	CmdId is the command ID with module ID and API ID
+ * @param	Cycles is the execution time in timer cycles
+ * @param	Count is the number of executions accounted
+ * @param	MaxCycles is the time of the longest of these executions
+ * @param	PayloadLen is the number of payload words processed
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XPlmi_AddCmdProfile(u32 CmdId, u64 Cycles, u32 Count,
+	u64 MaxCycles, u32 PayloadLen)
+{
+	u32 Id = CmdId & (XPLMI_CMD_MODULE_ID_MASK | XPLMI_CMD_API_ID_MASK);
+	u32 Index = (Id ^ (Id >> 6U)) & (XPLMI_CMD_PROFILE_ENTRIES - 1U);
+	u32 Probe;
+	XPlmi_CmdProfile *Entry = NULL;
+
+	if (CmdProfileEnabled == (u8)FALSE) {
+		goto END;
+	}
+
+	/* Open addressing with linear probing */
+	for (Probe = 0U; Probe < XPLMI_CMD_PROFILE_ENTRIES; ++Probe) {
+		if ((CmdProfile[Index].Count == 0U) ||
+			(CmdProfile[Index].CmdId == Id)) {
+			Entry = &CmdProfile[Index];
+			break;
+		}
+		Index = (Index + 1U) & (XPLMI_CMD_PROFILE_ENTRIES - 1U);
+	}
+	if (Entry == NULL) {
+		++CmdProfileDropped;
+		goto END;
+	}
+
+	if (Entry->Count == 0U) {
+		Entry->CmdId = Id;
+		++CmdProfileUsed;
+		/* A zero count marks a free entry, count a first resume too */
+		if (Count == 0U) {
+			Count = 1U;
+		}
+	}
+	Entry->Count += Count;
+	if (MaxCycles > Entry->MaxCycles) {
+		Entry->MaxCycles = (MaxCycles > 0xFFFFFFFFU) ?
+			0xFFFFFFFFU : (u32)MaxCycles;
+	}
+	Entry->TotalCycles += Cycles;
+	Entry->PayloadBytes += (u64)PayloadLen * XPLMI_WORD_LEN;
+
+END:
+	return;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function accounts one command handler call in the command
+ * profile. Time of nested commands is included in the time of the command
+ * which runs them.
+ *
+ * @param	CmdId is the command ID with module ID and API ID
+ * @param	StartTime is the timer value before the handler is called
+ * @param	PayloadLen is the number of payload words given to the handler
+ * @param	IsResume is TRUE if the handler resumed a partial command, which
+ * 		is not counted as a separate call
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XPlmi_StoreCmdProfile(u32 CmdId, u64 StartTime, u32 PayloadLen,
+	u8 IsResume)
+{
+	/* PIT timers count down */
+	u64 Cycles = StartTime - XPlmi_GetTimerValue();
+
+	XPlmi_AddCmdProfile(CmdId, Cycles, (IsResume == (u8)FALSE) ? 1U : 0U,
+		Cycles, PayloadLen);
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function accounts a run of commands which are executed
+ * together without calling their handler, such as coalesced CDO writes.
+ * Each command of the run is counted and the time is shared evenly.
+ *
+ * @param	CmdId is the command ID with module ID and API ID
+ * @param	Cycles is the time of the commands of the run in timer cycles
+ * @param	Count is the number of commands
+ * @param	PayloadLen is the number of payload words of all commands
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XPlmi_StoreCmdProfileRun(u32 CmdId, u64 Cycles, u32 Count,
+	u32 PayloadLen)
+{
+	if (Count != 0U) {
+		XPlmi_AddCmdProfile(CmdId, Cycles, Count, Cycles / Count,
+			PayloadLen);
+	}
 }
+#endif
 
 /**
  * @}
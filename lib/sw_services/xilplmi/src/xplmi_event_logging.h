@@ -23,6 +23,10 @@
 *       bsv  04/04/2020 Code clean up
 * 1.02  kc   06/18/2020 Made static functions inline
 *       bm   10/14/2020 Code clean up
+* 1.03  agent 10/17/2026 Added command profile logging commands
+*       agent 10/17/2026 Generated trace event IDs from xplmi_trace_events.h and
+*                        added trace module mask configuration command
+*       agent 10/17/2026 Log XilPlmi and XilLoader trace events by default
 *
 * </pre>
 *
@@ -40,6 +44,8 @@ extern "C" {
 /***************************** Include Files *********************************/
 #include "xplmi_cmd.h"
 #include "xplmi_util.h"
+#include "xplmi_modules.h"
+#include "xplmi_config.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -57,10 +63,25 @@ typedef struct XPlmi_LogInfo {
 	u8 LogLevel;
 }XPlmi_LogInfo;
 
+/* Command profile entry, one per module and API ID */
+typedef struct XPlmi_CmdProfile {
+	u32 CmdId; /**< Module ID and API ID of the command */
+	u32 Count; /**< Number of times the command is executed */
+	u32 MaxCycles; /**< Longest execution of the command in timer cycles */
+	u64 TotalCycles; /**< Total execution time in timer cycles */
+	u64 PayloadBytes; /**< Total payload processed in bytes */
+}XPlmi_CmdProfile;
+
 
 /************************** Function Prototypes ******************************/
 int XPlmi_EventLogging(XPlmi_Cmd * Cmd);
 void XPlmi_StoreTraceLog(u32 *TraceData, u32 Len);
+#ifdef PLM_ENABLE_CMD_PROFILE
+void XPlmi_StoreCmdProfile(u32 CmdId, u64 StartTime, u32 PayloadLen,
+	u8 IsResume);
+void XPlmi_StoreCmdProfileRun(u32 CmdId, u64 Cycles, u32 Count,
+	u32 PayloadLen);
+#endif
 
 /***************** Macros (Inline Functions) Definitions *********************/
 /** Event Logging sub command IDs */
@@ -71,12 +92,58 @@ void XPlmi_StoreTraceLog(u32 *TraceData, u32 Len);
 #define XPLMI_LOGGING_CMD_CONFIG_TRACE_MEM		(0x5U)
 #define XPLMI_LOGGING_CMD_RETRIEVE_TRACE_DATA	(0x6U)
 #define XPLMI_LOGGING_CMD_RETRIEVE_TRACE_BUFFER_INFO	(0x7U)
+#define XPLMI_LOGGING_CMD_CONFIG_CMD_PROFILE		(0x8U)
+#define XPLMI_LOGGING_CMD_RETRIEVE_CMD_PROFILE_DATA	(0x9U)
+#define XPLMI_LOGGING_CMD_RETRIEVE_CMD_PROFILE_INFO	(0xAU)
+#define XPLMI_LOGGING_CMD_CONFIG_TRACE_MODULES		(0xBU)
+
+/* Command profile configuration flags */
+#define XPLMI_CMD_PROFILE_ENABLE		(0x1U)
+#define XPLMI_CMD_PROFILE_CLEAR			(0x2U)
+
+/*
+ * Number of commands the profile table can hold, must be a power of 2.
+ * Each entry is retrieved as XPLMI_CMD_PROFILE_ENTRY_WORDS words
+ * 		0U - Command ID (module ID and API ID)
+ * 		1U - Count
+ * 		2U - Maximum cycles
+ * 		3U - Total cycles high
+ * 		4U - Total cycles low
+ * 		5U - Payload bytes high
+ * 		6U - Payload bytes low
+ */
+#define XPLMI_CMD_PROFILE_ENTRIES		(64U)
+#define XPLMI_CMD_PROFILE_ENTRY_WORDS		(7U)
 
 /* Trace log buffer length shift */
 #define XPLMI_TRACE_LOG_LEN_SHIFT		(16U)
 
-/* Trace event IDs */
-#define XPLMI_TRACE_LOG_LOAD_IMAGE		(0x1U)
+/*
+ * Trace event ID is module ID in bits [15:8] and event number in bits [7:0]
+ * of the header. Module 0 events can not be masked.
+ */
+#define XPLMI_TRACE_LOG_MODULE_SHIFT		(8U)
+#define XPLMI_TRACE_LOG_MODULE_MASK		(0xFF00U)
+#define XPLMI_TRACE_LOG_ALL_MODULES		(0xFFFFFFFFU)
+/*
+ * Modules whose events are logged by default, XilPlmi CDO and XilLoader
+ * partition events unless PLM_TRACE_LOG_MODULES is defined
+ */
+#ifdef PLM_TRACE_LOG_MODULES
+#define XPLMI_TRACE_LOG_DEFAULT_MODULES		(PLM_TRACE_LOG_MODULES)
+#else
+#define XPLMI_TRACE_LOG_DEFAULT_MODULES		\
+	(((u32)1U << XPLMI_MODULE_GENERIC_ID) | \
+	((u32)1U << XPLMI_MODULE_LOADER_ID))
+#endif
+
+/* Trace event IDs, see xplmi_trace_events.h */
+typedef enum {
+#define XPLMI_TRACE_EVENT(Name, ModuleId, EventNum, Format) \
+	Name = (((ModuleId) << XPLMI_TRACE_LOG_MODULE_SHIFT) | (EventNum)),
+#include "xplmi_trace_events.h"
+#undef XPLMI_TRACE_EVENT
+} XPlmi_TraceEventId;
 
 /*
  * Trace log functions
@@ -153,6 +220,26 @@ static inline void XPlmi_TraceLog5(u32 Header, u32 Arg1, u32 Arg2, u32 Arg3)
 	XPlmi_StoreTraceLog(TraceBuffer, XPLMI_ARRAY_SIZE(TraceBuffer));
 }
 
+/*****************************************************************************/
+/**
+ * @brief	This function writes to trace buffer
+ *
+ * @param 	Header of the Trace log
+ * @param	Arg1 of the Trace log
+ * @param	Arg2 of the Trace log
+ * @param	Arg3 of the Trace log
+ * @param	Arg4 of the Trace log
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static inline void XPlmi_TraceLog6(u32 Header, u32 Arg1, u32 Arg2, u32 Arg3,
+	u32 Arg4)
+{
+	u32 TraceBuffer[] = {Header, 0U, 0U, Arg1, Arg2, Arg3, Arg4};
+	XPlmi_StoreTraceLog(TraceBuffer, XPLMI_ARRAY_SIZE(TraceBuffer));
+}
+
 /************************** Variable Definitions *****************************/
 extern XPlmi_LogInfo DebugLog;
 
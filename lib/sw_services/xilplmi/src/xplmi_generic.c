@@ -39,6 +39,7 @@
 *       bm   10/14/2020 Code clean up
 *       td   10/19/2020 MISRA C Fixes
 *       ana  10/19/2020 Added doxygen comments
+* 1.04  agent 10/17/2026 SET command initializes the memory in background
 *
 * </pre>
 *
@@ -60,6 +61,7 @@
 #include "xplmi_modules.h"
 #include "xplmi_cmd.h"
 #include "xil_util.h"
+#include "xplmi_ipi.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -890,10 +892,12 @@ END:
  *		- Low Dest Addr
  *		- Length (Length of words to set to value)
  *		- Value
+ *		The memory is set by the PMC DMAs in background. Commands
+ *		which can access the memory wait for it in XPlmi_CmdExecute.
  *
  * @param	Cmd is pointer to the command structure
  *
- * @return	XST_SUCCESS
+ * @return	XST_SUCCESS on success and error code on failure
  *
  *****************************************************************************/
 static int XPlmi_Set(XPlmi_Cmd *Cmd)
@@ -905,7 +909,7 @@ static int XPlmi_Set(XPlmi_Cmd *Cmd)
 	u32 Len = Cmd->Payload[2U];
 	u32 Val = Cmd->Payload[3U];
 
-	Status = XPlmi_MemSet(DestAddr, Val, Len);
+	Status = XPlmi_MemSetNonBlk(DestAddr, Val, Len);
 
 	return Status;
 }
@@ -1177,6 +1181,42 @@ static int XPlmi_SetWdtParam(XPlmi_Cmd *Cmd)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * @brief	This function sets the memory window an IPI channel may place
+ * its IPI command ring in. Sent over IPI, the same command configures or
+ * rings the command ring itself and does not reach this handler.
+ *
+ * @param	Cmd is pointer to the command structure
+ *		Command payload parameters are
+ *		- IPI mask of the channel
+ *		- High Addr
+ *		- Low Addr
+ *		- Size of the window in bytes, 0 removes the window
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XPlmi_SetIpiRingWindow(XPlmi_Cmd *Cmd)
+{
+	int Status = XST_FAILURE;
+
+#ifdef XPAR_XIPIPSU_0_DEVICE_ID
+	if (Cmd->Len == XPLMI_IPI_RING_WINDOW_LEN) {
+		Status = XPlmi_IpiRingSetWindow(Cmd->Payload[0U],
+			((u64)Cmd->Payload[1U] << 32U) | Cmd->Payload[2U],
+			Cmd->Payload[3U]);
+	} else {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_RING, 0);
+	}
+#else
+	(void)Cmd;
+	Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_RING, 0);
+#endif
+
+	return Status;
+}
+
 /**
  * @{
  * @cond xplmi_internal
@@ -1211,6 +1251,7 @@ static XPlmi_ModuleCmd XPlmi_GenericCmds[] =
 	XPLMI_MODULE_COMMAND(XPlmi_SetBoard),
 	XPLMI_MODULE_COMMAND(XPlmi_GetBoard),
 	XPLMI_MODULE_COMMAND(XPlmi_SetWdtParam),
+	XPLMI_MODULE_COMMAND(XPlmi_SetIpiRingWindow),
 };
 
 /*****************************************************************************/
@@ -32,6 +32,8 @@
 *       bm   08/03/2020 Added ReadBack Props & related API
 *       bm   10/14/2020 Code clean up
 *       td   10/19/2020 MISRA C Fixes
+* 1.04  agent 10/17/2026 Added API IDs of the generic register commands
+*       agent 10/17/2026 Added API ID of the IPI command ring command
 *
 * </pre>
 *
@@ -93,10 +95,19 @@ typedef struct {
 #define XPLMI_MASKPOLL_FLAGS_DEFERRED_ERR	(0x2U)
 #define XPLMI_PLM_GENERIC_CMD_ID_MASK		(0xFFU)
 #define XPLMI_PLM_MODULES_FEATURES_VAL		(0x00U)
+#define XPLMI_PLM_GENERIC_MASK_POLL_VAL		(0x01U)
+#define XPLMI_PLM_GENERIC_MASK_WRITE_VAL	(0x02U)
+#define XPLMI_PLM_GENERIC_WRITE_VAL		(0x03U)
+#define XPLMI_PLM_GENERIC_DELAY_VAL		(0x04U)
+#define XPLMI_PLM_GENERIC_MASK_POLL64_VAL	(0x06U)
+#define XPLMI_PLM_GENERIC_MASK_WRITE64_VAL	(0x07U)
+#define XPLMI_PLM_GENERIC_WRITE64_VAL		(0x08U)
+#define XPLMI_PLM_GENERIC_NOP_VAL		(0x11U)
 #define XPLMI_PLM_GENERIC_DEVICE_ID_VAL		(0x12U)
 #define XPLMI_PLM_GENERIC_EVENT_LOGGING_VAL	(0x13U)
 #define XPLMI_PLM_MODULES_SET_BOARD_VAL		(0x14U)
 #define XPLMI_PLM_MODULES_GET_BOARD_VAL		(0x15U)
+#define XPLMI_PLM_GENERIC_IPI_RING_VAL		(0x17U)
 
 /************************** Function Prototypes ******************************/
 void XPlmi_GenericInit(void);
@@ -38,6 +38,7 @@
 *       bsv  09/21/2020 Set clock source to IRO before SRST for ES1 silicon
 *       bsv  09/30/2020 Added parallel DMA support for SBI, JTAG, SMAP
 *                       and PCIE boot modes
+*       agent 10/17/2026 Moved the trace log buffer to a larger free area
 *
 * </pre>
 *
@@ -156,8 +157,9 @@ static inline void XPlmi_PpuWakeUpDis(void)
  * PMC RAM Memory usage:
  * 0xF2000000U to 0xF2010100U - Used by XilLoader to process CDO
  * 0xF2014000U to 0xF2014FFFU - Used for PLM Runtime Configuration Registers
+ * 0xF2015000U to 0xF2017000U - Used by XilPlmi to store PLM Trace Events
  * 0xF2019000U to 0xF201D000U - Used by XilPlmi to store PLM prints
- * 0xF201D000U to 0xF201E000U - Used by XilPlmi to store PLM Trace Events
+ * 0xF201DD00U to 0xF201E000U - Used by XilPlmi to store Image Info Table
  * 0xF201E000U to 0xF2020000U - Used by XilPdi to get boot Header copied by ROM
  */
 #define XPLMI_PMCRAM_BASEADDR			(0xF2000000U)
@@ -171,9 +173,13 @@ static inline void XPlmi_PpuWakeUpDis(void)
 #define XPLMI_DEBUG_LOG_BUFFER_ADDR	(XPLMI_PMCRAM_BASEADDR + 0x19000U)
 #define XPLMI_DEBUG_LOG_BUFFER_LEN	(0x4000U) /* 16KB */
 
-/* Trace Buffer default address and length */
-#define XPLMI_TRACE_LOG_BUFFER_ADDR	(XPLMI_PMCRAM_BASEADDR + 0x1D000U)
-#define XPLMI_TRACE_LOG_BUFFER_LEN	(0xD00U)	/* 3.25KB */
+/*
+ * Trace Buffer default address and length. A boot logs 4 words per image,
+ * 17 per CDO partition and 12 per other partition, so the 8KB hold the
+ * events of about a hundred partitions.
+ */
+#define XPLMI_TRACE_LOG_BUFFER_ADDR	(XPLMI_PMCRAM_BASEADDR + 0x15000U)
+#define XPLMI_TRACE_LOG_BUFFER_LEN	(0x2000U)	/* 8KB */
 
 /* Image Info Table related macros */
 #define XPLMI_IMAGE_INFO_TBL_BUFFER_ADDR	(XPLMI_PMCRAM_BASEADDR + 0x1DD00U)
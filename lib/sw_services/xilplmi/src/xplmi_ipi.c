@@ -32,6 +32,8 @@
  *                       SET BOARD command via IPI
  *       bm   10/14/2020 Code clean up
  *       td   10/19/2020 MISRA C Fixes
+ * 1.03  agent 10/17/2026 Added shared memory command ring per IPI channel,
+ *                       drained on a single doorbell IPI
  *
  * </pre>
  *
@@ -43,6 +45,8 @@
 #include "xplmi_proc.h"
 #include "xplmi_generic.h"
 #include "xplmi_hw.h"
+#include "xplmi_dma.h"
+#include "xplmi_util.h"
 
 #ifdef XPAR_XIPIPSU_0_DEVICE_ID
 /************************** Constant Definitions *****************************/
@@ -53,6 +57,16 @@
 
 /************************** Function Prototypes ******************************/
 static int XPlmi_ValidateIpiCmd(u32 CmdId);
+static int XPlmi_IpiCmdExecute(XPlmi_Cmd *Cmd, u32 *Payload);
+static int XPlmi_IpiRingCmd(XPlmi_Cmd *Cmd, u32 MaskIndex,
+	const u32 *Payload);
+static int XPlmi_IpiRingConfig(XPlmi_IpiRing *Ring, u32 IpiMask,
+	const u32 *Payload);
+static int XPlmi_IpiRingDrain(XPlmi_IpiRing *Ring, u32 IpiMask, u32 *NumCmds,
+	u32 *NumLeft);
+static u8 XPlmi_IsIpiRingCmd(u32 CmdId);
+static u64 XPlmi_IpiRingEndAddr(u64 Addr, u32 Depth);
+static int XPlmi_IpiRingCheckAddr(u32 IpiMask, u64 Addr, u64 EndAddr);
 
 /************************** Variable Definitions *****************************/
 
@@ -60,6 +74,8 @@ static int XPlmi_ValidateIpiCmd(u32 CmdId);
 /* Instance of IPI Driver */
 static XIpiPsu IpiInst;
 static u32 IpiMaskList[XPLMI_IPI_MASK_COUNT] = {0U};
+static XPlmi_IpiRing IpiRings[XPLMI_IPI_MASK_COUNT];
+static XPlmi_IpiRingWindow IpiRingWindows[XPLMI_IPI_MASK_COUNT];
 
 /*****************************************************************************/
 /**
@@ -145,24 +161,11 @@ int XPlmi_IpiDispatchHandler(void *Data)
 			}
 			Cmd.CmdId = Payload[0U];
 			Cmd.IpiMask = IpiMaskList[MaskIndex];
-			Status = XPlmi_ValidateIpiCmd(Cmd.CmdId);
-			if (Status != XST_SUCCESS) {
-				Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_CMD, 0);
-				Cmd.Response[0U] = (u32)Status;
-				/* Send response to caller */
-				XPlmi_IpiWrite(Cmd.IpiMask, Cmd.Response,
-					XPLMI_CMD_RESP_SIZE, XIPIPSU_BUF_TYPE_RESP);
-				continue;
-			}
-
-			Cmd.Len = (Cmd.CmdId >> 16U) & 255U;
-			if (Cmd.Len > XPLMI_MAX_IPI_CMD_LEN) {
-				Cmd.Len = Payload[1U];
-				Cmd.Payload = (u32 *)&Payload[2U];
+			if (XPlmi_IsIpiRingCmd(Cmd.CmdId) == (u8)TRUE) {
+				Status = XPlmi_IpiRingCmd(&Cmd, MaskIndex, &Payload[1U]);
 			} else {
-				Cmd.Payload = (u32 *)&Payload[1U];
+				Status = XPlmi_IpiCmdExecute(&Cmd, Payload);
 			}
-			Status = XPlmi_CmdExecute(&Cmd);
 			Cmd.Response[0U] = (u32)Status;
 
 			/* Send response to caller */
@@ -194,6 +197,377 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * @brief	This function validates and executes a command received in an
+ * IPI message or in an IPI command ring slot.
+ *
+ * @param	Cmd is pointer to the command with CmdId and IpiMask filled
+ * @param	Payload is the IPI message holding the command
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XPlmi_IpiCmdExecute(XPlmi_Cmd *Cmd, u32 *Payload)
+{
+	int Status = XST_FAILURE;
+
+	Status = XPlmi_ValidateIpiCmd(Cmd->CmdId);
+	if (Status != XST_SUCCESS) {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_CMD, 0);
+		goto END;
+	}
+
+	Cmd->Len = (Cmd->CmdId >> 16U) & 255U;
+	if (Cmd->Len > XPLMI_MAX_IPI_CMD_LEN) {
+		Cmd->Len = Payload[1U];
+		Cmd->Payload = (u32 *)&Payload[2U];
+	} else {
+		Cmd->Payload = (u32 *)&Payload[1U];
+	}
+	Status = XPlmi_CmdExecute(Cmd);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function checks whether the CmdId is the IPI command ring
+ * command.
+ *
+ * @param	CmdId is the command ID
+ *
+ * @return	TRUE if it is the IPI command ring command, else FALSE
+ *
+ *****************************************************************************/
+static u8 XPlmi_IsIpiRingCmd(u32 CmdId)
+{
+	u8 IsRingCmd = (u8)FALSE;
+
+	if (((CmdId & XPLMI_CMD_HNDLR_MASK) == XPLMI_CMD_HNDLR_PLM_VAL) &&
+		((CmdId & XPLMI_PLM_GENERIC_CMD_ID_MASK) ==
+			XPLMI_PLM_GENERIC_IPI_RING_VAL)) {
+		IsRingCmd = (u8)TRUE;
+	}
+
+	return IsRingCmd;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function handles the IPI command ring command. With three
+ * payload words, AddrHigh, AddrLow and Depth, it configures the command ring
+ * of the IPI channel. Depth 0 removes the ring. Without payload, it acts as
+ * the doorbell and up to XPLMI_IPI_RING_DOORBELL_MAX_CMDS commands posted to
+ * the ring are processed. The number of processed commands is returned in
+ * the second response word and the number of commands left in the ring in
+ * the third one.
+ *
+ * @param	Cmd is pointer to the command
+ * @param	MaskIndex is index of the IPI channel
+ * @param	Payload is the command payload
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XPlmi_IpiRingCmd(XPlmi_Cmd *Cmd, u32 MaskIndex,
+	const u32 *Payload)
+{
+	int Status = XST_FAILURE;
+	u32 Len = (Cmd->CmdId >> 16U) & 255U;
+	u32 NumCmds = 0U;
+	u32 NumLeft = 0U;
+
+	if (Len == XPLMI_IPI_RING_CONFIG_LEN) {
+		Status = XPlmi_IpiRingConfig(&IpiRings[MaskIndex], Cmd->IpiMask,
+			Payload);
+	} else if (Len == XPLMI_IPI_RING_DOORBELL_LEN) {
+		Status = XPlmi_IpiRingDrain(&IpiRings[MaskIndex], Cmd->IpiMask,
+			&NumCmds, &NumLeft);
+		Cmd->Response[1U] = NumCmds;
+		Cmd->Response[2U] = NumLeft;
+	} else {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_RING, 0);
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function sets the memory window an IPI channel may place
+ * its command ring in. It is the IPI command ring command executed from a
+ * CDO, so only the boot PDI decides which memory a channel owns. A ring
+ * already configured outside of the new window is no longer processed.
+ *
+ * @param	IpiMask is the IPI mask of the channel
+ * @param	Addr is the start address of the window
+ * @param	Size is the size of the window in bytes, 0 removes the window
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+int XPlmi_IpiRingSetWindow(u32 IpiMask, u64 Addr, u64 Size)
+{
+	int Status = XST_FAILURE;
+	XPlmi_IpiRingWindow *Window = NULL;
+	u32 Index;
+
+	if ((IpiMask == 0U) || ((IpiMask & (IpiMask - 1U)) != 0U) ||
+		((Size != 0U) && ((Addr + Size - 1U) < Addr))) {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_RING, 0);
+		goto END;
+	}
+
+	for (Index = 0U; Index < XPLMI_IPI_MASK_COUNT; Index++) {
+		if (IpiRingWindows[Index].IpiMask == IpiMask) {
+			Window = &IpiRingWindows[Index];
+			break;
+		}
+		if ((Window == NULL) && (IpiRingWindows[Index].IpiMask == 0U)) {
+			Window = &IpiRingWindows[Index];
+		}
+	}
+	if (Window == NULL) {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_RING, 0);
+		goto END;
+	}
+
+	Window->IpiMask = (Size != 0U) ? IpiMask : 0U;
+	Window->Addr = Addr;
+	Window->Size = Size;
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function returns the last byte address of a command ring.
+ *
+ * @param	Addr is the start address of the ring
+ * @param	Depth is the number of slots of the ring
+ *
+ * @return	Last byte address of the ring
+ *
+ *****************************************************************************/
+static u64 XPlmi_IpiRingEndAddr(u64 Addr, u32 Depth)
+{
+	return Addr + (((u64)XPLMI_IPI_RING_HDR_LEN + ((u64)Depth *
+		(XPLMI_IPI_RING_SUBMIT_SLOT_LEN + XPLMI_IPI_RING_COMPL_SLOT_LEN))) *
+		XPLMI_WORD_LEN) - 1U;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function checks that a command ring lies within DDR or OCM
+ * and within the window set for the IPI channel.
+ *
+ * @param	IpiMask is the IPI mask of the channel
+ * @param	Addr is the start address of the ring
+ * @param	EndAddr is the last byte address of the ring
+ *
+ * @return	XST_SUCCESS if the ring may be used, else error code
+ *
+ *****************************************************************************/
+static int XPlmi_IpiRingCheckAddr(u32 IpiMask, u64 Addr, u64 EndAddr)
+{
+	int Status = XST_FAILURE;
+	const XPlmi_IpiRingWindow *Window = NULL;
+	u32 Index;
+
+	if ((Addr == 0U) || (EndAddr < Addr)) {
+		goto END;
+	}
+
+	if (!((EndAddr <= XPLMI_IPI_RING_DDR_LOW_0_HIGHADDR) ||
+		((Addr >= XPLMI_IPI_RING_OCM_BASEADDR) &&
+		(EndAddr <= XPLMI_IPI_RING_OCM_HIGHADDR)) ||
+		((Addr >= XPLMI_IPI_RING_DDR_LOW_1_BASEADDR) &&
+		(EndAddr <= XPLMI_IPI_RING_DDR_LOW_1_HIGHADDR)))) {
+		goto END;
+	}
+
+	for (Index = 0U; Index < XPLMI_IPI_MASK_COUNT; Index++) {
+		if (IpiRingWindows[Index].IpiMask == IpiMask) {
+			Window = &IpiRingWindows[Index];
+			break;
+		}
+	}
+	if ((Window == NULL) || (Addr < Window->Addr) ||
+		(EndAddr > (Window->Addr + Window->Size - 1U))) {
+		goto END;
+	}
+
+	Status = XST_SUCCESS;
+
+END:
+	if (Status != XST_SUCCESS) {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_RING, 0);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function configures the command ring of an IPI channel.
+ * The ring must be in DDR or OCM, within the window of the channel, and its
+ * indices are reset to zero. An invalid configuration leaves the current
+ * ring of the channel in place.
+ *
+ * @param	Ring is pointer to the command ring of the IPI channel
+ * @param	IpiMask is the IPI mask of the channel
+ * @param	Payload holds AddrHigh, AddrLow and Depth of the ring
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XPlmi_IpiRingConfig(XPlmi_IpiRing *Ring, u32 IpiMask,
+	const u32 *Payload)
+{
+	int Status = XST_FAILURE;
+	u64 Addr = ((u64)Payload[0U] << 32U) | Payload[1U];
+	u32 Depth = Payload[2U];
+	u32 Index;
+
+	if (Depth == 0U) {
+		Ring->Addr = 0U;
+		Ring->Depth = 0U;
+		Status = XST_SUCCESS;
+		goto END;
+	}
+
+	if ((Depth > XPLMI_IPI_RING_MAX_DEPTH) ||
+		((Depth & (Depth - 1U)) != 0U) ||
+		((Addr % XPLMI_WORD_LEN) != 0U)) {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_RING, 0);
+		goto END;
+	}
+
+	Status = XPlmi_IpiRingCheckAddr(IpiMask, Addr,
+		XPlmi_IpiRingEndAddr(Addr, Depth));
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	for (Index = 0U; Index < XPLMI_IPI_RING_HDR_LEN; Index++) {
+		XPlmi_Out64(Addr + ((u64)Index * XPLMI_WORD_LEN), 0U);
+	}
+	Ring->Addr = Addr;
+	Ring->Depth = Depth;
+	Ring->SubmitTail = 0U;
+	Ring->ComplHead = 0U;
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function processes the commands posted to the command ring
+ * of an IPI channel and posts their responses to the completion slots.
+ * It runs in the IPI interrupt handler, so at most
+ * XPLMI_IPI_RING_DOORBELL_MAX_CMDS commands are processed per doorbell.
+ * Processing stops early if the client has not consumed the completion
+ * slots yet. Errors of individual commands are reported in their
+ * completion slots.
+ *
+ * @param	Ring is pointer to the command ring of the IPI channel
+ * @param	IpiMask is the IPI mask of the channel
+ * @param	NumCmds is updated with the number of processed commands
+ * @param	NumLeft is updated with the number of commands left in the ring
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XPlmi_IpiRingDrain(XPlmi_IpiRing *Ring, u32 IpiMask, u32 *NumCmds,
+	u32 *NumLeft)
+{
+	int Status = XST_FAILURE;
+	u32 Payload[XPLMI_IPI_RING_SUBMIT_SLOT_LEN];
+	XPlmi_Cmd Cmd;
+	u64 SubmitAddr = Ring->Addr + ((u64)XPLMI_IPI_RING_HDR_LEN *
+		XPLMI_WORD_LEN);
+	u64 ComplAddr = SubmitAddr + ((u64)Ring->Depth *
+		XPLMI_IPI_RING_SUBMIT_SLOT_LEN * XPLMI_WORD_LEN);
+	u64 SlotAddr;
+	u32 SubmitHead;
+	u32 ComplTail;
+	u32 Index;
+
+	*NumCmds = 0U;
+	*NumLeft = 0U;
+	if (Ring->Addr == 0U) {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_RING, 0);
+		goto END;
+	}
+
+	/* The window of the channel may have changed since the ring was set */
+	Status = XPlmi_IpiRingCheckAddr(IpiMask, Ring->Addr,
+		XPlmi_IpiRingEndAddr(Ring->Addr, Ring->Depth));
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	SubmitHead = XPlmi_In64(Ring->Addr +
+		((u64)XPLMI_IPI_RING_SUBMIT_HEAD * XPLMI_WORD_LEN));
+	if ((SubmitHead - Ring->SubmitTail) > Ring->Depth) {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_RING, 0);
+		goto END;
+	}
+
+	while ((Ring->SubmitTail != SubmitHead) &&
+		(*NumCmds < XPLMI_IPI_RING_DOORBELL_MAX_CMDS)) {
+		ComplTail = XPlmi_In64(Ring->Addr +
+			((u64)XPLMI_IPI_RING_COMPL_TAIL * XPLMI_WORD_LEN));
+		if ((Ring->ComplHead - ComplTail) >= Ring->Depth) {
+			break;
+		}
+
+		SlotAddr = SubmitAddr + ((u64)(Ring->SubmitTail & (Ring->Depth - 1U)) *
+			XPLMI_IPI_RING_SUBMIT_SLOT_LEN * XPLMI_WORD_LEN);
+		for (Index = 0U; Index < XPLMI_IPI_RING_SUBMIT_SLOT_LEN; Index++) {
+			Payload[Index] = XPlmi_In64(SlotAddr +
+				((u64)Index * XPLMI_WORD_LEN));
+		}
+
+		(void)XPlmi_MemSetBytes(&Cmd, sizeof(Cmd), 0U, sizeof(Cmd));
+		Cmd.CmdId = Payload[0U];
+		Cmd.IpiMask = IpiMask;
+		if (XPlmi_IsIpiRingCmd(Cmd.CmdId) == (u8)TRUE) {
+			/* Ring commands are not allowed inside the ring */
+			Status = XPlmi_UpdateStatus(XPLMI_ERR_IPI_CMD, 0);
+		} else {
+			Status = XPlmi_IpiCmdExecute(&Cmd, Payload);
+		}
+		Cmd.Response[0U] = (u32)Status;
+
+		SlotAddr = ComplAddr + ((u64)(Ring->ComplHead & (Ring->Depth - 1U)) *
+			XPLMI_IPI_RING_COMPL_SLOT_LEN * XPLMI_WORD_LEN);
+		for (Index = 0U; Index < XPLMI_IPI_RING_COMPL_SLOT_LEN; Index++) {
+			XPlmi_Out64(SlotAddr + ((u64)Index * XPLMI_WORD_LEN),
+				Cmd.Response[Index]);
+		}
+
+		++Ring->ComplHead;
+		++Ring->SubmitTail;
+		XPlmi_Out64(Ring->Addr +
+			((u64)XPLMI_IPI_RING_COMPL_HEAD * XPLMI_WORD_LEN),
+			Ring->ComplHead);
+		XPlmi_Out64(Ring->Addr +
+			((u64)XPLMI_IPI_RING_SUBMIT_TAIL * XPLMI_WORD_LEN),
+			Ring->SubmitTail);
+		*NumCmds += 1U;
+	}
+	*NumLeft = SubmitHead - Ring->SubmitTail;
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * @brief	This function writes an IPI message or a response to
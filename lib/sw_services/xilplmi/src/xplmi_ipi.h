@@ -31,6 +31,7 @@
 * 1.02  bsv  06/02/2020 Added code to support GET BOARD command and disallow
 *                       SET BOARD command via IPI
 *       bm   10/14/2020 Code clean up
+* 1.03  agent 10/17/2026 Added shared memory command ring per IPI channel
 *
 * </pre>
 *
@@ -63,7 +64,66 @@ extern "C" {
 #define IPI_PMC_ISR					(IPI_BASEADDR + 0x20010U)
 #define IPI_PMC_ISR_PSM_BIT_MASK	(0x1U)
 
+/*
+ * IPI command ring layout in shared memory, in words:
+ * - Header of XPLMI_IPI_RING_HDR_LEN words holding the submission head
+ *   and completion tail written by the client, and the submission tail and
+ *   completion head written by PLM. Indices are free running counters.
+ * - Depth submission slots of XPLMI_IPI_RING_SUBMIT_SLOT_LEN words, each
+ *   holding a command in the format of an IPI message.
+ * - Depth completion slots of XPLMI_IPI_RING_COMPL_SLOT_LEN words, each
+ *   holding the response of the command with the same index.
+ */
+#define XPLMI_IPI_RING_HDR_LEN		(4U)
+#define XPLMI_IPI_RING_SUBMIT_HEAD	(0U)
+#define XPLMI_IPI_RING_SUBMIT_TAIL	(1U)
+#define XPLMI_IPI_RING_COMPL_HEAD	(2U)
+#define XPLMI_IPI_RING_COMPL_TAIL	(3U)
+#define XPLMI_IPI_RING_SUBMIT_SLOT_LEN	(XPLMI_IPI_MAX_MSG_LEN)
+#define XPLMI_IPI_RING_COMPL_SLOT_LEN	(XPLMI_CMD_RESP_SIZE)
+#define XPLMI_IPI_RING_MAX_DEPTH	(256U)
+#define XPLMI_IPI_RING_CONFIG_LEN	(3U)
+#define XPLMI_IPI_RING_DOORBELL_LEN	(0U)
+#define XPLMI_IPI_RING_WINDOW_LEN	(4U)
+
+/*
+ * Maximum number of ring commands processed by one doorbell. The doorbell
+ * is handled in the IPI interrupt handler, the client rings it again for
+ * the commands left in the ring.
+ */
+#ifndef XPLMI_IPI_RING_DOORBELL_MAX_CMDS
+#define XPLMI_IPI_RING_DOORBELL_MAX_CMDS	(16U)
+#endif
+
+/*
+ * Memories allowed to hold an IPI command ring. The ring must also be within
+ * the window set for the IPI channel by XPlmi_IpiRingSetWindow.
+ */
+#define XPLMI_IPI_RING_DDR_LOW_0_HIGHADDR	(0x7FFFFFFFU)
+#define XPLMI_IPI_RING_DDR_LOW_1_BASEADDR	(0x800000000UL)
+#define XPLMI_IPI_RING_DDR_LOW_1_HIGHADDR	(0xFFFFFFFFFUL)
+#define XPLMI_IPI_RING_OCM_BASEADDR		(0xFFFC0000U)
+#define XPLMI_IPI_RING_OCM_HIGHADDR		(0xFFFFFFFFU)
+
 /**************************** Type Definitions *******************************/
+/**
+ * IPI command ring of an IPI channel
+ */
+typedef struct {
+	u64 Addr; /**< Shared memory address of the ring, 0 if not configured */
+	u32 Depth; /**< Number of submission and completion slots */
+	u32 SubmitTail; /**< Index of the next command to be processed */
+	u32 ComplHead; /**< Index of the next response to be posted */
+} XPlmi_IpiRing;
+
+/**
+ * Memory window an IPI channel may place its command ring in
+ */
+typedef struct {
+	u32 IpiMask; /**< IPI mask of the channel, 0 if the entry is free */
+	u64 Addr; /**< Start address of the window */
+	u64 Size; /**< Size of the window in bytes */
+} XPlmi_IpiRingWindow;
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
@@ -74,6 +134,7 @@ int XPlmi_IpiWrite(u32 DestCpuMask, u32 *MsgPtr, u32 MsgLen, u8 Type);
 int XPlmi_IpiRead(u32 SrcCpuMask, u32 *MsgPtr, u32 MsgLen, u8 Type);
 int XPlmi_IpiTrigger(u32 DestCpuMask);
 int XPlmi_IpiPollForAck(u32 DestCpuMask, u32 TimeOutCount);
+int XPlmi_IpiRingSetWindow(u32 IpiMask, u64 Addr, u64 Size);
 
 /************************** Variable Definitions *****************************/
 
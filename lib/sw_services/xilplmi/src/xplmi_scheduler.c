@@ -23,6 +23,8 @@
 *       td   08/19/2020 Fixed MISRA C violations Rule 10.3
 *       bm   10/14/2020 Code clean up
 *       td   10/19/2020 MISRA C Fixes
+* 1.03  agent 10/17/2026 Scheduler tasks are kept in a hashed timer wheel
+*                        and periodic tasks use a persistent task node
 *
 * </pre>
 *
@@ -43,8 +45,7 @@
 #define XPLMI_SCHED_TICK	(10U)
 
 /************************** Function Prototypes ******************************/
-static u8 XPlmi_IsTaskNonPeriodic(XPlmi_Scheduler_t *SchedPtr,
-	u32 TaskListIndex);
+static void XPlmi_SchedulerInsert(struct XPlmi_Task_t *SchedTask);
 
 /************************** Variable Definitions *****************************/
 static XPlmi_Scheduler_t Sched;
@@ -53,55 +54,18 @@ static XPlmi_Scheduler_t Sched;
 
 /******************************************************************************/
 /**
-* @brief	The function checks the specified task is active or not, returns
-* corresponding status of the task
+* @brief	The function adds the scheduler task to the timer wheel slot of
+* its expiry tick.
 *
-* @param    	SchedPtr is Scheduler pointer
-* @param    	TaskListIndex is Task index
+* @param	SchedTask is pointer to the scheduler task
 *
-* @return	TRUE or FALSE based on the task active status
-*
-****************************************************************************/
-static u8 XPlmi_IsTaskActive(XPlmi_Scheduler_t *SchedPtr, u32 TaskListIndex)
-{
-	u8 ReturnVal = (u8)FALSE;
-
-	if (XPlmi_IsTaskNonPeriodic(SchedPtr, TaskListIndex) == (u8)TRUE) {
-		ReturnVal = (u8)TRUE;
-	} else {
-		if ((0U != SchedPtr->TaskList[TaskListIndex].Interval)
-		&& (NULL != SchedPtr->TaskList[TaskListIndex].CustomerFunc)
-		&& (0U == (SchedPtr->Tick
-		% SchedPtr->TaskList[TaskListIndex].Interval))) {
-			/* Periodic */
-			ReturnVal = (u8)TRUE;
-		}
-	}
-
-	return ReturnVal;
-}
-
-/******************************************************************************/
-/**
-* @brief	The function checks the specified task is periodic or not, returns
-* corresponding periodicity status.
-*
-* @param    Scheduler pointer
-* @param    Task index
-*
-* @return	TRUE or FALSE based on the task peridocity status
+* @return	None
 *
 ****************************************************************************/
-static u8 XPlmi_IsTaskNonPeriodic(XPlmi_Scheduler_t *SchedPtr, u32 TaskListIndex)
+static void XPlmi_SchedulerInsert(struct XPlmi_Task_t *SchedTask)
 {
-	u8 ReturnVal = (u8)FALSE;
-
-	if ((0U == SchedPtr->TaskList[TaskListIndex].Interval)
-		&& (NULL != SchedPtr->TaskList[TaskListIndex].CustomerFunc)) {
-		ReturnVal = (u8)TRUE;
-	}
-
-	return ReturnVal;
+	metal_list_add_tail(&Sched.Wheel[SchedTask->Expiry &
+		(XPLMI_SCHED_WHEEL_SIZE - 1U)], &SchedTask->WheelNode);
 }
 
 /******************************************************************************/
@@ -122,6 +86,12 @@ void XPlmi_SchedulerInit(void)
 	for (Idx = 0U; Idx < XPLMI_SCHED_MAX_TASK; Idx++) {
 		Sched.TaskList[Idx].Interval = 0U;
 		Sched.TaskList[Idx].CustomerFunc = NULL;
+		Sched.TaskList[Idx].Task = NULL;
+		metal_list_init(&Sched.TaskList[Idx].WheelNode);
+	}
+
+	for (Idx = 0U; Idx < XPLMI_SCHED_WHEEL_SIZE; Idx++) {
+		metal_list_init(&Sched.Wheel[Idx]);
 	}
 
 	Sched.Tick = 0U;
@@ -142,36 +112,51 @@ void XPlmi_SchedulerInit(void)
 void XPlmi_SchedulerHandler(void *Data)
 {
 	int Status = XST_FAILURE;
-	u32 Idx;
+	struct metal_list *Slot;
+	struct metal_list *Node;
+	struct XPlmi_Task_t *SchedTask;
 	XPlmi_TaskNode *Task;
 	(void)Data;
 
 	Sched.Tick++;
 	XPlmi_UtilRMW(PMC_PMC_MB_IO_IRQ_ACK, PMC_PMC_MB_IO_IRQ_ACK, 0x20U);
-	for (Idx = 0U; Idx < XPLMI_SCHED_MAX_TASK; Idx++) {
-		/* Check if the task is triggered and has a valid Callback */
-		if (XPlmi_IsTaskActive(&Sched, Idx) == (u8)TRUE) {
-			/* Add the Task to the PLM Task Queue */
-			Task = XPlmi_TaskCreate(Sched.TaskList[Idx].Priority,
-					Sched.TaskList[Idx].CustomerFunc, NULL);
-			if (Task == NULL) {
-				Status = XPlmi_UpdateStatus(XPLM_ERR_TASK_CREATE, 0x0);
-				XPlmi_Printf(DEBUG_GENERAL, "Task Creation Err:0x%x\n\r", Status);
-				goto END;
-			}
+
+	/* Only the tasks hashed to this tick's slot can expire */
+	Slot = &Sched.Wheel[Sched.Tick & (XPLMI_SCHED_WHEEL_SIZE - 1U)];
+	Node = Slot->next;
+	while (Node != Slot) {
+		SchedTask = metal_container_of(Node, struct XPlmi_Task_t,
+			WheelNode);
+		Node = Node->next;
+		/* Task is due in a later round of the wheel */
+		if (SchedTask->Expiry != Sched.Tick) {
+			continue;
+		}
+
+		metal_list_del(&SchedTask->WheelNode);
+		if (SchedTask->Task != NULL) {
+			/* Periodic, requeue the same task node */
+			XPlmi_TaskTriggerNow(SchedTask->Task);
+			SchedTask->Expiry += SchedTask->Interval;
+			XPlmi_SchedulerInsert(SchedTask);
+			continue;
+		}
+
+		/* Add the Task to the PLM Task Queue */
+		Task = XPlmi_TaskCreate(SchedTask->Priority,
+				SchedTask->CustomerFunc, NULL);
+		if (Task == NULL) {
+			Status = XPlmi_UpdateStatus(XPLM_ERR_TASK_CREATE, 0x0);
+			XPlmi_Printf(DEBUG_GENERAL, "Task Creation Err:0x%x\n\r", Status);
+		} else {
 			XPlmi_TaskTriggerNow(Task);
-			/* Remove the task from scheduler if it is non-periodic*/
-			if (Sched.TaskList[Idx].Interval == 0U) {
-				Sched.TaskList[Idx].OwnerId = 0U;
-				Sched.TaskList[Idx].CustomerFunc = NULL;
-			}
 		}
+		/* Remove the task from scheduler as it is non-periodic */
+		SchedTask->OwnerId = 0U;
+		SchedTask->CustomerFunc = NULL;
 	}
 
 	XPlmi_WdtHandler();
-
-END:
-	return;
 }
 
 /******************************************************************************/
@@ -193,20 +178,55 @@ int XPlmi_SchedulerAddTask(u32 OwnerId, XPlmi_Callback_t CallbackFn,
 {
 	int Status = XST_FAILURE;
 	u32 Idx;
+	u32 Msr;
+	struct XPlmi_Task_t *SchedTask;
+	XPlmi_TaskNode *Task = NULL;
 
+	/* Add Interval as a factor of TICK_MILLISECONDS */
+	u32 Interval = MilliSeconds / XPLMI_SCHED_TICK;
+
+	/* Periodic tasks reuse one task node for every trigger */
+	if (Interval != 0U) {
+		Task = XPlmi_TaskCreate(Priority, CallbackFn, NULL);
+		if (Task == NULL) {
+			Status = XPlmi_UpdateStatus(XPLM_ERR_TASK_CREATE, 0x0);
+			goto END;
+		}
+		Task->IsPersistent = (u8)TRUE;
+	}
+
+	Msr = XPlmi_TaskLock();
 	/* Get the Next Free Task Index */
 	for (Idx = 0U; Idx < XPLMI_SCHED_MAX_TASK; Idx++) {
-		if (NULL == Sched.TaskList[Idx].CustomerFunc) {
-			/* Add Interval as a factor of TICK_MILLISECONDS */
-			Sched.TaskList[Idx].Interval = MilliSeconds / XPLMI_SCHED_TICK;
-			Sched.TaskList[Idx].OwnerId = OwnerId;
-			Sched.TaskList[Idx].CustomerFunc = CallbackFn;
-			Sched.TaskList[Idx].Priority = Priority;
+		SchedTask = &Sched.TaskList[Idx];
+		if (NULL == SchedTask->CustomerFunc) {
+			SchedTask->Interval = Interval;
+			SchedTask->OwnerId = OwnerId;
+			SchedTask->CustomerFunc = CallbackFn;
+			SchedTask->Priority = Priority;
+			SchedTask->Task = Task;
+			/*
+			 * Periodic tasks are triggered on the ticks which are
+			 * multiples of the interval, others on the next tick
+			 */
+			if (Interval != 0U) {
+				SchedTask->Expiry = ((Sched.Tick / Interval) + 1U) *
+					Interval;
+			} else {
+				SchedTask->Expiry = Sched.Tick + 1U;
+			}
+			XPlmi_SchedulerInsert(SchedTask);
 			Status = XST_SUCCESS;
 			break;
 		}
 	}
+	XPlmi_TaskUnlock(Msr);
 
+	if ((Status != XST_SUCCESS) && (Task != NULL)) {
+		XPlmi_TaskFree(Task);
+	}
+
+END:
 	return Status;
 }
 
@@ -228,6 +248,7 @@ int XPlmi_SchedulerRemoveTask(u32 OwnerId, XPlmi_Callback_t CallbackFn,
 {
 	int Status = XST_FAILURE;
 	u32 Idx;
+	u32 Msr;
 	u32 TaskCount = 0U;
 
 	/* Find the Task Index */
@@ -237,9 +258,16 @@ int XPlmi_SchedulerRemoveTask(u32 OwnerId, XPlmi_Callback_t CallbackFn,
 			((Sched.TaskList[Idx].Interval ==
 				(MilliSeconds / XPLMI_SCHED_TICK)) ||
 				(0U == MilliSeconds))) {
+			Msr = XPlmi_TaskLock();
+			metal_list_del(&Sched.TaskList[Idx].WheelNode);
+			if (Sched.TaskList[Idx].Task != NULL) {
+				XPlmi_TaskFree(Sched.TaskList[Idx].Task);
+				Sched.TaskList[Idx].Task = NULL;
+			}
 			Sched.TaskList[Idx].Interval = 0U;
 			Sched.TaskList[Idx].OwnerId = 0U;
 			Sched.TaskList[Idx].CustomerFunc = NULL;
+			XPlmi_TaskUnlock(Msr);
 			TaskCount++;
 		}
 	}
@@ -22,6 +22,7 @@
 *       bsv  04/04/2020 Code clean up
 *       td   08/19/2020 Fixed MISRA C violations Rule 10.3
 *       td   10/19/2020 MISRA C Fixes
+* 1.02  agent 10/17/2026 Added timer wheel and persistent periodic task nodes
 *
 * </pre>
 *
@@ -41,6 +42,8 @@ extern "C" {
 
 /************************** Constant Definitions *****************************/
 #define XPLMI_SCHED_MAX_TASK		(10U)
+/* Number of timer wheel slots, must be a power of 2 */
+#define XPLMI_SCHED_WHEEL_SIZE		(16U)
 
 /* Values for TaskPtr->Status */
 #define XPLMI_TASK_STATUS_TRIGGERED	(0x5AFEC0C0)
@@ -58,10 +61,14 @@ struct XPlmi_Task_t{
 	u32 OwnerId;
 	XPlmi_Callback_t CustomerFunc;
 	TaskPriority_t Priority;
+	u32 Expiry; /**< Tick at which the task is triggered next */
+	XPlmi_TaskNode *Task; /**< Persistent task node of a periodic task */
+	struct metal_list WheelNode;
 };
 
 typedef struct {
 	struct XPlmi_Task_t TaskList[XPLMI_SCHED_MAX_TASK];
+	struct metal_list Wheel[XPLMI_SCHED_WHEEL_SIZE];
 	u32 TaskCount;
 	u32 Tick;
 } XPlmi_Scheduler_t ;
@@ -54,6 +54,9 @@
 *       bsv  10/13/2020 Code clean up
 *       kpt  10/19/2020 Added error code for glitch detection
 *       td   10/19/2020 MISRA C Fixes
+* 1.04  agent 10/17/2026 Added error code for busy PMC DMAs during memory
+*                        initialization
+*       agent 10/17/2026 Added error code for invalid IPI command ring
 *
 * </pre>
 *
@@ -204,6 +207,12 @@ typedef enum {
 						Number used to clear interrupt */
 	XPLMI_ERR_IO_MOD_INTR_NUM_DISABLE,	/**< 0x12B Invalid IoModule interrupt
 						Number used to disable interrupt */
+	XPLMI_ERR_MEMINIT_DMA_BUSY,	/**< 0x12C Both PMC DMAs have non blocking
+						transfers in flight, memory
+						initialization can not start */
+	XPLMI_ERR_IPI_RING,	/**< 0x12D Invalid IPI command ring
+						configuration or ring not
+						configured */
 
 	/** Status codes used in PLM */
 	XPLM_ERR_TASK_CREATE = 0x200,	/**< 0x200 - Error when task create
@@ -23,6 +23,8 @@
 * 1.03  kc   07/28/2020 WDT support added to set PLM live status
 *       bm   10/14/2020 Code clean up
 *       td   10/19/2020 MISRA C Fixes
+* 1.04  agent 10/17/2026 Ready bitmap based task dispatch, task node free
+*                        list and persistent task nodes
 *
 * </pre>
 *
@@ -40,13 +42,25 @@
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
+/*
+ * Ready bit of a priority queue. Priority 0 is the highest priority and is
+ * kept in the MSB, so that count leading zeros gives the queue to run.
+ */
+#define XPLMI_TASK_READY_BIT(Priority)	((u32)1U << (31U - (u32)(Priority)))
 
 /************************** Function Prototypes ******************************/
-static void XPlmi_TaskDelete(XPlmi_TaskNode *Task);
+static void XPlmi_TaskDequeue(XPlmi_TaskNode *Task);
+static void XPlmi_TaskRelease(XPlmi_TaskNode *Task);
+static void XPlmi_TaskDone(XPlmi_TaskNode *Task, int Status);
 
 /************************** Variable Definitions *****************************/
 static struct metal_list TaskQueue[XPLMI_TASK_PRIORITIES];
+/* Next task to run in round robin of every priority queue */
+static struct metal_list *TaskNext[XPLMI_TASK_PRIORITIES];
+static struct metal_list TaskFreeList;
 static XPlmi_TaskNode Tasks[XPLMI_TASK_MAX];
+static XPlmi_TaskNode *CurrentTask;
+static u32 TaskReadyMask;
 
 /*****************************************************************************/
 
@@ -66,23 +80,25 @@ XPlmi_TaskNode * XPlmi_TaskCreate(TaskPriority_t Priority,
 	int (*Handler)(void *Arg), void *PrivData)
 {
 	XPlmi_TaskNode *Task = NULL;
-	u32 Index;
+	struct metal_list *Node;
+	u32 Msr;
 
 	/* Assign free task node */
-	for (Index = 0U; Index < XPLMI_TASK_MAX; Index++) {
-		Task = &Tasks[Index];
-		if (Task->Handler == NULL) {
-			Task->Priority = Priority;
-			Task->Delay = 0U;
-			metal_list_init(&Task->TaskNode);
-			Task->Handler = Handler;
-			Task->PrivData = PrivData;
-			break;
-		}
+	Msr = XPlmi_TaskLock();
+	Node = metal_list_first(&TaskFreeList);
+	if (Node != NULL) {
+		metal_list_del(Node);
+		Task = metal_container_of(Node, XPlmi_TaskNode, TaskNode);
+		Task->Priority = Priority;
+		Task->Delay = 0U;
+		Task->Handler = Handler;
+		Task->PrivData = PrivData;
+		Task->IsPersistent = (u8)FALSE;
 	}
-	if (Index >= XPLMI_TASK_MAX) {
+	XPlmi_TaskUnlock(Msr);
+
+	if (Task == NULL) {
 		XPlmi_Printf(DEBUG_GENERAL, "Task create failed \n\r");
-		Task = NULL;
 	}
 
 	return Task;
@@ -90,21 +106,97 @@ XPlmi_TaskNode * XPlmi_TaskCreate(TaskPriority_t Priority,
 
 /*****************************************************************************/
 /**
- * @brief	This function deletes the task from the task queue.
+ * @brief	This function removes the task from its priority queue, if it is
+ * queued. Must be called with interrupts disabled.
  *
  * @param	Task Pointer to the task node
  *
  * @return	None
  *
  *****************************************************************************/
-static void XPlmi_TaskDelete(XPlmi_TaskNode *Task)
+static void XPlmi_TaskDequeue(XPlmi_TaskNode *Task)
 {
+	u32 Priority = (u32)Task->Priority;
+
 	if (metal_list_is_empty(&Task->TaskNode) == (int)FALSE) {
+		if (TaskNext[Priority] == &Task->TaskNode) {
+			TaskNext[Priority] = Task->TaskNode.next;
+		}
 		metal_list_del(&Task->TaskNode);
+		if (metal_list_is_empty(&TaskQueue[Priority]) != (int)FALSE) {
+			TaskReadyMask &= ~XPLMI_TASK_READY_BIT(Priority);
+		}
 	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function returns a dequeued task node to the free list.
+ * Must be called with interrupts disabled.
+ *
+ * @param	Task Pointer to the task node
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XPlmi_TaskRelease(XPlmi_TaskNode *Task)
+{
 	Task->Delay = 0U;
 	Task->Handler = NULL;
 	Task->PrivData = NULL;
+	Task->IsPersistent = (u8)FALSE;
+	metal_list_add_tail(&TaskFreeList, &Task->TaskNode);
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function is called by the dispatcher once the task handler
+ * is done. Unless the handler is still in progress, the task is deleted from
+ * the task queue. Persistent tasks are only dequeued, so that they can be
+ * triggered again. Clearing the current task is done in the same critical
+ * section, so that XPlmi_TaskFree either frees the node before or leaves it
+ * to this function, but never both.
+ *
+ * @param	Task Pointer to the task node
+ * @param	Status Status returned by the task handler
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XPlmi_TaskDone(XPlmi_TaskNode *Task, int Status)
+{
+	u32 Msr = XPlmi_TaskLock();
+
+	CurrentTask = NULL;
+	if (Status != (int)XPLMI_TASK_INPROGRESS) {
+		XPlmi_TaskDequeue(Task);
+		if (Task->IsPersistent == (u8)FALSE) {
+			XPlmi_TaskRelease(Task);
+		}
+	}
+	XPlmi_TaskUnlock(Msr);
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function frees a persistent task node. If the task handler
+ * is running, the node is freed by the dispatcher once the handler is done.
+ *
+ * @param	Task Pointer to the task node
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XPlmi_TaskFree(XPlmi_TaskNode *Task)
+{
+	u32 Msr = XPlmi_TaskLock();
+
+	Task->IsPersistent = (u8)FALSE;
+	if (Task != CurrentTask) {
+		XPlmi_TaskDequeue(Task);
+		XPlmi_TaskRelease(Task);
+	}
+	XPlmi_TaskUnlock(Msr);
 }
 
 /*****************************************************************************/
@@ -119,15 +211,21 @@ static void XPlmi_TaskDelete(XPlmi_TaskNode *Task)
  *****************************************************************************/
 void XPlmi_TaskTriggerNow(XPlmi_TaskNode *Task)
 {
+	u32 Msr;
+
 	Xil_AssertVoid(Task->Handler != NULL);
+	Msr = XPlmi_TaskLock();
 	if (metal_list_is_empty(&Task->TaskNode) != (int)FALSE) {
 		metal_list_add_tail(&TaskQueue[Task->Priority], &Task->TaskNode);
+		TaskReadyMask |= XPLMI_TASK_READY_BIT(Task->Priority);
 	}
+	XPlmi_TaskUnlock(Msr);
 }
 
 /*****************************************************************************/
 /**
- * @brief	This function initializes the task queues list.
+ * @brief	This function initializes the task queues list and the free list
+ * of task nodes.
  *
  * @param	None
  *
@@ -142,7 +240,14 @@ void XPlmi_TaskInit(void)
 	/* Initialize the list pointers */
 	for (Index = 0U; Index < XPLMI_TASK_PRIORITIES; Index++) {
 		metal_list_init(&TaskQueue[Index]);
+		TaskNext[Index] = &TaskQueue[Index];
 	}
+
+	metal_list_init(&TaskFreeList);
+	for (Index = 0U; Index < XPLMI_TASK_MAX; Index++) {
+		metal_list_add_tail(&TaskFreeList, &Tasks[Index].TaskNode);
+	}
+	TaskReadyMask = 0U;
 }
 
 /*****************************************************************************/
@@ -159,45 +264,35 @@ void XPlmi_TaskInit(void)
 void XPlmi_TaskDispatchLoop(void)
 {
 	int Status = XST_FAILURE;
-	struct metal_list *Node[XPLMI_TASK_PRIORITIES];
 	XPlmi_TaskNode *Task;
 	u32 Index;
+	u32 Msr;
 #ifdef PLM_DEBUG_INFO
 	u64 TaskStartTime;
 	XPlmi_PerfTime PerfTime = {0U};
 #endif
 
 	XPlmi_Printf(DEBUG_DETAILED, "%s\n\r", __func__);
-	for (Index = 0U; Index < XPLMI_TASK_PRIORITIES; Index++) {
-		Node[Index] = &TaskQueue[Index];
-	}
 
 	while (TRUE) {
 		Task = NULL;
 		XPlmi_SetPlmLiveStatus();
 
-		/* Priority based task handling */
-		for (Index = 0U; Index < XPLMI_TASK_PRIORITIES; Index++) {
-			/* If no pending tasks are present, go to sleep */
-			if (metal_list_is_empty(&TaskQueue[Index]) != (int)FALSE) {
-				XPlmi_Printf(DEBUG_DETAILED,
-				 "No pending tasks in Priority%d Queue\n\r",
-				 Index);
-				continue;
-			} else {
-				/* Skip the first element as it
-				 * is not proper task
-				 */
-				if (Node[Index] == &TaskQueue[Index]) {
-					Node[Index] = TaskQueue[Index].next;
-				}
-				/* Get the next task in round robin */
-				Task = metal_container_of(Node[Index],
-					XPlmi_TaskNode, TaskNode);
-				Node[Index] = Node[Index]->next;
-				break;
+		/* Pick the highest priority queue with pending tasks */
+		Msr = XPlmi_TaskLock();
+		if (TaskReadyMask != 0U) {
+			Index = (u32)__builtin_clz(TaskReadyMask);
+			/* Skip the list head as it is not a proper task */
+			if (TaskNext[Index] == &TaskQueue[Index]) {
+				TaskNext[Index] = TaskQueue[Index].next;
 			}
+			/* Get the next task in round robin */
+			Task = metal_container_of(TaskNext[Index],
+				XPlmi_TaskNode, TaskNode);
+			TaskNext[Index] = TaskNext[Index]->next;
+			CurrentTask = Task;
 		}
+		XPlmi_TaskUnlock(Msr);
 
 		if (Task != NULL) {
 #ifdef PLM_DEBUG_INFO
@@ -211,10 +306,8 @@ void XPlmi_TaskDispatchLoop(void)
 			XPlmi_Printf(DEBUG_PRINT_PERF, "%u.%06u ms: Task Time\n\r",
 				(u32)PerfTime.TPerfMs, (u32)PerfTime.TPerfMsFrac);
 #endif
-			if (Status != (int)XPLMI_TASK_INPROGRESS) {
-				/* Delete the task that is handled */
-				XPlmi_TaskDelete(Task);
-			}
+			/* Delete the task that is handled */
+			XPlmi_TaskDone(Task, Status);
 			if ((Status != XST_SUCCESS) &&
 				(Status != (int)XPLMI_TASK_INPROGRESS)) {
 				XPlmi_ErrMgr(Status);
@@ -20,6 +20,7 @@
 * 1.01  kc   07/16/2019 Added PERF macro to print task times
 * 1.02  kc   02/17/2020 Task dispatcher updated with round robin from FCFS
 *       bsv  04/04/2020 Code clean up
+* 1.03  agent 10/17/2026 Added ready bitmap, task free list and persistent tasks
 *
 * </pre>
 *
@@ -45,6 +46,9 @@ extern "C" {
 #define XPLMI_TASK_MAX			(32U)
 #define XPLMI_TASK_PRIORITIES		(2U)
 
+/* MicroBlaze MSR interrupt enable bit */
+#define XPLMI_MB_MSR_IE_MASK		(0x2U)
+
 typedef enum {
         XPLM_TASK_PRIORITY_0 = 0,
         XPLM_TASK_PRIORITY_1, /**< 1 */
@@ -59,6 +63,7 @@ struct XPlmi_TaskNode {
     struct metal_list TaskNode;
     int (*Handler)(void * PrivData);
     void * PrivData;
+    u8 IsPersistent; /**< TRUE if the node is kept after the handler is done */
 };
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -70,10 +75,47 @@ struct XPlmi_TaskNode {
 #define metal_container_of(ptr, structure, member)	\
 	(void *)((uintptr_t)(ptr) - metal_offset_of(structure, member))
 
+/*****************************************************************************/
+/**
+ * @brief	This function disables interrupts to protect the task lists,
+ * which are also updated from interrupt handlers.
+ *
+ * @param	None
+ *
+ * @return	MSR value to be passed to XPlmi_TaskUnlock
+ *
+ *****************************************************************************/
+static inline u32 XPlmi_TaskLock(void)
+{
+	u32 Msr = mfmsr();
+
+	microblaze_disable_interrupts();
+
+	return Msr;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function enables interrupts again if they were enabled
+ * before XPlmi_TaskLock was called.
+ *
+ * @param	Msr is the value returned by XPlmi_TaskLock
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static inline void XPlmi_TaskUnlock(u32 Msr)
+{
+	if ((Msr & XPLMI_MB_MSR_IE_MASK) != 0U) {
+		microblaze_enable_interrupts();
+	}
+}
+
 /************************** Function Prototypes ******************************/
 XPlmi_TaskNode * XPlmi_TaskCreate(TaskPriority_t Priority,
 	int (*Handler)(void *Arg), void * PrivData);
 void XPlmi_TaskTriggerNow(XPlmi_TaskNode * Task);
+void XPlmi_TaskFree(XPlmi_TaskNode * Task);
 void XPlmi_TaskInit(void);
 void XPlmi_TaskDispatchLoop(void);
 
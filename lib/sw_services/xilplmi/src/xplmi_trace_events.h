@@ -0,0 +1,59 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+*
+* @file xplmi_trace_events.h
+*
+* This file contains the table of the PLM trace events. It is included with
+* XPLMI_TRACE_EVENT defined as
+*	XPLMI_TRACE_EVENT(Name, ModuleId, EventNum, Format)
+* and has no include guard on purpose.
+*
+* The PLM only uses the event IDs, which are generated in
+* xplmi_event_logging.h as (ModuleId << 8) | EventNum. The format strings
+* are never built into the PLM, they are used by the host trace decoder in
+* xilplmi/plmtrace to print the events. Format takes up to 4 u32 arguments.
+*
+* Events of module 0 are always logged, events of other modules are logged
+* only if the module is enabled in the trace module mask.
+*
+* New events are added at the end of the module they belong to and existing
+* event numbers are never reused, so that old traces still decode.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agent 10/17/2026 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/* PLM core events, always logged */
+XPLMI_TRACE_EVENT(XPLMI_TRACE_LOG_LOAD_IMAGE, 0U, 0x1U,
+	"Load image 0x%08x")
+
+/* XilPlmi events */
+XPLMI_TRACE_EVENT(XPLMI_TRACE_LOG_CDO_HDR, XPLMI_MODULE_GENERIC_ID, 0x1U,
+	"CDO version 0x%08x, length 0x%08x")
+XPLMI_TRACE_EVENT(XPLMI_TRACE_LOG_CDO_END, XPLMI_MODULE_GENERIC_ID, 0x2U,
+	"CDO end command")
+
+/* XilLoader events */
+XPLMI_TRACE_EVENT(XPLMI_TRACE_LOG_PRTN_CDO, XPLMI_MODULE_LOADER_ID, 0x1U,
+	"Processing CDO partition 0x%08x")
+XPLMI_TRACE_EVENT(XPLMI_TRACE_LOG_PRTN_ELF, XPLMI_MODULE_LOADER_ID, 0x2U,
+	"Copying ELF partition 0x%08x to 0x%08x%08x, length 0x%08x")
+XPLMI_TRACE_EVENT(XPLMI_TRACE_LOG_PRTN_DATA, XPLMI_MODULE_LOADER_ID, 0x3U,
+	"Copying data partition 0x%08x to 0x%08x%08x, length 0x%08x")
+XPLMI_TRACE_EVENT(XPLMI_TRACE_LOG_PRTN_DONE, XPLMI_MODULE_LOADER_ID, 0x4U,
+	"Partition 0x%08x loaded, 0x%08x bytes")
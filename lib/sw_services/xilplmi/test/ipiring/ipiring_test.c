@@ -0,0 +1,302 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Host test of the IPI command ring (xplmi_ipi.c).
+ *
+ * xplmi_ipi.c is built against the cdosim register model, which holds the
+ * ring memory and the IPI registers. A doorbell is simulated by setting the
+ * channel bit in IPI_PMC_ISR, handing the IPI message to XIpiPsu_ReadMessage
+ * and calling XPlmi_IpiDispatchHandler as the IPI interrupt would. The test
+ * plays the client: it posts commands to the submission slots, rings the
+ * doorbell and checks the response and the completion slots.
+ *
+ * Checked are the per channel window, the rejection of address 0, that an
+ * invalid configuration keeps the old ring, the per doorbell command limit
+ * with the number of commands left, and that ring commands are rejected
+ * inside the ring.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xplmi_ipi.h"
+#include "xplmi_generic.h"
+#include "xplmi_proc.h"
+#include "xplmi_dma.h"
+#include "xplmi_status.h"
+#include "cdosim_model.h"
+
+#define CHAN_MASK	(0x4U)		/* Channel under test */
+#define OTHER_MASK	(0x8U)		/* Channel without a window */
+#define WINDOW_ADDR	(0x10000000U)
+#define WINDOW_SIZE	(0x10000U)
+#define RING_DEPTH	(32U)
+#define RING_CMD_ID	(XPLMI_CMD_HNDLR_PLM_VAL | XPLMI_PLM_GENERIC_IPI_RING_VAL)
+#define TEST_CMD_ID	(0x10204U)	/* PM module command, 1 word payload */
+#define ERR_RING	(XPlmi_UpdateStatus(XPLMI_ERR_IPI_RING, 0))
+#define ERR_CMD		(XPlmi_UpdateStatus(XPLMI_ERR_IPI_CMD, 0))
+
+#define CHECK(Cond)	do { \
+	if (!(Cond)) { \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Cond); \
+		exit(EXIT_FAILURE); \
+	} \
+} while (0)
+
+/* Symbols of the PLM the IPI code uses */
+u8 LpdInitialized = LPD_INITIALIZED;
+XPlmi_LogInfo DebugLog;
+
+static XIpiPsu_Config IpiCfg = {
+	.TargetCount = XPAR_XIPIPSU_NUM_TARGETS,
+	.TargetList = {
+		{ 0x1U, 0U }, { 0x2U, 1U }, { 0x4U, 2U }, { 0x8U, 3U },
+		{ 0x10U, 4U }, { 0x20U, 5U }, { 0x40U, 6U },
+	},
+};
+static u32 Msg[XPLMI_IPI_MAX_MSG_LEN];
+static u32 MsgMask;
+static u32 Resp[XPLMI_CMD_RESP_SIZE];
+static u32 NumExecuted;
+static u32 LastPayload;
+
+XIpiPsu_Config *XIpiPsu_LookupConfig(u32 DeviceId)
+{
+	(void)DeviceId;
+	return &IpiCfg;
+}
+
+s32 XIpiPsu_CfgInitialize(XIpiPsu *InstancePtr, XIpiPsu_Config *CfgPtr,
+		UINTPTR EffectiveAddress)
+{
+	InstancePtr->Config = *CfgPtr;
+	InstancePtr->Config.BaseAddress = (u32)EffectiveAddress;
+	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
+	return XST_SUCCESS;
+}
+
+XStatus XIpiPsu_ReadMessage(XIpiPsu *InstancePtr, u32 SrcCpuMask,
+		u32 *MsgPtr, u32 MsgLength, u8 BufferType)
+{
+	(void)InstancePtr;
+	(void)BufferType;
+	if (SrcCpuMask != MsgMask) {
+		return XST_FAILURE;
+	}
+	(void)memcpy(MsgPtr, Msg, MsgLength * sizeof(u32));
+	return XST_SUCCESS;
+}
+
+XStatus XIpiPsu_WriteMessage(XIpiPsu *InstancePtr, u32 DestCpuMask,
+		u32 *MsgPtr, u32 MsgLength, u8 BufferType)
+{
+	(void)InstancePtr;
+	(void)DestCpuMask;
+	(void)BufferType;
+	(void)memcpy(Resp, MsgPtr, MsgLength * sizeof(u32));
+	return XST_SUCCESS;
+}
+
+XStatus XIpiPsu_TriggerIpi(XIpiPsu *InstancePtr, u32 DestCpuMask)
+{
+	(void)InstancePtr;
+	(void)DestCpuMask;
+	return XST_SUCCESS;
+}
+
+XStatus XIpiPsu_PollForAck(XIpiPsu *InstancePtr, u32 DestCpuMask,
+		u32 TimeOutCount)
+{
+	(void)InstancePtr;
+	(void)DestCpuMask;
+	(void)TimeOutCount;
+	return XST_SUCCESS;
+}
+
+int XPlmi_CmdExecute(XPlmi_Cmd *CmdPtr)
+{
+	CHECK(CmdPtr->CmdId == TEST_CMD_ID);
+	CHECK(CmdPtr->Len == 1U);
+	LastPayload = CmdPtr->Payload[0U];
+	NumExecuted++;
+	return XST_SUCCESS;
+}
+
+int XPlmi_MemSetBytes(void *DestPtr, u32 DestLen, u8 Val, u32 Len)
+{
+	CHECK(Len <= DestLen);
+	(void)memset(DestPtr, Val, Len);
+	return XST_SUCCESS;
+}
+
+void XPlmi_PlmIntrEnable(u32 IntrId)
+{
+	(void)IntrId;
+}
+
+int XPlmi_PlmIntrClear(u32 IntrId)
+{
+	(void)IntrId;
+	return XST_SUCCESS;
+}
+
+void XPlmi_PrintPlmTimeStamp(void)
+{
+}
+
+void xil_printf(const char8 *ctrl1, ...)
+{
+	(void)ctrl1;
+}
+
+static u32 RingRead(u64 Addr, u32 Word)
+{
+	return (u32)CdoSim_Read(Addr + ((u64)Word * XPLMI_WORD_LEN), 4U);
+}
+
+static void RingWrite(u64 Addr, u32 Word, u32 Value)
+{
+	CdoSim_Write(Addr + ((u64)Word * XPLMI_WORD_LEN), Value, 4U);
+}
+
+/* Raises the IPI of the channel with the message and runs the handler */
+static int Doorbell(u32 Mask, const u32 *Words, u32 NumWords)
+{
+	(void)memset(Msg, 0, sizeof(Msg));
+	(void)memcpy(Msg, Words, NumWords * sizeof(u32));
+	(void)memset(Resp, 0xFF, sizeof(Resp));
+	MsgMask = Mask;
+	CdoSim_Write(IPI_PMC_ISR, Mask, 4U);
+	(void)XPlmi_IpiDispatchHandler(NULL);
+
+	return (int)Resp[0U];
+}
+
+static int RingConfig(u32 Mask, u64 Addr, u32 Depth)
+{
+	u32 Words[4U] = {
+		(XPLMI_IPI_RING_CONFIG_LEN << 16U) | RING_CMD_ID,
+		(u32)(Addr >> 32U), (u32)Addr, Depth,
+	};
+
+	return Doorbell(Mask, Words, 4U);
+}
+
+static int RingDoorbell(u32 Mask)
+{
+	u32 Words[1U] = { RING_CMD_ID };
+
+	return Doorbell(Mask, Words, 1U);
+}
+
+/* Posts a command to the next submission slot of the ring */
+static void RingPost(u64 Addr, u32 Depth, u32 CmdId, u32 Arg)
+{
+	u32 Head = RingRead(Addr, XPLMI_IPI_RING_SUBMIT_HEAD);
+	u32 Slot = XPLMI_IPI_RING_HDR_LEN +
+		((Head & (Depth - 1U)) * XPLMI_IPI_RING_SUBMIT_SLOT_LEN);
+
+	RingWrite(Addr, Slot, CmdId);
+	RingWrite(Addr, Slot + 1U, Arg);
+	RingWrite(Addr, XPLMI_IPI_RING_SUBMIT_HEAD, Head + 1U);
+}
+
+/* Consumes all completions and returns the status of the last one */
+static u32 RingComplete(u64 Addr, u32 Depth, u32 *NumCompl)
+{
+	u32 Head = RingRead(Addr, XPLMI_IPI_RING_COMPL_HEAD);
+	u32 Tail = RingRead(Addr, XPLMI_IPI_RING_COMPL_TAIL);
+	u32 Status = 0U;
+
+	*NumCompl = Head - Tail;
+	for (; Tail != Head; Tail++) {
+		Status = RingRead(Addr, XPLMI_IPI_RING_HDR_LEN +
+			(Depth * XPLMI_IPI_RING_SUBMIT_SLOT_LEN) +
+			((Tail & (Depth - 1U)) * XPLMI_IPI_RING_COMPL_SLOT_LEN));
+	}
+	RingWrite(Addr, XPLMI_IPI_RING_COMPL_TAIL, Tail);
+
+	return Status;
+}
+
+int main(void)
+{
+	const CdoSim_Latency Latency = { 0 };
+	const u64 Ring = WINDOW_ADDR + 0x100U;
+	u32 Index;
+	u32 NumCompl;
+
+	CdoSim_ModelInit(&Latency);
+	CHECK(XPlmi_IpiInit() == XST_SUCCESS);
+
+	/* Without a window no ring may be configured */
+	CHECK(RingConfig(CHAN_MASK, Ring, RING_DEPTH) == ERR_RING);
+	CHECK(RingDoorbell(CHAN_MASK) == ERR_RING);
+
+	/* Windows are set per channel */
+	CHECK(XPlmi_IpiRingSetWindow(0U, WINDOW_ADDR, WINDOW_SIZE) != XST_SUCCESS);
+	CHECK(XPlmi_IpiRingSetWindow(CHAN_MASK | OTHER_MASK, WINDOW_ADDR,
+		WINDOW_SIZE) != XST_SUCCESS);
+	CHECK(XPlmi_IpiRingSetWindow(CHAN_MASK, WINDOW_ADDR, WINDOW_SIZE) ==
+		XST_SUCCESS);
+
+	/* Address 0, rings outside the window or of another channel */
+	CHECK(RingConfig(CHAN_MASK, 0U, RING_DEPTH) == ERR_RING);
+	CHECK(RingConfig(CHAN_MASK, WINDOW_ADDR - 0x100U, RING_DEPTH) ==
+		ERR_RING);
+	CHECK(RingConfig(CHAN_MASK, WINDOW_ADDR + WINDOW_SIZE - 0x100U,
+		RING_DEPTH) == ERR_RING);
+	CHECK(RingConfig(OTHER_MASK, Ring, RING_DEPTH) == ERR_RING);
+	CHECK(RingConfig(CHAN_MASK, Ring, RING_DEPTH + 1U) == ERR_RING);
+	CHECK(RingConfig(CHAN_MASK, Ring, RING_DEPTH) == XST_SUCCESS);
+
+	/* An invalid configuration keeps the configured ring */
+	CHECK(RingConfig(CHAN_MASK, 0U, RING_DEPTH) == ERR_RING);
+	RingPost(Ring, RING_DEPTH, TEST_CMD_ID, 0x55U);
+	CHECK(RingDoorbell(CHAN_MASK) == XST_SUCCESS);
+	CHECK((Resp[1U] == 1U) && (Resp[2U] == 0U));
+	CHECK((NumExecuted == 1U) && (LastPayload == 0x55U));
+	CHECK(RingComplete(Ring, RING_DEPTH, &NumCompl) == XST_SUCCESS);
+	CHECK(NumCompl == 1U);
+
+	/* A doorbell processes at most XPLMI_IPI_RING_DOORBELL_MAX_CMDS */
+	NumExecuted = 0U;
+	for (Index = 0U; Index < (XPLMI_IPI_RING_DOORBELL_MAX_CMDS + 4U);
+		Index++) {
+		RingPost(Ring, RING_DEPTH, TEST_CMD_ID, Index);
+	}
+	CHECK(RingDoorbell(CHAN_MASK) == XST_SUCCESS);
+	CHECK(Resp[1U] == XPLMI_IPI_RING_DOORBELL_MAX_CMDS);
+	CHECK(Resp[2U] == 4U);
+	CHECK(NumExecuted == XPLMI_IPI_RING_DOORBELL_MAX_CMDS);
+	CHECK(RingComplete(Ring, RING_DEPTH, &NumCompl) == XST_SUCCESS);
+	CHECK(NumCompl == XPLMI_IPI_RING_DOORBELL_MAX_CMDS);
+	CHECK(RingDoorbell(CHAN_MASK) == XST_SUCCESS);
+	CHECK((Resp[1U] == 4U) && (Resp[2U] == 0U));
+	CHECK(LastPayload == (XPLMI_IPI_RING_DOORBELL_MAX_CMDS + 3U));
+	CHECK(RingComplete(Ring, RING_DEPTH, &NumCompl) == XST_SUCCESS);
+	CHECK(NumCompl == 4U);
+
+	/* Ring commands are rejected inside the ring */
+	NumExecuted = 0U;
+	RingPost(Ring, RING_DEPTH, RING_CMD_ID, 0U);
+	CHECK(RingDoorbell(CHAN_MASK) == XST_SUCCESS);
+	CHECK((Resp[1U] == 1U) && (NumExecuted == 0U));
+	CHECK(RingComplete(Ring, RING_DEPTH, &NumCompl) == (u32)ERR_CMD);
+
+	/* Moving the window away from the ring stops its processing */
+	CHECK(XPlmi_IpiRingSetWindow(CHAN_MASK, WINDOW_ADDR + WINDOW_SIZE,
+		WINDOW_SIZE) == XST_SUCCESS);
+	RingPost(Ring, RING_DEPTH, TEST_CMD_ID, 0U);
+	CHECK(RingDoorbell(CHAN_MASK) == ERR_RING);
+	CHECK(NumExecuted == 0U);
+
+	CdoSim_ModelFree();
+	printf("IPI command ring: all checks passed\n");
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,22 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Hooks of the task dispatcher host test, included before every source.
+ *
+ * TaskDisp_Msr() replaces mfmsr(), which XPlmi_TaskLock() reads just before
+ * disabling interrupts. It runs the interrupt set in TaskDisp_Irq, once, so
+ * that a test can raise an interrupt right before the next critical section.
+ * TaskDisp_Sleep() replaces mb_sleep() and leaves the dispatch loop.
+ */
+#ifndef TASKDISP_HOOKS_H
+#define TASKDISP_HOOKS_H
+
+extern void (*TaskDisp_Irq)(void);
+
+unsigned int TaskDisp_Msr(void);
+void TaskDisp_Sleep(void);
+
+#endif /* TASKDISP_HOOKS_H */
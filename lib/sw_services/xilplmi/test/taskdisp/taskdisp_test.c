@@ -0,0 +1,347 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Host test of the PLM task dispatcher (xplmi_task.c) and of the timer wheel
+ * scheduler (xplmi_scheduler.c).
+ *
+ * The dispatch loop runs until all task queues are empty, when mb_sleep()
+ * returns to the test. Interrupts are simulated by the hook of mfmsr(),
+ * which runs a test function right before the next critical section.
+ *
+ * Checked are the priority order and round robin of the ready queues, that
+ * the free list holds XPLMI_TASK_MAX nodes, the expiry ticks of one-shot and
+ * periodic scheduler tasks, including intervals longer than the wheel, and
+ * that a periodic task removed by an interrupt raised when its handler is
+ * done is released once, after the handler.
+ */
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xplmi_task.h"
+#include "xplmi_scheduler.h"
+#include "xplmi_debug.h"
+#include "xplmi_wdt.h"
+
+#define OWNER_ID	(0x1234U)
+#define NUM_TICKS	(64U)
+
+#define CHECK(Cond)	do { \
+	if (!(Cond)) { \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Cond); \
+		exit(EXIT_FAILURE); \
+	} \
+} while (0)
+
+/* Symbols of the PLM the task code uses */
+XPlmi_LogInfo DebugLog;
+u32 Xil_AssertStatus;
+s32 Xil_AssertWait;
+
+void (*TaskDisp_Irq)(void);
+static jmp_buf SleepEnv;
+static char Order[32U];
+static u32 OrderLen;
+static u32 Runs[NUM_TICKS + 1U];
+static u32 Tick;
+static u32 NumErrors;
+static XPlmi_TaskNode *Held[XPLMI_TASK_MAX];
+static u32 NumHeld;
+static u32 QRuns;
+static u32 RemovedRuns;
+
+unsigned int TaskDisp_Msr(void)
+{
+	void (*Irq)(void) = TaskDisp_Irq;
+
+	if (Irq != NULL) {
+		TaskDisp_Irq = NULL;
+		Irq();
+	}
+
+	return XPLMI_MB_MSR_IE_MASK;
+}
+
+void TaskDisp_Sleep(void)
+{
+	longjmp(SleepEnv, 1);
+}
+
+void Xil_Assert(const char8 *File, s32 Line)
+{
+	printf("%s:%d: assert\n", File, Line);
+	exit(EXIT_FAILURE);
+}
+
+void XPlmi_ErrMgr(int ErrStatus)
+{
+	(void)ErrStatus;
+	NumErrors++;
+}
+
+void XPlmi_UtilRMW(u32 RegAddr, u32 Mask, u32 Value)
+{
+	(void)RegAddr;
+	(void)Mask;
+	(void)Value;
+}
+
+void XPlmi_SetPlmLiveStatus(void)
+{
+}
+
+void XPlmi_WdtHandler(void)
+{
+}
+
+void XPlmi_PrintPlmTimeStamp(void)
+{
+}
+
+void xil_printf(const char8 *ctrl1, ...)
+{
+	(void)ctrl1;
+}
+
+/* Runs the dispatch loop until all task queues are empty */
+static void Dispatch(void)
+{
+	if (setjmp(SleepEnv) == 0) {
+		XPlmi_TaskDispatchLoop();
+	}
+}
+
+/* Returns the number of free task nodes */
+static u32 CountFree(void)
+{
+	XPlmi_TaskNode *Nodes[XPLMI_TASK_MAX + 1U];
+	u32 Count = 0U;
+	u32 Index;
+
+	while (Count <= XPLMI_TASK_MAX) {
+		Nodes[Count] = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_1, NULL, NULL);
+		if (Nodes[Count] == NULL) {
+			break;
+		}
+		Count++;
+	}
+	for (Index = 0U; Index < Count; Index++) {
+		XPlmi_TaskFree(Nodes[Index]);
+	}
+
+	return Count;
+}
+
+static void Record(char Name)
+{
+	CHECK(OrderLen < (sizeof(Order) - 1U));
+	Order[OrderLen] = Name;
+	OrderLen++;
+}
+
+static int HighHandler(void *Data)
+{
+	(void)Data;
+	Record('C');
+	return XST_SUCCESS;
+}
+
+static XPlmi_TaskNode *HighTask;
+
+static void TriggerHigh(void)
+{
+	HighTask = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_0, HighHandler, NULL);
+	CHECK(HighTask != NULL);
+	XPlmi_TaskTriggerNow(HighTask);
+}
+
+/* Runs twice, the first run raises an interrupt adding a priority 0 task */
+static int AHandler(void *Data)
+{
+	u32 *Count = Data;
+
+	Record('A');
+	(*Count)++;
+	if (*Count == 1U) {
+		TaskDisp_Irq = TriggerHigh;
+		return (int)XPLMI_TASK_INPROGRESS;
+	}
+
+	return XST_SUCCESS;
+}
+
+static int BHandler(void *Data)
+{
+	u32 *Count = Data;
+
+	Record('B');
+	(*Count)++;
+	if (*Count == 1U) {
+		return (int)XPLMI_TASK_INPROGRESS;
+	}
+
+	return XST_FAILURE;
+}
+
+static int TickHandler(void *Data)
+{
+	(void)Data;
+	Runs[Tick]++;
+	return XST_SUCCESS;
+}
+
+static int OnceHandler(void *Data)
+{
+	(void)Data;
+	Runs[Tick] += 0x100U;
+	return XST_SUCCESS;
+}
+
+static int LongHandler(void *Data)
+{
+	(void)Data;
+	Runs[Tick] += 0x10000U;
+	return XST_SUCCESS;
+}
+
+static int QHandler(void *Data)
+{
+	(void)Data;
+	QRuns++;
+	return XST_SUCCESS;
+}
+
+static int RemovedHandler(void *Data);
+
+/*
+ * Interrupt removing the periodic task whose handler is done, then freeing
+ * a node and creating a one-shot task, as an IPI would
+ */
+static void RemoveIsr(void)
+{
+	XPlmi_TaskNode *Task;
+
+	CHECK(XPlmi_SchedulerRemoveTask(OWNER_ID, RemovedHandler, 10U) ==
+		XST_SUCCESS);
+	NumHeld--;
+	XPlmi_TaskFree(Held[NumHeld]);
+	Task = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_0, QHandler, NULL);
+	CHECK(Task != NULL);
+	XPlmi_TaskTriggerNow(Task);
+}
+
+static int RemovedHandler(void *Data)
+{
+	(void)Data;
+	RemovedRuns++;
+	TaskDisp_Irq = RemoveIsr;
+	return XST_SUCCESS;
+}
+
+static void RunTicks(u32 NumTicks)
+{
+	for (Tick = 1U; Tick <= NumTicks; Tick++) {
+		XPlmi_SchedulerHandler(NULL);
+		Dispatch();
+	}
+}
+
+int main(void)
+{
+	XPlmi_TaskNode *A;
+	XPlmi_TaskNode *B;
+	u32 ACount = 0U;
+	u32 BCount = 0U;
+	u32 Index;
+
+	XPlmi_TaskInit();
+	XPlmi_SchedulerInit();
+	CHECK(CountFree() == XPLMI_TASK_MAX);
+
+	/* Priority 0 runs first, priority 1 tasks alternate in round robin */
+	A = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_1, AHandler, &ACount);
+	B = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_1, BHandler, &BCount);
+	CHECK((A != NULL) && (B != NULL));
+	XPlmi_TaskTriggerNow(A);
+	XPlmi_TaskTriggerNow(B);
+	/* Triggering a queued task doesn't queue it twice */
+	XPlmi_TaskTriggerNow(A);
+	Dispatch();
+	CHECK(strcmp(Order, "ACBAB") == 0);
+	CHECK(NumErrors == 1U);
+	CHECK(CountFree() == XPLMI_TASK_MAX);
+
+	/* One-shot and periodic tasks expire on their ticks */
+	CHECK(XPlmi_SchedulerAddTask(OWNER_ID, TickHandler, 30U,
+		XPLM_TASK_PRIORITY_1) == XST_SUCCESS);
+	CHECK(XPlmi_SchedulerAddTask(OWNER_ID, OnceHandler, 0U,
+		XPLM_TASK_PRIORITY_0) == XST_SUCCESS);
+	/* Longer than one round of the wheel */
+	CHECK(XPlmi_SchedulerAddTask(OWNER_ID, LongHandler,
+		(XPLMI_SCHED_WHEEL_SIZE + 4U) * 10U,
+		XPLM_TASK_PRIORITY_1) == XST_SUCCESS);
+	/* Periodic tasks hold one node, one-shot tasks only while queued */
+	CHECK(CountFree() == (XPLMI_TASK_MAX - 2U));
+	RunTicks(NUM_TICKS);
+	for (Index = 1U; Index <= NUM_TICKS; Index++) {
+		u32 Expected = 0U;
+
+		if ((Index % 3U) == 0U) {
+			Expected += 1U;
+		}
+		if (Index == 1U) {
+			Expected += 0x100U;
+		}
+		if ((Index % (XPLMI_SCHED_WHEEL_SIZE + 4U)) == 0U) {
+			Expected += 0x10000U;
+		}
+		CHECK(Runs[Index] == Expected);
+	}
+	CHECK(CountFree() == (XPLMI_TASK_MAX - 2U));
+	CHECK(XPlmi_SchedulerRemoveTask(OWNER_ID, TickHandler, 30U) ==
+		XST_SUCCESS);
+	CHECK(XPlmi_SchedulerRemoveTask(OWNER_ID, LongHandler, 0U) ==
+		XST_SUCCESS);
+	CHECK(XPlmi_SchedulerRemoveTask(OWNER_ID, OnceHandler, 0U) ==
+		XST_FAILURE);
+	CHECK(CountFree() == XPLMI_TASK_MAX);
+
+	/*
+	 * A periodic task removed by an interrupt raised when its handler is
+	 * done is released once, after the handler. Until then its node must
+	 * not be handed out, else the task created by the interrupt would be
+	 * deleted in its place.
+	 */
+	XPlmi_SchedulerInit();
+	CHECK(XPlmi_SchedulerAddTask(OWNER_ID, RemovedHandler, 10U,
+		XPLM_TASK_PRIORITY_1) == XST_SUCCESS);
+	/* Keep all other nodes allocated, so that a freed node is reused */
+	while (NumHeld < XPLMI_TASK_MAX) {
+		Held[NumHeld] = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_1, NULL,
+			NULL);
+		if (Held[NumHeld] == NULL) {
+			break;
+		}
+		NumHeld++;
+	}
+	CHECK(NumHeld == (XPLMI_TASK_MAX - 1U));
+	RunTicks(1U);
+	CHECK(RemovedRuns == 1U);
+	CHECK(TaskDisp_Irq == NULL);
+	CHECK(QRuns == 1U);
+	for (Index = 0U; Index < NumHeld; Index++) {
+		XPlmi_TaskFree(Held[Index]);
+	}
+	CHECK(CountFree() == XPLMI_TASK_MAX);
+	RunTicks(4U);
+	CHECK(RemovedRuns == 1U);
+
+	printf("Task dispatcher: all checks passed\n");
+
+	return EXIT_SUCCESS;
+}